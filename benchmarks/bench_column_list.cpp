@@ -0,0 +1,114 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of ColumnList against a List of records: sum of one field, max
+ * of one field and stable sort by one field.
+ *
+ * Usage: bench_column_list [list size]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/collections/column_list.hpp"
+#include "snowball/collections/algorithms.hpp"
+#include "snowball/collections/timsort.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+struct Trade
+{
+    long id;
+    double price;
+    double quantity;
+    long timestamp;
+    char symbol[16];
+};
+
+int main(int argc, char** argv)
+{
+    long size = argc > 1 ? atol(argv[1]) : 10000000;
+    List<Trade> rows;
+    ColumnList<long, double, double, long> columns;
+    rows.reserve(size);
+    columns.reserve(size);
+    srand(0);
+    for (long i = 0; i < size; ++i)
+    {
+        Trade trade = {i, double(rand() % 100000) / 100., 1., i, "SNOW"};
+        rows.append(trade);
+        columns.append(trade.id, trade.price, trade.quantity, trade.timestamp);
+    }
+    const ColumnList<long, double, double, long>& table = columns;
+
+    TimeIt<double()> rowSum([&]() {
+        double sum = 0.;
+        for (const Trade& trade: rows)
+            sum += trade.price;
+        return sum;
+    });
+    TimeIt<double()> columnSum([&]() {
+        double sum = 0.;
+        for (double price: table.column<1>())
+            sum += price;
+        return sum;
+    });
+    TimeIt<double()> rowMax([&]() {
+        double highest = rows[0].price;
+        for (const Trade& trade: rows)
+            if (trade.price > highest)
+                highest = trade.price;
+        return highest;
+    });
+    TimeIt<double()> columnMax([&]() {
+        return max(table.column<1>());
+    });
+    TimeIt<double()> rowSort([&]() {
+        stableSort(rows.begin(), rows.end(),
+                   [](const Trade& a, const Trade& b)
+                   { return a.price < b.price; });
+        return rows[0].price;
+    });
+    TimeIt<double()> columnSort([&]() {
+        columns.sortBy<1>();
+        return table.column<1>()[0];
+    });
+    if (rowSum() != columnSum() || rowMax() != columnMax() ||
+        rowSort() != columnSort())
+    {
+        cout << "mismatch between rows and columns" << endl;
+        return 1;
+    }
+    cout << "list size: " << size << " (wall times in ms)" << endl;
+    cout << setw(16) << left << "" << setw(12) << right << "sum"
+         << setw(12) << right << "max" << setw(12) << right << "sort" << endl;
+    cout << setw(16) << left << "List<Trade>" << fixed << setprecision(2)
+         << setw(12) << right << rowSum.wallTime()
+         << setw(12) << right << rowMax.wallTime()
+         << setw(12) << right << rowSort.wallTime() << endl;
+    cout << setw(16) << left << "ColumnList" << fixed << setprecision(2)
+         << setw(12) << right << columnSum.wallTime()
+         << setw(12) << right << columnMax.wallTime()
+         << setw(12) << right << columnSort.wallTime() << endl;
+    return 0;
+}
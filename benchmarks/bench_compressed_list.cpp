@@ -0,0 +1,144 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of CompressedList against List on sorted timestamps: memory,
+ * append, sequential sum, random access and lookups.
+ *
+ * Usage: bench_compressed_list [list size]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/collections/bisect.hpp"
+#include "snowball/collections/compressed_list.hpp"
+#include "snowball/collections/bit_packing.h"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+/*
+ * Millisecond timestamps of events arriving every 0 to 20 ms.
+ */
+List<long> timestamps(long size)
+{
+    List<long> output;
+    output.reserve(size);
+    long timestamp = 1500000000000L;
+    srand(0);
+    for (long i = 0; i < size; ++i)
+    {
+        timestamp += rand() % 21;
+        output.append(timestamp);
+    }
+    return output;
+}
+
+int main(int argc, char** argv)
+{
+    long size = argc > 1 ? atol(argv[1]) : 10000000;
+    const long lookups = 1000000;
+    List<long> items = timestamps(size);
+    List<long> list;
+    CompressedList<long> compressed;
+
+    TimeIt<long()> listAppend([&]() {
+        for (long item: items)
+            list.append(item);
+        return long(list.size());
+    });
+    TimeIt<long()> compressedAppend([&]() {
+        for (long item: items)
+            compressed.append(item);
+        compressed.shrinkToFit();
+        return long(compressed.size());
+    });
+    TimeIt<long()> listSum([&]() {
+        long sum = 0;
+        for (long item: list)
+            sum += item;
+        return sum;
+    });
+    TimeIt<long()> compressedSum([&]() {
+        long sum = 0;
+        for (long item: compressed)
+            sum += item;
+        return sum;
+    });
+    TimeIt<long()> listRandom([&]() {
+        long sum = 0;
+        for (long i = 0; i < lookups; ++i)
+            sum += list[(i * 7919) % size];
+        return sum;
+    });
+    TimeIt<long()> compressedRandom([&]() {
+        long sum = 0;
+        for (long i = 0; i < lookups; ++i)
+            sum += compressed[(i * 7919) % size];
+        return sum;
+    });
+    TimeIt<long()> listContains([&]() {
+        long found = 0;
+        for (long i = 0; i < lookups; ++i)
+        {
+            long item = items[(i * 7919) % size] + i % 2;
+            size_t pos = bisectLeft(list, item);
+            found += pos < list.size() && list[pos] == item;
+        }
+        return found;
+    });
+    TimeIt<long()> compressedContains([&]() {
+        long found = 0;
+        for (long i = 0; i < lookups; ++i)
+            found += compressed.contains(items[(i * 7919) % size] + i % 2);
+        return found;
+    });
+    listAppend();
+    compressedAppend();
+    if (listSum() != compressedSum() || listRandom() != compressedRandom() ||
+        listContains() != compressedContains())
+    {
+        cout << "mismatch between List and CompressedList" << endl;
+        return 1;
+    }
+    cout << "list size: " << size << ", " << lookups << " lookups, "
+         << detail::bitPackingInstructionSet() << " kernels"
+         << " (wall times in ms)" << endl;
+    cout << setw(16) << left << "" << setw(12) << right << "MB"
+         << setw(12) << right << "append" << setw(12) << right << "sum"
+         << setw(12) << right << "[] random" << setw(12) << right
+         << "contains" << endl;
+    cout << setw(16) << left << "List" << fixed << setprecision(2)
+         << setw(12) << right << list.size() * sizeof(long) / 1e6
+         << setw(12) << right << listAppend.wallTime()
+         << setw(12) << right << listSum.wallTime()
+         << setw(12) << right << listRandom.wallTime()
+         << setw(12) << right << listContains.wallTime() << endl;
+    cout << setw(16) << left << "CompressedList" << fixed << setprecision(2)
+         << setw(12) << right << compressed.memoryUsage() / 1e6
+         << setw(12) << right << compressedAppend.wallTime()
+         << setw(12) << right << compressedSum.wallTime()
+         << setw(12) << right << compressedRandom.wallTime()
+         << setw(12) << right << compressedContains.wallTime() << endl;
+    return 0;
+}
@@ -0,0 +1,161 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Mixed lookups and updates of random keys from 1 to N threads: Dictionary
+ * guarded by a mutex against ConcurrentDictionary. Each thread runs the same
+ * number of operations; throughput of all threads is reported in millions
+ * of operations per second.
+ *
+ * Usage: bench_concurrent_dictionary [keys] [operations per thread]
+ *                                    [max threads] [read percentage]
+ *
+ * Defaults are 100000 keys, 1000000 operations, 32 threads (or the number of
+ * hardware threads if greater) and 90% reads.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "snowball/collections/dictionary.hpp"
+#include "snowball/concurrency/concurrent_dictionary.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+/*
+ * Small random generator, so that drawing operations costs less than
+ * running them.
+ */
+struct XorShift
+{
+    explicit XorShift(uint64_t seed):
+        state(seed * 0x9e3779b97f4a7c15ULL + 1) { }
+
+    uint64_t operator()()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    uint64_t state;
+};
+
+/*
+ * Sum of values read, so that lookups are not optimized away.
+ */
+atomic<long> sink(0);
+
+/*
+ * Run operations on given number of threads: worker is called with
+ * (key, true) for a read and (key, false) for an update, and returns the
+ * value read.
+ */
+template <typename Worker>
+void run(long keys, long operations, unsigned threads, unsigned reads,
+         Worker worker)
+{
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; ++t)
+        workers.push_back(thread([=]() {
+            XorShift random(t);
+            long sum = 0;
+            for (long i = 0; i < operations; ++i)
+            {
+                uint64_t r = random();
+                sum += worker(long((r >> 8) % keys),
+                              unsigned(r & 0xff) % 100 < reads);
+            }
+            sink += sum;
+        }));
+    for (thread& w: workers)
+        w.join();
+}
+
+int main(int argc, char** argv)
+{
+    long keys = argc > 1 ? atol(argv[1]) : 100000;
+    long operations = argc > 2 ? atol(argv[2]) : 1000000;
+    unsigned maxThreads = argc > 3 ? atoi(argv[3])
+                                   : max(32u, thread::hardware_concurrency());
+    unsigned reads = argc > 4 ? atoi(argv[4]) : 90;
+    if (maxThreads == 0)
+        maxThreads = 1;
+    cout << "keys: " << keys << ", operations per thread: " << operations
+         << ", reads: " << reads << "% (millions of operations per second)"
+         << endl;
+    cout << setw(10) << left << "threads" << setw(20) << right
+         << "mutex + Dictionary" << setw(22) << right << "ConcurrentDictionary"
+         << setw(10) << right << "ratio" << endl;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        Dictionary<long, long> locked;
+        mutex guard;
+        ConcurrentDictionary<long, long> concurrent;
+        concurrent.reserve(keys);
+        for (long key = 0; key < keys; ++key)
+        {
+            locked[key] = 0;
+            concurrent.set(key, 0);
+        }
+        TimeIt<long()> lockedRun([&]() {
+            run(keys, operations, threads, reads, [&](long key, bool read) {
+                lock_guard<mutex> lock(guard);
+                return read ? locked.get(key, -1) : ++locked[key];
+            });
+            long sum = 0;
+            for (long key = 0; key < keys; ++key)
+                sum += locked[key];
+            return sum;
+        });
+        TimeIt<long()> concurrentRun([&]() {
+            run(keys, operations, threads, reads, [&](long key, bool read) {
+                if (read)
+                    return concurrent.get(key, -1);
+                return concurrent.update(key, [](long& count) { ++count; });
+            });
+            long sum = 0;
+            concurrent.forEach([&sum](long, long count) { sum += count; });
+            return sum;
+        });
+        if (lockedRun() != concurrentRun())
+        {
+            cout << "mismatch between dictionaries" << endl;
+            return 1;
+        }
+        double total = double(operations) * threads / 1000.;
+        cout << setw(10) << left << threads << fixed << setprecision(2)
+             << setw(20) << right << total / lockedRun.wallTime()
+             << setw(22) << right << total / concurrentRun.wallTime()
+             << setw(10) << right
+             << lockedRun.wallTime() / concurrentRun.wallTime() << endl;
+        if (threads * 2 > maxThreads && threads != maxThreads)
+            threads = maxThreads / 2;
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Appends from 1 to N producer threads: List guarded by a mutex against
+ * ConcurrentList, both turned into a List at the end.
+ *
+ * Usage: bench_concurrent_list [number of items] [max threads]
+ *
+ * Max threads defaults to the number of hardware threads.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/concurrency/concurrent_list.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+/*
+ * Run producer on given number of threads, each one appending its share of
+ * items.
+ */
+template <typename Producer>
+void produce(long items, unsigned threads, Producer producer)
+{
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; ++t)
+        workers.push_back(thread([=]() {
+            for (long i = t; i < items; i += threads)
+                producer(i);
+        }));
+    for (thread& worker: workers)
+        worker.join();
+}
+
+int main(int argc, char** argv)
+{
+    long items = argc > 1 ? atol(argv[1]) : 10000000;
+    unsigned maxThreads = argc > 2 ? atoi(argv[2])
+                                   : thread::hardware_concurrency();
+    if (maxThreads == 0)
+        maxThreads = 1;
+    cout << "items: " << items << " (wall times in ms)" << endl;
+    cout << setw(10) << left << "threads" << setw(16) << right << "mutex + List"
+         << setw(16) << right << "ConcurrentList" << setw(10) << right
+         << "ratio" << endl;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        TimeIt<size_t()> locked([&]() {
+            List<long> list;
+            mutex guard;
+            produce(items, threads, [&](long i) {
+                lock_guard<mutex> lock(guard);
+                list.append(i);
+            });
+            return list.size();
+        });
+        TimeIt<size_t()> concurrent([&]() {
+            ConcurrentList<long> list;
+            produce(items, threads, [&](long i) { list.append(i); });
+            return list.freeze().size();
+        });
+        if (locked() != size_t(items) || concurrent() != size_t(items))
+        {
+            cout << "missing items" << endl;
+            return 1;
+        }
+        cout << setw(10) << left << threads << fixed << setprecision(2)
+             << setw(16) << right << locked.wallTime()
+             << setw(16) << right << concurrent.wallTime()
+             << setw(10) << right
+             << locked.wallTime() / concurrent.wallTime() << endl;
+        if (threads * 2 > maxThreads && threads != maxThreads)
+            threads = maxThreads / 2;
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of queue workloads on Deque against List.
+ *
+ * Usage: bench_deque [queue length] [operations]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/collections/deque.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+void report(const string& name, TimeIt<long()>& timer)
+{
+    long checksum = timer();
+    cout << setw(36) << left << name
+         << setw(12) << right << fixed << setprecision(2) << timer.wallTime()
+         << "   (" << checksum << ")" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    long length = argc > 1 ? atol(argv[1]) : 10000;
+    long ops = argc > 2 ? atol(argv[2]) : 1000000;
+    cout << "queue length: " << length << ", operations: " << ops << endl;
+    cout << setw(36) << left << "workload" << setw(12) << right << "wall (ms)"
+         << endl;
+
+    //FIFO: steady state queue of given length
+    TimeIt<long()> listFifo([=]() {
+        List<long> queue;
+        long total = 0;
+        for (long i = 0; i < length; ++i)
+            queue.append(i);
+        for (long i = 0; i < ops; ++i)
+        {
+            queue.append(i);
+            total += queue.pop(0);
+        }
+        return total;
+    });
+    TimeIt<long()> dequeFifo([=]() {
+        Deque<long> queue;
+        long total = 0;
+        for (long i = 0; i < length; ++i)
+            queue.append(i);
+        for (long i = 0; i < ops; ++i)
+        {
+            queue.append(i);
+            total += queue.popleft();
+        }
+        return total;
+    });
+    report("FIFO List append/pop(0)", listFifo);
+    report("FIFO Deque append/popleft", dequeFifo);
+
+    //LIFO at the front
+    TimeIt<long()> listFront([=]() {
+        List<long> stack;
+        long total = 0;
+        for (long i = 0; i < length; ++i)
+            stack.insert(0, i);
+        for (long i = 0; i < ops; ++i)
+        {
+            stack.insert(0, i);
+            total += stack.pop(0);
+        }
+        return total;
+    });
+    TimeIt<long()> dequeFront([=]() {
+        Deque<long> stack;
+        long total = 0;
+        for (long i = 0; i < length; ++i)
+            stack.appendleft(i);
+        for (long i = 0; i < ops; ++i)
+        {
+            stack.appendleft(i);
+            total += stack.popleft();
+        }
+        return total;
+    });
+    report("front List insert(0)/pop(0)", listFront);
+    report("front Deque appendleft/popleft", dequeFront);
+
+    //sliding window of fixed length
+    TimeIt<long()> dequeWindow([=]() {
+        Deque<long> window(length);
+        long total = 0;
+        for (long i = 0; i < ops; ++i)
+        {
+            window.append(i);
+            total += window[0];
+        }
+        return total;
+    });
+    report("sliding window Deque(maxlen)", dequeWindow);
+
+    //round robin scheduling
+    TimeIt<long()> dequeRotate([=]() {
+        Deque<long> ring;
+        long total = 0;
+        for (long i = 0; i < length; ++i)
+            ring.append(i);
+        for (long i = 0; i < ops; ++i)
+        {
+            ring.rotate(-1);
+            total += ring[-1];
+        }
+        return total;
+    });
+    report("round robin Deque rotate(-1)", dequeRotate);
+    return 0;
+}
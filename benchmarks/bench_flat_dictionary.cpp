@@ -0,0 +1,116 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of FlatDictionary against Dictionary with random long keys:
+ * insertion of all keys, lookup of present keys in random order and lookup
+ * of missing keys. At least 1M lookups are timed for each size.
+ *
+ * Usage: bench_flat_dictionary [size...]
+ *
+ * Sizes default to 1000, 1000000 and 100000000. Dictionary needs about 6 GB
+ * at 100M entries.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "snowball/collections/dictionary.hpp"
+#include "snowball/collections/flat_dictionary.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+/*
+ * Time insertions and lookups in a dictionary, print a row and return the
+ * sum of values found (to check both dictionaries agree).
+ */
+template <typename DictionaryType>
+long run(const string& name, const vector<long>& keys,
+         const vector<long>& order, const vector<long>& missing)
+{
+    DictionaryType dict;
+    TimeIt<size_t()> insert([&]() {
+        for (size_t i = 0; i < keys.size(); ++i)
+            dict[keys[i]] = long(i);
+        return dict.size();
+    });
+    TimeIt<long()> hit([&]() {
+        long sum = 0;
+        for (long i: order)
+            sum += dict.get(keys[i], -1);
+        return sum;
+    });
+    TimeIt<long()> miss([&]() {
+        long sum = 0;
+        for (long key: missing)
+            sum += dict.get(key, -1);
+        return sum;
+    });
+    insert();
+    long sum = hit() + miss();
+    cout << setw(16) << left << name << fixed << setprecision(2)
+         << setw(12) << right << insert.wallTime()
+         << setw(12) << right << hit.wallTime()
+         << setw(12) << right << miss.wallTime() << endl;
+    return sum;
+}
+
+int main(int argc, char** argv)
+{
+    vector<long> sizes;
+    for (int i = 1; i < argc; ++i)
+        sizes.push_back(atol(argv[i]));
+    if (sizes.empty())
+        sizes = {1000, 1000000, 100000000};
+    mt19937_64 random(0);
+    for (long size: sizes)
+    {
+        //odd keys are present, even keys are missing
+        vector<long> keys(size);
+        for (long& key: keys)
+            key = long(random() | 1);
+        size_t lookups = max(size_t(size), size_t(1000000));
+        vector<long> order(lookups);
+        for (long& i: order)
+            i = long(random() % size);
+        vector<long> missing(lookups);
+        for (long& key: missing)
+            key = long(random() & ~1UL);
+        cout << "dictionary size: " << size << ", lookups: " << lookups
+             << " (wall times in ms)" << endl;
+        cout << setw(16) << left << "" << setw(12) << right << "insert"
+             << setw(12) << right << "hit" << setw(12) << right << "miss"
+             << endl;
+        long flat = run< FlatDictionary<long, long> >(
+            "FlatDictionary", keys, order, missing);
+        long node = run< Dictionary<long, long> >(
+            "Dictionary", keys, order, missing);
+        if (flat != node)
+        {
+            cout << "mismatch between dictionaries" << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of List::sort(key, reverse) against a comparator recomputing
+ * keys, on a case-insensitive sort of String.
+ *
+ * Usage: bench_key_sort [list size]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/collections/string.h"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+void report(const string& name, TimeIt<bool()>& timer)
+{
+    timer();
+    cout << setw(36) << left << name << setw(12) << right << fixed
+         << setprecision(2) << timer.wallTime() << endl;
+}
+
+int main(int argc, char** argv)
+{
+    long size = argc > 1 ? atol(argv[1]) : 1000000;
+    cout << "list size: " << size << endl;
+    cout << setw(36) << left << "sort" << setw(12) << right << "wall (ms)"
+         << endl;
+    mt19937_64 generator(42);
+    List<String> data;
+    for (long i = 0; i < size; ++i)
+    {
+        string word;
+        for (int c = 0; c < 12; ++c)
+        {
+            char letter = char('a' + generator() % 26);
+            word += generator() % 2 ? letter : char(letter - 'a' + 'A');
+        }
+        data.append(String(word));
+    }
+    TimeIt<bool()> comparator([&]() {
+        List<String> list = data;
+        list.sort([](const String& a, const String& b) {
+            return a.lower() < b.lower();
+        });
+        return list.size() > 0;
+    });
+    TimeIt<bool()> key([&]() {
+        List<String> list = data;
+        list.sort([](const String& s) { return s.lower(); }, false);
+        return list.size() > 0;
+    });
+    TimeIt<bool()> parallelKey([&]() {
+        List<String> list = data;
+        list.sort([](const String& s) { return s.lower(); }, false,
+                  Parallel());
+        return list.size() > 0;
+    });
+    report("comparator calling lower()", comparator);
+    report("sort(key, false)", key);
+    report("sort(key, false, Parallel())", parallelKey);
+    return 0;
+}
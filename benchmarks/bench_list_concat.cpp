@@ -0,0 +1,103 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of chained List concatenation a + b + c + d: eager evaluation, 
+ * as operator+ used to do (copy of a + b then extension of the temporary by
+ * c and d), against the lazy concatenation built in one allocation.
+ *
+ * Usage: bench_list_concat [items per list] [repeats]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+template <typename T>
+void measure(const string& name, const List<T>& a, long repeats)
+{
+    TimeIt<size_t()> eager([&]() {
+        size_t size = 0;
+        for (long i = 0; i < repeats; ++i)
+        {
+            List<T> result;
+            result.reserve(2 * a.size());
+            result.extend(a);
+            result.extend(a);
+            result.extend(a);
+            result.extend(a);
+            size += result.size();
+        }
+        return size;
+    });
+    TimeIt<size_t()> lazy([&]() {
+        size_t size = 0;
+        for (long i = 0; i < repeats; ++i)
+        {
+            List<T> result = a + a + a + a;
+            size += result.size();
+        }
+        return size;
+    });
+    TimeIt<size_t()> iterate([&]() {
+        size_t size = 0;
+        for (long i = 0; i < repeats; ++i)
+        {
+            for (const T& item: a + a + a + a)
+                size += sizeof(item) != 0;
+        }
+        return size;
+    });
+    if (eager() != lazy() || lazy() != iterate())
+    {
+        cout << "mismatch" << endl;
+        return;
+    }
+    cout << setw(16) << left << name << fixed << setprecision(2)
+         << setw(12) << right << eager.wallTime()
+         << setw(12) << right << lazy.wallTime()
+         << setw(12) << right << iterate.wallTime() << endl;
+}
+
+int main(int argc, char** argv)
+{
+    long size = argc > 1 ? atol(argv[1]) : 1000000;
+    long repeats = argc > 2 ? atol(argv[2]) : 20;
+    List<long> longs;
+    List<string> strings;
+    for (long i = 0; i < size; ++i)
+    {
+        longs.append(i);
+        strings.append(string(32, char('a' + i % 26)));
+    }
+    cout << "items per list: " << size << ", " << repeats 
+         << " repeats (wall times in ms)" << endl;
+    cout << setw(16) << left << "" << setw(12) << right << "eager"
+         << setw(12) << right << "lazy" << setw(12) << right << "iterate" 
+         << endl;
+    measure("long", longs, repeats);
+    measure("string", strings, repeats / 10 + 1);
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of List::operator== (memcmp) and Hash<List> (byte hashing)
+ * against item-wise loops.
+ *
+ * Usage: bench_list_equality [list size] [repeats]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    long size = argc > 1 ? atol(argv[1]) : 1000000;
+    long repeats = argc > 2 ? atol(argv[2]) : 100;
+    List<int> list1;
+    for (long i = 0; i < size; ++i)
+        list1.append(int(i * 7919));
+    List<int> list2 = list1;
+    TimeIt<long()> loop([&]() {
+        long equal = 0;
+        for (long r = 0; r < repeats; ++r)
+        {
+            list2[r % size] = list1[r % size];
+            bool same = true;
+            for (size_t i = 0; i < list1.size() && same; ++i)
+                same = list1[i] == list2[i];
+            equal += same;
+        }
+        return equal;
+    });
+    TimeIt<long()> memcmp([&]() {
+        long equal = 0;
+        for (long r = 0; r < repeats; ++r)
+        {
+            list2[r % size] = list1[r % size];
+            equal += list1 == list2;
+        }
+        return equal;
+    });
+    TimeIt<size_t()> itemHash([&]() {
+        Hash<int> hasher;
+        size_t seed = 0;
+        for (long r = 0; r < repeats; ++r)
+        {
+            list2[r % size] = int(r);
+            for (int item: list2)
+                seed ^= hasher(item) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    });
+    TimeIt<size_t()> bulkHash([&]() {
+        Hash< List<int> > hasher;
+        size_t seed = 0;
+        for (long r = 0; r < repeats; ++r)
+        {
+            list2[r % size] = int(r);
+            seed ^= hasher(list2);
+        }
+        return seed;
+    });
+    loop();
+    memcmp();
+    itemHash();
+    bulkHash();
+    cout << "list size: " << size << ", repeats: " << repeats
+         << " (wall times in ms)" << endl;
+    cout << fixed << setprecision(2);
+    cout << setw(20) << left << "item-wise ==" << setw(12) << right
+         << loop.wallTime() << endl;
+    cout << setw(20) << left << "operator==" << setw(12) << right
+         << memcmp.wallTime() << endl;
+    cout << setw(20) << left << "item-wise hash" << setw(12) << right
+         << itemHash.wallTime() << endl;
+    cout << setw(20) << left << "Hash<List<int>>" << setw(12) << right
+         << bulkHash.wallTime() << endl;
+    return 0;
+}
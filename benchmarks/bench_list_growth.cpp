@@ -0,0 +1,107 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of List growth: longs are appended until the list holds the
+ * given number of megabytes, with realloc growth (RelocatableVector, the
+ * default) and with std::vector growth (forced by another allocator type).
+ * Total time (without timing each append), worst single append and peak
+ * resident memory are reported.
+ *
+ * Usage: bench_list_growth [megabytes]
+ */
+
+#include <cstdlib>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+
+#include <sys/resource.h>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+/*
+ * std::allocator under another name: List stores items in a std::vector.
+ */
+template <typename T>
+struct VectorAllocator: public std::allocator<T>
+{
+    template <typename U>
+    struct rebind { typedef VectorAllocator<U> other; };
+    VectorAllocator() { };
+    template <typename U>
+    VectorAllocator(const VectorAllocator<U>&) { };
+};
+
+long peakMegabytes()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024;
+}
+
+template <typename ListType>
+void measure(const string& name, long size)
+{
+    typedef chrono::steady_clock Clock;
+    double worst = 0.;
+    TimeIt<long()> append([&]() {
+        ListType list;
+        for (long i = 0; i < size; ++i)
+        {
+            Clock::time_point start = Clock::now();
+            list.append(i);
+            chrono::duration<double, milli> elapsed = Clock::now() - start;
+            if (elapsed.count() > worst)
+                worst = elapsed.count();
+        }
+        return long(list.size());
+    });
+    TimeIt<long()> plain([&]() {
+        ListType list;
+        for (long i = 0; i < size; ++i)
+            list.append(i);
+        return long(list.size());
+    });
+    plain();
+    append();
+    cout << setw(14) << left << name << fixed << setprecision(2)
+         << setw(12) << right << plain.wallTime()
+         << setw(12) << right << worst
+         << setw(12) << right << peakMegabytes() << endl;
+}
+
+int main(int argc, char** argv)
+{
+    long megabytes = argc > 1 ? atol(argv[1]) : 1024;
+    long size = megabytes * 1024 * 1024 / long(sizeof(long));
+    cout << "items: " << size << " (" << megabytes << " MB)" << endl;
+    cout << setw(14) << left << "" << setw(12) << right << "total ms"
+         << setw(12) << right << "worst ms" << setw(12) << right
+         << "peak MB" << endl;
+    //realloc first: peak memory is cumulative over the process
+    measure< List<long> >("realloc", size);
+    measure< List<long, VectorAllocator<long> > >("std::vector", size);
+    return 0;
+}
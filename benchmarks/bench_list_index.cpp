@@ -0,0 +1,126 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of List::operator[] check policies against std::vector indexing.
+ *
+ * Usage: bench_list_index [number of items] [repetitions]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+/*
+ * Indexing as List::operator[] used to do it: negative index normalization,
+ * std::vector::at and exception translation.
+ */
+const long& legacyAt(const vector<long>& vect, long index)
+{
+    if (index < 0)
+        index += vect.size();
+    try
+    {
+        return vect.at(index);
+    }
+    catch (std::out_of_range& e)
+    {
+        THROW(IndexError, "index out of range");
+    }
+}
+
+/*
+ * Sum items with forward and backward (negative) indexing.
+ */
+template <typename Container>
+long sum(const Container& cont, long n)
+{
+    long total = 0;
+    for (long i = 0; i < n; ++i)
+        total += cont[i];
+    for (long i = 1; i <= n; ++i)
+        total -= cont[-i] >> 1;
+    return total;
+}
+
+long sumVector(const vector<long>& vect, long n)
+{
+    long total = 0;
+    for (long i = 0; i < n; ++i)
+        total += vect[i];
+    for (long i = 1; i <= n; ++i)
+        total -= vect[n - i] >> 1;
+    return total;
+}
+
+long sumLegacy(const vector<long>& vect, long n)
+{
+    long total = 0;
+    for (long i = 0; i < n; ++i)
+        total += legacyAt(vect, i);
+    for (long i = 1; i <= n; ++i)
+        total -= legacyAt(vect, -i) >> 1;
+    return total;
+}
+
+void report(const string& name, TimeIt<long()>& timer, long n)
+{
+    long checksum = timer();
+    cout << setw(32) << left << name
+         << setw(12) << right << fixed << setprecision(3) << timer.wallTime()
+         << setw(12) << setprecision(3) << timer.wallTime() * 1.e6 / (2 * n)
+         << "   (" << checksum << ")" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    long n = argc > 1 ? atol(argv[1]) : 10000000;
+    int repeat = argc > 2 ? atoi(argv[2]) : 10;
+    vector<long> vect(n);
+    for (long i = 0; i < n; ++i)
+        vect[i] = i % 1000;
+    const List<long> python(vect);
+    const DebugList<long> debug(vect);
+    const UncheckedList<long> unchecked(vect);
+
+    cout << "items: " << n << ", repetitions: " << repeat << endl;
+    cout << setw(32) << left << "indexing"
+         << setw(12) << right << "wall (ms)"
+         << setw(12) << "ns/access" << endl;
+
+    TimeIt<long()> t1([&]() { return sumVector(vect, n); }, repeat);
+    TimeIt<long()> t2([&]() { return sumLegacy(vect, n); }, repeat);
+    TimeIt<long()> t3([&]() { return sum(python, n); }, repeat);
+    TimeIt<long()> t4([&]() { return sum(debug, n); }, repeat);
+    TimeIt<long()> t5([&]() { return sum(unchecked, n); }, repeat);
+    report("std::vector::operator[]", t1, n);
+    report("at() + exception translation", t2, n);
+    report("List (PythonCheck)", t3, n);
+    report("DebugList (DebugCheck)", t4, n);
+    report("UncheckedList (NoCheck)", t5, n);
+    return 0;
+}
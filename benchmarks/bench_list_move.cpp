@@ -0,0 +1,181 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of List hand-offs with copy semantics against move semantics.
+ *
+ * Usage: bench_list_move [number of items]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <utility>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+/*
+ * Payload counting its copies. It owns a heap allocated string so that a copy
+ * has a realistic cost.
+ */
+struct Payload
+{
+    static long copies;
+    string data;
+    Payload(): data() { };
+    Payload(long i): data(32, char('a' + i % 26)) { };
+    Payload(const Payload& other): data(other.data) { ++copies; };
+    Payload(Payload&& other) noexcept: data(std::move(other.data)) { };
+    Payload& operator=(const Payload& other)
+    {
+        data = other.data;
+        ++copies;
+        return *this;
+    };
+    Payload& operator=(Payload&& other) noexcept
+    {
+        data = std::move(other.data);
+        return *this;
+    };
+};
+
+long Payload::copies = 0;
+
+void report(const string& name, TimeIt<void()>& timer)
+{
+    Payload::copies = 0;
+    timer();
+    cout << setw(28) << left << name
+         << setw(12) << right << Payload::copies
+         << setw(12) << fixed << setprecision(2) << timer.wallTime()
+         << endl;
+}
+
+int main(int argc, char** argv)
+{
+    long n = argc > 1 ? atol(argv[1]) : 1000000;
+    cout << "items: " << n << endl;
+    cout << setw(28) << left << "scenario"
+         << setw(12) << right << "copies"
+         << setw(12) << "wall (ms)" << endl;
+
+    TimeIt<void()> copyAppend([n]() {
+        List<Payload> list;
+        for (long i = 0; i < n; ++i)
+        {
+            Payload item(i);
+            list.append(item);
+        }
+    });
+    TimeIt<void()> moveAppend([n]() {
+        List<Payload> list;
+        for (long i = 0; i < n; ++i)
+            list.emplace(i);
+    });
+    report("append (copy)", copyAppend);
+    report("emplace (move)", moveAppend);
+
+    TimeIt<void()> copyConcat([n]() {
+        List<Payload> a, b, c, d;
+        for (long i = 0; i < n / 4; ++i)
+        {
+            a.emplace(i);
+            b.emplace(i);
+            c.emplace(i);
+            d.emplace(i);
+        }
+        Payload::copies = 0;
+        List<Payload> ab = a + b;
+        List<Payload> abc = ab + c;
+        List<Payload> abcd = abc + d;
+    });
+    TimeIt<void()> moveConcat([n]() {
+        List<Payload> a, b, c, d;
+        for (long i = 0; i < n / 4; ++i)
+        {
+            a.emplace(i);
+            b.emplace(i);
+            c.emplace(i);
+            d.emplace(i);
+        }
+        Payload::copies = 0;
+        List<Payload> abcd = std::move(a) + b + c + d;
+    });
+    report("a + b + c + d (copy)", copyConcat);
+    report("a + b + c + d (move)", moveConcat);
+
+    TimeIt<void()> copyExtend([n]() {
+        List<Payload> a, b;
+        for (long i = 0; i < n / 2; ++i)
+        {
+            a.emplace(i);
+            b.emplace(i);
+        }
+        Payload::copies = 0;
+        a.extend(b);
+    });
+    TimeIt<void()> moveExtend([n]() {
+        List<Payload> a, b;
+        for (long i = 0; i < n / 2; ++i)
+        {
+            a.emplace(i);
+            b.emplace(i);
+        }
+        Payload::copies = 0;
+        a.extend(std::move(b));
+    });
+    report("extend (copy)", copyExtend);
+    report("extend (move)", moveExtend);
+
+    TimeIt<void()> copyHandOff([n]() {
+        List<Payload> a;
+        for (long i = 0; i < n; ++i)
+            a.emplace(i);
+        Payload::copies = 0;
+        List<Payload> b(a);
+        List<Payload> c;
+        c = b;
+    });
+    TimeIt<void()> moveHandOff([n]() {
+        List<Payload> a;
+        for (long i = 0; i < n; ++i)
+            a.emplace(i);
+        Payload::copies = 0;
+        List<Payload> b(std::move(a));
+        List<Payload> c;
+        c = std::move(b);
+    });
+    report("hand-off (copy)", copyHandOff);
+    report("hand-off (move)", moveHandOff);
+
+    TimeIt<void()> drain([n]() {
+        List<Payload> a;
+        for (long i = 0; i < n; ++i)
+            a.emplace(i);
+        Payload::copies = 0;
+        while (a.size() > 0)
+            a.pop();
+    });
+    report("pop until empty", drain);
+    return 0;
+}
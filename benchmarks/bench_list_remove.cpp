@@ -0,0 +1,84 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of bulk removal: List::remove in a loop against List::removeAll
+ * and List::removeMany.
+ *
+ * Usage: bench_list_remove [list size] [distinct values removed]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    long size = argc > 1 ? atol(argv[1]) : 100000;
+    long removed = argc > 2 ? atol(argv[2]) : 100;
+    List<long> source;
+    for (long i = 0; i < size; ++i)
+        source.append((i * 7919) % 1000);
+    List<long> values;
+    for (long i = 0; i < removed; ++i)
+        values.append(i * 1000 / removed);
+
+    List<long> list1 = source;
+    List<long> list2 = source;
+    List<long> list3 = source;
+    TimeIt<long()> loop([&]() {
+        long count = 0;
+        for (long value: values)
+        {
+            while (list1.contains(value))
+            {
+                list1.remove(value);
+                ++count;
+            }
+        }
+        return count;
+    });
+    TimeIt<long()> removeAll([&]() {
+        long count = 0;
+        for (long value: values)
+            count += list2.removeAll(value);
+        return count;
+    });
+    TimeIt<long()> removeMany([&]() {
+        return long(list3.removeMany(values));
+    });
+    long count = loop();
+    removeAll();
+    removeMany();
+    cout << "list size: " << size << ", removed items: " << count
+         << " (wall times in ms)" << endl;
+    cout << fixed << setprecision(2);
+    cout << setw(12) << left << "remove" << setw(12) << right
+         << loop.wallTime() << endl;
+    cout << setw(12) << left << "removeAll" << setw(12) << right
+         << removeAll.wallTime() << endl;
+    cout << setw(12) << left << "removeMany" << setw(12) << right
+         << removeMany.wallTime() << endl;
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of List::contains and List::count (SIMD kernels) against
+ * std::find and std::count.
+ *
+ * Usage: bench_list_search [list size] [lookups]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+template <typename T>
+void compare(const string& name, long size, long lookups)
+{
+    List<T> list;
+    for (long i = 0; i < size; ++i)
+        list.append(T(i % 1000003));
+    vector<T> vect(list.begin(), list.end());
+    //missing values: whole list is scanned
+    TimeIt<long()> stdFind([&]() {
+        long found = 0;
+        for (long i = 0; i < lookups; ++i)
+            found += find(vect.begin(), vect.end(), T(-1 - i)) != vect.end();
+        return found;
+    });
+    TimeIt<long()> contains([&]() {
+        long found = 0;
+        for (long i = 0; i < lookups; ++i)
+            found += list.contains(T(-1 - i));
+        return found;
+    });
+    TimeIt<long()> stdCount([&]() {
+        long total = 0;
+        for (long i = 0; i < lookups; ++i)
+            total += count(vect.begin(), vect.end(), T(i));
+        return total;
+    });
+    TimeIt<long()> listCount([&]() {
+        long total = 0;
+        for (long i = 0; i < lookups; ++i)
+            total += list.count(T(i));
+        return total;
+    });
+    stdFind();
+    contains();
+    stdCount();
+    listCount();
+    cout << setw(8) << left << name << fixed << setprecision(2)
+         << setw(12) << right << stdFind.wallTime()
+         << setw(12) << right << contains.wallTime()
+         << setw(12) << right << stdCount.wallTime()
+         << setw(12) << right << listCount.wallTime() << endl;
+}
+
+int main(int argc, char** argv)
+{
+    long size = argc > 1 ? atol(argv[1]) : 100000;
+    long lookups = argc > 2 ? atol(argv[2]) : 10000;
+    cout << "list size: " << size << ", lookups: " << lookups
+         << ", kernels: " << detail::simdInstructionSet()
+         << " (wall times in ms)" << endl;
+    cout << setw(8) << left << "type" << setw(12) << right << "std::find"
+         << setw(12) << right << "contains" << setw(12) << right
+         << "std::count" << setw(12) << right << "count" << endl;
+    compare<int>("int", size, lookups);
+    compare<long>("long", size, lookups);
+    compare<float>("float", size, lookups);
+    compare<double>("double", size, lookups);
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Scaling of List::sort(Parallel) from 1 to N threads.
+ *
+ * Usage: bench_parallel_sort [list size] [max threads]
+ *
+ * Max threads defaults to the size of the shared thread pool, that is the
+ * number of hardware threads.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/collections/string.h"
+#include "snowball/concurrency/thread_pool.h"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+template <typename T>
+void scaling(const string& name, const List<T>& data, unsigned maxThreads)
+{
+    double sequential = 0.;
+    for (unsigned threads = 0; threads <= maxThreads; ++threads)
+    {
+        TimeIt<bool()> timer([&]() {
+            List<T> list = data;
+            if (threads == 0)
+                list.sort();
+            else
+                list.sort(Parallel(threads));
+            return list.size() > 0;
+        });
+        timer();
+        if (threads == 0)
+            sequential = timer.wallTime();
+        cout << setw(8) << left << name
+             << setw(12) << left << (threads == 0 ? string("std::sort")
+                                                  : to_string(threads))
+             << setw(12) << right << fixed << setprecision(2)
+             << timer.wallTime()
+             << setw(10) << right << setprecision(2)
+             << sequential / timer.wallTime() << endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    long size = argc > 1 ? atol(argv[1]) : 5000000;
+    unsigned maxThreads = argc > 2 ? unsigned(atol(argv[2]))
+                                   : ThreadPool::instance().size();
+    cout << "list size: " << size << ", hardware threads: "
+         << ThreadPool::instance().size() << endl;
+    cout << setw(8) << left << "type" << setw(12) << left << "threads"
+         << setw(12) << right << "wall (ms)" << setw(10) << right
+         << "speedup" << endl;
+
+    mt19937_64 generator(42);
+    List<int> ints;
+    List<double> doubles;
+    List<String> strings;
+    ints.reserve(size);
+    doubles.reserve(size);
+    strings.reserve(size);
+    uniform_int_distribution<int> intDist;
+    uniform_real_distribution<double> doubleDist(-1e6, 1e6);
+    for (long i = 0; i < size; ++i)
+    {
+        ints.append(intDist(generator));
+        doubles.append(doubleDist(generator));
+        strings.append(String(to_string(generator() % 100000000)));
+    }
+    scaling("int", ints, maxThreads);
+    scaling("double", doubles, maxThreads);
+    scaling("String", strings, maxThreads);
+    return 0;
+}
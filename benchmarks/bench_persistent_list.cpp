@@ -0,0 +1,134 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of PersistentList against List: build by append, snapshots
+ * taken while a writer modifies the list, random reads and iteration.
+ *
+ * Usage: bench_persistent_list [list size] [snapshots]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/collections/persistent_list.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    long size = argc > 1 ? atol(argv[1]) : 1000000;
+    long snapshots = argc > 2 ? atol(argv[2]) : 100;
+    const long reads = 1000000;
+    List<long> list;
+    PersistentList<long> persistent;
+
+    TimeIt<long()> listAppend([&]() {
+        for (long i = 0; i < size; ++i)
+            list.append(i);
+        return long(list.size());
+    });
+    TimeIt<long()> persistentAppend([&]() {
+        PersistentList<long> built;
+        for (long i = 0; i < size; ++i)
+            built = built.append(i);
+        return long(built.size());
+    });
+    TimeIt<long()> transientAppend([&]() {
+        PersistentList<long>::Transient transient = persistent.transient();
+        for (long i = 0; i < size; ++i)
+            transient.append(i);
+        persistent = transient.persistent();
+        return long(persistent.size());
+    });
+    //writer modifies one item, then publishes a snapshot for readers
+    TimeIt<long()> listSnapshots([&]() {
+        long sum = 0;
+        for (long i = 0; i < snapshots; ++i)
+        {
+            list[(i * 7919) % size] = i;
+            List<long> snapshot(list);
+            sum += snapshot[i];
+        }
+        return sum;
+    });
+    TimeIt<long()> persistentSnapshots([&]() {
+        long sum = 0;
+        for (long i = 0; i < snapshots; ++i)
+        {
+            persistent = persistent.set((i * 7919) % size, i);
+            PersistentList<long> snapshot(persistent);
+            sum += snapshot[i];
+        }
+        return sum;
+    });
+    TimeIt<long()> listReads([&]() {
+        long sum = 0;
+        for (long i = 0; i < reads; ++i)
+            sum += list[(i * 7919) % size];
+        return sum;
+    });
+    TimeIt<long()> persistentReads([&]() {
+        long sum = 0;
+        for (long i = 0; i < reads; ++i)
+            sum += persistent[(i * 7919) % size];
+        return sum;
+    });
+    TimeIt<long()> listSum([&]() {
+        long sum = 0;
+        for (long item: list)
+            sum += item;
+        return sum;
+    });
+    TimeIt<long()> persistentSum([&]() {
+        long sum = 0;
+        for (long item: persistent)
+            sum += item;
+        return sum;
+    });
+    if (listAppend() != persistentAppend() || transientAppend() != size ||
+        listSnapshots() != persistentSnapshots() ||
+        listReads() != persistentReads() || listSum() != persistentSum())
+    {
+        cout << "mismatch between List and PersistentList" << endl;
+        return 1;
+    }
+    cout << "list size: " << size << ", " << snapshots << " snapshots, "
+         << reads << " random reads (wall times in ms)" << endl;
+    cout << setw(16) << left << "" << setw(12) << right << "append"
+         << setw(12) << right << "transient" << setw(12) << right
+         << "snapshots" << setw(12) << right << "reads" << setw(12) << right
+         << "sum" << endl;
+    cout << setw(16) << left << "List" << fixed << setprecision(2)
+         << setw(12) << right << listAppend.wallTime()
+         << setw(12) << right << "-"
+         << setw(12) << right << listSnapshots.wallTime()
+         << setw(12) << right << listReads.wallTime()
+         << setw(12) << right << listSum.wallTime() << endl;
+    cout << setw(16) << left << "PersistentList" << fixed << setprecision(2)
+         << setw(12) << right << persistentAppend.wallTime()
+         << setw(12) << right << transientAppend.wallTime()
+         << setw(12) << right << persistentSnapshots.wallTime()
+         << setw(12) << right << persistentReads.wallTime()
+         << setw(12) << right << persistentSum.wallTime() << endl;
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of List::sort (radix sort) against std::sort.
+ *
+ * Usage: bench_radix_sort [list size]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/collections/string.h"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+template <typename T>
+void compare(const string& name, const List<T>& data)
+{
+    TimeIt<bool()> comparison([&]() {
+        vector<T> vect(data.begin(), data.end());
+        std::sort(vect.begin(), vect.end());
+        return vect.size() > 0;
+    });
+    TimeIt<bool()> radix([&]() {
+        List<T> list = data;
+        list.sort();
+        return list.size() > 0;
+    });
+    comparison();
+    radix();
+    cout << setw(24) << left << name << fixed << setprecision(2)
+         << setw(12) << right << comparison.wallTime()
+         << setw(12) << right << radix.wallTime()
+         << setw(10) << right << comparison.wallTime() / radix.wallTime()
+         << endl;
+}
+
+int main(int argc, char** argv)
+{
+    long size = argc > 1 ? atol(argv[1]) : 10000000;
+    cout << "list size: " << size << " (wall times in ms, copy included)"
+         << endl;
+    cout << setw(24) << left << "type" << setw(12) << right << "std::sort"
+         << setw(12) << right << "List::sort" << setw(10) << right
+         << "speedup" << endl;
+    mt19937_64 generator(42);
+    List<int> ints;
+    List<long> longs;
+    List<int> smallInts;
+    List<double> doubles;
+    List<String> strings;
+    List<String> urls;
+    normal_distribution<double> normal(0., 1e3);
+    for (long i = 0; i < size; ++i)
+    {
+        ints.append(int(generator()));
+        longs.append(long(generator()));
+        smallInts.append(int(generator() % 65536));
+        doubles.append(normal(generator));
+        strings.append(String(to_string(generator() % 1000000000)));
+        urls.append(String("https://example.org/items/" +
+                           to_string(generator() % 1000000)));
+    }
+    compare("int", ints);
+    compare("long", longs);
+    compare("int in [0, 65536)", smallInts);
+    compare("double", doubles);
+    compare("String", strings);
+    compare("String (long prefix)", urls);
+    return 0;
+}
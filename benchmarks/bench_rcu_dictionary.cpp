@@ -0,0 +1,194 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Cost of a lookup in RcuDictionary against unsynchronized dictionaries and
+ * a Dictionary guarded by a mutex, then throughput of 1 to N reader threads
+ * while a writer publishes a batch of edits every millisecond.
+ *
+ * Usage: bench_rcu_dictionary [keys] [lookups] [max threads]
+ *
+ * Defaults are 100000 keys, 10000000 lookups (per thread) and the number of
+ * hardware threads, but at least 4.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "snowball/collections/dictionary.hpp"
+#include "snowball/collections/flat_dictionary.hpp"
+#include "snowball/concurrency/rcu_dictionary.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+/*
+ * Time lookups of keys in order, print ns per lookup and return the sum of
+ * values found.
+ */
+template <typename Lookup>
+long single(const string& name, const vector<long>& order, Lookup lookup)
+{
+    TimeIt<long()> timed([&]() {
+        long sum = 0;
+        for (long key: order)
+            sum += lookup(key);
+        return sum;
+    });
+    long sum = timed();
+    cout << setw(24) << left << name << fixed << setprecision(2)
+         << setw(12) << right << timed.wallTime() * 1e6 / order.size()
+         << endl;
+    return sum;
+}
+
+/*
+ * Run lookups of keys in order on given number of threads while writer
+ * runs every millisecond, and return millions of lookups per second.
+ */
+template <typename Lookup, typename Writer>
+double multiple(const vector<long>& order, unsigned threads, Lookup lookup,
+                Writer writer, long& versions)
+{
+    atomic<bool> stop(false);
+    atomic<long> sink(0);
+    thread writing([&]() {
+        while (!stop)
+        {
+            writer();
+            ++versions;
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+    });
+    TimeIt<long()> timed([&]() {
+        vector<thread> readers;
+        for (unsigned t = 0; t < threads; ++t)
+            readers.push_back(thread([&]() {
+                long sum = 0;
+                for (long key: order)
+                    sum += lookup(key);
+                sink += sum;
+            }));
+        for (thread& reader: readers)
+            reader.join();
+        return sink.load();
+    });
+    timed();
+    stop = true;
+    writing.join();
+    return double(order.size()) * threads / 1000. / timed.wallTime();
+}
+
+int main(int argc, char** argv)
+{
+    long keys = argc > 1 ? atol(argv[1]) : 100000;
+    long lookups = argc > 2 ? atol(argv[2]) : 10000000;
+    unsigned maxThreads = argc > 3 ? atoi(argv[3])
+                                   : max(4u, thread::hardware_concurrency());
+    if (maxThreads == 0)
+        maxThreads = 1;
+    mt19937_64 random(0);
+    vector<long> order(lookups);
+    for (long& key: order)
+        key = long(random() % keys);
+
+    Dictionary<long, long> node;
+    FlatDictionary<long, long> flat;
+    for (long key = 0; key < keys; ++key)
+    {
+        node[key] = key;
+        flat[key] = key;
+    }
+    RcuDictionary<long, long> rcu(flat);
+    mutex guard;
+
+    cout << "keys: " << keys << ", lookups: " << lookups
+         << " (ns per lookup, 1 thread)" << endl;
+    long sums[] = {
+        single("Dictionary", order, [&](long key) {
+            return node.get(key, -1);
+        }),
+        single("FlatDictionary", order, [&](long key) {
+            return flat.get(key, -1);
+        }),
+        single("mutex + Dictionary", order, [&](long key) {
+            lock_guard<mutex> lock(guard);
+            return node.get(key, -1);
+        }),
+        single("RcuDictionary", order, [&](long key) {
+            return rcu.get(key, -1);
+        }),
+        single("RcuDictionary snapshot", order, [&](long key) {
+            //a snapshot per lookup: enter and exit reader section each time
+            RcuDictionary<long, long>::Snapshot snapshot = rcu.snapshot();
+            return snapshot->get(key, -1);
+        })
+    };
+    if (count(sums, sums + 5, sums[0]) != 5)
+    {
+        cout << "mismatch between dictionaries" << endl;
+        return 1;
+    }
+
+    cout << endl << "lookups per thread: " << lookups
+         << ", 100 edits published every ms (millions of lookups per second)"
+         << endl;
+    cout << setw(10) << left << "threads" << setw(20) << right
+         << "mutex + Dictionary" << setw(16) << right << "RcuDictionary"
+         << setw(10) << right << "ratio" << setw(12) << right << "versions"
+         << endl;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        long edit = 0;
+        long lockedVersions = 0;
+        double locked = multiple(order, threads, [&](long key) {
+            lock_guard<mutex> lock(guard);
+            return node.get(key, -1);
+        }, [&]() {
+            lock_guard<mutex> lock(guard);
+            for (int i = 0; i < 100; ++i)
+                node[edit++ % keys] = -1;
+        }, lockedVersions);
+        long rcuVersions = 0;
+        double concurrent = multiple(order, threads, [&](long key) {
+            return rcu.get(key, -1);
+        }, [&]() {
+            rcu.update([&](FlatDictionary<long, long>& version) {
+                for (int i = 0; i < 100; ++i)
+                    version[edit++ % keys] = -1;
+            });
+        }, rcuVersions);
+        cout << setw(10) << left << threads << fixed << setprecision(2)
+             << setw(20) << right << locked
+             << setw(16) << right << concurrent
+             << setw(10) << right << concurrent / locked
+             << setw(12) << right << rcuVersions << endl;
+        if (threads * 2 > maxThreads && threads != maxThreads)
+            threads = maxThreads / 2;
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of SegmentedList against List: total and worst single append
+ * time while growing, then a sum by index and a sum by iterator.
+ *
+ * Usage: bench_segmented_list [list size]
+ */
+
+#include <cstdlib>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/collections/segmented_list.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+template <typename ListType>
+void measure(const string& name, long size)
+{
+    typedef chrono::steady_clock Clock;
+    ListType list;
+    double worst = 0.;
+    TimeIt<long()> append([&]() {
+        for (long i = 0; i < size; ++i)
+        {
+            Clock::time_point start = Clock::now();
+            list.append(i);
+            chrono::duration<double, milli> elapsed = Clock::now() - start;
+            if (elapsed.count() > worst)
+                worst = elapsed.count();
+        }
+        return long(list.size());
+    });
+    TimeIt<long()> indexSum([&]() {
+        long sum = 0;
+        for (long i = 0; i < size; ++i)
+            sum += list[i];
+        return sum;
+    });
+    TimeIt<long()> iteratorSum([&]() {
+        long sum = 0;
+        for (long value: list)
+            sum += value;
+        return sum;
+    });
+    append();
+    indexSum();
+    iteratorSum();
+    cout << setw(16) << left << name << fixed << setprecision(2)
+         << setw(12) << right << append.wallTime()
+         << setw(12) << right << worst
+         << setw(12) << right << indexSum.wallTime()
+         << setw(12) << right << iteratorSum.wallTime() << endl;
+}
+
+int main(int argc, char** argv)
+{
+    long size = argc > 1 ? atol(argv[1]) : 50000000;
+    cout << "list size: " << size << " (wall times in ms)" << endl;
+    cout << setw(16) << left << "" << setw(12) << right << "append"
+         << setw(12) << right << "worst" << setw(12) << right << "[] sum"
+         << setw(12) << right << "iter sum" << endl;
+    measure< List<long> >("List", size);
+    measure< SegmentedList<long> >("SegmentedList", size);
+    return 0;
+}
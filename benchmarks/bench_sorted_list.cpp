@@ -0,0 +1,104 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of SortedList against insort into a List: random insertions,
+ * then membership tests, then removals.
+ *
+ * Usage: bench_sorted_list [size]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/collections/bisect.hpp"
+#include "snowball/collections/sorted_list.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    long size = argc > 1 ? atol(argv[1]) : 200000;
+    List<long> values;
+    mt19937_64 generator(42);
+    for (long i = 0; i < size; ++i)
+        values.append(long(generator() % (size * 4)));
+
+    List<long> list;
+    SortedList<long> sorted;
+    TimeIt<long()> listAdd([&]() {
+        for (long value: values)
+            insort(list, value);
+        return long(list.size());
+    });
+    TimeIt<long()> sortedAdd([&]() {
+        for (long value: values)
+            sorted.add(value);
+        return long(sorted.size());
+    });
+    TimeIt<long()> listContains([&]() {
+        long found = 0;
+        for (long i = 0; i < size; ++i)
+        {
+            size_t pos = bisectLeft(list, i);
+            found += pos < list.size() && list[pos] == i;
+        }
+        return found;
+    });
+    TimeIt<long()> sortedContains([&]() {
+        long found = 0;
+        for (long i = 0; i < size; ++i)
+            found += sorted.contains(i);
+        return found;
+    });
+    TimeIt<long()> listRemove([&]() {
+        for (long value: values)
+            list.pop(long(bisectLeft(list, value)));
+        return long(list.size());
+    });
+    TimeIt<long()> sortedRemove([&]() {
+        for (long value: values)
+            sorted.remove(value);
+        return long(sorted.size());
+    });
+    listAdd();
+    sortedAdd();
+    listContains();
+    sortedContains();
+    listRemove();
+    sortedRemove();
+    cout << "size: " << size << " (wall times in ms)" << endl;
+    cout << setw(10) << left << "" << setw(12) << right << "List"
+         << setw(12) << right << "SortedList" << endl;
+    cout << fixed << setprecision(2);
+    cout << setw(10) << left << "add" << setw(12) << right
+         << listAdd.wallTime() << setw(12) << right << sortedAdd.wallTime()
+         << endl;
+    cout << setw(10) << left << "contains" << setw(12) << right
+         << listContains.wallTime() << setw(12) << right
+         << sortedContains.wallTime() << endl;
+    cout << setw(10) << left << "remove" << setw(12) << right
+         << listRemove.wallTime() << setw(12) << right
+         << sortedRemove.wallTime() << endl;
+    return 0;
+}
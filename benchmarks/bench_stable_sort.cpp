@@ -0,0 +1,90 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Benchmark of List::stableSort (Timsort) against List::sort and
+ * std::stable_sort on random and presorted inputs.
+ *
+ * Usage: bench_stable_sort [list size]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "snowball/collections/list.hpp"
+#include "snowball/decorators/timeit.hpp"
+
+using namespace snowball;
+using namespace std;
+
+void compare(const string& name, const List<long>& data)
+{
+    TimeIt<bool()> sorted([&]() {
+        List<long> list = data;
+        list.sort();
+        return list.size() > 0;
+    });
+    TimeIt<bool()> stdStable([&]() {
+        vector<long> vect(data.begin(), data.end());
+        std::stable_sort(vect.begin(), vect.end());
+        return vect.size() > 0;
+    });
+    TimeIt<bool()> timsort([&]() {
+        List<long> list = data;
+        list.stableSort();
+        return list.size() > 0;
+    });
+    sorted();
+    stdStable();
+    timsort();
+    cout << setw(24) << left << name << fixed << setprecision(2)
+         << setw(12) << right << sorted.wallTime()
+         << setw(18) << right << stdStable.wallTime()
+         << setw(14) << right << timsort.wallTime() << endl;
+}
+
+int main(int argc, char** argv)
+{
+    long size = argc > 1 ? atol(argv[1]) : 10000000;
+    cout << "list size: " << size << " (wall times in ms)" << endl;
+    cout << setw(24) << left << "input" << setw(12) << right << "sort"
+         << setw(18) << right << "std::stable_sort" << setw(14) << right
+         << "stableSort" << endl;
+    mt19937_64 generator(42);
+    List<long> random, ascending, descending, appended, sawtooth;
+    for (long i = 0; i < size; ++i)
+    {
+        random.append(long(generator() % size));
+        ascending.append(i);
+        descending.append(size - i);
+        //append-mostly time series: sorted with 1% late arrivals
+        appended.append(generator() % 100 == 0 ? i - long(generator() % 1000)
+                                               : i);
+        sawtooth.append(i % (size / 16 + 1));
+    }
+    compare("random", random);
+    compare("ascending", ascending);
+    compare("descending", descending);
+    compare("nearly sorted (1%)", appended);
+    compare("16 sorted runs", sawtooth);
+    return 0;
+}
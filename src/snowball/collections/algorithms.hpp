@@ -115,7 +115,7 @@ typename Container::index_type argmin(const Container& cont)
 }
 
 //Forward declaration of List template
-template <typename T, typename Alloc> class List;
+template <typename T, typename Alloc, typename CheckPolicy> class List;
 
 /**
  * Filter the given collection.
@@ -0,0 +1,255 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ *
+ * Functions of Python bisect module for sorted sequences:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * List<int> list = {1, 3, 3, 7};
+ * bisectLeft(list, 3);   //1
+ * bisectRight(list, 3);  //3
+ * insort(list, 5);       //list is now {1, 3, 3, 5, 7}
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Sequences must be sorted according to operator< of their items, or to the
+ * comparator given as argument. Searches take O(log n) comparisons; insort
+ * also moves the items after the insertion point.
+ */
+
+#ifndef SNOWBALL_BISECT_H
+#define SNOWBALL_BISECT_H
+
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "snowball/exceptions/exceptions.h"
+#include "list_view.hpp"
+
+namespace snowball
+{
+
+namespace detail
+{
+
+/**
+ * Return type of bisections taking a comparator: excludes integers so that
+ * bisectLeft(list, item, lo) is not taken for a comparator.
+ */
+template <typename Compare>
+struct IfComparator: public std::enable_if<
+    !std::is_arithmetic<Compare>::value, std::size_t> { };
+
+} //end of namespace detail
+
+/**
+ * Return the index where to insert item in sorted container, before any
+ * equal item.
+ *
+ * Only [lo, hi) is searched; hi defaults to the size of the container and
+ * is clamped to [lo, size]: as in Python, lo is returned when hi is below
+ * it.
+ *
+ * @tparam Container sorted sequence
+ * @tparam Compare comparator type
+ * @param cont sorted sequence
+ * @param item item to be looked for
+ * @param comp comparator by which sequence is sorted
+ * @param lo first index to be searched
+ * @param hi index after the last one to be searched
+ * @throw ValueError if lo is negative
+ */
+template <typename Container, typename Compare>
+typename detail::IfComparator<Compare>::type
+bisectLeft(const Container& cont, const typename Container::value_type& item,
+           const Compare& comp, long lo = 0, long hi = Slice::none)
+    throw(ValueError);
+
+/**
+ * Return the index where to insert item in sorted container, before any
+ * equal item.
+ *
+ * @see bisectLeft(const Container&, const value_type&, const Compare&, long, long)
+ */
+template <typename Container>
+std::size_t bisectLeft(const Container& cont,
+                       const typename Container::value_type& item,
+                       long lo = 0, long hi = Slice::none) throw(ValueError);
+
+/**
+ * Return the index where to insert item in sorted container, after any
+ * equal item.
+ *
+ * Only [lo, hi) is searched; hi defaults to the size of the container and
+ * is clamped to [lo, size]: as in Python, lo is returned when hi is below
+ * it.
+ *
+ * @tparam Container sorted sequence
+ * @tparam Compare comparator type
+ * @param cont sorted sequence
+ * @param item item to be looked for
+ * @param comp comparator by which sequence is sorted
+ * @param lo first index to be searched
+ * @param hi index after the last one to be searched
+ * @throw ValueError if lo is negative
+ */
+template <typename Container, typename Compare>
+typename detail::IfComparator<Compare>::type
+bisectRight(const Container& cont, const typename Container::value_type& item,
+            const Compare& comp, long lo = 0, long hi = Slice::none)
+    throw(ValueError);
+
+/**
+ * Return the index where to insert item in sorted container, after any
+ * equal item.
+ *
+ * @see bisectRight(const Container&, const value_type&, const Compare&, long, long)
+ */
+template <typename Container>
+std::size_t bisectRight(const Container& cont,
+                        const typename Container::value_type& item,
+                        long lo = 0, long hi = Slice::none) throw(ValueError);
+
+/**
+ * Insert item in sorted list, before any equal item.
+ *
+ * @tparam ListType list type with an insert(long, T) method
+ * @param list sorted list
+ * @param item item to be inserted
+ */
+template <typename ListType>
+void insortLeft(ListType& list, typename ListType::value_type item);
+
+/**
+ * Insert item in sorted list, after any equal item.
+ *
+ * This is Python bisect.insort, which keeps items in insertion order among
+ * equal ones.
+ *
+ * @tparam ListType list type with an insert(long, T) method
+ * @param list sorted list
+ * @param item item to be inserted
+ */
+template <typename ListType>
+void insort(ListType& list, typename ListType::value_type item);
+
+/**
+ * Insert item in a list sorted according to comp, after any equal item.
+ *
+ * @tparam ListType list type with an insert(long, T) method
+ * @tparam Compare comparator type
+ * @param list sorted list
+ * @param item item to be inserted
+ * @param comp comparator by which list is sorted
+ */
+template <typename ListType, typename Compare>
+void insort(ListType& list, typename ListType::value_type item,
+            const Compare& comp);
+
+//=============================================================================
+// Implementation
+//=============================================================================
+
+namespace detail
+{
+
+/**
+ * Check and clamp [lo, hi) bounds of a bisection.
+ */
+inline void bisectBounds(long& lo, long& hi, std::size_t size)
+    throw(ValueError)
+{
+    if (lo < 0)
+        THROW(ValueError, "lo must be non-negative");
+    if (lo > long(size))
+        lo = long(size);
+    if (hi == Slice::none || hi > long(size))
+        hi = long(size);
+    if (hi < lo)
+        hi = lo;
+}
+
+} //end of namespace detail
+
+template <typename Container, typename Compare>
+typename detail::IfComparator<Compare>::type
+bisectLeft(const Container& cont, const typename Container::value_type& item,
+           const Compare& comp, long lo, long hi) throw(ValueError)
+{
+    detail::bisectBounds(lo, hi, cont.size());
+    return std::lower_bound(cont.begin() + lo, cont.begin() + hi, item, comp)
+           - cont.begin();
+}
+
+template <typename Container>
+std::size_t bisectLeft(const Container& cont,
+                       const typename Container::value_type& item,
+                       long lo, long hi) throw(ValueError)
+{
+    typedef typename Container::value_type T;
+    return bisectLeft(cont, item, std::less<T>(), lo, hi);
+}
+
+template <typename Container, typename Compare>
+typename detail::IfComparator<Compare>::type
+bisectRight(const Container& cont, const typename Container::value_type& item,
+            const Compare& comp, long lo, long hi) throw(ValueError)
+{
+    detail::bisectBounds(lo, hi, cont.size());
+    return std::upper_bound(cont.begin() + lo, cont.begin() + hi, item, comp)
+           - cont.begin();
+}
+
+template <typename Container>
+std::size_t bisectRight(const Container& cont,
+                        const typename Container::value_type& item,
+                        long lo, long hi) throw(ValueError)
+{
+    typedef typename Container::value_type T;
+    return bisectRight(cont, item, std::less<T>(), lo, hi);
+}
+
+template <typename ListType>
+void insortLeft(ListType& list, typename ListType::value_type item)
+{
+    long index = long(bisectLeft(list, item));
+    list.insert(index, std::move(item));
+}
+
+template <typename ListType>
+void insort(ListType& list, typename ListType::value_type item)
+{
+    long index = long(bisectRight(list, item));
+    list.insert(index, std::move(item));
+}
+
+template <typename ListType, typename Compare>
+void insort(ListType& list, typename ListType::value_type item,
+            const Compare& comp)
+{
+    long index = long(bisectRight(list, item, comp));
+    list.insert(index, std::move(item));
+}
+
+} //end of namespace snowball
+
+#endif
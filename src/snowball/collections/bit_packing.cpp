@@ -0,0 +1,233 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bit_packing.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SNOWBALL_SIMD_X86
+#include <immintrin.h>
+#define SNOWBALL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+using namespace snowball;
+
+namespace
+{
+
+const std::size_t lanes = 4;
+const std::size_t steps = detail::packedBlockSize / lanes;
+
+//=============================================================================
+// Scalar kernels
+//=============================================================================
+
+void scalarPack(const std::uint64_t* values, std::uint64_t base,
+                unsigned bits, std::uint64_t* out)
+{
+    if (bits == 0)
+        return;
+    for (std::size_t lane = 0; lane < lanes; ++lane)
+    {
+        std::uint64_t word = 0;
+        std::size_t k = 0;
+        unsigned shift = 0;
+        for (std::size_t step = 0; step < steps; ++step)
+        {
+            std::uint64_t offset = values[lanes * step + lane] - base;
+            word |= offset << shift;
+            if (shift + bits >= 64)
+            {
+                out[lanes * k++ + lane] = word;
+                //bits of offset which did not fit in word
+                word = shift == 0 ? 0 : offset >> (64 - shift);
+                shift = shift + bits - 64;
+            }
+            else
+                shift += bits;
+        }
+        if (shift != 0)
+            out[lanes * k + lane] = word;
+    }
+}
+
+void scalarUnpack(const std::uint64_t* in, unsigned bits, std::uint64_t base,
+                  std::uint64_t* out)
+{
+    if (bits == 0)
+    {
+        for (std::size_t i = 0; i < detail::packedBlockSize; ++i)
+            out[i] = base;
+        return;
+    }
+    std::uint64_t mask = bits == 64 ? ~std::uint64_t(0)
+                                    : (std::uint64_t(1) << bits) - 1;
+    for (std::size_t lane = 0; lane < lanes; ++lane)
+    {
+        std::size_t k = 0;
+        unsigned shift = 0;
+        for (std::size_t step = 0; step < steps; ++step)
+        {
+            std::uint64_t offset = in[lanes * k + lane] >> shift;
+            if (shift + bits > 64)
+                offset |= in[lanes * (k + 1) + lane] << (64 - shift);
+            out[lanes * step + lane] = base + (offset & mask);
+            shift += bits;
+            if (shift >= 64)
+            {
+                shift -= 64;
+                ++k;
+            }
+        }
+    }
+}
+
+#ifdef SNOWBALL_SIMD_X86
+
+//=============================================================================
+// AVX2 kernels
+//
+// Same loops as scalar kernels, the 4 lanes being processed at once. Vector
+// shifts by 64 bits or more give 0, which removes the special cases of
+// scalar shifts.
+//=============================================================================
+
+SNOWBALL_TARGET_AVX2 void avx2Pack(const std::uint64_t* values,
+                                   std::uint64_t base, unsigned bits,
+                                   std::uint64_t* out)
+{
+    if (bits == 0)
+        return;
+    __m256i vbase = _mm256_set1_epi64x(base);
+    __m256i word = _mm256_setzero_si256();
+    __m256i* output = reinterpret_cast<__m256i*>(out);
+    unsigned shift = 0;
+    for (std::size_t step = 0; step < steps; ++step)
+    {
+        __m256i offset = _mm256_sub_epi64(_mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(values + lanes * step)), vbase);
+        word = _mm256_or_si256(word,
+            _mm256_sll_epi64(offset, _mm_cvtsi32_si128(shift)));
+        if (shift + bits >= 64)
+        {
+            _mm256_storeu_si256(output++, word);
+            word = _mm256_srl_epi64(offset, _mm_cvtsi32_si128(64 - shift));
+            shift = shift + bits - 64;
+        }
+        else
+            shift += bits;
+    }
+    if (shift != 0)
+        _mm256_storeu_si256(output, word);
+}
+
+SNOWBALL_TARGET_AVX2 void avx2Unpack(const std::uint64_t* in, unsigned bits,
+                                     std::uint64_t base, std::uint64_t* out)
+{
+    __m256i vbase = _mm256_set1_epi64x(base);
+    __m256i* output = reinterpret_cast<__m256i*>(out);
+    if (bits == 0)
+    {
+        for (std::size_t step = 0; step < steps; ++step)
+            _mm256_storeu_si256(output + step, vbase);
+        return;
+    }
+    __m256i mask = _mm256_set1_epi64x(bits == 64 ? ~std::uint64_t(0)
+                                      : (std::uint64_t(1) << bits) - 1);
+    const __m256i* input = reinterpret_cast<const __m256i*>(in);
+    unsigned shift = 0;
+    for (std::size_t step = 0; step < steps; ++step)
+    {
+        __m256i offset = _mm256_srl_epi64(_mm256_loadu_si256(input),
+                                          _mm_cvtsi32_si128(shift));
+        if (shift + bits > 64)
+            offset = _mm256_or_si256(offset,
+                _mm256_sll_epi64(_mm256_loadu_si256(input + 1),
+                                 _mm_cvtsi32_si128(64 - shift)));
+        offset = _mm256_and_si256(offset, mask);
+        _mm256_storeu_si256(output + step, _mm256_add_epi64(offset, vbase));
+        shift += bits;
+        if (shift >= 64)
+        {
+            shift -= 64;
+            ++input;
+        }
+    }
+}
+
+/*
+ * Whether AVX2 kernels may be used.
+ */
+bool hasAvx2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif
+
+//=============================================================================
+// Runtime dispatch
+//=============================================================================
+
+struct Kernels
+{
+    void (*pack)(const std::uint64_t*, std::uint64_t, unsigned,
+                 std::uint64_t*);
+    void (*unpack)(const std::uint64_t*, unsigned, std::uint64_t,
+                   std::uint64_t*);
+};
+
+const Kernels& kernels()
+{
+#ifdef SNOWBALL_SIMD_X86
+    static const Kernels avx2 = {&avx2Pack, &avx2Unpack};
+    static const Kernels scalar = {&scalarPack, &scalarUnpack};
+    static const Kernels& k = hasAvx2() ? avx2 : scalar;
+#else
+    static const Kernels k = {&scalarPack, &scalarUnpack};
+#endif
+    return k;
+}
+
+} //end of anonymous namespace
+
+//=============================================================================
+// Public kernels
+//=============================================================================
+
+void detail::packBlock(const std::uint64_t* values, std::uint64_t base,
+                       unsigned bits, std::uint64_t* out)
+{
+    kernels().pack(values, base, bits, out);
+}
+
+void detail::unpackBlock(const std::uint64_t* in, unsigned bits,
+                         std::uint64_t base, std::uint64_t* out)
+{
+    kernels().unpack(in, bits, base, out);
+}
+
+const char* detail::bitPackingInstructionSet()
+{
+#ifdef SNOWBALL_SIMD_X86
+    static const char* name = hasAvx2() ? "avx2" : "scalar";
+    return name;
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,125 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_BIT_PACKING_H
+#define SNOWBALL_BIT_PACKING_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace snowball
+{
+
+namespace detail
+{
+
+/**
+ * Bit-packing kernels for blocks of 128 unsigned 64-bit values.
+ *
+ * A block is stored as offsets from a base value (frame of reference), each
+ * one on the same number of bits. Values are interleaved over 4 lanes: value
+ * i goes to lane i % 4, and word k of lane j is stored at index 4 * k + j.
+ * The 4 lanes of a word are then contiguous and processed by one AVX2
+ * instruction; a lane holding 32 values takes (bits + 1) / 2 words.
+ *
+ * The instruction set is selected once at runtime: AVX2 if the CPU supports
+ * it, else a scalar loop.
+ */
+const std::size_t packedBlockSize = 128;
+
+/**
+ * Return the number of 64-bit words of a block packed on given bits.
+ *
+ * @param bits number of bits per value, from 0 to 64
+ */
+inline std::size_t packedWords(unsigned bits)
+{
+    return 4 * ((bits + 1) / 2);
+}
+
+/**
+ * Return the number of bits needed to store offsets up to range.
+ *
+ * @param range largest offset from base
+ */
+inline unsigned packedBits(std::uint64_t range)
+{
+    return range == 0 ? 0 : 64 - __builtin_clzll(range);
+}
+
+/**
+ * Pack a block of values.
+ *
+ * @param values 128 values, none of them below base
+ * @param base base value of block
+ * @param bits number of bits of the largest offset from base
+ * @param out packedWords(bits) words
+ */
+void packBlock(const std::uint64_t* values, std::uint64_t base, unsigned bits,
+               std::uint64_t* out);
+
+/**
+ * Unpack a block of values.
+ *
+ * @param in packed words
+ * @param bits number of bits per value
+ * @param base base value of block
+ * @param out 128 values
+ */
+void unpackBlock(const std::uint64_t* in, unsigned bits, std::uint64_t base,
+                 std::uint64_t* out);
+
+/**
+ * Unpack a single value of a block.
+ *
+ * @param in packed words
+ * @param bits number of bits per value
+ * @param base base value of block
+ * @param index index of value in block
+ */
+inline std::uint64_t unpackItem(const std::uint64_t* in, unsigned bits,
+                                std::uint64_t base, std::size_t index)
+{
+    if (bits == 0)
+        return base;
+    std::size_t position = (index >> 2) * bits;
+    std::size_t word = 4 * (position >> 6) + (index & 3);
+    unsigned shift = position & 63;
+    std::uint64_t value = in[word] >> shift;
+    if (shift + bits > 64)
+        value |= in[word + 4] << (64 - shift);
+    if (bits < 64)
+        value &= (std::uint64_t(1) << bits) - 1;
+    return base + value;
+}
+
+/**
+ * Return the name of the instruction set used by packing kernels: "avx2" or
+ * "scalar".
+ */
+const char* bitPackingInstructionSet();
+
+} //end of namespace detail
+
+} //end of namespace snowball
+
+#endif
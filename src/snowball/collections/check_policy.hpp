@@ -0,0 +1,127 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_CHECK_POLICY_HPP
+#define SNOWBALL_CHECK_POLICY_HPP
+
+#include <cassert>
+#include <cstddef>
+
+#include "snowball/exceptions/exceptions.h"
+
+namespace snowball
+{
+
+/**
+ * Throw an IndexError.
+ *
+ * This function is kept out of line so that the fast path of index checking
+ * only contains a comparison and a rarely taken branch.
+ */
+#if defined(__GNUC__)
+__attribute__((noinline, cold))
+#endif
+inline void throwIndexError()
+{
+    THROW(IndexError, "index out of range");
+}
+
+/**
+ * @brief Index check policy with Python semantics.
+ *
+ * Negative indices are applied from the end of the container and an IndexError
+ * exception is thrown when index is out of range.
+ *
+ * Both negative and too large indices are detected with a single unsigned
+ * comparison.
+ */
+struct PythonCheck
+{
+    /**
+     * Return position in container of given index.
+     *
+     * @param index index of item, possibly negative
+     * @param size size of container
+     * @throw IndexError if index is out of range
+     */
+    static std::size_t position(long index, std::size_t size)
+    {
+        std::size_t pos = static_cast<std::size_t>(index);
+        if (index < 0)
+            pos += size;
+        if (pos >= size)
+            throwIndexError();
+        return pos;
+    };
+};
+
+/**
+ * @brief Index check policy with debug-only assertions.
+ *
+ * Negative indices are applied from the end of the container. Index range is
+ * checked with assert, hence only when NDEBUG is not defined. In release
+ * builds out of range indices are undefined behavior.
+ */
+struct DebugCheck
+{
+    /**
+     * Return position in container of given index.
+     *
+     * @param index index of item, possibly negative
+     * @param size size of container
+     */
+    static std::size_t position(long index, std::size_t size)
+    {
+        std::size_t pos = static_cast<std::size_t>(index);
+        if (index < 0)
+            pos += size;
+        assert(pos < size && "index out of range");
+        return pos;
+    };
+};
+
+/**
+ * @brief Index check policy without any check.
+ *
+ * Negative indices are still applied from the end of the container but index
+ * range is never checked: out of range indices are undefined behavior.
+ */
+struct NoCheck
+{
+    /**
+     * Return position in container of given index.
+     *
+     * @param index index of item, possibly negative
+     * @param size size of container
+     */
+    static std::size_t position(long index, std::size_t size)
+    {
+        std::size_t pos = static_cast<std::size_t>(index);
+        if (index < 0)
+            pos += size;
+        return pos;
+    };
+};
+
+} //end of snowball namespace
+
+#endif
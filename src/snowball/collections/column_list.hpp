@@ -0,0 +1,623 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_COLUMN_LIST_HPP
+#define SNOWBALL_COLUMN_LIST_HPP
+
+#include <cstddef>
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <numeric>
+#include <type_traits>
+#include <initializer_list>
+
+#include "snowball/exceptions/exceptions.h"
+#include "check_policy.hpp"
+#include "list.hpp"
+#include "list_view.hpp"
+#include "timsort.hpp"
+
+namespace snowball
+{
+
+namespace detail
+{
+
+/**
+ * Compile time sequence of indices (std::index_sequence of C++14).
+ */
+template <std::size_t... I>
+struct IndexSequence { };
+
+template <std::size_t N, std::size_t... I>
+struct MakeIndexSequence: public MakeIndexSequence<N - 1, N - 1, I...> { };
+
+template <std::size_t... I>
+struct MakeIndexSequence<0, I...>
+{
+    typedef IndexSequence<I...> type;
+};
+
+} //end of namespace detail
+
+//==============================================================================
+// COLUMNLIST DECLARATION
+//==============================================================================
+
+/**
+ * @brief Implements a list of records which fields are stored in columns
+ * (struct of arrays).
+ *
+ * @tparam Fields types of the fields of a record
+ *
+ * Each field is stored in its own List, so that a pass over one field reads
+ * contiguous memory holding nothing but that field, instead of striding over
+ * whole records. Rows are accessed through proxies mirroring List:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * ColumnList<long, double> trades;      //id, price
+ * trades.append(1, 10.5);
+ * trades.append(2, 9.75);
+ * trades[1].get<1>() = 9.5;
+ * std::tuple<long, double> last = trades.pop();
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Columns can be handed over to the functions of algorithms.hpp:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * const ColumnList<long, double>& table = trades;
+ * double highest = max(table.column<1>());
+ * std::size_t cheapest = argmin(table.column<1>());
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Row access costs one memory access per field: prefer columns for scans.
+ */
+template <typename... Fields>
+class ColumnList
+{
+    public:
+
+    /**
+     * @typedef size_type
+     * size type for list
+     */
+    typedef std::size_t size_type;
+
+    /**
+     * @typedef value_type
+     * a record as a tuple of fields
+     */
+    typedef std::tuple<Fields...> value_type;
+
+    /**
+     * @typedef index_type
+     * the index type for list is size_type
+     */
+    typedef size_type index_type;
+
+    /**
+     * @brief Type of field I.
+     */
+    template <std::size_t I>
+    struct Field
+    {
+        typedef typename std::tuple_element<I, value_type>::type type;
+    };
+
+    /**
+     * @brief Proxy to a row of a ColumnList.
+     *
+     * @tparam ListType ColumnList or const ColumnList
+     */
+    template <typename ListType>
+    class RowProxy
+    {
+        public:
+
+        /**
+         * Constructor
+         *
+         * @param list list of row
+         * @param index index of row
+         */
+        RowProxy(ListType* list, size_type index):
+            m_list(list), m_index(index) { };
+
+        /**
+         * Return field I of row.
+         */
+        template <std::size_t I>
+        typename std::conditional<std::is_const<ListType>::value,
+            const typename Field<I>::type&, typename Field<I>::type&>::type
+        get() const
+        {
+            return std::get<I>(m_list->m_columns).begin()[m_index];
+        };
+
+        /**
+         * Copy fields of row into a tuple.
+         */
+        operator value_type() const
+        {
+            return m_list->row(m_index, Indices());
+        };
+
+        /**
+         * Assign all fields of row.
+         *
+         * @param values fields to be assigned
+         */
+        const RowProxy& operator=(const value_type& values) const
+        {
+            m_list->assignRow(m_index, values, Indices());
+            return *this;
+        };
+
+        private:
+
+        ListType* m_list;
+        size_type m_index;
+    };
+
+    /**
+     * @typedef Row
+     * proxy to a row of a non-const list
+     */
+    typedef RowProxy< ColumnList<Fields...> > Row;
+
+    /**
+     * @typedef ConstRow
+     * proxy to a row of a const list
+     */
+    typedef RowProxy< const ColumnList<Fields...> > ConstRow;
+
+    /**
+     * Constructor
+     *
+     * Creates an empty list.
+     */
+    ColumnList();
+
+    /**
+     * Constructor
+     *
+     * Creates a list from an initializer list of records.
+     *
+     * @param il initializer list
+     */
+    ColumnList(std::initializer_list<value_type> il);
+
+    /**
+     * Return list size
+     *
+     * @return the number of rows in the list
+     */
+    size_type size() const;
+
+    /**
+     * Reserve memory in every column.
+     *
+     * @param capacity number of rows
+     */
+    void reserve(size_type capacity);
+
+    /**
+     * Append a row at the end of the list.
+     *
+     * @param fields fields of row
+     */
+    void append(const Fields&... fields);
+
+    /**
+     * Append a row at the end of the list.
+     *
+     * @param values fields of row
+     */
+    void append(const value_type& values);
+
+    /**
+     * Return a proxy to the row at specified index.
+     *
+     * If specified index is negative, rows are counted from the end of the
+     * list.
+     *
+     * @param index index of row
+     * @throw IndexError if index is out of range
+     */
+    Row operator[](long index) throw(IndexError);
+
+    /**
+     * Return a proxy to the row at specified index.
+     *
+     * If specified index is negative, rows are counted from the end of the
+     * list.
+     *
+     * @param index index of row
+     * @throw IndexError if index is out of range
+     */
+    ConstRow operator[](long index) const throw(IndexError);
+
+    /**
+     * Remove the row at given index (last one by default) and return it.
+     *
+     * @param index index of row
+     * @throw IndexError if list is empty or index is out of range
+     */
+    value_type pop(long index = -1) throw(IndexError);
+
+    /**
+     * Sort rows in lexicographical order of their fields.
+     *
+     * The sort is stable. A permutation is computed on row indices, then
+     * applied to each column in turn.
+     */
+    void sort();
+
+    /**
+     * Sort rows according to field I.
+     *
+     * The sort is stable, including in reverse order, like Python
+     * list.sort(key=..., reverse=...).
+     *
+     * @tparam I index of field
+     * @param reverse true to sort in descending order
+     */
+    template <std::size_t I>
+    void sortBy(bool reverse = false);
+
+    /**
+     * Return column I.
+     *
+     * The column is a List: items are contiguous and any read-only function
+     * taking a List or a container applies to it.
+     *
+     * @tparam I index of field
+     */
+    template <std::size_t I>
+    const List<typename Field<I>::type>& column() const;
+
+    /**
+     * Return a view over column I.
+     *
+     * Items of the column can be modified through the view, but not its size.
+     * The view is invalidated when rows are added or removed.
+     *
+     * @tparam I index of field
+     */
+    template <std::size_t I>
+    ListView<typename Field<I>::type> column();
+
+    /**
+     * Row-wise equality comparison with another list.
+     *
+     * @param other list to be compared to
+     */
+    bool operator==(const ColumnList<Fields...>& other) const;
+
+    /**
+     * Clear all rows from the list.
+     */
+    void clear();
+
+    private:
+
+    typedef typename detail::MakeIndexSequence<sizeof...(Fields)>::type
+        Indices;
+
+    template <std::size_t... I>
+    void reserve(size_type capacity, detail::IndexSequence<I...>);
+
+    template <std::size_t... I>
+    void clear(detail::IndexSequence<I...>);
+
+    template <std::size_t... I>
+    void appendRow(const value_type& values, detail::IndexSequence<I...>);
+
+    template <std::size_t... I>
+    value_type row(size_type index, detail::IndexSequence<I...>) const;
+
+    template <std::size_t... I>
+    void assignRow(size_type index, const value_type& values,
+                   detail::IndexSequence<I...>);
+
+    template <std::size_t... I>
+    value_type popRow(size_type index, detail::IndexSequence<I...>);
+
+    template <std::size_t... I>
+    void permute(const std::vector<size_type>& order,
+                 detail::IndexSequence<I...>);
+
+    template <std::size_t I>
+    void permuteColumn(const std::vector<size_type>& order);
+
+    /**
+     * Whether row a is less than row b, comparing fields from I on.
+     */
+    template <std::size_t I>
+    bool rowLess(size_type a, size_type b,
+                 std::integral_constant<bool, true>) const;
+
+    template <std::size_t I>
+    bool rowLess(size_type a, size_type b,
+                 std::integral_constant<bool, false>) const;
+
+    /**
+     * Attributes
+     */
+    std::tuple< List<Fields>... > m_columns;
+
+}; // end of ColumnList class
+
+//==============================================================================
+// COLUMNLIST DEFINITION
+//==============================================================================
+
+//Constructors
+
+template <typename... Fields>
+ColumnList<Fields...>::ColumnList() { };
+
+template <typename... Fields>
+ColumnList<Fields...>::ColumnList(std::initializer_list<value_type> il)
+{
+    reserve(il.size());
+    for (const value_type& values: il)
+        append(values);
+}
+
+//size and reserve methods
+
+template <typename... Fields>
+typename ColumnList<Fields...>::size_type ColumnList<Fields...>::size() const
+{
+    return std::get<0>(m_columns).size();
+}
+
+template <typename... Fields>
+void ColumnList<Fields...>::reserve(size_type capacity)
+{
+    reserve(capacity, Indices());
+}
+
+template <typename... Fields>
+template <std::size_t... I>
+void ColumnList<Fields...>::reserve(size_type capacity,
+                                    detail::IndexSequence<I...>)
+{
+    int expand[] = {0, (std::get<I>(m_columns).reserve(capacity), 0)...};
+    (void) expand;
+}
+
+//append methods
+
+template <typename... Fields>
+void ColumnList<Fields...>::append(const Fields&... fields)
+{
+    appendRow(value_type(fields...), Indices());
+}
+
+template <typename... Fields>
+void ColumnList<Fields...>::append(const value_type& values)
+{
+    appendRow(values, Indices());
+}
+
+template <typename... Fields>
+template <std::size_t... I>
+void ColumnList<Fields...>::appendRow(const value_type& values,
+                                      detail::IndexSequence<I...>)
+{
+    int expand[] = {0, (std::get<I>(m_columns).append(std::get<I>(values)),
+                        0)...};
+    (void) expand;
+}
+
+//row access
+
+template <typename... Fields>
+typename ColumnList<Fields...>::Row
+ColumnList<Fields...>::operator[](long index) throw(IndexError)
+{
+    return Row(this, PythonCheck::position(index, size()));
+}
+
+template <typename... Fields>
+typename ColumnList<Fields...>::ConstRow
+ColumnList<Fields...>::operator[](long index) const throw(IndexError)
+{
+    return ConstRow(this, PythonCheck::position(index, size()));
+}
+
+template <typename... Fields>
+template <std::size_t... I>
+typename ColumnList<Fields...>::value_type
+ColumnList<Fields...>::row(size_type index, detail::IndexSequence<I...>) const
+{
+    return value_type(std::get<I>(m_columns).begin()[index]...);
+}
+
+template <typename... Fields>
+template <std::size_t... I>
+void ColumnList<Fields...>::assignRow(size_type index, const value_type& values,
+                                      detail::IndexSequence<I...>)
+{
+    int expand[] = {0, (std::get<I>(m_columns).begin()[index] =
+                        std::get<I>(values), 0)...};
+    (void) expand;
+}
+
+//pop method
+
+template <typename... Fields>
+typename ColumnList<Fields...>::value_type
+ColumnList<Fields...>::pop(long index) throw(IndexError)
+{
+    if (size() == 0)
+        THROW(IndexError, "pop from an empty list");
+    return popRow(PythonCheck::position(index, size()), Indices());
+}
+
+template <typename... Fields>
+template <std::size_t... I>
+typename ColumnList<Fields...>::value_type
+ColumnList<Fields...>::popRow(size_type index, detail::IndexSequence<I...>)
+{
+    //braced initialization pops columns from left to right
+    return value_type{std::get<I>(m_columns).pop(long(index))...};
+}
+
+//sort methods
+
+template <typename... Fields>
+void ColumnList<Fields...>::sort()
+{
+    std::vector<size_type> order(size());
+    std::iota(order.begin(), order.end(), size_type(0));
+    const ColumnList<Fields...>* self = this;
+    stableSort(order.begin(), order.end(),
+        [self](size_type a, size_type b)
+        {
+            return self->rowLess<0>(a, b, std::integral_constant<bool, true>());
+        });
+    permute(order, Indices());
+}
+
+template <typename... Fields>
+template <std::size_t I>
+void ColumnList<Fields...>::sortBy(bool reverse)
+{
+    //keys are sorted along with row indices, so that the sort reads
+    //contiguous memory instead of looking keys up in the column
+    typedef typename Field<I>::type F;
+    typedef std::pair<F, size_type> Key;
+    const List<F>& column = std::get<I>(m_columns);
+    std::vector<Key> keys;
+    keys.reserve(size());
+    for (size_type index = 0; index < size(); ++index)
+        keys.push_back(Key(column.begin()[index], index));
+    if (reverse)
+        stableSort(keys.begin(), keys.end(),
+            [](const Key& a, const Key& b) { return b.first < a.first; });
+    else
+        stableSort(keys.begin(), keys.end(),
+            [](const Key& a, const Key& b) { return a.first < b.first; });
+    std::vector<size_type> order;
+    order.reserve(keys.size());
+    for (const Key& key: keys)
+        order.push_back(key.second);
+    permute(order, Indices());
+}
+
+template <typename... Fields>
+template <std::size_t I>
+bool ColumnList<Fields...>::rowLess(size_type a, size_type b,
+                                    std::integral_constant<bool, true>) const
+{
+    typename List<typename Field<I>::type>::const_iterator column;
+    column = std::get<I>(m_columns).begin();
+    if (column[a] < column[b])
+        return true;
+    if (column[b] < column[a])
+        return false;
+    return rowLess<I + 1>(a, b,
+        std::integral_constant<bool, (I + 1 < sizeof...(Fields))>());
+}
+
+template <typename... Fields>
+template <std::size_t I>
+bool ColumnList<Fields...>::rowLess(size_type, size_type,
+                                    std::integral_constant<bool, false>) const
+{
+    return false;
+}
+
+template <typename... Fields>
+template <std::size_t... I>
+void ColumnList<Fields...>::permute(const std::vector<size_type>& order,
+                                    detail::IndexSequence<I...>)
+{
+    int expand[] = {0, (permuteColumn<I>(order), 0)...};
+    (void) expand;
+}
+
+template <typename... Fields>
+template <std::size_t I>
+void ColumnList<Fields...>::permuteColumn(const std::vector<size_type>& order)
+{
+    typedef typename Field<I>::type F;
+    List<F>& column = std::get<I>(m_columns);
+    List<F> sorted;
+    sorted.reserve(order.size());
+    for (size_type index: order)
+        sorted.append(std::move(column.begin()[index]));
+    column = std::move(sorted);
+}
+
+//column methods
+
+template <typename... Fields>
+template <std::size_t I>
+const List<typename ColumnList<Fields...>::template Field<I>::type>&
+ColumnList<Fields...>::column() const
+{
+    return std::get<I>(m_columns);
+}
+
+template <typename... Fields>
+template <std::size_t I>
+ListView<typename ColumnList<Fields...>::template Field<I>::type>
+ColumnList<Fields...>::column()
+{
+    typedef typename Field<I>::type F;
+    List<F>& column = std::get<I>(m_columns);
+    F* data = column.size() ? &*column.begin() : 0;
+    return ListView<F>(data, Slice(Slice::none, Slice::none, 1, column.size()));
+}
+
+//operator==
+
+template <typename... Fields>
+bool ColumnList<Fields...>::operator==(const ColumnList<Fields...>& other) const
+{
+    return m_columns == other.m_columns;
+}
+
+//clear method
+
+template <typename... Fields>
+void ColumnList<Fields...>::clear()
+{
+    clear(Indices());
+}
+
+template <typename... Fields>
+template <std::size_t... I>
+void ColumnList<Fields...>::clear(detail::IndexSequence<I...>)
+{
+    int expand[] = {0, (std::get<I>(m_columns).clear(), 0)...};
+    (void) expand;
+}
+
+} //end of namespace snowball
+
+#endif
@@ -0,0 +1,601 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_COMPRESSED_LIST_HPP
+#define SNOWBALL_COMPRESSED_LIST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <initializer_list>
+
+#include "snowball/exceptions/exceptions.h"
+#include "check_policy.hpp"
+#include "bit_packing.h"
+#include "simd_search.h"
+#include "list.hpp"
+
+namespace snowball
+{
+
+//Forward declaration of CompressedList template
+template <typename T> class CompressedList;
+
+//==============================================================================
+// COMPRESSEDLISTITERATOR DECLARATION
+//==============================================================================
+
+/**
+ * @brief Forward iterator over a CompressedList.
+ *
+ * The iterator holds the current block decoded, so that a block is unpacked
+ * once per 128 items. Items are returned by value: they cannot be modified.
+ *
+ * @warning an iterator is invalidated when items are added to the list.
+ *
+ * @tparam T integral type of items
+ */
+template <typename T>
+class CompressedListIterator
+{
+    public:
+
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef T reference;
+
+    /**
+     * Constructor
+     *
+     * @param list list to be iterated over
+     * @param pos index of item
+     */
+    CompressedListIterator(const CompressedList<T>* list, std::size_t pos);
+
+    T operator*() const
+    {
+        if (m_pos < m_packed)
+            return T(m_buffer[m_pos % detail::packedBlockSize]);
+        return m_tail[m_pos - m_packed];
+    };
+
+    CompressedListIterator& operator++()
+    {
+        ++m_pos;
+        if (m_pos % detail::packedBlockSize == 0)
+            load();
+        return *this;
+    };
+
+    CompressedListIterator operator++(int)
+    {
+        CompressedListIterator it(*this);
+        ++(*this);
+        return it;
+    };
+
+    bool operator==(const CompressedListIterator& o) const { return m_pos == o.m_pos; };
+    bool operator!=(const CompressedListIterator& o) const { return m_pos != o.m_pos; };
+
+    private:
+
+    /**
+     * Decode the block of current item if it is packed.
+     */
+    void load();
+
+    const CompressedList<T>* m_list;
+    const T* m_tail;
+    std::size_t m_packed;
+    std::size_t m_pos;
+    std::uint64_t m_buffer[detail::packedBlockSize];
+};
+
+//==============================================================================
+// COMPRESSEDLIST DECLARATION
+//==============================================================================
+
+/**
+ * @brief Implements an append-only list of integers compressed by blocks.
+ *
+ * @tparam T integral type of items
+ *
+ * Items are grouped in blocks of 128. Each block stores its smallest item and
+ * the offsets of all items from it, bit-packed on the number of bits of the
+ * largest offset (frame of reference). Sorted timestamps or identifiers, for
+ * which consecutive items are close, take a few bits per item instead of 64.
+ * The last block is kept uncompressed until it is full.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * CompressedList<long> ids;
+ * for (long id = 1000000; id < 2000000; id += 3)
+ *     ids.append(id);
+ * ids[-1];                  //1999999, unpacked alone
+ * ids.contains(1500001);    //true, only one block is unpacked
+ * ids.bisectLeft(1500000);  //166667
+ * ids.memoryUsage();        //about 1.5 byte per item
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The smallest and largest item of each block are kept aside: contains skips
+ * blocks which cannot hold the item, and when items were appended in sorted
+ * order, contains and bisections look for the block by binary search.
+ *
+ * Items can't be modified or removed, except by clear.
+ */
+template <typename T>
+class CompressedList
+{
+    static_assert(std::is_integral<T>::value && sizeof(T) <= 8,
+                  "CompressedList holds integers of at most 64 bits");
+
+    public:
+
+    /**
+     * @typedef size_type
+     * size type for list
+     */
+    typedef std::size_t size_type;
+
+    /**
+     * @typedef value_type
+     * value type for list
+     */
+    typedef T value_type;
+
+    /**
+     * @typedef index_type
+     * the index type for list is size_type
+     */
+    typedef size_type index_type;
+
+    /**
+     * @typedef iterator
+     * a forward iterator to items
+     */
+    typedef CompressedListIterator<T> iterator;
+
+    /**
+     * @typedef const_iterator
+     * a forward iterator to items
+     */
+    typedef CompressedListIterator<T> const_iterator;
+
+    /**
+     * Constructor
+     *
+     * Creates an empty list.
+     */
+    CompressedList();
+
+    /**
+     * Constructor
+     *
+     * Creates a list from an initializer list.
+     *
+     * @param il initializer list
+     */
+    CompressedList(std::initializer_list<T> il);
+
+    /**
+     * Return list size
+     *
+     * @return the number of items in the list
+     */
+    size_type size() const;
+
+    /**
+     * Append an item at the end of the list.
+     *
+     * @param item item to be appended
+     */
+    void append(T item);
+
+    /**
+     * Append all items of a container at the end of the list.
+     *
+     * @param cont container of items to be appended
+     */
+    template <typename Container>
+    void extend(const Container& cont);
+
+    /**
+     * Return the item at specified index.
+     *
+     * Only the requested item is unpacked.
+     *
+     * @param index index of item, negative indices are applied from the end
+     * @throw IndexError if index is out of range
+     */
+    T operator[](long index) const throw(IndexError);
+
+    /**
+     * Check whether a given item is in the list.
+     *
+     * @param item item to be looked for
+     */
+    bool contains(T item) const;
+
+    /**
+     * Return the index where to insert item to keep the list sorted, before
+     * any equal item.
+     *
+     * @param item item to be looked for
+     * @throw ValueError if items were not appended in sorted order
+     */
+    size_type bisectLeft(T item) const throw(ValueError);
+
+    /**
+     * Return the index where to insert item to keep the list sorted, after
+     * any equal item.
+     *
+     * @param item item to be looked for
+     * @throw ValueError if items were not appended in sorted order
+     */
+    size_type bisectRight(T item) const throw(ValueError);
+
+    /**
+     * Whether items were appended in non-decreasing order.
+     */
+    bool sorted() const;
+
+    /**
+     * Return the number of bytes allocated by the list.
+     */
+    size_type memoryUsage() const;
+
+    /**
+     * Release memory allocated in excess of the items of the list.
+     */
+    void shrinkToFit();
+
+    /**
+     * Return an uncompressed copy of the list.
+     */
+    List<T> toList() const;
+
+    /**
+     * Remove all items from the list.
+     */
+    void clear();
+
+    /**
+     * Return an iterator to the beginning of the list.
+     */
+    const_iterator begin() const;
+
+    /**
+     * Return an iterator to the end of the list.
+     */
+    const_iterator end() const;
+
+    private:
+
+    friend class CompressedListIterator<T>;
+
+    /**
+     * Return the number of packed blocks.
+     */
+    size_type blocks() const { return m_mins.size(); };
+
+    /**
+     * Unpack a block.
+     *
+     * @param block index of block
+     * @param out 128 items, as 64-bit integers
+     */
+    void unpack(size_type block, std::uint64_t* out) const;
+
+    /**
+     * Pack the uncompressed block.
+     */
+    void pack();
+
+    /**
+     * Return position of first item not less than item (left) or greater
+     * than item (right) in sorted list.
+     */
+    template <bool Right>
+    size_type bisect(T item) const throw(ValueError);
+
+    /**
+     * Attributes
+     */
+    std::vector<std::uint64_t> m_words;     //packed offsets of all blocks
+    std::vector<std::size_t> m_offsets;     //first word of each block
+    std::vector<unsigned char> m_bits;      //bits per offset in each block
+    std::vector<T> m_mins;                  //smallest item of each block
+    std::vector<T> m_maxes;                 //largest item of each block
+    std::vector<T> m_tail;                  //items of the unpacked block
+    bool m_sorted;
+
+}; // end of CompressedList class
+
+//==============================================================================
+// COMPRESSEDLISTITERATOR DEFINITION
+//==============================================================================
+
+template <typename T>
+CompressedListIterator<T>::CompressedListIterator(
+    const CompressedList<T>* list, std::size_t pos):
+    m_list(list), m_tail(list->m_tail.data()),
+    m_packed(list->blocks() * detail::packedBlockSize), m_pos(pos)
+{
+    load();
+}
+
+template <typename T>
+void CompressedListIterator<T>::load()
+{
+    if (m_pos < m_packed)
+        m_list->unpack(m_pos / detail::packedBlockSize, m_buffer);
+}
+
+//==============================================================================
+// COMPRESSEDLIST DEFINITION
+//==============================================================================
+
+//Constructors
+
+template <typename T>
+CompressedList<T>::CompressedList(): m_sorted(true) { };
+
+template <typename T>
+CompressedList<T>::CompressedList(std::initializer_list<T> il): m_sorted(true)
+{
+    extend(il);
+}
+
+//size method
+
+template <typename T>
+typename CompressedList<T>::size_type CompressedList<T>::size() const
+{
+    return blocks() * detail::packedBlockSize + m_tail.size();
+}
+
+//append and extend methods
+
+template <typename T>
+void CompressedList<T>::append(T item)
+{
+    if (m_sorted)
+    {
+        if (!m_tail.empty())
+            m_sorted = !(item < m_tail.back());
+        else if (blocks() != 0)
+            m_sorted = !(item < m_maxes.back());
+    }
+    if (m_tail.capacity() == 0)
+        m_tail.reserve(detail::packedBlockSize);
+    m_tail.push_back(item);
+    if (m_tail.size() == detail::packedBlockSize)
+        pack();
+}
+
+template <typename T>
+template <typename Container>
+void CompressedList<T>::extend(const Container& cont)
+{
+    for (const T& item: cont)
+        append(item);
+}
+
+template <typename T>
+void CompressedList<T>::pack()
+{
+    std::uint64_t values[detail::packedBlockSize];
+    T min = m_tail[0];
+    T max = m_tail[0];
+    for (size_type i = 0; i < detail::packedBlockSize; ++i)
+    {
+        min = std::min(min, m_tail[i]);
+        max = std::max(max, m_tail[i]);
+        values[i] = std::uint64_t(m_tail[i]);
+    }
+    //offsets from min, computed modulo 2^64, fit on 64 bits for any T
+    std::uint64_t base = std::uint64_t(min);
+    unsigned bits = detail::packedBits(std::uint64_t(max) - base);
+    size_type offset = m_words.size();
+    m_words.resize(offset + detail::packedWords(bits));
+    detail::packBlock(values, base, bits, m_words.data() + offset);
+    m_offsets.push_back(offset);
+    m_bits.push_back(bits);
+    m_mins.push_back(min);
+    m_maxes.push_back(max);
+    m_tail.clear();
+}
+
+template <typename T>
+void CompressedList<T>::unpack(size_type block, std::uint64_t* out) const
+{
+    detail::unpackBlock(m_words.data() + m_offsets[block], m_bits[block],
+                        std::uint64_t(m_mins[block]), out);
+}
+
+//operator[]
+
+template <typename T>
+T CompressedList<T>::operator[](long index) const throw(IndexError)
+{
+    size_type pos = PythonCheck::position(index, size());
+    size_type block = pos / detail::packedBlockSize;
+    if (block == blocks())
+        return m_tail[pos % detail::packedBlockSize];
+    return T(detail::unpackItem(m_words.data() + m_offsets[block],
+                                m_bits[block], std::uint64_t(m_mins[block]),
+                                pos % detail::packedBlockSize));
+}
+
+//contains method
+
+template <typename T>
+bool CompressedList<T>::contains(T item) const
+{
+    if (m_sorted)
+    {
+        size_type pos = bisect<false>(item);
+        return pos < size() && (*this)[long(pos)] == item;
+    }
+    //items are unpacked as 64-bit integers, sign extended
+    std::int64_t value = std::int64_t(item);
+    std::uint64_t buffer[detail::packedBlockSize];
+    const std::int64_t* items = reinterpret_cast<const std::int64_t*>(buffer);
+    for (size_type block = 0; block < blocks(); ++block)
+    {
+        if (item < m_mins[block] || m_maxes[block] < item)
+            continue;
+        unpack(block, buffer);
+        if (detail::simdFind(items, detail::packedBlockSize, value) !=
+            detail::packedBlockSize)
+            return true;
+    }
+    return findItem(m_tail.begin(), m_tail.end(), item) != m_tail.end();
+}
+
+//bisect methods
+
+template <typename T>
+typename CompressedList<T>::size_type
+CompressedList<T>::bisectLeft(T item) const throw(ValueError)
+{
+    return bisect<false>(item);
+}
+
+template <typename T>
+typename CompressedList<T>::size_type
+CompressedList<T>::bisectRight(T item) const throw(ValueError)
+{
+    return bisect<true>(item);
+}
+
+template <typename T>
+template <bool Right>
+typename CompressedList<T>::size_type
+CompressedList<T>::bisect(T item) const throw(ValueError)
+{
+    if (!m_sorted)
+        THROW(ValueError, "list is not sorted");
+    //first block which largest item is not less than (greater than) item
+    typename std::vector<T>::const_iterator max;
+    if (Right)
+        max = std::upper_bound(m_maxes.begin(), m_maxes.end(), item);
+    else
+        max = std::lower_bound(m_maxes.begin(), m_maxes.end(), item);
+    size_type block = max - m_maxes.begin();
+    size_type first = block * detail::packedBlockSize;
+    if (block == blocks())
+    {
+        if (Right)
+            return first + (std::upper_bound(m_tail.begin(), m_tail.end(),
+                                             item) - m_tail.begin());
+        return first + (std::lower_bound(m_tail.begin(), m_tail.end(), item)
+                        - m_tail.begin());
+    }
+    std::uint64_t buffer[detail::packedBlockSize];
+    unpack(block, buffer);
+    const std::uint64_t* items = buffer;
+    const std::uint64_t* last = buffer + detail::packedBlockSize;
+    if (Right)
+        return first + (std::upper_bound(items, last, item,
+            [](T a, std::uint64_t b) { return a < T(b); }) - buffer);
+    return first + (std::lower_bound(items, last, item,
+        [](std::uint64_t a, T b) { return T(a) < b; }) - buffer);
+}
+
+//sorted method
+
+template <typename T>
+bool CompressedList<T>::sorted() const
+{
+    return m_sorted;
+}
+
+//memory methods
+
+template <typename T>
+typename CompressedList<T>::size_type CompressedList<T>::memoryUsage() const
+{
+    return m_words.capacity() * sizeof(std::uint64_t)
+         + m_offsets.capacity() * sizeof(std::size_t)
+         + m_bits.capacity()
+         + (m_mins.capacity() + m_maxes.capacity() + m_tail.capacity())
+           * sizeof(T);
+}
+
+template <typename T>
+void CompressedList<T>::shrinkToFit()
+{
+    m_words.shrink_to_fit();
+    m_offsets.shrink_to_fit();
+    m_bits.shrink_to_fit();
+    m_mins.shrink_to_fit();
+    m_maxes.shrink_to_fit();
+}
+
+//toList method
+
+template <typename T>
+List<T> CompressedList<T>::toList() const
+{
+    List<T> output;
+    output.reserve(size());
+    for (const_iterator it = begin(); it != end(); ++it)
+        output.append(*it);
+    return output;
+}
+
+//clear method
+
+template <typename T>
+void CompressedList<T>::clear()
+{
+    m_words.clear();
+    m_offsets.clear();
+    m_bits.clear();
+    m_mins.clear();
+    m_maxes.clear();
+    m_tail.clear();
+    m_sorted = true;
+}
+
+//iterators
+
+template <typename T>
+typename CompressedList<T>::const_iterator CompressedList<T>::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+template <typename T>
+typename CompressedList<T>::const_iterator CompressedList<T>::end() const
+{
+    return const_iterator(this, size());
+}
+
+} //end of namespace snowball
+
+#endif
@@ -0,0 +1,1059 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_DEQUE_HPP
+#define SNOWBALL_DEQUE_HPP
+
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <limits>
+#include <type_traits>
+#include <initializer_list>
+#include <vector>
+
+#include "snowball/exceptions/exceptions.h"
+#include "check_policy.hpp"
+
+namespace snowball
+{
+
+//==============================================================================
+// DEQUEITERATOR DECLARATION
+//==============================================================================
+
+/**
+ * @brief Random access iterator over the ring buffer of a Deque.
+ *
+ * The iterator stores the position of the item relatively to the head of the
+ * deque. It is invalidated by any insertion or removal.
+ *
+ * @tparam T type of items (possibly const)
+ */
+template <typename T>
+class DequeIterator
+{
+    public:
+
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef typename std::remove_const<T>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* pointer;
+    typedef T& reference;
+
+    /**
+     * Constructor
+     *
+     * Build a singular iterator.
+     */
+    DequeIterator(): m_buffer(0), m_mask(0), m_head(0), m_pos(0) { };
+
+    /**
+     * Constructor
+     *
+     * @param buffer ring buffer
+     * @param mask capacity of ring buffer minus one
+     * @param head position of first item in ring buffer
+     * @param pos position of item relatively to head
+     */
+    DequeIterator(T* buffer, std::size_t mask, std::size_t head,
+                  difference_type pos):
+        m_buffer(buffer), m_mask(mask), m_head(head), m_pos(pos) { };
+
+    /**
+     * Conversion from non-const iterator to const iterator
+     *
+     * @param other iterator to be converted
+     */
+    template <typename U>
+    DequeIterator(const DequeIterator<U>& other):
+        m_buffer(other.m_buffer), m_mask(other.m_mask), m_head(other.m_head),
+        m_pos(other.m_pos) { };
+
+    reference operator*() const
+    {
+        return m_buffer[(m_head + m_pos) & m_mask];
+    };
+    pointer operator->() const { return &(operator*()); };
+    reference operator[](difference_type n) const
+    {
+        return m_buffer[(m_head + m_pos + n) & m_mask];
+    };
+
+    DequeIterator& operator++() { ++m_pos; return *this; };
+    DequeIterator operator++(int) { DequeIterator it(*this); ++m_pos; return it; };
+    DequeIterator& operator--() { --m_pos; return *this; };
+    DequeIterator operator--(int) { DequeIterator it(*this); --m_pos; return it; };
+    DequeIterator& operator+=(difference_type n) { m_pos += n; return *this; };
+    DequeIterator& operator-=(difference_type n) { m_pos -= n; return *this; };
+    DequeIterator operator+(difference_type n) const
+    {
+        return DequeIterator(m_buffer, m_mask, m_head, m_pos + n);
+    };
+    DequeIterator operator-(difference_type n) const
+    {
+        return DequeIterator(m_buffer, m_mask, m_head, m_pos - n);
+    };
+    template <typename U>
+    difference_type operator-(const DequeIterator<U>& other) const
+    {
+        return m_pos - other.m_pos;
+    };
+
+    template <typename U>
+    bool operator==(const DequeIterator<U>& o) const { return m_pos == o.m_pos; };
+    template <typename U>
+    bool operator!=(const DequeIterator<U>& o) const { return m_pos != o.m_pos; };
+    template <typename U>
+    bool operator<(const DequeIterator<U>& o) const { return m_pos < o.m_pos; };
+    template <typename U>
+    bool operator<=(const DequeIterator<U>& o) const { return m_pos <= o.m_pos; };
+    template <typename U>
+    bool operator>(const DequeIterator<U>& o) const { return m_pos > o.m_pos; };
+    template <typename U>
+    bool operator>=(const DequeIterator<U>& o) const { return m_pos >= o.m_pos; };
+
+    private:
+
+    template <typename U> friend class DequeIterator;
+
+    T* m_buffer;
+    std::size_t m_mask;
+    std::size_t m_head;
+    difference_type m_pos;
+};
+
+template <typename T>
+DequeIterator<T> operator+(typename DequeIterator<T>::difference_type n,
+                           const DequeIterator<T>& it)
+{
+    return it + n;
+}
+
+//==============================================================================
+// DEQUE DECLARATION
+//==============================================================================
+
+/**
+ * @brief Implements a double-ended queue with Python collections.deque
+ * semantics.
+ *
+ * @tparam T type of items in the deque
+ * @tparam Alloc allocator to use for items
+ *
+ * Items are stored in a ring buffer which capacity is a power of two. Items
+ * can therefore be added or removed at both ends in constant time, without
+ * moving other items. When the buffer is full its capacity is doubled, hence
+ * growth is amortized constant time.
+ *
+ * A deque may be bounded by a maximum length. Once a bounded deque is full,
+ * adding an item at one end discards an item from the opposite end.
+ *
+ * Like List, operator[] accepts negative indices and throws IndexError when
+ * index is out of range.
+ *
+ * Fast methods of deque:
+ * - Deque<T, Alloc>::append, Deque<T, Alloc>::appendleft
+ * - Deque<T, Alloc>::pop, Deque<T, Alloc>::popleft
+ * - Deque<T, Alloc>::operator[]
+ * - Deque<T, Alloc>::rotate when deque size equals its capacity
+ *
+ * Potentially slow methods because it requires to potentially navigate
+ * throug the whole deque:
+ * - Deque<T, Alloc>::contains
+ * - Deque<T, Alloc>::index
+ * - Deque<T, Alloc>::count
+ * - Deque<T, Alloc>::remove
+ */
+template <typename T, typename Alloc = std::allocator<T> >
+class Deque
+{
+    private:
+
+    /**
+     * @typedef alloc_traits
+     * traits of the allocator
+     */
+    typedef std::allocator_traits<Alloc> alloc_traits;
+
+    public:
+
+    /**
+     * @typedef size_type
+     * size type for deque
+     */
+    typedef std::size_t size_type;
+
+    /**
+     * @typedef value_type
+     * value type of deque
+     */
+    typedef T value_type;
+
+    /**
+     * @typedef allocator_type
+     * allocator type of deque
+     */
+    typedef Alloc allocator_type;
+
+    /**
+     * @typedef iterator
+     * a random access iterator to Deque<T, Alloc>::value_type
+     */
+    typedef DequeIterator<T> iterator;
+
+    /**
+     * @typedef const_iterator
+     * a random access iterator to const Deque<T, Alloc>::value_type
+     */
+    typedef DequeIterator<const T> const_iterator;
+
+    /**
+     * @typedef reverse_iterator
+     * a random access reverse iterator to Deque<T, Alloc>::value_type
+     */
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+
+    /**
+     * @typedef const_reverse_iterator
+     * a random access reverse iterator to const Deque<T, Alloc>::value_type
+     */
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    /**
+     * @typedef index_type
+     * the index type for deque is size_type
+     */
+    typedef size_type index_type;
+
+    /**
+     * Maximum length of an unbounded deque.
+     */
+    static const size_type unbounded = size_type(-1);
+
+    public:
+
+    /**
+     * Constructor
+     *
+     * Creates an empty and unbounded deque.
+     *
+     * @param alloc allocator to use for items
+     */
+    Deque(const allocator_type& alloc = allocator_type());
+
+    /**
+     * Constructor
+     *
+     * Creates an empty deque bounded to a maximum length.
+     *
+     * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * Deque<int> deque(3);
+     * deque.append(0);
+     * deque.append(1);
+     * deque.append(2);
+     * deque.append(3);
+     * //deque contains {1, 2, 3}
+     * ~~~~~~~~~~~~~~~~~~~~~
+     *
+     * @param maxlen maximum length
+     * @param alloc allocator to use for items
+     */
+    explicit Deque(size_type maxlen,
+                   const allocator_type& alloc = allocator_type());
+
+    /**
+     * Constructor
+     *
+     * Creates a deque from an initializer list. If the deque is bounded, only
+     * the last maxlen items are kept.
+     *
+     * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * Deque<int> deque = {0, 1, 2, 3};
+     * ~~~~~~~~~~~~~~~~~~~~~
+     *
+     * @param il initializer list
+     * @param maxlen maximum length
+     * @param alloc allocator to use for items
+     */
+    Deque(std::initializer_list<T> il, size_type maxlen = unbounded,
+          const allocator_type& alloc = allocator_type());
+
+    /**
+     * Copy constructor
+     *
+     * @param other existing deque
+     */
+    Deque(const Deque<T, Alloc>& other);
+
+    /**
+     * Move constructor
+     *
+     * @param other existing deque, left empty
+     */
+    Deque(Deque<T, Alloc>&& other) noexcept;
+
+    /**
+     * Destructor
+     */
+    virtual ~Deque();
+
+    /**
+     * Assignment operator with another deque
+     *
+     * @param other existing deque
+     */
+    Deque<T, Alloc>& operator=(const Deque<T, Alloc>& other);
+
+    /**
+     * Move assignment operator with another deque
+     *
+     * The buffer of other deque is stolen when its allocator is propagated
+     * or compares equal to the one of current deque. Otherwise items are
+     * moved one by one into a buffer of current allocator.
+     *
+     * @param other existing deque, left empty
+     */
+    Deque<T, Alloc>& operator=(Deque<T, Alloc>&& other) 
+        noexcept(alloc_traits::propagate_on_container_move_assignment::value);
+
+    /**
+     * Return deque size
+     *
+     * @return the number of items in the deque
+     */
+    size_type size() const;
+
+    /**
+     * Return maximum length of deque
+     *
+     * @return maximum length or Deque<T, Alloc>::unbounded
+     */
+    size_type maxlen() const;
+
+    /**
+     * Return an item from the deque at specified index.
+     *
+     * If specified index is negative, operator[] returns items from the end
+     * of the deque.
+     *
+     * @param index index of item
+     * @throw IndexError if index is out of range
+     */
+    T& operator[](long index) throw(IndexError);
+
+    /**
+     * Return an item from the deque at specified index.
+     *
+     * If specified index is negative, operator[] returns items from the end
+     * of the deque.
+     *
+     * @param index index of item
+     * @throw IndexError if index is out of range
+     */
+    const T& operator[](long index) const throw(IndexError);
+
+    /**
+     * Item-wise equality comparison with another deque.
+     *
+     * @param other deque to be compared to
+     * @return true if both deques are equal
+     */
+    bool operator==(const Deque<T, Alloc>& other) const;
+
+    /**
+     * Append an item to the right end of the deque.
+     *
+     * If the deque is bounded and full, the leftmost item is discarded.
+     *
+     * @param item item to be appended
+     */
+    void append(const T& item);
+
+    /**
+     * Append an item to the right end of the deque.
+     *
+     * If the deque is bounded and full, the leftmost item is discarded.
+     *
+     * @param item item to be appended
+     */
+    void append(T&& item);
+
+    /**
+     * Append an item to the left end of the deque.
+     *
+     * If the deque is bounded and full, the rightmost item is discarded.
+     *
+     * @param item item to be appended
+     */
+    void appendleft(const T& item);
+
+    /**
+     * Append an item to the left end of the deque.
+     *
+     * If the deque is bounded and full, the rightmost item is discarded.
+     *
+     * @param item item to be appended
+     */
+    void appendleft(T&& item);
+
+    /**
+     * Append all items of a container to the right end of the deque.
+     *
+     * The container may be the deque itself: its items are then appended
+     * once.
+     *
+     * @tparam Container container type
+     * @param cont container which items are appended
+     */
+    template <typename Container>
+    void extend(const Container& cont);
+
+    /**
+     * Append all items of a container to the left end of the deque.
+     *
+     * As with Python, the items end up in reverse order.
+     *
+     * @tparam Container container type
+     * @param cont container which items are appended
+     */
+    template <typename Container>
+    void extendleft(const Container& cont);
+
+    /**
+     * Remove and return the rightmost item.
+     *
+     * @throw IndexError if deque is empty
+     */
+    T pop() throw(IndexError);
+
+    /**
+     * Remove and return the leftmost item.
+     *
+     * @throw IndexError if deque is empty
+     */
+    T popleft() throw(IndexError);
+
+    /**
+     * Rotate the deque n steps to the right. If n is negative, rotate to the
+     * left.
+     *
+     * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * Deque<int> deque = {0, 1, 2, 3};
+     * deque.rotate(1); //deque is now {3, 0, 1, 2}
+     * deque.rotate(-2); //deque is now {1, 2, 3, 0}
+     * ~~~~~~~~~~~~~~~~~~~~~
+     *
+     * When deque size equals its capacity (which is always the case of a full
+     * bounded deque which maximum length is a power of two) this method runs
+     * in constant time. Otherwise at most size / 2 items are moved.
+     *
+     * @param n number of steps
+     */
+    void rotate(long n = 1);
+
+    /**
+     * Check wether a given item is in the deque
+     *
+     * @param item item to be looked for
+     */
+    bool contains(const T& item) const;
+
+    /**
+     * Return the index of item in the deque.
+     *
+     * @param item to be looked for
+     * @throw ValueError if item is not in deque
+     */
+    size_type index(const T& item) const throw(ValueError);
+
+    /**
+     * Count number of occurences of given item.
+     *
+     * @param item item to count
+     */
+    size_type count(const T& item) const;
+
+    /**
+     * Remove the first item in the deque with specified value.
+     *
+     * @param item item to be removed from the deque
+     * @throw ValueError if item is not in deque
+     */
+    void remove(const T& item) throw(ValueError);
+
+    /**
+     * Reverse deque in place.
+     */
+    void reverse();
+
+    /**
+     * Clear all items from the deque.
+     *
+     * Capacity is kept.
+     */
+    void clear();
+
+    /**
+     * Iterator to the begin of the deque.
+     */
+    iterator begin();
+
+    /**
+     * Const iterator to the begin of the deque.
+     */
+    const_iterator begin() const;
+
+    /**
+     * Iterator to the end of the deque.
+     */
+    iterator end();
+
+    /**
+     * Const iterator to the end of the deque.
+     */
+    const_iterator end() const;
+
+    /**
+     * Reverse iterator to the reverse begining of the deque.
+     */
+    reverse_iterator rbegin();
+
+    /**
+     * Const reverse iterator to the reverse begining of the deque.
+     */
+    const_reverse_iterator rbegin() const;
+
+    /**
+     * Reverse iterator to the reverse end of the deque.
+     */
+    reverse_iterator rend();
+
+    /**
+     * Const reverse iterator to the reverse end of the deque.
+     */
+    const_reverse_iterator rend() const;
+
+    private:
+
+    /**
+     * Return item at given position from head (no check).
+     */
+    T& item(size_type pos) const;
+
+    /**
+     * Make room for one more item. Return false if deque is bounded and full.
+     */
+    bool reserveOne();
+
+    /**
+     * Reallocate ring buffer with given capacity (a power of two).
+     */
+    void reallocate(size_type capacity);
+
+    /**
+     * Destroy all items and release ring buffer.
+     */
+    void release();
+
+    /**
+     * Move allocator of other deque when the allocator propagates on move
+     * assignment, do nothing otherwise.
+     */
+    template <typename A>
+    static void moveAllocator(A& to, A& from, std::true_type);
+    template <typename A>
+    static void moveAllocator(A& to, A& from, std::false_type);
+
+    /**
+     * Attributes
+     */
+    Alloc m_alloc;
+    T* m_buffer;
+    size_type m_capacity;
+    size_type m_head;
+    size_type m_size;
+    size_type m_maxlen;
+
+}; // end of Deque class
+
+//==============================================================================
+// DEQUE DEFINITION
+//==============================================================================
+
+template <typename T, typename Alloc>
+const typename Deque<T, Alloc>::size_type Deque<T, Alloc>::unbounded;
+
+//Constructor
+
+template <typename T, typename Alloc>
+Deque<T, Alloc>::Deque(const allocator_type& alloc):
+    m_alloc(alloc), m_buffer(0), m_capacity(0), m_head(0), m_size(0),
+    m_maxlen(unbounded) { };
+
+template <typename T, typename Alloc>
+Deque<T, Alloc>::Deque(size_type maxlen, const allocator_type& alloc):
+    m_alloc(alloc), m_buffer(0), m_capacity(0), m_head(0), m_size(0),
+    m_maxlen(maxlen) { };
+
+template <typename T, typename Alloc>
+Deque<T, Alloc>::Deque(std::initializer_list<T> il, size_type maxlen,
+                       const allocator_type& alloc):
+    m_alloc(alloc), m_buffer(0), m_capacity(0), m_head(0), m_size(0),
+    m_maxlen(maxlen)
+{
+    extend(il);
+}
+
+template <typename T, typename Alloc>
+Deque<T, Alloc>::Deque(const Deque<T, Alloc>& other):
+    m_alloc(alloc_traits::select_on_container_copy_construction(other.m_alloc)),
+    m_buffer(0), m_capacity(0), m_head(0), m_size(0),
+    m_maxlen(other.m_maxlen)
+{
+    extend(other);
+}
+
+template <typename T, typename Alloc>
+Deque<T, Alloc>::Deque(Deque<T, Alloc>&& other) noexcept:
+    m_alloc(std::move(other.m_alloc)), m_buffer(other.m_buffer),
+    m_capacity(other.m_capacity), m_head(other.m_head), m_size(other.m_size),
+    m_maxlen(other.m_maxlen)
+{
+    other.m_buffer = 0;
+    other.m_capacity = 0;
+    other.m_head = 0;
+    other.m_size = 0;
+}
+
+//Destructor
+
+template <typename T, typename Alloc>
+Deque<T, Alloc>::~Deque()
+{
+    release();
+}
+
+//Assignment operator
+
+template <typename T, typename Alloc>
+Deque<T, Alloc>& Deque<T, Alloc>::operator=(const Deque<T, Alloc>& other)
+{
+    if (this != &other)
+    {
+        clear();
+        m_maxlen = other.m_maxlen;
+        extend(other);
+    }
+    return *this;
+}
+
+template <typename T, typename Alloc>
+Deque<T, Alloc>& Deque<T, Alloc>::operator=(Deque<T, Alloc>&& other) 
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value)
+{
+    typedef typename alloc_traits::propagate_on_container_move_assignment propagate;
+    if (this != &other)
+    {
+        release();
+        if (!propagate::value && !(m_alloc == other.m_alloc))
+        {
+            //buffer of other deque cannot be released by current allocator
+            m_maxlen = other.m_maxlen;
+            for (size_type i = 0; i < other.m_size; ++i)
+                append(std::move(other.item(i)));
+            other.clear();
+            return *this;
+        }
+        moveAllocator(m_alloc, other.m_alloc, propagate());
+        std::swap(m_buffer, other.m_buffer);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_head, other.m_head);
+        std::swap(m_size, other.m_size);
+        m_maxlen = other.m_maxlen;
+    }
+    return *this;
+}
+
+//size and maxlen methods
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::size_type Deque<T, Alloc>::size() const
+{
+    return m_size;
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::size_type Deque<T, Alloc>::maxlen() const
+{
+    return m_maxlen;
+}
+
+//private helpers
+
+template <typename T, typename Alloc>
+T& Deque<T, Alloc>::item(size_type pos) const
+{
+    return m_buffer[(m_head + pos) & (m_capacity - 1)];
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::reallocate(size_type capacity)
+{
+    T* buffer = alloc_traits::allocate(m_alloc, capacity);
+    for (size_type i = 0; i < m_size; ++i)
+    {
+        T& source = item(i);
+        alloc_traits::construct(m_alloc, buffer + i, std::move(source));
+        alloc_traits::destroy(m_alloc, &source);
+    }
+    if (m_buffer)
+        alloc_traits::deallocate(m_alloc, m_buffer, m_capacity);
+    m_buffer = buffer;
+    m_capacity = capacity;
+    m_head = 0;
+}
+
+template <typename T, typename Alloc>
+bool Deque<T, Alloc>::reserveOne()
+{
+    if (m_size == m_maxlen)
+        return false;
+    if (m_size == m_capacity)
+    {
+        size_type capacity = m_capacity ? 2 * m_capacity : 8;
+        reallocate(capacity);
+    }
+    return true;
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::release()
+{
+    clear();
+    if (m_buffer)
+        alloc_traits::deallocate(m_alloc, m_buffer, m_capacity);
+    m_buffer = 0;
+    m_capacity = 0;
+}
+
+template <typename T, typename Alloc>
+template <typename A>
+void Deque<T, Alloc>::moveAllocator(A& to, A& from, std::true_type)
+{
+    to = std::move(from);
+}
+
+template <typename T, typename Alloc>
+template <typename A>
+void Deque<T, Alloc>::moveAllocator(A&, A&, std::false_type) { }
+
+//operator[]
+
+template <typename T, typename Alloc>
+T& Deque<T, Alloc>::operator[](long index) throw(IndexError)
+{
+    return item(PythonCheck::position(index, m_size));
+}
+
+template <typename T, typename Alloc>
+const T& Deque<T, Alloc>::operator[](long index) const throw(IndexError)
+{
+    return item(PythonCheck::position(index, m_size));
+}
+
+//operator==
+
+template <typename T, typename Alloc>
+bool Deque<T, Alloc>::operator==(const Deque<T, Alloc>& other) const
+{
+    if (m_size != other.m_size)
+        return false;
+    return std::equal(begin(), end(), other.begin());
+}
+
+//append methods
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::append(const T& item)
+{
+    append(T(item));
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::append(T&& value)
+{
+    if (m_maxlen == 0)
+        return;
+    if (!reserveOne())
+    {
+        //bounded and full: discard the leftmost item
+        alloc_traits::destroy(m_alloc, &item(0));
+        m_head = (m_head + 1) & (m_capacity - 1);
+        --m_size;
+    }
+    alloc_traits::construct(m_alloc, &item(m_size), std::move(value));
+    ++m_size;
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::appendleft(const T& item)
+{
+    appendleft(T(item));
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::appendleft(T&& value)
+{
+    if (m_maxlen == 0)
+        return;
+    if (!reserveOne())
+    {
+        //bounded and full: discard the rightmost item
+        alloc_traits::destroy(m_alloc, &item(m_size - 1));
+        --m_size;
+    }
+    m_head = (m_head - 1) & (m_capacity - 1);
+    alloc_traits::construct(m_alloc, &item(0), std::move(value));
+    ++m_size;
+}
+
+//extend methods
+
+template <typename T, typename Alloc>
+template <typename Container>
+void Deque<T, Alloc>::extend(const Container& cont)
+{
+    if (static_cast<const void*>(&cont) == static_cast<const void*>(this))
+    {
+        //growth would release the items being read
+        std::vector<T> copy(begin(), end());
+        extend(copy);
+        return;
+    }
+    for (auto it = cont.begin(); it != cont.end(); ++it)
+        append(*it);
+}
+
+template <typename T, typename Alloc>
+template <typename Container>
+void Deque<T, Alloc>::extendleft(const Container& cont)
+{
+    if (static_cast<const void*>(&cont) == static_cast<const void*>(this))
+    {
+        std::vector<T> copy(begin(), end());
+        extendleft(copy);
+        return;
+    }
+    for (auto it = cont.begin(); it != cont.end(); ++it)
+        appendleft(*it);
+}
+
+//pop methods
+
+template <typename T, typename Alloc>
+T Deque<T, Alloc>::pop() throw(IndexError)
+{
+    if (m_size == 0)
+        THROW(IndexError, "pop from an empty deque");
+    T& last = item(m_size - 1);
+    T value(std::move(last));
+    alloc_traits::destroy(m_alloc, &last);
+    --m_size;
+    return value;
+}
+
+template <typename T, typename Alloc>
+T Deque<T, Alloc>::popleft() throw(IndexError)
+{
+    if (m_size == 0)
+        THROW(IndexError, "pop from an empty deque");
+    T& first = item(0);
+    T value(std::move(first));
+    alloc_traits::destroy(m_alloc, &first);
+    m_head = (m_head + 1) & (m_capacity - 1);
+    --m_size;
+    return value;
+}
+
+//rotate method
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::rotate(long n)
+{
+    if (m_size <= 1)
+        return;
+    long size = long(m_size);
+    n %= size;
+    if (n < 0)
+        n += size;
+    if (n == 0)
+        return;
+    if (m_size == m_capacity)
+    {
+        m_head = (m_head + m_capacity - n) & (m_capacity - 1);
+        return;
+    }
+    //move the shortest side through the free slots of the buffer
+    if (n <= size / 2)
+    {
+        for (long i = 0; i < n; ++i)
+        {
+            T& last = item(m_size - 1);
+            size_type head = (m_head - 1) & (m_capacity - 1);
+            alloc_traits::construct(m_alloc, m_buffer + head, std::move(last));
+            alloc_traits::destroy(m_alloc, &last);
+            m_head = head;
+        }
+    }
+    else
+    {
+        for (long i = 0; i < size - n; ++i)
+        {
+            T& first = item(0);
+            alloc_traits::construct(m_alloc, &item(m_size), std::move(first));
+            alloc_traits::destroy(m_alloc, &first);
+            m_head = (m_head + 1) & (m_capacity - 1);
+        }
+    }
+}
+
+//search methods
+
+template <typename T, typename Alloc>
+bool Deque<T, Alloc>::contains(const T& item) const
+{
+    return std::find(begin(), end(), item) != end();
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::size_type
+Deque<T, Alloc>::index(const T& item) const throw(ValueError)
+{
+    const_iterator it = std::find(begin(), end(), item);
+    if (it == end())
+        THROW(ValueError, "value not in deque");
+    return it - begin();
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::size_type Deque<T, Alloc>::count(const T& item) const
+{
+    return std::count(begin(), end(), item);
+}
+
+//remove method
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::remove(const T& value) throw(ValueError)
+{
+    size_type pos = index(value);
+    //shift the shortest side over the removed item
+    if (pos < m_size / 2)
+    {
+        std::move_backward(begin(), begin() + pos, begin() + pos + 1);
+        alloc_traits::destroy(m_alloc, &item(0));
+        m_head = (m_head + 1) & (m_capacity - 1);
+    }
+    else
+    {
+        std::move(begin() + pos + 1, end(), begin() + pos);
+        alloc_traits::destroy(m_alloc, &item(m_size - 1));
+    }
+    --m_size;
+}
+
+//reverse method
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::reverse()
+{
+    std::reverse(begin(), end());
+}
+
+//clear method
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::clear()
+{
+    for (size_type i = 0; i < m_size; ++i)
+        alloc_traits::destroy(m_alloc, &item(i));
+    m_head = 0;
+    m_size = 0;
+}
+
+//forward iterators
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::iterator Deque<T, Alloc>::begin()
+{
+    return iterator(m_buffer, m_capacity - 1, m_head, 0);
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::const_iterator Deque<T, Alloc>::begin() const
+{
+    return const_iterator(m_buffer, m_capacity - 1, m_head, 0);
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::iterator Deque<T, Alloc>::end()
+{
+    return iterator(m_buffer, m_capacity - 1, m_head, m_size);
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::const_iterator Deque<T, Alloc>::end() const
+{
+    return const_iterator(m_buffer, m_capacity - 1, m_head, m_size);
+}
+
+//reverse iterators
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::reverse_iterator Deque<T, Alloc>::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::const_reverse_iterator Deque<T, Alloc>::rbegin() const
+{
+    return const_reverse_iterator(end());
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::reverse_iterator Deque<T, Alloc>::rend()
+{
+    return reverse_iterator(begin());
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::const_reverse_iterator Deque<T, Alloc>::rend() const
+{
+    return const_reverse_iterator(begin());
+}
+
+} //end of snowball namespace
+
+#endif
@@ -25,6 +25,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <unordered_map>
 #include <stdexcept>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <tuple>
+#include <utility>
+#include <initializer_list>
 
 #include "hash.hpp"
 #include "list.hpp"
@@ -37,6 +43,278 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 namespace snowball
 {
 
+namespace detail
+{
+
+/**
+ * Projection of a dictionary pair on its key.
+ */
+template <typename Pair>
+struct KeyOf
+{
+    typedef typename std::remove_const<typename Pair::first_type>::type type;
+    static const type& get(const Pair& item) { return item.first; };
+};
+
+/**
+ * Projection of a dictionary pair on its value.
+ */
+template <typename Pair>
+struct ValueOf
+{
+    typedef typename Pair::second_type type;
+    static const type& get(const Pair& item) { return item.second; };
+};
+
+} //end of namespace detail
+
+//==============================================================================
+// DICTIONARYVIEWITERATOR DECLARATION
+//==============================================================================
+
+/**
+ * @brief Forward iterator over keys or values of a dictionary.
+ *
+ * @tparam MapIterator const iterator of underlying map
+ * @tparam Projection detail::KeyOf or detail::ValueOf
+ */
+template <typename MapIterator, typename Projection>
+class DictionaryViewIterator
+{
+public:
+
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename Projection::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type* pointer;
+    typedef const value_type& reference;
+
+    DictionaryViewIterator() { };
+    explicit DictionaryViewIterator(MapIterator it): m_it(it) { };
+
+    reference operator*() const { return Projection::get(*m_it); };
+    pointer operator->() const { return &Projection::get(*m_it); };
+    DictionaryViewIterator& operator++() { ++m_it; return *this; };
+    DictionaryViewIterator operator++(int) { DictionaryViewIterator it(*this); ++m_it; return it; };
+    bool operator==(const DictionaryViewIterator& other) const { return m_it == other.m_it; };
+    bool operator!=(const DictionaryViewIterator& other) const { return m_it != other.m_it; };
+
+private:
+
+    MapIterator m_it;
+};
+
+//==============================================================================
+// DICTIONARY VIEWS DECLARATION
+//==============================================================================
+
+/**
+ * @brief Dynamic view on the keys of a dictionary.
+ *
+ * As Python dict_keys, a view does not copy keys: it iterates the hash table
+ * of the dictionary and reflects its changes. It is invalidated when the
+ * dictionary is destroyed, and its iterators are invalidated by insertions
+ * which rehash the table.
+ *
+ * Set operations between key views return a List of keys, in an unspecified
+ * order and without duplicates.
+ *
+ * @tparam Map underlying std::unordered_map
+ */
+template <typename Map>
+class DictionaryKeysView
+{
+public:
+
+    typedef typename Map::size_type size_type;
+    typedef typename Map::key_type value_type;
+    typedef DictionaryViewIterator<typename Map::const_iterator,
+        detail::KeyOf<typename Map::value_type> > iterator;
+    typedef iterator const_iterator;
+
+    /**
+     * Constructor
+     *
+     * @param map table of dictionary
+     */
+    explicit DictionaryKeysView(const Map& map): m_map(&map) { };
+
+    /**
+     * Return the number of keys.
+     */
+    size_type size() const { return m_map->size(); };
+
+    /**
+     * Return true if key is in dictionary, in constant time.
+     *
+     * @param key key to be looked for
+     */
+    bool contains(const value_type& key) const
+    {
+        return m_map->find(key) != m_map->end();
+    };
+
+    /**
+     * Return true if no key is in both views.
+     *
+     * @param other view on keys of another dictionary
+     */
+    template <typename OtherMap>
+    bool isDisjoint(const DictionaryKeysView<OtherMap>& other) const;
+
+    /**
+     * Return keys in both views.
+     */
+    template <typename OtherMap>
+    List<value_type> operator&(const DictionaryKeysView<OtherMap>& other) const;
+
+    /**
+     * Return keys in any of the views.
+     */
+    template <typename OtherMap>
+    List<value_type> operator|(const DictionaryKeysView<OtherMap>& other) const;
+
+    /**
+     * Return keys of this view which are not in other.
+     */
+    template <typename OtherMap>
+    List<value_type> operator-(const DictionaryKeysView<OtherMap>& other) const;
+
+    /**
+     * Return keys in exactly one of the views.
+     */
+    template <typename OtherMap>
+    List<value_type> operator^(const DictionaryKeysView<OtherMap>& other) const;
+
+    /**
+     * Return true if both views hold the same keys.
+     */
+    template <typename OtherMap>
+    bool operator==(const DictionaryKeysView<OtherMap>& other) const;
+
+    /**
+     * Return true if views do not hold the same keys.
+     */
+    template <typename OtherMap>
+    bool operator!=(const DictionaryKeysView<OtherMap>& other) const
+    {
+        return !(*this == other);
+    };
+
+    const_iterator begin() const { return const_iterator(m_map->begin()); };
+    const_iterator end() const { return const_iterator(m_map->end()); };
+
+private:
+
+    template <typename OtherMap> friend class DictionaryKeysView;
+
+    /**
+     * Append keys of this view which membership in other is as given.
+     */
+    template <typename OtherMap>
+    void select(const DictionaryKeysView<OtherMap>& other, bool member,
+                List<value_type>& output) const;
+
+    const Map* m_map;
+};
+
+/**
+ * @brief Dynamic view on the values of a dictionary.
+ *
+ * Values are not copied; contains is a linear search.
+ *
+ * @tparam Map underlying std::unordered_map
+ */
+template <typename Map>
+class DictionaryValuesView
+{
+public:
+
+    typedef typename Map::size_type size_type;
+    typedef typename Map::mapped_type value_type;
+    typedef DictionaryViewIterator<typename Map::const_iterator,
+        detail::ValueOf<typename Map::value_type> > iterator;
+    typedef iterator const_iterator;
+
+    /**
+     * Constructor
+     *
+     * @param map table of dictionary
+     */
+    explicit DictionaryValuesView(const Map& map): m_map(&map) { };
+
+    /**
+     * Return the number of values.
+     */
+    size_type size() const { return m_map->size(); };
+
+    /**
+     * Return true if value is in dictionary, in linear time.
+     *
+     * @param value value to be looked for
+     */
+    bool contains(const value_type& value) const
+    {
+        return std::find(begin(), end(), value) != end();
+    };
+
+    const_iterator begin() const { return const_iterator(m_map->begin()); };
+    const_iterator end() const { return const_iterator(m_map->end()); };
+
+private:
+
+    const Map* m_map;
+};
+
+/**
+ * @brief Dynamic view on the (key, value) pairs of a dictionary.
+ *
+ * @tparam Map underlying std::unordered_map
+ */
+template <typename Map>
+class DictionaryItemsView
+{
+public:
+
+    typedef typename Map::size_type size_type;
+    typedef typename Map::value_type value_type;
+    typedef typename Map::const_iterator iterator;
+    typedef iterator const_iterator;
+
+    /**
+     * Constructor
+     *
+     * @param map table of dictionary
+     */
+    explicit DictionaryItemsView(const Map& map): m_map(&map) { };
+
+    /**
+     * Return the number of pairs.
+     */
+    size_type size() const { return m_map->size(); };
+
+    /**
+     * Return true if key is in dictionary and maps to value, in constant
+     * time.
+     *
+     * @param key key to be looked for
+     * @param value value expected for key
+     */
+    bool contains(const typename Map::key_type& key,
+                  const typename Map::mapped_type& value) const
+    {
+        const_iterator it = m_map->find(key);
+        return it != m_map->end() && it->second == value;
+    };
+
+    const_iterator begin() const { return m_map->begin(); };
+    const_iterator end() const { return m_map->end(); };
+
+private:
+
+    const Map* m_map;
+};
+
 
 //==============================================================================
 // DICTIONARY DECLARATION
@@ -80,6 +358,24 @@ public:
      */
     typedef typename map_type::size_type size_type;
     
+    /**
+     * @typedef keys_view
+     * Type of view on keys
+     */
+    typedef DictionaryKeysView<map_type> keys_view;
+    
+    /**
+     * @typedef values_view
+     * Type of view on values
+     */
+    typedef DictionaryValuesView<map_type> values_view;
+    
+    /**
+     * @typedef items_view
+     * Type of view on (key, value) pairs
+     */
+    typedef DictionaryItemsView<map_type> items_view;
+    
     /**
      * Constructor
      * 
@@ -126,12 +422,95 @@ public:
     /**
      * Return item at specified key.
      * 
-     * If key does not exist, it is added to dictionary and the value associated
-     * is generated from the default constructor of Value.
+     * The dictionary is left unchanged.
      * 
      * @param key key of item to be retrieved
+     * @throw KeyError key does not exist
      */
-    Value operator[](const Key& key) const;
+    const Value& operator[](const Key& key) const throw(KeyError);
+    
+    /**
+     * Return true if key exists in dictionary.
+     * 
+     * @param key key to be looked for
+     */
+    bool contains(const Key& key) const;
+    
+    /**
+     * Remove key and return its value.
+     * 
+     * @param key key of item to be removed
+     * @throw KeyError key does not exist
+     */
+    Value pop(const Key& key) throw(KeyError);
+    
+    /**
+     * Remove key and return its value. If no such key exists, it returns 
+     * instead the default value provided.
+     * 
+     * @param key key of item to be removed
+     * @param defaultValue value returned when key is not found
+     */
+    Value pop(const Key& key, const Value& defaultValue);
+    
+    /**
+     * Return item at specified key, inserting default value first if key does
+     * not exist. The table is probed once.
+     * 
+     * @param key key of item to be retrieved
+     * @param defaultValue value inserted when key is not found
+     */
+    Value& setDefault(const Key& key, const Value& defaultValue = Value());
+    
+    /**
+     * Insert or assign all items of another dictionary.
+     * 
+     * @param other dictionary which items are copied
+     */
+    void update(const Dictionary& other);
+    
+    /**
+     * Insert or assign items.
+     * 
+     * @param items (key, value) pairs
+     */
+    void update(std::initializer_list< std::pair<const Key, Value> > items);
+    
+    /**
+     * Remove key if it exists.
+     * 
+     * @param key key of item to be removed
+     * @return true if key was removed
+     */
+    bool erase(const Key& key);
+    
+    /**
+     * Insert a value built from arguments, unless key exists.
+     * 
+     * As std::unordered_map::emplace, the value is built before the table is
+     * probed, even if key exists.
+     * 
+     * @param key key of item
+     * @param args arguments given to the constructor of Value
+     * @return true if item was inserted
+     */
+    template <typename... Args>
+    bool emplace(const Key& key, Args&&... args);
+    
+    /**
+     * Insert a value built from arguments, unless key exists.
+     * 
+     * The value is only built if key does not exist: arguments given as 
+     * rvalues are left untouched otherwise. std::unordered_map has no 
+     * try_emplace before C++17, so that the table is probed twice when the 
+     * key is inserted.
+     * 
+     * @param key key of item
+     * @param args arguments given to the constructor of Value
+     * @return true if item was inserted
+     */
+    template <typename... Args>
+    bool tryEmplace(const Key& key, Args&&... args);
     
     /**
      * Return item at specified key. If no such key exists, it returns instead
@@ -184,6 +563,21 @@ public:
      * Return a list of all dictionary values.
      */
     List<Value> values() const;
+    
+    /**
+     * Return a view on dictionary keys, which are not copied.
+     */
+    keys_view keysView() const;
+    
+    /**
+     * Return a view on dictionary values, which are not copied.
+     */
+    values_view valuesView() const;
+    
+    /**
+     * Return a view on dictionary (key, value) pairs, which are not copied.
+     */
+    items_view items() const;
 
 private:
 
@@ -251,9 +645,116 @@ V& Dictionary<K, V, H, P, A>::operator[](const K& key)
 }
 
 template <typename K, typename V, typename H, typename P, typename A>
-V Dictionary<K, V, H, P, A>::operator[](const K& key) const
+const V& Dictionary<K, V, H, P, A>::operator[](const K& key) const 
+    throw(KeyError)
 {
-    return m_map[key];
+    typename map_type::const_iterator it = m_map.find(key);
+    if (it == m_map.end())
+        THROW(KeyError, "key not found");
+    return it->second;
+}
+
+/*
+ * method: contains
+ */
+
+template <typename K, typename V, typename H, typename P, typename A>
+bool Dictionary<K, V, H, P, A>::contains(const K& key) const
+{
+    return m_map.find(key) != m_map.end();
+}
+
+/*
+ * method: pop
+ */
+
+template <typename K, typename V, typename H, typename P, typename A>
+V Dictionary<K, V, H, P, A>::pop(const K& key) throw(KeyError)
+{
+    typename map_type::iterator it = m_map.find(key);
+    if (it == m_map.end())
+        THROW(KeyError, "key not found");
+    V value(std::move(it->second));
+    m_map.erase(it);
+    return value;
+}
+
+template <typename K, typename V, typename H, typename P, typename A>
+V Dictionary<K, V, H, P, A>::pop(const K& key, const V& defaultValue)
+{
+    typename map_type::iterator it = m_map.find(key);
+    if (it == m_map.end())
+        return defaultValue;
+    V value(std::move(it->second));
+    m_map.erase(it);
+    return value;
+}
+
+/*
+ * method: setDefault
+ */
+
+template <typename K, typename V, typename H, typename P, typename A>
+V& Dictionary<K, V, H, P, A>::setDefault(const K& key, const V& defaultValue)
+{
+    //insert probes before allocating a node
+    return m_map.insert(typename map_type::value_type(key, defaultValue))
+        .first->second;
+}
+
+/*
+ * method: update
+ */
+
+template <typename K, typename V, typename H, typename P, typename A>
+void Dictionary<K, V, H, P, A>::update(const Dictionary& other)
+{
+    if (this == &other)
+        return;
+    typename map_type::const_iterator it;
+    for (it = other.m_map.begin(); it != other.m_map.end(); ++it)
+        m_map[it->first] = it->second;
+}
+
+template <typename K, typename V, typename H, typename P, typename A>
+void Dictionary<K, V, H, P, A>::update(
+    std::initializer_list< std::pair<const K, V> > items)
+{
+    for (const std::pair<const K, V>& item: items)
+        m_map[item.first] = item.second;
+}
+
+/*
+ * method: erase
+ */
+
+template <typename K, typename V, typename H, typename P, typename A>
+bool Dictionary<K, V, H, P, A>::erase(const K& key)
+{
+    return m_map.erase(key) > 0;
+}
+
+/*
+ * method: emplace and tryEmplace
+ */
+
+template <typename K, typename V, typename H, typename P, typename A>
+template <typename... Args>
+bool Dictionary<K, V, H, P, A>::emplace(const K& key, Args&&... args)
+{
+    return m_map.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...)).second;
+}
+
+template <typename K, typename V, typename H, typename P, typename A>
+template <typename... Args>
+bool Dictionary<K, V, H, P, A>::tryEmplace(const K& key, Args&&... args)
+{
+    if (m_map.find(key) != m_map.end())
+        return false;
+    m_map.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                  std::forward_as_tuple(std::forward<Args>(args)...));
+    return true;
 }
 
 /*
@@ -308,6 +809,7 @@ template <typename K, typename V, typename H, typename P, typename A>
 List<K> Dictionary<K, V, H, P, A>::keys() const
 {
     List<K> output;
+    output.reserve(m_map.size());
     typename map_type::const_iterator it;
     for (it = m_map.begin(); it != m_map.end(); ++it)
         output.append(it->first);
@@ -322,11 +824,130 @@ template <typename K, typename V, typename H, typename P, typename A>
 List<V> Dictionary<K, V, H, P, A>::values() const
 {
     List<V> output;
+    output.reserve(m_map.size());
     typename map_type::const_iterator it;
     for (it = m_map.begin(); it != m_map.end(); ++it)
         output.append(it->second);
     return output;    
 }
+
+/*
+ * method: views
+ */
+
+template <typename K, typename V, typename H, typename P, typename A>
+typename Dictionary<K, V, H, P, A>::keys_view 
+Dictionary<K, V, H, P, A>::keysView() const
+{
+    return keys_view(m_map);
+}
+
+template <typename K, typename V, typename H, typename P, typename A>
+typename Dictionary<K, V, H, P, A>::values_view 
+Dictionary<K, V, H, P, A>::valuesView() const
+{
+    return values_view(m_map);
+}
+
+template <typename K, typename V, typename H, typename P, typename A>
+typename Dictionary<K, V, H, P, A>::items_view 
+Dictionary<K, V, H, P, A>::items() const
+{
+    return items_view(m_map);
+}
+
+//==============================================================================
+// DICTIONARYKEYSVIEW DEFINITION
+//==============================================================================
+
+template <typename Map>
+template <typename OtherMap>
+bool DictionaryKeysView<Map>::isDisjoint(
+    const DictionaryKeysView<OtherMap>& other) const
+{
+    //look up keys of the smaller view in the larger one
+    if (other.size() < size())
+        return other.isDisjoint(*this);
+    for (const value_type& key: *this)
+        if (other.contains(key))
+            return false;
+    return true;
+}
+
+template <typename Map>
+template <typename OtherMap>
+List<typename DictionaryKeysView<Map>::value_type> 
+DictionaryKeysView<Map>::operator&(
+    const DictionaryKeysView<OtherMap>& other) const
+{
+    List<value_type> output;
+    if (other.size() < size())
+        other.select(*this, true, output);
+    else
+        select(other, true, output);
+    return output;
+}
+
+template <typename Map>
+template <typename OtherMap>
+List<typename DictionaryKeysView<Map>::value_type> 
+DictionaryKeysView<Map>::operator|(
+    const DictionaryKeysView<OtherMap>& other) const
+{
+    List<value_type> output;
+    output.reserve(size() + other.size());
+    for (const value_type& key: *this)
+        output.append(key);
+    other.select(*this, false, output);
+    return output;
+}
+
+template <typename Map>
+template <typename OtherMap>
+List<typename DictionaryKeysView<Map>::value_type> 
+DictionaryKeysView<Map>::operator-(
+    const DictionaryKeysView<OtherMap>& other) const
+{
+    List<value_type> output;
+    select(other, false, output);
+    return output;
+}
+
+template <typename Map>
+template <typename OtherMap>
+List<typename DictionaryKeysView<Map>::value_type> 
+DictionaryKeysView<Map>::operator^(
+    const DictionaryKeysView<OtherMap>& other) const
+{
+    List<value_type> output;
+    select(other, false, output);
+    other.select(*this, false, output);
+    return output;
+}
+
+template <typename Map>
+template <typename OtherMap>
+bool DictionaryKeysView<Map>::operator==(
+    const DictionaryKeysView<OtherMap>& other) const
+{
+    if (size() != other.size())
+        return false;
+    for (const value_type& key: *this)
+        if (!other.contains(key))
+            return false;
+    return true;
+}
+
+template <typename Map>
+template <typename OtherMap>
+void DictionaryKeysView<Map>::select(
+    const DictionaryKeysView<OtherMap>& other, bool member,
+    List<value_type>& output) const
+{
+    for (const value_type& key: *this)
+        if (other.contains(key) == member)
+            output.append(key);
+}
 } //end of namespace snowball
 
 #endif
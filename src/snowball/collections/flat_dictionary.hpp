@@ -0,0 +1,1104 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_FLAT_DICTIONARY_HPP
+#define SNOWBALL_FLAT_DICTIONARY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <initializer_list>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "hash.hpp"
+#include "list.hpp"
+#include "../exceptions/exceptions.h"
+
+#ifdef SNOWBALL_WITH_BOOST_HASH
+#include <boost/functional/hash.hpp>
+#endif //SNOWBALL_WITH_BOOST_HASH
+
+namespace snowball
+{
+
+namespace detail
+{
+
+/**
+ * Control byte of an empty slot. Full slots store the 7 low bits of the hash
+ * of their key, so that the sign bit tells free slots from full ones.
+ */
+const signed char flatEmpty = -128;
+
+/**
+ * Control byte of a slot which pair was erased (tombstone). Lookups probe
+ * past it, insertions may reuse it.
+ */
+const signed char flatDeleted = -2;
+
+/**
+ * Number of control bytes probed at once.
+ */
+const std::size_t flatGroupSize = 16;
+
+/**
+ * Mix bits of a hash value: std::hash of integers is the identity, which
+ * would put consecutive keys in the same group.
+ */
+inline std::uint64_t flatMix(std::uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * @brief Group of 16 control bytes, compared at once with SSE2.
+ *
+ * Each match method returns a bit mask which bit i is set when control byte
+ * i matches.
+ */
+class FlatGroup
+{
+public:
+
+    explicit FlatGroup(const signed char* control)
+#ifdef __SSE2__
+        : m_control(_mm_loadu_si128(reinterpret_cast<const __m128i*>(control)))
+#else
+        : m_control(control)
+#endif
+    { };
+
+    /**
+     * Control bytes equal to h2.
+     */
+    unsigned match(signed char h2) const
+    {
+#ifdef __SSE2__
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_control));
+#else
+        unsigned mask = 0;
+        for (std::size_t i = 0; i < flatGroupSize; ++i)
+            mask |= unsigned(m_control[i] == h2) << i;
+        return mask;
+#endif
+    };
+
+    /**
+     * Empty slots.
+     */
+    unsigned matchEmpty() const { return match(flatEmpty); };
+
+    /**
+     * Empty or deleted slots.
+     */
+    unsigned matchFree() const
+    {
+#ifdef __SSE2__
+        return _mm_movemask_epi8(m_control);
+#else
+        unsigned mask = 0;
+        for (std::size_t i = 0; i < flatGroupSize; ++i)
+            mask |= unsigned(m_control[i] < 0) << i;
+        return mask;
+#endif
+    };
+
+    /**
+     * Full slots.
+     */
+    unsigned matchFull() const
+    {
+#ifdef __SSE2__
+        return ~_mm_movemask_epi8(m_control) & 0xffff;
+#else
+        unsigned mask = 0;
+        for (std::size_t i = 0; i < flatGroupSize; ++i)
+            mask |= unsigned(m_control[i] >= 0) << i;
+        return mask;
+#endif
+    };
+
+private:
+
+#ifdef __SSE2__
+    __m128i m_control;
+#else
+    const signed char* m_control;
+#endif
+};
+
+/**
+ * Helper for FlatProbe: void if both types exist.
+ */
+template <typename T, typename U>
+struct VoidIfTransparent
+{
+    typedef void type;
+};
+
+/**
+ * @brief Type used to probe a FlatDictionary with a key of type K.
+ *
+ * If Hash and Pred declare is_transparent, the key is used as is. Else it is
+ * converted once into Key (unless it already is one).
+ */
+template <typename Key, typename K, typename Hash, typename Pred,
+          typename = void>
+struct FlatProbe
+{
+    typedef typename std::conditional<std::is_same<K, Key>::value,
+                                      const Key&, Key>::type type;
+};
+
+template <typename Key, typename K, typename Hash, typename Pred>
+struct FlatProbe<Key, K, Hash, Pred, typename VoidIfTransparent<
+    typename Hash::is_transparent, typename Pred::is_transparent>::type>
+{
+    typedef const K& type;
+};
+
+} //end of namespace detail
+
+//Forward declaration of ConcurrentDictionary template
+template <typename Key, typename Value, typename Hash, typename Pred>
+class ConcurrentDictionary;
+
+//Forward declaration of RcuDictionary template
+template <typename Key, typename Value, typename Hash, typename Pred>
+class RcuDictionary;
+
+//==============================================================================
+// FLATDICTIONARY DECLARATION
+//==============================================================================
+
+/**
+ * Implements a dictionary (hash table) with open addressing.
+ *
+ * FlatDictionary provides the interface of Dictionary but stores pairs inline
+ * in a single array instead of one node per pair, in the manner of Swiss
+ * tables. A second array holds one control byte per slot: empty, or 7 bits of
+ * the hash of the key. A lookup loads 16 control bytes at once and compares
+ * them with the hash in a couple of SSE2 instructions; keys are only compared
+ * for the (rare) slots which control byte matches. Probing moves from group
+ * to group with a quadratic step until a group with an empty slot is found.
+ *
+ * The number of slots is a power of two and the table grows when it is 7/8
+ * full. Growth moves pairs, so that references returned by operator[] or get
+ * are invalidated by insertions.
+ *
+ * Compared with Dictionary, a lookup touches 2 cache lines (control bytes and
+ * slot) instead of 3 (bucket, node and often a collision node), and memory
+ * holds no pointer nor allocator header per pair.
+ *
+ * Erased slots are marked deleted rather than empty so that probe sequences
+ * going through them are not cut; they are reused by insertions and purged
+ * when the table is rehashed.
+ *
+ * Lookup methods take keys of any type. When Hash and Pred declare
+ * is_transparent (as StringHash and StringEqual do), the table is probed with
+ * the given key as is:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * FlatDictionary<std::string, int, StringHash, StringEqual> dict;
+ * dict["one"] = 1;         //std::string built once, on insertion
+ * dict.contains("one");    //no std::string built
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Else the key is converted into Key once per call.
+ *
+ * @tparam Key type of keys
+ * @tparam Value type of values
+ * @tparam Hash hash function of keys
+ * @tparam Pred equality of keys
+ */
+template <typename Key,
+          typename Value,
+#ifdef SNOWBALL_WITH_BOOST_HASH
+          typename Hash=boost::hash<Key>,
+#else
+          typename Hash=std::hash<Key>,
+#endif
+          typename Pred=std::equal_to<Key> >
+class FlatDictionary
+{
+public:
+
+    /**
+     * @typedef size_type
+     * Type of dictionary size
+     */
+    typedef std::size_t size_type;
+
+    /**
+     * @typedef value_type
+     * Type of pairs stored in slots
+     */
+    typedef std::pair<Key, Value> value_type;
+
+    /**
+     * Constructor
+     *
+     * Default constructor for empty dictionary. No memory is allocated.
+     */
+    FlatDictionary();
+
+    /**
+     * Copy constructor
+     *
+     * @param other dictionary to be copied
+     */
+    FlatDictionary(const FlatDictionary& other);
+
+    /**
+     * Move constructor
+     *
+     * @param other dictionary to be moved, left empty
+     */
+    FlatDictionary(FlatDictionary&& other) noexcept;
+
+    /**
+     * Assignment operator
+     *
+     * @param other dictionary to be assigned from
+     */
+    FlatDictionary& operator=(const FlatDictionary& other);
+
+    /**
+     * Move assignment operator
+     *
+     * @param other dictionary to be moved, left empty
+     */
+    FlatDictionary& operator=(FlatDictionary&& other) noexcept;
+
+    /**
+     * Destructor
+     */
+    virtual ~FlatDictionary();
+
+    /**
+     * Return size of dictionary.
+     *
+     * The number of pairs in the dictionary is returned.
+     */
+    size_type size() const;
+
+    /**
+     * Return the number of slots of the table.
+     */
+    size_type capacity() const;
+
+    /**
+     * Allocate slots so that n pairs may be stored without growth.
+     *
+     * @param n number of pairs
+     */
+    void reserve(size_type n);
+
+    /**
+     * Remove all pairs. Slots are kept.
+     */
+    void clear();
+
+    /**
+     * Return item at specified key.
+     *
+     * If key does not exist, it is added to dictionary and the value associated
+     * is generated from the default constructor of Value.
+     *
+     * @param key key of item to be retrieved
+     */
+    template <typename K = Key>
+    Value& operator[](const K& key);
+
+    /**
+     * Return item at specified key.
+     *
+     * @param key key of item to be retrieved
+     * @throw KeyError key does not exist
+     */
+    template <typename K = Key>
+    const Value& operator[](const K& key) const throw(KeyError);
+
+    /**
+     * Return item at specified key. If no such key exists, it returns instead
+     * the default value provided and dictionary is left unchanged.
+     *
+     * @param key  key of item to be retrieved
+     * @param default value returned when key is not found
+     */
+    template <typename K = Key>
+    Value& get(const K& key, Value& defaultValue);
+
+    /**
+     * Return item at specified key. If no such key exists, it returns instead
+     * the default value provided and dictionary is left unchanged.
+     *
+     * @param key  key of item to be retrieved
+     * @param default value returned when key is not found
+     */
+    template <typename K = Key>
+    Value& get(const K& key, Value&& defaultValue);
+
+    /**
+     * Return item at specified key. If no such key exists, it returns instead
+     * the default value provided and dictionary is left unchanged.
+     *
+     * @param key  key of item to be retrieved
+     * @param default value returned when key is not found
+     */
+    template <typename K = Key>
+    Value get(const K& key, Value& defaultValue) const;
+
+    /**
+     * Return item at specified key. If no such key exists, it returns instead
+     * the default value provided and dictionary is left unchanged.
+     *
+     * @param key  key of item to be retrieved
+     * @param default value returned when key is not found
+     */
+    template <typename K = Key>
+    Value get(const K& key, Value&& defaultValue) const;
+
+    /**
+     * Return true if key exists in dictionary.
+     *
+     * @param key key to be looked for
+     */
+    template <typename K = Key>
+    bool contains(const K& key) const;
+
+    /**
+     * Remove key and return its value.
+     *
+     * @param key key of item to be removed
+     * @throw KeyError key does not exist
+     */
+    template <typename K = Key>
+    Value pop(const K& key) throw(KeyError);
+
+    /**
+     * Remove key and return its value. If no such key exists, it returns
+     * instead the default value provided.
+     *
+     * @param key key of item to be removed
+     * @param defaultValue value returned when key is not found
+     */
+    template <typename K = Key>
+    Value pop(const K& key, const Value& defaultValue);
+
+    /**
+     * Return item at specified key, inserting default value first if key does
+     * not exist. The table is probed once.
+     *
+     * @param key key of item to be retrieved
+     * @param defaultValue value inserted when key is not found
+     */
+    template <typename K = Key>
+    Value& setDefault(const K& key, const Value& defaultValue = Value());
+
+    /**
+     * Insert or assign all items of another dictionary.
+     *
+     * @param other dictionary which items are copied
+     */
+    void update(const FlatDictionary& other);
+
+    /**
+     * Insert or assign items.
+     *
+     * @param items (key, value) pairs
+     */
+    void update(std::initializer_list<value_type> items);
+
+    /**
+     * Remove key if it exists.
+     *
+     * @param key key of item to be removed
+     * @return true if key was removed
+     */
+    template <typename K = Key>
+    bool erase(const K& key);
+
+    /**
+     * Insert a value built from arguments, unless key exists.
+     *
+     * The table is probed once and the value is only built if key does not
+     * exist, so that emplace and tryEmplace are the same.
+     *
+     * @param key key of item
+     * @param args arguments given to the constructor of Value
+     * @return true if item was inserted
+     */
+    template <typename K = Key, typename... Args>
+    bool emplace(const K& key, Args&&... args);
+
+    /**
+     * Insert a value built from arguments, unless key exists.
+     *
+     * Arguments given as rvalues are left untouched if key exists.
+     *
+     * @param key key of item
+     * @param args arguments given to the constructor of Value
+     * @return true if item was inserted
+     */
+    template <typename K = Key, typename... Args>
+    bool tryEmplace(const K& key, Args&&... args);
+
+    /**
+     * Return a list of all dictionary keys.
+     */
+    List<Key> keys() const;
+
+    /**
+     * Return a list of all dictionary values.
+     */
+    List<Value> values() const;
+
+private:
+
+    template <typename K, typename V, typename H, typename P>
+    friend class ConcurrentDictionary;
+    template <typename K, typename V, typename H, typename P>
+    friend class RcuDictionary;
+
+    /**
+     * Value returned by find when key is not found.
+     */
+    static const size_type npos = size_type(-1);
+
+    /**
+     * Smallest number of slots once allocated.
+     */
+    static const size_type minimumCapacity = detail::flatGroupSize;
+
+    /**
+     * Return mixed hash of key.
+     */
+    template <typename K>
+    std::uint64_t hashOf(const K& key) const;
+
+    /**
+     * Return slot of key, or npos.
+     */
+    template <typename K>
+    size_type find(const K& key, std::uint64_t hash) const;
+
+    /**
+     * Return slot of key converted into probe type, or npos.
+     */
+    template <typename K>
+    size_type lookup(const K& key) const;
+
+    /**
+     * Return slot of key, inserting a value built from args if key does not
+     * exist.
+     */
+    template <typename K, typename... Args>
+    size_type insert(const K& key, bool& inserted, Args&&... args);
+
+    /**
+     * Same as above, for a key already converted into probe type and its
+     * mixed hash.
+     */
+    template <typename K, typename... Args>
+    size_type insert(const K& probe, std::uint64_t hash, bool& inserted,
+                     Args&&... args);
+
+    /**
+     * Return first free slot of the probe sequence of hash.
+     */
+    size_type freeSlot(std::uint64_t hash) const;
+
+    /**
+     * Destroy pair of slot and mark it deleted.
+     */
+    void eraseSlot(size_type slot);
+
+    /**
+     * Set control byte of slot, and its copy past the end of table.
+     */
+    void setControl(size_type slot, signed char h2);
+
+    /**
+     * Move pairs into a table of given number of slots.
+     */
+    void rehash(size_type capacity);
+
+    /**
+     * Allocate empty table of given number of slots.
+     */
+    void allocate(size_type capacity);
+
+    /**
+     * Destroy pairs and release table.
+     */
+    void release();
+
+    /**
+     * Attributes
+     *
+     * m_control holds m_capacity + 15 bytes: the first 15 are copied at the
+     * end so that a group may be loaded from any slot without wrapping.
+     */
+    signed char* m_control;
+    value_type* m_slots;
+    size_type m_capacity;
+    size_type m_size;
+    size_type m_growthLeft;
+    Hash m_hash;
+    Pred m_pred;
+};
+
+//==============================================================================
+// FLATDICTIONARY DEFINITION
+//==============================================================================
+
+/*
+ * Constructors
+ */
+
+template <typename K, typename V, typename H, typename P>
+FlatDictionary<K, V, H, P>::FlatDictionary():
+    m_control(0), m_slots(0), m_capacity(0), m_size(0), m_growthLeft(0) { };
+
+template <typename K, typename V, typename H, typename P>
+FlatDictionary<K, V, H, P>::FlatDictionary(const FlatDictionary& other):
+    m_control(0), m_slots(0), m_capacity(0), m_size(0), m_growthLeft(0),
+    m_hash(other.m_hash), m_pred(other.m_pred)
+{
+    if (other.m_size == 0)
+        return;
+    //same layout as other: no hash is computed
+    allocate(other.m_capacity);
+    std::memcpy(m_control, other.m_control,
+                m_capacity + detail::flatGroupSize - 1);
+    size_type i = 0;
+    try
+    {
+        for (; i < m_capacity; ++i)
+            if (m_control[i] >= 0)
+                new (m_slots + i) value_type(other.m_slots[i]);
+    }
+    catch (...)
+    {
+        for (size_type j = 0; j < i; ++j)
+            if (m_control[j] >= 0)
+                m_slots[j].~value_type();
+        ::operator delete(m_slots);
+        delete[] m_control;
+        throw;
+    }
+    m_size = other.m_size;
+    m_growthLeft = other.m_growthLeft;
+}
+
+template <typename K, typename V, typename H, typename P>
+FlatDictionary<K, V, H, P>::FlatDictionary(FlatDictionary&& other) noexcept:
+    m_control(other.m_control), m_slots(other.m_slots),
+    m_capacity(other.m_capacity), m_size(other.m_size),
+    m_growthLeft(other.m_growthLeft), m_hash(other.m_hash),
+    m_pred(other.m_pred)
+{
+    other.m_control = 0;
+    other.m_slots = 0;
+    other.m_capacity = 0;
+    other.m_size = 0;
+    other.m_growthLeft = 0;
+}
+
+/*
+ * Assignment operators
+ */
+
+template <typename K, typename V, typename H, typename P>
+FlatDictionary<K, V, H, P>& FlatDictionary<K, V, H, P>::operator=(
+    const FlatDictionary& other)
+{
+    if (this != &other)
+    {
+        FlatDictionary tmp(other);
+        *this = std::move(tmp);
+    }
+    return *this;
+}
+
+template <typename K, typename V, typename H, typename P>
+FlatDictionary<K, V, H, P>& FlatDictionary<K, V, H, P>::operator=(
+    FlatDictionary&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        std::swap(m_control, other.m_control);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_growthLeft, other.m_growthLeft);
+        m_hash = other.m_hash;
+        m_pred = other.m_pred;
+    }
+    return *this;
+}
+
+/*
+ * Destructor
+ */
+
+template <typename K, typename V, typename H, typename P>
+FlatDictionary<K, V, H, P>::~FlatDictionary()
+{
+    release();
+}
+
+/*
+ * Method: size, capacity, reserve and clear
+ */
+
+template <typename K, typename V, typename H, typename P>
+typename FlatDictionary<K, V, H, P>::size_type
+FlatDictionary<K, V, H, P>::size() const
+{
+    return m_size;
+}
+
+template <typename K, typename V, typename H, typename P>
+typename FlatDictionary<K, V, H, P>::size_type
+FlatDictionary<K, V, H, P>::capacity() const
+{
+    return m_capacity;
+}
+
+template <typename K, typename V, typename H, typename P>
+void FlatDictionary<K, V, H, P>::reserve(size_type n)
+{
+    size_type capacity = minimumCapacity;
+    while (capacity - capacity / 8 < n)
+        capacity *= 2;
+    if (capacity > m_capacity)
+        rehash(capacity);
+}
+
+template <typename K, typename V, typename H, typename P>
+void FlatDictionary<K, V, H, P>::clear()
+{
+    if (m_capacity == 0)
+        return;
+    for (size_type i = 0; i < m_capacity; ++i)
+        if (m_control[i] >= 0)
+            m_slots[i].~value_type();
+    std::memset(m_control, detail::flatEmpty,
+                m_capacity + detail::flatGroupSize - 1);
+    m_size = 0;
+    m_growthLeft = m_capacity - m_capacity / 8;
+}
+
+/*
+ * method: operator[]
+ */
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+V& FlatDictionary<K, V, H, P>::operator[](const K2& key)
+{
+    bool inserted;
+    //insert may reallocate slots: call it before reading m_slots
+    size_type slot = insert(key, inserted);
+    return m_slots[slot].second;
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+const V& FlatDictionary<K, V, H, P>::operator[](const K2& key) const
+    throw(KeyError)
+{
+    size_type slot = lookup(key);
+    if (slot == npos)
+        THROW(KeyError, "key not found");
+    return m_slots[slot].second;
+}
+
+/*
+ * method: get
+ */
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+V& FlatDictionary<K, V, H, P>::get(const K2& key, V& defaultValue)
+{
+    size_type slot = lookup(key);
+    return slot == npos ? defaultValue : m_slots[slot].second;
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+V& FlatDictionary<K, V, H, P>::get(const K2& key, V&& defaultValue)
+{
+    size_type slot = lookup(key);
+    return slot == npos ? defaultValue : m_slots[slot].second;
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+V FlatDictionary<K, V, H, P>::get(const K2& key, V& defaultValue) const
+{
+    size_type slot = lookup(key);
+    return slot == npos ? defaultValue : m_slots[slot].second;
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+V FlatDictionary<K, V, H, P>::get(const K2& key, V&& defaultValue) const
+{
+    size_type slot = lookup(key);
+    return slot == npos ? defaultValue : m_slots[slot].second;
+}
+
+/*
+ * method: contains
+ */
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+bool FlatDictionary<K, V, H, P>::contains(const K2& key) const
+{
+    return lookup(key) != npos;
+}
+
+/*
+ * method: pop
+ */
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+V FlatDictionary<K, V, H, P>::pop(const K2& key) throw(KeyError)
+{
+    size_type slot = lookup(key);
+    if (slot == npos)
+        THROW(KeyError, "key not found");
+    V value(std::move(m_slots[slot].second));
+    eraseSlot(slot);
+    return value;
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+V FlatDictionary<K, V, H, P>::pop(const K2& key, const V& defaultValue)
+{
+    size_type slot = lookup(key);
+    if (slot == npos)
+        return defaultValue;
+    V value(std::move(m_slots[slot].second));
+    eraseSlot(slot);
+    return value;
+}
+
+/*
+ * method: setDefault
+ */
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+V& FlatDictionary<K, V, H, P>::setDefault(const K2& key, const V& defaultValue)
+{
+    bool inserted;
+    size_type slot = insert(key, inserted, defaultValue);
+    return m_slots[slot].second;
+}
+
+/*
+ * method: update
+ */
+
+template <typename K, typename V, typename H, typename P>
+void FlatDictionary<K, V, H, P>::update(const FlatDictionary& other)
+{
+    if (this == &other)
+        return;
+    for (size_type i = 0; i < other.m_capacity; ++i)
+        if (other.m_control[i] >= 0)
+            (*this)[other.m_slots[i].first] = other.m_slots[i].second;
+}
+
+template <typename K, typename V, typename H, typename P>
+void FlatDictionary<K, V, H, P>::update(std::initializer_list<value_type> items)
+{
+    for (const value_type& item: items)
+        (*this)[item.first] = item.second;
+}
+
+/*
+ * method: erase
+ */
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+bool FlatDictionary<K, V, H, P>::erase(const K2& key)
+{
+    size_type slot = lookup(key);
+    if (slot == npos)
+        return false;
+    eraseSlot(slot);
+    return true;
+}
+
+/*
+ * method: emplace and tryEmplace
+ */
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2, typename... Args>
+bool FlatDictionary<K, V, H, P>::emplace(const K2& key, Args&&... args)
+{
+    bool inserted;
+    insert(key, inserted, std::forward<Args>(args)...);
+    return inserted;
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2, typename... Args>
+bool FlatDictionary<K, V, H, P>::tryEmplace(const K2& key, Args&&... args)
+{
+    bool inserted;
+    insert(key, inserted, std::forward<Args>(args)...);
+    return inserted;
+}
+
+/*
+ * method: keys and values
+ */
+
+template <typename K, typename V, typename H, typename P>
+List<K> FlatDictionary<K, V, H, P>::keys() const
+{
+    List<K> output;
+    output.reserve(m_size);
+    for (size_type i = 0; i < m_capacity; ++i)
+        if (m_control[i] >= 0)
+            output.append(m_slots[i].first);
+    return output;
+}
+
+template <typename K, typename V, typename H, typename P>
+List<V> FlatDictionary<K, V, H, P>::values() const
+{
+    List<V> output;
+    output.reserve(m_size);
+    for (size_type i = 0; i < m_capacity; ++i)
+        if (m_control[i] >= 0)
+            output.append(m_slots[i].second);
+    return output;
+}
+
+/*
+ * private helpers
+ */
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+std::uint64_t FlatDictionary<K, V, H, P>::hashOf(const K2& key) const
+{
+    return detail::flatMix(m_hash(key));
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+typename FlatDictionary<K, V, H, P>::size_type
+FlatDictionary<K, V, H, P>::find(const K2& key, std::uint64_t hash) const
+{
+    if (m_capacity == 0)
+        return npos;
+    size_type mask = m_capacity - 1;
+    size_type pos = (hash >> 7) & mask;
+    signed char h2 = static_cast<signed char>(hash & 0x7f);
+    //triangular steps visit every group of a power of two table
+    for (size_type step = detail::flatGroupSize; ;
+         step += detail::flatGroupSize)
+    {
+        detail::FlatGroup group(m_control + pos);
+        for (unsigned bits = group.match(h2); bits; bits &= bits - 1)
+        {
+            size_type slot = (pos + __builtin_ctz(bits)) & mask;
+            if (m_pred(m_slots[slot].first, key))
+                return slot;
+        }
+        if (group.matchEmpty())
+            return npos;
+        pos = (pos + step) & mask;
+    }
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+typename FlatDictionary<K, V, H, P>::size_type
+FlatDictionary<K, V, H, P>::lookup(const K2& key) const
+{
+    typename detail::FlatProbe<K, K2, H, P>::type probe = key;
+    return find(probe, hashOf(probe));
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2, typename... Args>
+typename FlatDictionary<K, V, H, P>::size_type
+FlatDictionary<K, V, H, P>::insert(const K2& key, bool& inserted,
+                                   Args&&... args)
+{
+    typename detail::FlatProbe<K, K2, H, P>::type probe = key;
+    return insert(probe, hashOf(probe), inserted,
+                  std::forward<Args>(args)...);
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2, typename... Args>
+typename FlatDictionary<K, V, H, P>::size_type
+FlatDictionary<K, V, H, P>::insert(const K2& probe, std::uint64_t hash,
+                                   bool& inserted, Args&&... args)
+{
+    size_type slot = find(probe, hash);
+    inserted = slot == npos;
+    if (!inserted)
+        return slot;
+    if (m_capacity == 0)
+        rehash(minimumCapacity);
+    slot = freeSlot(hash);
+    if (m_control[slot] == detail::flatEmpty && m_growthLeft == 0)
+    {
+        //no slot left for growth: purge tombstones in place unless pairs
+        //fill more than 25/32 of the table
+        rehash(m_size * 32 <= m_capacity * 25 ? m_capacity : 2 * m_capacity);
+        slot = freeSlot(hash);
+    }
+    new (m_slots + slot) value_type(std::piecewise_construct,
+        std::forward_as_tuple(probe),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    if (m_control[slot] == detail::flatEmpty)
+        --m_growthLeft;
+    setControl(slot, static_cast<signed char>(hash & 0x7f));
+    ++m_size;
+    return slot;
+}
+
+template <typename K, typename V, typename H, typename P>
+typename FlatDictionary<K, V, H, P>::size_type
+FlatDictionary<K, V, H, P>::freeSlot(std::uint64_t hash) const
+{
+    size_type mask = m_capacity - 1;
+    size_type pos = (hash >> 7) & mask;
+    for (size_type step = detail::flatGroupSize; ;
+         step += detail::flatGroupSize)
+    {
+        unsigned bits = detail::FlatGroup(m_control + pos).matchFree();
+        if (bits)
+            return (pos + __builtin_ctz(bits)) & mask;
+        pos = (pos + step) & mask;
+    }
+}
+
+template <typename K, typename V, typename H, typename P>
+void FlatDictionary<K, V, H, P>::eraseSlot(size_type slot)
+{
+    m_slots[slot].~value_type();
+    setControl(slot, detail::flatDeleted);
+    --m_size;
+}
+
+template <typename K, typename V, typename H, typename P>
+void FlatDictionary<K, V, H, P>::setControl(size_type slot, signed char h2)
+{
+    m_control[slot] = h2;
+    if (slot < detail::flatGroupSize - 1)
+        m_control[m_capacity + slot] = h2;
+}
+
+template <typename K, typename V, typename H, typename P>
+void FlatDictionary<K, V, H, P>::rehash(size_type capacity)
+{
+    signed char* control = m_control;
+    value_type* slots = m_slots;
+    size_type oldCapacity = m_capacity;
+    allocate(capacity);
+    for (size_type i = 0; i < oldCapacity; ++i)
+    {
+        if (control[i] < 0)
+            continue;
+        std::uint64_t hash = hashOf(slots[i].first);
+        size_type slot = freeSlot(hash);
+        new (m_slots + slot) value_type(std::move(slots[i]));
+        setControl(slot, static_cast<signed char>(hash & 0x7f));
+        slots[i].~value_type();
+    }
+    m_growthLeft = m_capacity - m_capacity / 8 - m_size;
+    ::operator delete(slots);
+    delete[] control;
+}
+
+template <typename K, typename V, typename H, typename P>
+void FlatDictionary<K, V, H, P>::allocate(size_type capacity)
+{
+    value_type* slots = static_cast<value_type*>(
+        ::operator new(capacity * sizeof(value_type)));
+    signed char* control;
+    try
+    {
+        control = new signed char[capacity + detail::flatGroupSize - 1];
+    }
+    catch (...)
+    {
+        ::operator delete(slots);
+        throw;
+    }
+    std::memset(control, detail::flatEmpty,
+                capacity + detail::flatGroupSize - 1);
+    m_control = control;
+    m_slots = slots;
+    m_capacity = capacity;
+    m_growthLeft = capacity - capacity / 8;
+}
+
+template <typename K, typename V, typename H, typename P>
+void FlatDictionary<K, V, H, P>::release()
+{
+    for (size_type i = 0; i < m_capacity; ++i)
+        if (m_control[i] >= 0)
+            m_slots[i].~value_type();
+    ::operator delete(m_slots);
+    delete[] m_control;
+    m_control = 0;
+    m_slots = 0;
+    m_capacity = 0;
+    m_size = 0;
+    m_growthLeft = 0;
+}
+
+} //end of namespace snowball
+
+#endif
@@ -23,8 +23,61 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef SNOWBALL_HASH_HPP
 #define SNOWBALL_HASH_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+
 namespace snowball
 {  
+/**
+ * Hash a contiguous block of bytes.
+ * 
+ * Bytes are read as 64-bit words in four independent lanes, which are then 
+ * mixed together with the size. Two blocks with the same bytes have the same
+ * hash.
+ * 
+ * @param data beginning of block
+ * @param size number of bytes
+ * @returns hash of block
+ */
+inline size_t hashBytes(const void* data, size_t size)
+{
+    const std::uint64_t k1 = 0x9e3779b97f4a7c15ULL;
+    const std::uint64_t k2 = 0xff51afd7ed558ccdULL;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    std::uint64_t lanes[4] = {k1, k2, ~k1, ~k2};
+    std::uint64_t word;
+    size_t n = size;
+    for (; n >= 32; n -= 32, p += 32)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            std::memcpy(&word, p + 8 * i, 8);
+            lanes[i] = (lanes[i] ^ word) * k1;
+            lanes[i] ^= lanes[i] >> 31;
+        }
+    }
+    std::uint64_t h = std::uint64_t(size) * k2;
+    for (int i = 0; i < 4; ++i)
+        h = (h ^ lanes[i]) * k1;
+    for (; n >= 8; n -= 8, p += 8)
+    {
+        std::memcpy(&word, p, 8);
+        h = (h ^ word) * k1;
+        h ^= h >> 31;
+    }
+    word = 0;
+    if (n > 0)
+        std::memcpy(&word, p, n);
+    h = (h ^ word) * k2;
+    h ^= h >> 33;
+    h *= k1;
+    h ^= h >> 29;
+    return size_t(h);
+}
+
 /**
  * This class provides a default hash function to all objects for which 
  * std::hash has not been specialized. This hash function performance is not 
@@ -38,6 +91,12 @@ namespace snowball
 template <typename T>
 struct Hash
 {
+    /**
+     * @typedef bytewise
+     * only defined by this generic version, which hashes the bytes of T
+     */
+    typedef void bytewise;
+    
     /**
      * Operator()
      * 
@@ -127,6 +186,28 @@ struct Hash<std::string>
     };
 };
 
+/**
+ * Hash functor to be used by default for T: Hash<T> when it has been 
+ * specialized, std::hash<T> otherwise.
+ * 
+ * Unlike the generic Hash<T>, std::hash<T> agrees with operator== for types
+ * which bytes do not identify their value (-0.0 and 0.0, padded structures, 
+ * types owning heap memory...).
+ * 
+ * @tparam T object to be hashed
+ */
+template <typename T, typename = void>
+struct DefaultHash
+{
+    typedef Hash<T> type;
+};
+
+template <typename T>
+struct DefaultHash<T, typename Hash<T>::bytewise>
+{
+    typedef std::hash<T> type;
+};
+
 } //end of snowball namespace
 
 #endif
\ No newline at end of file
@@ -26,13 +26,57 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <vector>
 #include <stdexcept>
 #include <algorithm>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+#include <functional>
+#include <unordered_set>
+#include <cstring>
 
 #include "snowball/exceptions/exceptions.h"
+#include "check_policy.hpp"
+#include "hash.hpp"
+#include "traits.hpp"
+#include "relocatable_vector.hpp"
+#include "list_view.hpp"
+#include "timsort.hpp"
+#include "radix_sort.hpp"
+#include "simd_search.h"
+#include "snowball/concurrency/parallel_sort.hpp"
 #include "iterator.h"
 
 
 namespace snowball
 {
+
+namespace detail
+{
+
+/**
+ * @brief Storage of List items.
+ *
+ * Items which are trivially relocatable (and not over-aligned) are stored in
+ * a RelocatableVector growing with realloc when the allocator is the default
+ * one. Other items are stored in a std::vector.
+ */
+template <typename T, typename Alloc>
+struct ListStorage
+{
+    typedef typename std::conditional<
+        std::is_same<Alloc, std::allocator<T> >::value &&
+        TriviallyRelocatable<T>::value &&
+        alignof(T) <= alignof(std::max_align_t),
+        RelocatableVector<T>, std::vector<T, Alloc> >::type type;
+};
+
+} //end of namespace detail
+
+//Forward declaration of ListConcatenation template
+template <typename ListType, typename Left, typename Right> 
+class ListConcatenation;
+
+//Forward declaration of ConcurrentList template
+template <typename T> class ConcurrentList;
     
 //==============================================================================
 // LIST DECLARATION
@@ -41,16 +85,24 @@ namespace snowball
 /**
  * @brief Implements a list on top of std::vector.
  * 
+ * With the default allocator, items for which TriviallyRelocatable holds 
+ * (integers, floating point numbers, PODs...) are stored in a 
+ * RelocatableVector instead: growth reallocates the buffer with realloc 
+ * rather than moving items one by one into a new buffer.
+ * 
  * @tparam T type of items in the list
  * @tparam Alloc allocator to use for items
+ * @tparam CheckPolicy index check policy of operator[]: PythonCheck (default),
+ * DebugCheck or NoCheck
  * 
  * @warning index of std::vector is an unsigned integer of type 
  * std::vector::size_type. As list accepts negative index those methods take 
  * a long integer as input.
  * 
- * @note due to systematic index range check, operator[] method is slower than
- * the one from std::vector. In case you need a fast operator[] consider using 
- * a std::vector instead.
+ * @note with the default PythonCheck policy, operator[] checks index range and
+ * throws IndexError. In tight loops where indices are known to be valid, 
+ * consider UncheckedList (no check) or DebugList (assert only) which index as 
+ * fast as a std::vector.
  * 
  * Fast methods of list:
  * - List<T, Alloc>::append
@@ -67,53 +119,61 @@ namespace snowball
  * - List<T, Alloc>::insert
  * - List<T, Alloc>::remove
  */
-template <typename T, typename Alloc = std::allocator<T> >
+template <typename T, 
+          typename Alloc = std::allocator<T>, 
+          typename CheckPolicy = PythonCheck>
 class List
 {
     
     public:
     
+    /**
+     * @typedef storage_type
+     * container in which items are stored
+     */
+    typedef typename detail::ListStorage<T, Alloc>::type storage_type;
+    
     /**
      * @typedef size_type
      * size type for list
      */
-    typedef typename std::vector<T, Alloc>::size_type size_type;
+    typedef typename storage_type::size_type size_type;
     
     /**
      * @typedef value_type
      * value type of list
      */    
-    typedef typename std::vector<T, Alloc>::value_type value_type;
+    typedef typename storage_type::value_type value_type;
     
     /**
      * @typedef allocator_type
      * allocator type of list
      */
-    typedef typename std::vector<T, Alloc>::allocator_type allocator_type;
+    typedef typename storage_type::allocator_type allocator_type;
     
     /**
      * @typedef iterator
      * a random access iterator to List<T, Alloc>::value_type
      */
-    typedef typename std::vector<T, Alloc>::iterator iterator;
+    typedef typename storage_type::iterator iterator;
     
     /**
      * @typedef const_iterator
      * a random access iterator to const List<T, Alloc>::value_type
      */
-    typedef typename std::vector<T, Alloc>::const_iterator const_iterator;
+    typedef typename storage_type::const_iterator const_iterator;
 
     /**
      * @typedef reverse_iterator
      * a random access reverse iterator to List<T, Alloc>::value_type
      */
-    typedef typename std::vector<T, Alloc>::reverse_iterator reverse_iterator;
+    typedef typename storage_type::reverse_iterator reverse_iterator;
     
     /**
      * @typedef const_reverse_iterator
      * a random access reverse iterator to const List<T, Alloc>::value_type
      */
-    typedef typename std::vector<T, Alloc>::const_reverse_iterator const_reverse_iterator;
+    typedef typename storage_type::const_reverse_iterator const_reverse_iterator;
 
     /**
      * @typedef index_type
@@ -184,6 +244,25 @@ class List
     List(const std::vector<T, Alloc>& vect, 
          const allocator_type& alloc = allocator_type());
     
+    /**
+     * Constructor
+     * 
+     * Creates a list from the items of an existing vector, which is left 
+     * empty. When items are stored in a std::vector, its buffer is stolen and
+     * no item is copied. When they are stored in a RelocatableVector (the 
+     * default for numbers and other trivially relocatable items), the buffer
+     * cannot be taken over and items are copied into a new one.
+     * 
+     * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * std::vector<std::string> vect = {"a", "b"};
+     * List<std::string> list(std::move(vect));
+     * //list contains {"a", "b"}, no string is copied
+     * ~~~~~~~~~~~~~~~~~~~~~
+     * 
+     * @param vect existing vector
+     */
+    List(std::vector<T, Alloc>&& vect);
+    
     /**
      * Copy constructor
      * 
@@ -195,7 +274,7 @@ class List
      * 
      * @param other existing list
      */
-    List(const List<T, Alloc>& other);
+    List(const List<T, Alloc, CheckPolicy>& other);
     
     /**
      * Copy constructor with allocator
@@ -210,7 +289,38 @@ class List
      * @param other existing list
      * @param alloc allocator to use for items
      */
-    List(const List<T, Alloc>& other, const allocator_type& alloc);
+    List(const List<T, Alloc, CheckPolicy>& other, const allocator_type& alloc);
+    
+    /**
+     * Move constructor
+     * 
+     * The buffer of the other list is stolen: no item is copied and the other 
+     * list is left empty.
+     * 
+     * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * List<int> list1 = {0, 2, 4, 6};
+     * List<int> list2(std::move(list1));
+     * //list2 contains {0, 2, 4, 6}
+     * ~~~~~~~~~~~~~~~~~~~~~
+     * 
+     * @param other existing list
+     */
+    List(List<T, Alloc, CheckPolicy>&& other) noexcept;
+    
+    /**
+     * Constructor from a concatenation of lists.
+     * 
+     * Items of all lists are copied once, in a buffer allocated to the exact
+     * size of the concatenation.
+     * 
+     * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * List<int> list = list1 + list2 + list3;
+     * ~~~~~~~~~~~~~~~~~~~~~
+     * 
+     * @param expr concatenation of lists
+     */
+    template <typename Left, typename Right>
+    List(const ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right>& expr);
         
     /**
      * Destructor
@@ -229,7 +339,23 @@ class List
      * 
      * @param other existing list
      */
-    List<T, Alloc>& operator=(const List<T, Alloc>& other);
+    List<T, Alloc, CheckPolicy>& operator=(const List<T, Alloc, CheckPolicy>& other);
+    
+    /**
+     * Move assignment operator with another list
+     * 
+     * The buffer of the other list is stolen: no item is copied.
+     * 
+     * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * List<int> list1 = {0, 2, 4, 6};
+     * List<int> list2 = {1, 2, 3};
+     * list2 = std::move(list1);
+     * //list2 contains {0, 2, 4, 6}
+     * ~~~~~~~~~~~~~~~~~~~~~
+     * 
+     * @param other existing list
+     */
+    List<T, Alloc, CheckPolicy>& operator=(List<T, Alloc, CheckPolicy>&& other) noexcept;
     
     /**
      * Assignment operator with a vector
@@ -243,7 +369,7 @@ class List
      * 
      * @param vect existing vector
      */
-    List<T, Alloc>& operator=(const std::vector<T, Alloc>& vect);
+    List<T, Alloc, CheckPolicy>& operator=(const std::vector<T, Alloc>& vect);
     
     /**
      * Assignment operator from an initializer list
@@ -256,7 +382,17 @@ class List
      * 
      * @param il initializer list
      */
-    List<T, Alloc>& operator=(std::initializer_list<T> il);
+    List<T, Alloc, CheckPolicy>& operator=(std::initializer_list<T> il);
+    
+    /**
+     * Assignment operator from a concatenation of lists.
+     * 
+     * The concatenation may refer to current list.
+     * 
+     * @param expr concatenation of lists
+     */
+    template <typename Left, typename Right>
+    List<T, Alloc, CheckPolicy>& operator=(const ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right>& expr);
     
     /**
      * Return list size
@@ -270,6 +406,13 @@ class List
      */
     size_type size() const;
     
+    /**
+     * Make sure the list can hold given number of items without reallocating.
+     * 
+     * @param capacity number of items
+     */
+    void reserve(size_type capacity);
+    
     /**
      * Return an item from the list at specified index.
      * 
@@ -285,7 +428,7 @@ class List
      * ~~~~~~~~~~~~~~~~~~~~~
      * 
      * @param index index of item
-     * @throw IndexError if index is out of range
+     * @throw IndexError if index is out of range (PythonCheck policy only)
      */
     T& operator[](long index) throw(IndexError);
     
@@ -303,7 +446,7 @@ class List
      * ~~~~~~~~~~~~~~~~~~~~~
      * 
      * @param index index of item
-     * @throw IndexError if index is out of range
+     * @throw IndexError if index is out of range (PythonCheck policy only)
      */
     const T& operator[](long index) const throw(IndexError);
     
@@ -314,6 +457,8 @@ class List
      * index are all the same, lists are considered to be equal.
      * 
      * T list parameter shall implement operator!= for that method to be used.
+     * When TriviallyComparable<T> holds, storages are compared with memcmp 
+     * instead.
      * 
      * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
      * List<int> list1 = {1, 3, 5, 7};
@@ -326,7 +471,42 @@ class List
      * @param other list to be compared to
      * @return true if both lists are equal
      */
-    bool operator==(const List<T, Alloc>& other) const;
+    bool operator==(const List<T, Alloc, CheckPolicy>& other) const;
+    
+    /**
+     * Return a view over a slice of the list.
+     * 
+     * Start, stop and step follow Python slicing semantics, including 
+     * negative indices and negative steps. Slice::none stands for an omitted 
+     * value. No item is copied: the view refers to the items of the list.
+     * 
+     * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * List<int> list = {0, 1, 2, 3, 4, 5};
+     * list.slice(1, 4);                        //list[1:4] is {1, 2, 3}
+     * list.slice(-2);                          //list[-2:] is {4, 5}
+     * list.slice(Slice::none, Slice::none, -2); //list[::-2] is {5, 3, 1}
+     * list.slice(1, 4).erase();                //del list[1:4]
+     * ~~~~~~~~~~~~~~~~~~~~~
+     * 
+     * @param start first index
+     * @param stop index after the last one
+     * @param step step between indices
+     * @throw ValueError if step is zero
+     */
+    MutableListView< List<T, Alloc, CheckPolicy> > 
+    slice(long start, long stop = Slice::none, long step = 1) throw(ValueError);
+    
+    /**
+     * Return a read-only view over a slice of the list.
+     * 
+     * @param start first index
+     * @param stop index after the last one
+     * @param step step between indices
+     * @throw ValueError if step is zero
+     */
+    ListView<const T> 
+    slice(long start, long stop = Slice::none, long step = 1) const 
+        throw(ValueError);
 
     /**
      * Append an item to the end of the list
@@ -337,6 +517,32 @@ class List
      */
     void append(const T& item);
     
+    /**
+     * Append an item to the end of the list
+     * 
+     * The item is moved into the list instead of being copied.
+     * 
+     * @param item item to be append
+     */
+    void append(T&& item);
+    
+    /**
+     * Construct an item in place at the end of the list
+     * 
+     * Arguments are forwarded to the constructor of T so that no temporary 
+     * item is built.
+     * 
+     * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * List<std::string> list;
+     * list.emplace(3, 'a');
+     * //list contains {"aaa"}
+     * ~~~~~~~~~~~~~~~~~~~~~
+     * 
+     * @param args arguments of the constructor of T
+     */
+    template <typename... Args>
+    void emplace(Args&&... args);
+    
     /**
      * Insert an item in the list before specified index
      * 
@@ -359,6 +565,16 @@ class List
      */
     void insert(long index, const T& item);
     
+    /**
+     * Insert an item in the list before specified index
+     * 
+     * Same as List<T, Alloc>::insert but the item is moved into the list.
+     * 
+     * @param index index where item is going to be inserted
+     * @param item item to be inserted
+     */
+    void insert(long index, T&& item);
+    
     /**
      * Insert another list before specified index.
      * 
@@ -375,7 +591,19 @@ class List
      * @param index index where item is going to be inserted
      * @param other other list to be inserted into current one
      */
-    void insert(long index, const List<T, Alloc>& other);
+    void insert(long index, const List<T, Alloc, CheckPolicy>& other);
+    
+    /**
+     * Insert a concatenation of lists before specified index.
+     * 
+     * Index is applied as in List<T, Alloc>::insert(long, const List&). Items 
+     * are copied once, without building the concatenation first.
+     * 
+     * @param index index where items are going to be inserted
+     * @param expr concatenation of lists
+     */
+    template <typename Left, typename Right>
+    void insert(long index, const ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right>& expr);
     
     /**
      * Check wether a given item is in the list
@@ -408,14 +636,35 @@ class List
      * @param item to be looked for
      * @throw ValueError if item is not in list
      */
-    size_type index(const T item) const throw(ValueError);
+    size_type index(const T& item) const throw(ValueError);
+    
+    /**
+     * Extend the content of current list by the one of provided list.
+     * 
+     * @param list list used to extend current one
+     */
+    void extend(const List<T, Alloc, CheckPolicy>& other);
     
     /**
      * Extend the content of current list by the one of provided list.
      * 
+     * Items of the other list are moved instead of being copied. If current
+     * list is empty, the buffer of the other list is stolen. The other list is
+     * left empty, unless it is current list which items are then duplicated.
+     * 
      * @param list list used to extend current one
      */
-    void extend(const List<T, Alloc>& other);
+    void extend(List<T, Alloc, CheckPolicy>&& other);
+    
+    /**
+     * Extend the content of current list by a concatenation of lists.
+     * 
+     * The list grows once to its final size.
+     * 
+     * @param expr concatenation of lists
+     */
+    template <typename Left, typename Right>
+    void extend(const ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right>& expr);
     
     /**
      * Operator+=
@@ -424,26 +673,157 @@ class List
      * 
      * @param list list used to extend current one
      */
-    void operator+=(const List<T, Alloc>& other);
+    void operator+=(const List<T, Alloc, CheckPolicy>& other);
+    
+    /**
+     * Operator+=
+     * 
+     * This methods does exactly the same than List<T, Alloc>::extend with a 
+     * temporary list: items are moved.
+     * 
+     * @param list list used to extend current one
+     */
+    void operator+=(List<T, Alloc, CheckPolicy>&& other);
+    
+    /**
+     * Operator+=
+     * 
+     * This methods does exactly the same than List<T, Alloc>::extend with a 
+     * concatenation of lists.
+     * 
+     * @param expr concatenation of lists
+     */
+    template <typename Left, typename Right>
+    void operator+=(const ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right>& expr);
+    
+    /**
+     * Operator+
+     * 
+     * This method returns the concatenation of current list and the second
+     * one. The concatenation is lazy: no item is copied until it is converted
+     * to a List, so that a + b + c + d allocates and copies items once.
+     * 
+     * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * List<int> list1 = {0, 1};
+     * List<int> list2 = {2};
+     * List<int> list3 = list1 + list2 + list1; //list3 is {0, 1, 2, 0, 1}
+     * for (int item: list1 + list2) {}         //iterates over 0, 1, 2
+     * ~~~~~~~~~~~~~~~~~~~~~
+     * 
+     * @warning the concatenation refers to the lists it is made of: it must
+     * not outlive them and it follows their later changes. 
+     * `auto c = a + b;` keeps a concatenation, not a List: write 
+     * `List<T> c = a + b;` to get a list of its own.
+     * 
+     * @param other list to be concatenated to current list
+     */
+    ListConcatenation<List<T, Alloc, CheckPolicy>, List<T, Alloc, CheckPolicy>, List<T, Alloc, CheckPolicy> > 
+    operator+(const List<T, Alloc, CheckPolicy>& other) const &;
+    
+    /**
+     * Operator+
+     * 
+     * A temporary list cannot be referred to by a lazy concatenation: the
+     * result is built at once. Items of current list are copied and items of
+     * the other list are moved.
+     * 
+     * @param other temporary list to be concatenated to current list
+     */
+    List<T, Alloc, CheckPolicy> operator+(List<T, Alloc, CheckPolicy>&& other) const &;
+    
+    /**
+     * Operator+
+     * 
+     * Lazy concatenation of current list and a concatenation of lists.
+     * 
+     * @param expr concatenation to be concatenated to current list
+     */
+    template <typename Left, typename Right>
+    ListConcatenation<List<T, Alloc, CheckPolicy>, List<T, Alloc, CheckPolicy>, ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right> > 
+    operator+(const ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right>& expr) const &;
+    
+    /**
+     * Operator+
+     * 
+     * When current list is a temporary, its buffer is reused for the result
+     * instead of being copied. Chained concatenations such as a + b + c then 
+     * only copy each item once.
+     * 
+     * @param other list to be extended to current list
+     */
+    List<T, Alloc, CheckPolicy> operator+(const List<T, Alloc, CheckPolicy>& other) &&;
+    
+    /**
+     * Operator+
+     * 
+     * When both lists are temporaries, the buffer of current list is reused
+     * and items of the other list are moved.
+     * 
+     * @param other temporary list to be concatenated to current list
+     */
+    List<T, Alloc, CheckPolicy> operator+(List<T, Alloc, CheckPolicy>&& other) &&;
     
     /**
      * Operator+
      * 
-     * This method return a new list that is a copy of current list extended 
-     * by the items of the second list.
+     * When current list is a temporary, it is extended by the concatenation
+     * instead of being referred to.
      * 
-     * @param other list to be extended to the copy of current list
+     * @param expr concatenation to be concatenated to current list
      */
-    List<T, Alloc> operator+(const List<T, Alloc>& other) const;
+    template <typename Left, typename Right>
+    List<T, Alloc, CheckPolicy> operator+(const ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right>& expr) &&;
     
     /**
      * Remove the first item in the list with specified value.
      * 
+     * Items after the removed one are moved: to remove many items, prefer 
+     * removeIf, removeAll or removeMany which compact the list in one pass.
+     * 
      * @param item item to be removed from the list
      * @throw ValueError if item is not in list
      */
     void remove(const T& item) throw(ValueError);
 
+    /**
+     * Remove all items for which predicate returns true.
+     * 
+     * Items are compacted in a single pass, keeping their order.
+     * 
+     * @tparam Predicate callable taking a const T& and returning a bool
+     * @param pred predicate
+     * @return number of removed items
+     */
+    template <typename Predicate>
+    size_type removeIf(const Predicate& pred);
+
+    /**
+     * Remove all items equal to given item.
+     * 
+     * @param item item to be removed from the list
+     * @return number of removed items
+     */
+    size_type removeAll(const T& item);
+
+    /**
+     * Remove all items equal to any item of another list.
+     * 
+     * Items are compacted in a single pass. When there are more than a few 
+     * items to be removed, they are put in a hash set so that each item of 
+     * the list is probed in constant time: T must then be hashable by Hash.
+     * 
+     * By default, items are hashed by Hash<T> when it is specialized (int, 
+     * long, std::string, String, List...) and by std::hash<T> otherwise.
+     * 
+     * @tparam HashType hash functor of T
+     * @param items items to be removed from the list
+     * @param hash hash functor
+     * @return number of removed items
+     */
+    template <typename HashType = typename DefaultHash<T>::type>
+    size_type removeMany(const List<T, Alloc, CheckPolicy>& items, 
+                         const HashType& hash = HashType());
+
     /**
      * Count number of occurences of given item.
      * 
@@ -463,6 +843,11 @@ class List
      * 
      * This method uses the operator< of T and cannot be used if this operator 
      * is not defined.
+     * 
+     * Lists of integers, float, double and String are sorted with a radix 
+     * sort which scratch memory is taken from the list allocator.
+     * 
+     * @see RadixSorter
      */
     void sort();
     
@@ -485,6 +870,109 @@ class List
      */
     template <typename Compare>
     void sort(const Compare& functor);
+    
+    /**
+     * Sort list using several threads.
+     * 
+     * Lists smaller than the threshold of policy are sorted sequentially.
+     * 
+     * @param policy thread count and threshold
+     * @see parallelSort
+     */
+    void sort(const Parallel& policy);
+    
+    /**
+     * Sort list using several threads and a function provided as argument.
+     * 
+     * @param funcptr sorting function
+     * @param policy thread count and threshold
+     */
+    void sort(bool (*funcptr)(const T&, const T&), const Parallel& policy);
+    
+    /**
+     * Sort list using several threads and a functor provided as argument.
+     * 
+     * The functor is shared between threads and must be safe to call 
+     * concurrently.
+     * 
+     * @param functor sorting functor of type Compare
+     * @param policy thread count and threshold
+     */
+    template <typename Compare>
+    void sort(const Compare& functor, const Parallel& policy);
+    
+    /**
+     * Sort list keeping the order of equal items.
+     * 
+     * This is Python list.sort algorithm (Timsort): it is adaptive and runs 
+     * in linear time on sorted, reverse-sorted or nearly sorted lists. It 
+     * uses the operator< of T.
+     * 
+     * @see stableSort(RandomIt, RandomIt, const Compare&)
+     */
+    void stableSort();
+    
+    /**
+     * Sort list keeping the order of equal items.
+     * 
+     * This method uses a function provided as argument.
+     * 
+     * @param funcptr sorting function
+     */
+    void stableSort(bool (*funcptr)(const T&, const T&));
+    
+    /**
+     * Sort list keeping the order of equal items.
+     * 
+     * This method uses a functor object provided as argument.
+     * The functor object must have an operator() method.
+     * 
+     * @param functor sorting functor of type Compare
+     */
+    template <typename Compare>
+    void stableSort(const Compare& functor);
+    
+    /**
+     * Sort list on a key computed from each item.
+     * 
+     * This is Python list.sort(key=..., reverse=...): key is called exactly 
+     * once per item, keys are sorted with their position (stableSort) and 
+     * items are then moved in place following the resulting permutation. 
+     * Items of equal keys keep their relative order, even when reversed.
+     * 
+     * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * List<String> names = {"bob", "Alice", "carol"};
+     * names.sort([](const String& name) { return name.lower(); }, false);
+     * ~~~~~~~~~~~~~~~~~~~~~
+     * 
+     * Key may be any callable taking a const T& and returning a type with an
+     * operator<. The reverse argument cannot be defaulted since sort(key) 
+     * would be the comparator overload.
+     * 
+     * If key throws, the exception is propagated and the list is unchanged.
+     * 
+     * @tparam KeyFunc type of key callable
+     * @param key function computing the sorting key of an item
+     * @param reverse sort in descending order of keys
+     */
+    template <typename KeyFunc>
+    void sort(const KeyFunc& key, bool reverse);
+    
+    /**
+     * Sort list on a key computed from each item, computing keys in 
+     * parallel.
+     * 
+     * Same as sort(key, reverse) but keys are computed by several threads. 
+     * Key must be safe to call concurrently and its return type must be 
+     * default constructible.
+     * 
+     * @tparam KeyFunc type of key callable
+     * @param key function computing the sorting key of an item
+     * @param reverse sort in descending order of keys
+     * @param policy thread count and threshold
+     */
+    template <typename KeyFunc>
+    void sort(const KeyFunc& key, bool reverse, const Parallel& policy);
         
     /**
      * Iterator to the begin of the list.
@@ -534,118 +1022,176 @@ class List
     
     private:
     
-    std::vector<T, Alloc> m_vector;
+    template <typename ListType> friend class MutableListView;
+    template <typename U> friend class ConcurrentList;
+    
+    /**
+     * Sort (key, position) pairs and permute items accordingly.
+     */
+    template <typename Key>
+    void sortDecorated(std::vector< std::pair<Key, size_type> >& decorated, 
+                       bool reverse);
+    
+    storage_type m_vector;
     
 }; // end of List class
 
+/**
+ * @typedef UncheckedList
+ * List which operator[] does not check index range.
+ */
+template <typename T, typename Alloc = std::allocator<T> >
+using UncheckedList = List<T, Alloc, NoCheck>;
+
+/**
+ * @typedef DebugList
+ * List which operator[] checks index range with assert only.
+ */
+template <typename T, typename Alloc = std::allocator<T> >
+using DebugList = List<T, Alloc, DebugCheck>;
+
 //==============================================================================
 // LIST DEFINITION
 //==============================================================================
 
 //Constructor
 
-template <typename T, typename Alloc>
-List<T, Alloc>::List(const allocator_type& alloc) 
-{ }
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy>::List(const allocator_type& alloc): m_vector(alloc) { };
 
-template <typename T, typename Alloc>
-List<T, Alloc>::List(std::initializer_list<T> il, 
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy>::List(std::initializer_list<T> il, 
                      const allocator_type& alloc): m_vector(il, alloc) { };
 
-template <typename T, typename Alloc>
-List<T, Alloc>::List(size_type n, const T& v, const allocator_type& alloc): 
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy>::List(size_type n, const T& v, const allocator_type& alloc): 
     m_vector(n, v, alloc) { };
 
-template <typename T, typename Alloc>
-List<T, Alloc>::List(const std::vector<T, Alloc>& vect, 
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy>::List(const std::vector<T, Alloc>& vect, 
                      const allocator_type& alloc): m_vector(vect, alloc) { };
 
-template <typename T, typename Alloc>
-List<T, Alloc>::List(const List<T, Alloc>& other): m_vector(other.m_vector) { };
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy>::List(std::vector<T, Alloc>&& vect): 
+    m_vector(std::move(vect)) { };
 
-template <typename T, typename Alloc>
-List<T, Alloc>::List(const List<T, Alloc>& other, const allocator_type& alloc): 
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy>::List(const List<T, Alloc, CheckPolicy>& other): m_vector(other.m_vector) { };
+
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy>::List(const List<T, Alloc, CheckPolicy>& other, const allocator_type& alloc): 
     m_vector(other.m_vector, alloc) { };
 
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy>::List(List<T, Alloc, CheckPolicy>&& other) noexcept: 
+    m_vector(std::move(other.m_vector)) { };
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename Left, typename Right>
+List<T, Alloc, CheckPolicy>::List(const ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right>& expr)
+{
+    m_vector.reserve(expr.size());
+    expr.appendTo(*this);
+}
+
 //Assignment operator
     
-template <typename T, typename Alloc>
-List<T, Alloc>& List<T, Alloc>::operator=(const List<T, Alloc>& other)
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy>& List<T, Alloc, CheckPolicy>::operator=(const List<T, Alloc, CheckPolicy>& other)
 {
     if (this != &other)
         m_vector = other.m_vector;
     return *this;
 }
 
-template <typename T, typename Alloc>
-List<T, Alloc>& List<T, Alloc>::operator=(const std::vector<T, Alloc>& vect)
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy>& List<T, Alloc, CheckPolicy>::operator=(List<T, Alloc, CheckPolicy>&& other) noexcept
+{
+    if (this != &other)
+        m_vector = std::move(other.m_vector);
+    return *this;
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy>& List<T, Alloc, CheckPolicy>::operator=(const std::vector<T, Alloc>& vect)
 {
     m_vector = vect;
     return *this;
 }
 
-template <typename T, typename Alloc>
-List<T, Alloc>& List<T, Alloc>::operator=(std::initializer_list<T> il)
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy>& List<T, Alloc, CheckPolicy>::operator=(std::initializer_list<T> il)
 {
     m_vector = il;
     return *this;
 }
 
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename Left, typename Right>
+List<T, Alloc, CheckPolicy>& List<T, Alloc, CheckPolicy>::operator=(const ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right>& expr)
+{
+    if (expr.refersTo(*this))
+    {
+        List<T, Alloc, CheckPolicy> items(expr);
+        m_vector.swap(items.m_vector);
+        return *this;
+    }
+    m_vector.clear();
+    m_vector.reserve(expr.size());
+    expr.appendTo(*this);
+    return *this;
+}
+
 //Destructor
 
-template <typename T, typename Alloc>
-List<T, Alloc>::~List() { }
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy>::~List() { }
 
 //size method
 
-template <typename T, typename Alloc>
-typename List<T, Alloc>::size_type List<T, Alloc>::size() const
+template <typename T, typename Alloc, typename CheckPolicy>
+typename List<T, Alloc, CheckPolicy>::size_type List<T, Alloc, CheckPolicy>::size() const
 {
     return m_vector.size();
 }
 
+//reserve method
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::reserve(size_type capacity)
+{
+    m_vector.reserve(capacity);
+}
+
 //operator[]
 
-template <typename T, typename Alloc>
-T& List<T, Alloc>::operator[](long index) throw(IndexError)
+template <typename T, typename Alloc, typename CheckPolicy>
+T& List<T, Alloc, CheckPolicy>::operator[](long index) throw(IndexError)
 {
-    if (index < 0)
-        index += size();
-    try
-    {
-        return m_vector.at(index);
-    }
-    catch (std::out_of_range& e)
-    {
-        THROW(IndexError, "index out of range");
-    }
+    return m_vector[CheckPolicy::position(index, m_vector.size())];
 }
     
-template <typename T, typename Alloc>
-const T& List<T, Alloc>::operator[](long index) const throw(IndexError)
+template <typename T, typename Alloc, typename CheckPolicy>
+const T& List<T, Alloc, CheckPolicy>::operator[](long index) const throw(IndexError)
 {
-    if (index < 0)
-        index += size();
-    try
-    {
-        return m_vector.at(index);
-    }
-    catch (std::out_of_range& e)
-    {
-        THROW(IndexError, "index out of range");
-    }
+    return m_vector[CheckPolicy::position(index, m_vector.size())];
 }
 
 //operator==
 
-template <typename T, typename Alloc>
-bool List<T, Alloc>::operator==(const List<T, Alloc>& other) const
+template <typename T, typename Alloc, typename CheckPolicy>
+bool List<T, Alloc, CheckPolicy>::operator==(const List<T, Alloc, CheckPolicy>& other) const
 {
     if (size() != other.size())
         return false;
+    else if (TriviallyComparable<T>::value)
+    {
+        return size() == 0 || std::memcmp(m_vector.data(), 
+            other.m_vector.data(), size() * sizeof(T)) == 0;
+    }
     else
     {
-        for (int i = 0; i < size(); ++i)
+        for (size_type i = 0; i < size(); ++i)
         {
             if (m_vector[i] != other.m_vector[i])
                 return false;
@@ -654,18 +1200,53 @@ bool List<T, Alloc>::operator==(const List<T, Alloc>& other) const
     }
 }
 
+//slice method
+
+template <typename T, typename Alloc, typename CheckPolicy>
+MutableListView< List<T, Alloc, CheckPolicy> > 
+List<T, Alloc, CheckPolicy>::slice(long start, long stop, long step) 
+    throw(ValueError)
+{
+    return MutableListView< List<T, Alloc, CheckPolicy> >(
+        *this, Slice(start, stop, step, size()));
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+ListView<const T> 
+List<T, Alloc, CheckPolicy>::slice(long start, long stop, long step) const 
+    throw(ValueError)
+{
+    return ListView<const T>(m_vector.data(), 
+                             Slice(start, stop, step, size()));
+}
+
 //method append
 
-template <typename T, typename Alloc>
-void List<T, Alloc>::append(const T& item)
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::append(const T& item)
 {
     m_vector.push_back(item);
 }
 
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::append(T&& item)
+{
+    m_vector.push_back(std::move(item));
+}
+
+//method emplace
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename... Args>
+void List<T, Alloc, CheckPolicy>::emplace(Args&&... args)
+{
+    m_vector.emplace_back(std::forward<Args>(args)...);
+}
+
 //method insert
 
-template <typename T, typename Alloc>
-void List<T, Alloc>::insert(long index, const T& item)
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::insert(long index, const T& item)
 {
     size_type n = size();
     if (index < 0)
@@ -677,8 +1258,21 @@ void List<T, Alloc>::insert(long index, const T& item)
     m_vector.insert(m_vector.begin() + index, item);
 }
 
-template <typename T, typename Alloc>
-void List<T, Alloc>::insert(long index, const List<T, Alloc>& other)
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::insert(long index, T&& item)
+{
+    size_type n = size();
+    if (index < 0)
+    {
+        index += n;
+        index = std::max(long(0), index);
+    }
+    index = std::min(index, long(n));
+    m_vector.insert(m_vector.begin() + index, std::move(item));
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::insert(long index, const List<T, Alloc, CheckPolicy>& other)
 {
     size_type n = size();
     if (index < 0)
@@ -690,54 +1284,64 @@ void List<T, Alloc>::insert(long index, const List<T, Alloc>& other)
     m_vector.insert(m_vector.begin() + index, other.begin(), other.end());
 }
 
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename Left, typename Right>
+void List<T, Alloc, CheckPolicy>::insert(long index, const ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right>& expr)
+{
+    size_type n = size();
+    if (index < 0)
+    {
+        index += n;
+        index = std::max(long(0), index);
+    }
+    index = std::min(index, long(n));
+    if (expr.refersTo(*this))
+    {
+        List<T, Alloc, CheckPolicy> items(expr);
+        m_vector.insert(m_vector.begin() + index, 
+                        std::make_move_iterator(items.m_vector.begin()), 
+                        std::make_move_iterator(items.m_vector.end()));
+    }
+    else
+        m_vector.insert(m_vector.begin() + index, expr.begin(), expr.end());
+}
+
 //method contains
 
-template <typename T, typename Alloc>
-bool List<T, Alloc>::contains(const T& item) const
+template <typename T, typename Alloc, typename CheckPolicy>
+bool List<T, Alloc, CheckPolicy>::contains(const T& item) const
 {
-    typename std::vector<T, Alloc>::const_iterator it;
-    it = std::find(m_vector.begin(), m_vector.end(), item);
+    const_iterator it;
+    it = findItem(m_vector.begin(), m_vector.end(), item);
     return it != m_vector.end();
 }
 
 //method pop
 
-template <typename T, typename Alloc>
-T List<T, Alloc>::pop(long index) throw(IndexError)
+template <typename T, typename Alloc, typename CheckPolicy>
+T List<T, Alloc, CheckPolicy>::pop(long index) throw(IndexError)
 {
-    T item;
     if (size() == 0)
         THROW(IndexError, "pop from an empty list");
     if (index == -1)
     {
-        item = m_vector.back();
+        T item(std::move(m_vector.back()));
         m_vector.pop_back();
+        return item;
     }
-    else
-    {
-        if (index < 0)
-            index += size();
-        try
-        {
-            item = m_vector.at(index);
-        }
-        catch (std::out_of_range& e)
-        {
-            THROW(IndexError, "index out of range");
-        }
-        typename std::vector<T>::iterator it = m_vector.begin() + index;
-        m_vector.erase(it);
-    }
+    iterator it = m_vector.begin() + PythonCheck::position(index, size());
+    T item(std::move(*it));
+    m_vector.erase(it);
     return item;
 }
 
 //index method
 
-template <typename T, typename Alloc>
-typename List<T, Alloc>::size_type List<T, Alloc>::index(const T item) const throw(ValueError)
+template <typename T, typename Alloc, typename CheckPolicy>
+typename List<T, Alloc, CheckPolicy>::size_type List<T, Alloc, CheckPolicy>::index(const T& item) const throw(ValueError)
 {
-    typename std::vector<T, Alloc>::const_iterator it;
-    it = std::find(m_vector.begin(), m_vector.end(), item);
+    const_iterator it;
+    it = findItem(m_vector.begin(), m_vector.end(), item);
     if (it == m_vector.end())
         THROW(ValueError, "value not in list");
     else
@@ -746,141 +1350,441 @@ typename List<T, Alloc>::size_type List<T, Alloc>::index(const T item) const thr
 
 //extend method
 
-template <typename T, typename Alloc>
-void List<T, Alloc>::extend(const List<T, Alloc>& other)
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::extend(const List<T, Alloc, CheckPolicy>& other)
 {
     m_vector.insert(m_vector.end(), 
                     other.m_vector.begin(), 
                     other.m_vector.end());
 }
 
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::extend(List<T, Alloc, CheckPolicy>&& other)
+{
+    if (&other == this)
+    {
+        //items cannot be moved into their own list: duplicate them
+        List<T, Alloc, CheckPolicy> copy(*this);
+        extend(std::move(copy));
+        return;
+    }
+    if (m_vector.empty())
+        m_vector.swap(other.m_vector);
+    else
+        m_vector.insert(m_vector.end(), 
+                        std::make_move_iterator(other.m_vector.begin()), 
+                        std::make_move_iterator(other.m_vector.end()));
+    other.m_vector.clear();
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename Left, typename Right>
+void List<T, Alloc, CheckPolicy>::extend(const ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right>& expr)
+{
+    if (expr.refersTo(*this))
+    {
+        //growth would move items still to be copied
+        extend(List<T, Alloc, CheckPolicy>(expr));
+        return;
+    }
+    m_vector.reserve(size() + expr.size());
+    expr.appendTo(*this);
+}
+
 //operator+=
 
-template <typename T, typename Alloc>
-void List<T, Alloc>::operator+=(const List<T, Alloc>& other)
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::operator+=(const List<T, Alloc, CheckPolicy>& other)
 {
     m_vector.insert(m_vector.end(), 
                     other.m_vector.begin(), 
                     other.m_vector.end());
 }
 
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::operator+=(List<T, Alloc, CheckPolicy>&& other)
+{
+    extend(std::move(other));
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename Left, typename Right>
+void List<T, Alloc, CheckPolicy>::operator+=(const ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right>& expr)
+{
+    extend(expr);
+}
+
 //operator+
 
-template <typename T, typename Alloc>
-List<T, Alloc> List<T, Alloc>::operator+(const List<T, Alloc>& other) const
+template <typename T, typename Alloc, typename CheckPolicy>
+ListConcatenation<List<T, Alloc, CheckPolicy>, List<T, Alloc, CheckPolicy>, List<T, Alloc, CheckPolicy> > 
+List<T, Alloc, CheckPolicy>::operator+(const List<T, Alloc, CheckPolicy>& other) const &
+{
+    return ListConcatenation<List<T, Alloc, CheckPolicy>, List<T, Alloc, CheckPolicy>, List<T, Alloc, CheckPolicy> >(*this, other);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename Left, typename Right>
+ListConcatenation<List<T, Alloc, CheckPolicy>, List<T, Alloc, CheckPolicy>, ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right> > 
+List<T, Alloc, CheckPolicy>::operator+(const ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right>& expr) const &
 {
-    List<T, Alloc> copy(*this);
-    copy.extend(other);
-    return copy;
+    return ListConcatenation<List<T, Alloc, CheckPolicy>, List<T, Alloc, CheckPolicy>, ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right> >(*this, expr);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy> List<T, Alloc, CheckPolicy>::operator+(List<T, Alloc, CheckPolicy>&& other) const &
+{
+    List<T, Alloc, CheckPolicy> result(m_vector.get_allocator());
+    result.m_vector.reserve(size() + other.size());
+    result.extend(*this);
+    result.extend(std::move(other));
+    return result;
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy> List<T, Alloc, CheckPolicy>::operator+(const List<T, Alloc, CheckPolicy>& other) &&
+{
+    extend(other);
+    return std::move(*this);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+List<T, Alloc, CheckPolicy> List<T, Alloc, CheckPolicy>::operator+(List<T, Alloc, CheckPolicy>&& other) &&
+{
+    extend(std::move(other));
+    return std::move(*this);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename Left, typename Right>
+List<T, Alloc, CheckPolicy> List<T, Alloc, CheckPolicy>::operator+(const ListConcatenation<List<T, Alloc, CheckPolicy>, Left, Right>& expr) &&
+{
+    extend(expr);
+    return std::move(*this);
 }
 
 //remove method
 
-template <typename T, typename Alloc>
-void List<T, Alloc>::remove(const T& item) throw(ValueError)
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::remove(const T& item) throw(ValueError)
 {
     size_type i = index(item);
-    typename std::vector<T>::iterator it = m_vector.begin() + i;
+    iterator it = m_vector.begin() + i;
     m_vector.erase(it);
 }
 
+//removeIf/removeAll/removeMany methods
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename Predicate>
+typename List<T, Alloc, CheckPolicy>::size_type List<T, Alloc, CheckPolicy>::removeIf(const Predicate& pred)
+{
+    size_type n = m_vector.size();
+    m_vector.erase(std::remove_if(m_vector.begin(), m_vector.end(), pred), 
+                   m_vector.end());
+    return n - m_vector.size();
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+typename List<T, Alloc, CheckPolicy>::size_type List<T, Alloc, CheckPolicy>::removeAll(const T& item)
+{
+    iterator first = findItem(m_vector.begin(), m_vector.end(), item);
+    if (first == m_vector.end())
+        return 0;
+    size_type n = m_vector.size();
+    m_vector.erase(std::remove(first, m_vector.end(), item), m_vector.end());
+    return n - m_vector.size();
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename HashType>
+typename List<T, Alloc, CheckPolicy>::size_type List<T, Alloc, CheckPolicy>::removeMany(const List<T, Alloc, CheckPolicy>& items, const HashType& hash)
+{
+    //below this size, scanning items is cheaper than hashing
+    const size_type hashThreshold = 16;
+    if (items.size() <= hashThreshold)
+    {
+        const_iterator first = items.m_vector.begin();
+        const_iterator last = items.m_vector.end();
+        return removeIf([first, last](const T& item) {
+            return findItem(first, last, item) != last;
+        });
+    }
+    std::unordered_set<T, HashType> set(items.m_vector.begin(), 
+                                        items.m_vector.end(), items.size(),
+                                        hash);
+    return removeIf([&set](const T& item) {
+        return set.count(item) != 0;
+    });
+}
+
 //count method
 
-template <typename T, typename Alloc>
-typename List<T, Alloc>::size_type List<T, Alloc>::count(const T& item) const
+template <typename T, typename Alloc, typename CheckPolicy>
+typename List<T, Alloc, CheckPolicy>::size_type List<T, Alloc, CheckPolicy>::count(const T& item) const
 {
-    return std::count(m_vector.begin(), m_vector.end(), item);
+    return countItem(m_vector.begin(), m_vector.end(), item);
 }
 
 //reverse method
 
-template <typename T, typename Alloc>
-void List<T, Alloc>::reverse()
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::reverse()
 {
     std::reverse(m_vector.begin(), m_vector.end());
 }
 
 //sort method
 
-template <typename T, typename Alloc>
-void List<T, Alloc>::sort()
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::sort()
 {
-    std::sort(m_vector.begin(), m_vector.end());
+    radixSort(m_vector.begin(), m_vector.end(), m_vector.get_allocator());
 }
 
-template <typename T, typename Alloc>
-void List<T, Alloc>::sort(bool (*funcptr)(const T&, const T&))
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::sort(bool (*funcptr)(const T&, const T&))
 {
     std::sort(m_vector.begin(), m_vector.end(), funcptr);
 }
 
-template <typename T, typename Alloc>
+template <typename T, typename Alloc, typename CheckPolicy>
 template <typename Compare>
-void List<T, Alloc>::sort(const Compare& functor)
+void List<T, Alloc, CheckPolicy>::sort(const Compare& functor)
 {
     std::sort(m_vector.begin(), m_vector.end(), functor);
 }
 
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::sort(const Parallel& policy)
+{
+    parallelSort(m_vector.begin(), m_vector.end(), policy);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::sort(bool (*funcptr)(const T&, const T&),
+                                       const Parallel& policy)
+{
+    parallelSort(m_vector.begin(), m_vector.end(), funcptr, policy);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename Compare>
+void List<T, Alloc, CheckPolicy>::sort(const Compare& functor,
+                                       const Parallel& policy)
+{
+    parallelSort(m_vector.begin(), m_vector.end(), functor, policy);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::stableSort()
+{
+    snowball::stableSort(m_vector.begin(), m_vector.end());
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::stableSort(bool (*funcptr)(const T&, const T&))
+{
+    snowball::stableSort(m_vector.begin(), m_vector.end(), funcptr);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename Compare>
+void List<T, Alloc, CheckPolicy>::stableSort(const Compare& functor)
+{
+    snowball::stableSort(m_vector.begin(), m_vector.end(), functor);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename KeyFunc>
+void List<T, Alloc, CheckPolicy>::sort(const KeyFunc& key, bool reverse)
+{
+    typedef typename std::decay<decltype(key(std::declval<const T&>()))>::type
+        Key;
+    std::vector< std::pair<Key, size_type> > decorated;
+    decorated.reserve(m_vector.size());
+    for (size_type i = 0; i < m_vector.size(); ++i)
+        decorated.push_back(std::make_pair(key(m_vector[i]), i));
+    sortDecorated(decorated, reverse);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename KeyFunc>
+void List<T, Alloc, CheckPolicy>::sort(const KeyFunc& key, bool reverse,
+                                       const Parallel& policy)
+{
+    typedef typename std::decay<decltype(key(std::declval<const T&>()))>::type
+        Key;
+    size_type n = m_vector.size();
+    unsigned threads = policy.concurrency(n);
+    if (threads <= 1)
+    {
+        sort(key, reverse);
+        return;
+    }
+    std::vector< std::pair<Key, size_type> > decorated(n);
+    ThreadPool::instance().parallelFor(threads, [&](std::size_t chunk) {
+        size_type last = n * (chunk + 1) / threads;
+        for (size_type i = n * chunk / threads; i < last; ++i)
+        {
+            decorated[i].first = key(m_vector[i]);
+            decorated[i].second = i;
+        }
+    });
+    sortDecorated(decorated, reverse);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename Key>
+void List<T, Alloc, CheckPolicy>::sortDecorated(
+    std::vector< std::pair<Key, size_type> >& decorated, bool reverse)
+{
+    typedef std::pair<Key, size_type> Decorated;
+    if (reverse)
+        snowball::stableSort(decorated.begin(), decorated.end(), 
+            [](const Decorated& a, const Decorated& b) { 
+                return b.first < a.first; 
+            });
+    else
+        snowball::stableSort(decorated.begin(), decorated.end(), 
+            [](const Decorated& a, const Decorated& b) { 
+                return a.first < b.first; 
+            });
+    //keys are not needed anymore: keep the permutation only
+    std::vector<size_type> order;
+    order.reserve(decorated.size());
+    for (size_type i = 0; i < decorated.size(); ++i)
+        order.push_back(decorated[i].second);
+    std::vector<Decorated>().swap(decorated);
+    //follow cycles of the permutation, item at i comes from order[i]
+    for (size_type start = 0; start < order.size(); ++start)
+    {
+        if (order[start] == start)
+            continue;
+        T item = std::move(m_vector[start]);
+        size_type current = start;
+        while (order[current] != start)
+        {
+            size_type next = order[current];
+            m_vector[current] = std::move(m_vector[next]);
+            order[current] = current;
+            current = next;
+        }
+        m_vector[current] = std::move(item);
+        order[current] = current;
+    }
+}
+
 //forward iterators
 
-template <typename T, typename Alloc>
-typename List<T, Alloc>::iterator List<T, Alloc>::begin()
+template <typename T, typename Alloc, typename CheckPolicy>
+typename List<T, Alloc, CheckPolicy>::iterator List<T, Alloc, CheckPolicy>::begin()
 {
     return m_vector.begin();
 }
 
-template <typename T, typename Alloc>
-typename List<T, Alloc>::const_iterator List<T, Alloc>::begin() const
+template <typename T, typename Alloc, typename CheckPolicy>
+typename List<T, Alloc, CheckPolicy>::const_iterator List<T, Alloc, CheckPolicy>::begin() const
 {
     return m_vector.begin();
 }
 
-template <typename T, typename Alloc>
-typename List<T, Alloc>::iterator List<T, Alloc>::end()
+template <typename T, typename Alloc, typename CheckPolicy>
+typename List<T, Alloc, CheckPolicy>::iterator List<T, Alloc, CheckPolicy>::end()
 {
     return m_vector.end();
 }
 
-template <typename T, typename Alloc>
-typename List<T, Alloc>::const_iterator List<T, Alloc>::end() const
+template <typename T, typename Alloc, typename CheckPolicy>
+typename List<T, Alloc, CheckPolicy>::const_iterator List<T, Alloc, CheckPolicy>::end() const
 {
     return m_vector.end();
 }
 
 //reverse iterators
 
-template <typename T, typename Alloc>
-typename List<T, Alloc>::reverse_iterator List<T, Alloc>::rbegin()
+template <typename T, typename Alloc, typename CheckPolicy>
+typename List<T, Alloc, CheckPolicy>::reverse_iterator List<T, Alloc, CheckPolicy>::rbegin()
 {
     return m_vector.rbegin();
 }
 
-template <typename T, typename Alloc>
-typename List<T, Alloc>::const_reverse_iterator List<T, Alloc>::rbegin() const
+template <typename T, typename Alloc, typename CheckPolicy>
+typename List<T, Alloc, CheckPolicy>::const_reverse_iterator List<T, Alloc, CheckPolicy>::rbegin() const
 {
     return m_vector.rbegin();
 }
 
-template <typename T, typename Alloc>
-typename List<T, Alloc>::reverse_iterator List<T, Alloc>::rend()
+template <typename T, typename Alloc, typename CheckPolicy>
+typename List<T, Alloc, CheckPolicy>::reverse_iterator List<T, Alloc, CheckPolicy>::rend()
 {
     return m_vector.rend();
 }
 
-template <typename T, typename Alloc>
-typename List<T, Alloc>::const_reverse_iterator List<T, Alloc>::rend() const
+template <typename T, typename Alloc, typename CheckPolicy>
+typename List<T, Alloc, CheckPolicy>::const_reverse_iterator List<T, Alloc, CheckPolicy>::rend() const
 {
     return m_vector.rend();
 }
 
 // clear method
 
-template <typename T, typename Alloc>
-void List<T, Alloc>::clear()
+template <typename T, typename Alloc, typename CheckPolicy>
+void List<T, Alloc, CheckPolicy>::clear()
 {
     m_vector.erase(m_vector.begin(), m_vector.end());
 }
 
+//==============================================================================
+// HASH SPECIALIZATION
+//==============================================================================
+
+/**
+ * Specialization of Hash for List
+ * 
+ * When TriviallyComparable<T> holds, the storage of the list is hashed as a 
+ * single block of bytes. Otherwise, hashes of items computed by 
+ * DefaultHash<T> (Hash<T> when it is specialized, std::hash<T> otherwise) 
+ * are combined. Lists can then be used as Dictionary keys:
+ * 
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * Dictionary<List<int>, int, Hash< List<int> > > dct;
+ * dct[List<int>({1, 2})] = 3;
+ * ~~~~~~~~~~~~~~~~~~~~~
+ */
+template <typename T, typename Alloc, typename CheckPolicy>
+struct Hash< List<T, Alloc, CheckPolicy> >
+{
+    /**
+     * Operator()
+     * 
+     * @param key list to be hashed
+     * @returns hash of list
+     */
+    size_t operator()(const List<T, Alloc, CheckPolicy>& key) const
+    {
+        return hash(key, TriviallyComparable<T>());
+    };
+    
+    private:
+    
+    size_t hash(const List<T, Alloc, CheckPolicy>& key, std::true_type) const
+    {
+        if (key.size() == 0)
+            return hashBytes(0, 0);
+        return hashBytes(&*key.begin(), key.size() * sizeof(T));
+    };
+    
+    size_t hash(const List<T, Alloc, CheckPolicy>& key, std::false_type) const
+    {
+        typename DefaultHash<T>::type hasher;
+        size_t seed = key.size();
+        for (const T& item: key)
+            seed ^= hasher(item) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+    };
+};
+
 //==============================================================================
 // LISTITERATOR DECLARATION
 //==============================================================================
@@ -1165,6 +2069,265 @@ class ReverseListIterator<const Container>: public Iterator<const typename Conta
 
 };
 
+//==============================================================================
+// LISTCONCATENATION DECLARATION
+//==============================================================================
+
+namespace detail
+{
+
+/**
+ * Operand of a ListConcatenation: lists are held by reference, nested 
+ * concatenations (two references) by value so that a + b + c does not refer
+ * to the temporary a + b. Temporary lists are never operands: operator+ 
+ * builds the result at once when given one.
+ */
+template <typename Operand>
+struct ConcatenationOperand
+{
+    typedef const Operand& type;
+};
+
+template <typename ListType, typename Left, typename Right>
+struct ConcatenationOperand< ListConcatenation<ListType, Left, Right> >
+{
+    typedef ListConcatenation<ListType, Left, Right> type;
+};
+
+} //end of namespace detail
+
+/**
+ * @brief Forward iterator over the items of a ListConcatenation.
+ * 
+ * @tparam LeftIt iterator over the left operand
+ * @tparam RightIt iterator over the right operand
+ */
+template <typename LeftIt, typename RightIt>
+class ConcatenationIterator
+{
+    public:
+    
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename std::iterator_traits<LeftIt>::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type* pointer;
+    typedef const value_type& reference;
+    
+    /**
+     * Constructor
+     * 
+     * @param left current position in left operand
+     * @param leftEnd end of left operand
+     * @param right current position in right operand
+     */
+    ConcatenationIterator(LeftIt left, LeftIt leftEnd, RightIt right): 
+        m_left(left), m_leftEnd(leftEnd), m_right(right) { };
+    
+    reference operator*() const { return m_left != m_leftEnd ? *m_left : *m_right; };
+    pointer operator->() const { return &(operator*()); };
+    
+    ConcatenationIterator& operator++()
+    {
+        if (m_left != m_leftEnd)
+            ++m_left;
+        else
+            ++m_right;
+        return *this;
+    };
+    
+    ConcatenationIterator operator++(int)
+    {
+        ConcatenationIterator it(*this);
+        ++(*this);
+        return it;
+    };
+    
+    bool operator==(const ConcatenationIterator& o) const { return m_left == o.m_left && m_right == o.m_right; };
+    bool operator!=(const ConcatenationIterator& o) const { return !(*this == o); };
+    
+    private:
+    
+    LeftIt m_left;
+    LeftIt m_leftEnd;
+    RightIt m_right;
+};
+
+/**
+ * @brief Lazy concatenation of lists returned by List::operator+.
+ * 
+ * A concatenation only refers to its operands: items are copied when it is
+ * converted or assigned to a List, extends a List or is inserted in a List,
+ * once and in a buffer of the exact size. It can also be iterated over 
+ * without being built.
+ * 
+ * @tparam ListType type of lists
+ * @tparam Left type of left operand: ListType or ListConcatenation
+ * @tparam Right type of right operand: ListType or ListConcatenation
+ */
+template <typename ListType, typename Left, typename Right>
+class ListConcatenation
+{
+    public:
+    
+    /**
+     * @typedef size_type
+     * size type for concatenation
+     */
+    typedef typename ListType::size_type size_type;
+    
+    /**
+     * @typedef value_type
+     * value type of concatenation
+     */
+    typedef typename ListType::value_type value_type;
+    
+    /**
+     * @typedef const_iterator
+     * a forward iterator to const items
+     */
+    typedef ConcatenationIterator<typename Left::const_iterator, 
+                                  typename Right::const_iterator> const_iterator;
+    
+    /**
+     * @typedef iterator
+     * a forward iterator to const items
+     */
+    typedef const_iterator iterator;
+    
+    /**
+     * Constructor
+     * 
+     * @param left left operand
+     * @param right right operand
+     */
+    ListConcatenation(const Left& left, const Right& right): 
+        m_left(left), m_right(right) { };
+    
+    /**
+     * Return the number of items of the concatenation.
+     */
+    size_type size() const { return m_left.size() + m_right.size(); };
+    
+    /**
+     * Return an iterator to the first item.
+     */
+    const_iterator begin() const
+    {
+        return const_iterator(m_left.begin(), m_left.end(), m_right.begin());
+    };
+    
+    /**
+     * Return an iterator to the end of the concatenation.
+     */
+    const_iterator end() const
+    {
+        return const_iterator(m_left.end(), m_left.end(), m_right.end());
+    };
+    
+    /**
+     * Lazy concatenation with another list.
+     * 
+     * @param other list to be concatenated
+     */
+    ListConcatenation<ListType, ListConcatenation, ListType> 
+    operator+(const ListType& other) const
+    {
+        return ListConcatenation<ListType, ListConcatenation, ListType>(*this, other);
+    };
+    
+    /**
+     * Concatenation with a temporary list, which cannot be referred to: the 
+     * result is built at once and items of other list are moved.
+     * 
+     * @param other temporary list to be concatenated
+     */
+    ListType operator+(ListType&& other) const
+    {
+        ListType result;
+        result.reserve(size() + other.size());
+        appendTo(result);
+        result.extend(std::move(other));
+        return result;
+    };
+    
+    /**
+     * Lazy concatenation with another concatenation.
+     * 
+     * @param other concatenation to be concatenated
+     */
+    template <typename L, typename R>
+    ListConcatenation<ListType, ListConcatenation, ListConcatenation<ListType, L, R> > 
+    operator+(const ListConcatenation<ListType, L, R>& other) const
+    {
+        return ListConcatenation<ListType, ListConcatenation, ListConcatenation<ListType, L, R> >(*this, other);
+    };
+    
+    /**
+     * Whether concatenation holds the same items as list.
+     * 
+     * @param list list to be compared to
+     */
+    bool operator==(const ListType& list) const
+    {
+        return size() == list.size() && std::equal(list.begin(), list.end(), begin());
+    };
+    
+    /**
+     * Whether concatenation and list have different items.
+     * 
+     * @param list list to be compared to
+     */
+    bool operator!=(const ListType& list) const { return !(*this == list); };
+    
+    /**
+     * Append items of the concatenation at the end of list.
+     * 
+     * @param list list to be extended, which capacity is large enough
+     */
+    void appendTo(ListType& list) const
+    {
+        appendTo(list, m_left);
+        appendTo(list, m_right);
+    };
+    
+    /**
+     * Whether list is one of the operands of the concatenation.
+     * 
+     * @param list list to be looked for
+     */
+    bool refersTo(const ListType& list) const
+    {
+        return refersTo(m_left, list) || refersTo(m_right, list);
+    };
+    
+    private:
+    
+    static void appendTo(ListType& list, const ListType& operand)
+    {
+        list.extend(operand);
+    };
+    
+    template <typename L, typename R>
+    static void appendTo(ListType& list, const ListConcatenation<ListType, L, R>& operand)
+    {
+        operand.appendTo(list);
+    };
+    
+    static bool refersTo(const ListType& operand, const ListType& list)
+    {
+        return &operand == &list;
+    };
+    
+    template <typename L, typename R>
+    static bool refersTo(const ListConcatenation<ListType, L, R>& operand, const ListType& list)
+    {
+        return operand.refersTo(list);
+    };
+    
+    typename detail::ConcatenationOperand<Left>::type m_left;
+    typename detail::ConcatenationOperand<Right>::type m_right;
+};
+
 } //end of snowball namespace
 
 #endif
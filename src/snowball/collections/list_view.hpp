@@ -0,0 +1,557 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_LIST_VIEW_HPP
+#define SNOWBALL_LIST_VIEW_HPP
+
+#include <cstddef>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <functional>
+
+#include "snowball/exceptions/exceptions.h"
+#include "check_policy.hpp"
+
+namespace snowball
+{
+
+//Forward declaration of List template
+template <typename T, typename Alloc, typename CheckPolicy> class List;
+
+//==============================================================================
+// SLICE
+//==============================================================================
+
+/**
+ * @brief Normalized slice of a sequence.
+ *
+ * A slice is built from Python-like start, stop and step values and the size
+ * of the sliced sequence. Negative start and stop are applied from the end of
+ * the sequence and out of range values are clamped, exactly like Python does.
+ * Slice::none stands for an omitted value:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * Slice(1, Slice::none, 1, 5);          //list[1:]
+ * Slice(Slice::none, Slice::none, -1, 5); //list[::-1]
+ * ~~~~~~~~~~~~~~~~~~~~~
+ */
+struct Slice
+{
+    /**
+     * Value standing for an omitted start or stop.
+     */
+    enum: long { none = std::numeric_limits<long>::min() };
+
+    /**
+     * Constructor
+     *
+     * @param start first index
+     * @param stop index after last one
+     * @param step step between indices
+     * @param size size of the sliced sequence
+     * @throw ValueError if step is zero
+     */
+    Slice(long start, long stop, long step, std::size_t size)
+        throw(ValueError): start(0), step(step), length(0)
+    {
+        if (step == 0)
+            THROW(ValueError, "slice step cannot be zero");
+        long n = long(size);
+        if (step > 0)
+        {
+            start = (start == none) ? 0 : clamp(start, n, 0, n);
+            stop = (stop == none) ? n : clamp(stop, n, 0, n);
+            if (stop > start)
+                length = std::size_t((stop - start - 1) / step + 1);
+        }
+        else
+        {
+            start = (start == none) ? n - 1 : clamp(start, n, -1, n - 1);
+            stop = (stop == none) ? -1 : clamp(stop, n, -1, n - 1);
+            if (stop < start)
+                length = std::size_t((start - stop - 1) / (-step) + 1);
+        }
+        this->start = start;
+    };
+
+    /**
+     * Index in sequence of first item (meaningless if length is zero)
+     */
+    long start;
+
+    /**
+     * Step between indices
+     */
+    long step;
+
+    /**
+     * Number of items in slice
+     */
+    std::size_t length;
+
+    private:
+
+    static long clamp(long index, long n, long low, long high)
+    {
+        if (index < 0)
+            index += n;
+        return std::min(std::max(index, low), high);
+    };
+};
+
+//==============================================================================
+// LISTVIEWITERATOR DECLARATION
+//==============================================================================
+
+/**
+ * @brief Random access iterator over the items of a ListView.
+ *
+ * @tparam T type of items (possibly const)
+ */
+template <typename T>
+class ListViewIterator
+{
+    public:
+
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef typename std::remove_const<T>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* pointer;
+    typedef T& reference;
+
+    ListViewIterator(): m_first(0), m_step(1), m_pos(0) { };
+    ListViewIterator(T* first, long step, difference_type pos):
+        m_first(first), m_step(step), m_pos(pos) { };
+    template <typename U>
+    ListViewIterator(const ListViewIterator<U>& other):
+        m_first(other.m_first), m_step(other.m_step), m_pos(other.m_pos) { };
+
+    reference operator*() const { return m_first[m_pos * m_step]; };
+    pointer operator->() const { return &(operator*()); };
+    reference operator[](difference_type n) const
+    {
+        return m_first[(m_pos + n) * m_step];
+    };
+
+    ListViewIterator& operator++() { ++m_pos; return *this; };
+    ListViewIterator operator++(int) { ListViewIterator it(*this); ++m_pos; return it; };
+    ListViewIterator& operator--() { --m_pos; return *this; };
+    ListViewIterator operator--(int) { ListViewIterator it(*this); --m_pos; return it; };
+    ListViewIterator& operator+=(difference_type n) { m_pos += n; return *this; };
+    ListViewIterator& operator-=(difference_type n) { m_pos -= n; return *this; };
+    ListViewIterator operator+(difference_type n) const
+    {
+        return ListViewIterator(m_first, m_step, m_pos + n);
+    };
+    ListViewIterator operator-(difference_type n) const
+    {
+        return ListViewIterator(m_first, m_step, m_pos - n);
+    };
+    difference_type operator-(const ListViewIterator& other) const
+    {
+        return m_pos - other.m_pos;
+    };
+
+    bool operator==(const ListViewIterator& o) const { return m_pos == o.m_pos; };
+    bool operator!=(const ListViewIterator& o) const { return m_pos != o.m_pos; };
+    bool operator<(const ListViewIterator& o) const { return m_pos < o.m_pos; };
+    bool operator<=(const ListViewIterator& o) const { return m_pos <= o.m_pos; };
+    bool operator>(const ListViewIterator& o) const { return m_pos > o.m_pos; };
+    bool operator>=(const ListViewIterator& o) const { return m_pos >= o.m_pos; };
+
+    private:
+
+    template <typename U> friend class ListViewIterator;
+
+    T* m_first;
+    long m_step;
+    difference_type m_pos;
+};
+
+//==============================================================================
+// LISTVIEW DECLARATION
+//==============================================================================
+
+/**
+ * @brief Non-owning view over a slice of a List.
+ *
+ * @tparam T type of items in the view (const T for a read-only view)
+ *
+ * A view refers to the items of a list without copying them. It supports the
+ * read-only part of the List interface. Use ListView::toList to materialize
+ * the view into a new list.
+ *
+ * @warning a view is invalidated by any operation that reallocates or
+ * shifts the items of the list it refers to.
+ */
+template <typename T>
+class ListView
+{
+    public:
+
+    /**
+     * @typedef size_type
+     * size type for view
+     */
+    typedef std::size_t size_type;
+
+    /**
+     * @typedef value_type
+     * value type of view
+     */
+    typedef typename std::remove_const<T>::type value_type;
+
+    /**
+     * @typedef iterator
+     * a random access iterator to ListView<T>::value_type
+     */
+    typedef ListViewIterator<T> iterator;
+
+    /**
+     * @typedef const_iterator
+     * a random access iterator to const ListView<T>::value_type
+     */
+    typedef ListViewIterator<const T> const_iterator;
+
+    /**
+     * @typedef index_type
+     * the index type for view is size_type
+     */
+    typedef size_type index_type;
+
+    /**
+     * Constructor
+     *
+     * @param data first item of sliced sequence
+     * @param slice normalized slice
+     */
+    ListView(T* data, const Slice& slice):
+        m_first(slice.length ? data + slice.start : data), m_step(slice.step), m_size(slice.length)
+    { };
+
+    /**
+     * Return number of items in view.
+     */
+    size_type size() const { return m_size; };
+
+    /**
+     * Return step between two items of the view in the list.
+     */
+    long step() const { return m_step; };
+
+    /**
+     * Return an item from the view at specified index.
+     *
+     * @param index index of item, negative indices are applied from the end
+     * @throw IndexError if index is out of range
+     */
+    T& operator[](long index) const throw(IndexError)
+    {
+        return m_first[long(PythonCheck::position(index, m_size)) * m_step];
+    };
+
+    /**
+     * Check wether a given item is in the view
+     *
+     * @param item item to be looked for
+     */
+    bool contains(const value_type& item) const
+    {
+        return std::find(begin(), end(), item) != end();
+    };
+
+    /**
+     * Count number of occurences of given item.
+     *
+     * @param item item to count
+     */
+    size_type count(const value_type& item) const
+    {
+        return std::count(begin(), end(), item);
+    };
+
+    /**
+     * Return the index of item in the view.
+     *
+     * @param item to be looked for
+     * @throw ValueError if item is not in view
+     */
+    size_type index(const value_type& item) const throw(ValueError)
+    {
+        iterator it = std::find(begin(), end(), item);
+        if (it == end())
+            THROW(ValueError, "value not in list");
+        return it - begin();
+    };
+
+    /**
+     * Copy items of the view into a new list.
+     */
+    List<value_type, std::allocator<value_type>, PythonCheck> toList() const
+    {
+        List<value_type, std::allocator<value_type>, PythonCheck> output;
+        output.reserve(m_size);
+        for (iterator it = begin(); it != end(); ++it)
+            output.append(*it);
+        return output;
+    };
+
+    /**
+     * Iterator to the begin of the view.
+     */
+    iterator begin() const { return iterator(m_first, m_step, 0); };
+
+    /**
+     * Iterator to the end of the view.
+     */
+    iterator end() const { return iterator(m_first, m_step, m_size); };
+
+    protected:
+
+    /**
+     * Attributes
+     */
+    T* m_first;
+    long m_step;
+    size_type m_size;
+};
+
+namespace detail
+{
+
+/**
+ * Return true if the first item of a container lies within the storage of a
+ * list, of given capacity: the container is the list or a view of it.
+ */
+template <typename Container, typename T>
+auto overlaps(const Container& items, const T* data, std::size_t capacity,
+              int) -> decltype(&*items.begin() == data, bool())
+{
+    if (items.size() == 0 || data == 0)
+        return false;
+    const T* first = &*items.begin();
+    std::less<const T*> less;
+    return !less(first, data) && less(first, data + capacity);
+}
+
+/**
+ * Containers which iterators do not refer to stored items are never part of
+ * a list.
+ */
+template <typename Container, typename T>
+bool overlaps(const Container&, const T*, std::size_t, long)
+{
+    return false;
+}
+
+} //end of namespace detail
+
+//==============================================================================
+// MUTABLELISTVIEW DECLARATION
+//==============================================================================
+
+/**
+ * @brief View over a slice of a non-const List.
+ *
+ * @tparam ListType type of viewed list
+ *
+ * In addition to ListView, a mutable view can replace the items of the slice
+ * (slice assignment) or remove them from the list (del statement of Python).
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * List<int> list = {0, 1, 2, 3, 4, 5};
+ * list.slice(1, 3).assign(List<int>({7, 8, 9})); //list[1:3] = [7, 8, 9]
+ * //list contains {0, 7, 8, 9, 3, 4, 5}
+ * list.slice(0, Slice::none, 2).erase();         //del list[::2]
+ * //list contains {7, 9, 4}
+ * ~~~~~~~~~~~~~~~~~~~~~
+ */
+template <typename ListType>
+class MutableListView: public ListView<typename ListType::value_type>
+{
+    public:
+
+    /**
+     * @typedef value_type
+     * value type of view
+     */
+    typedef typename ListType::value_type value_type;
+
+    /**
+     * Constructor
+     *
+     * @param list viewed list
+     * @param slice normalized slice
+     */
+    MutableListView(ListType& list, const Slice& slice):
+        ListView<value_type>(list.m_vector.data(), slice), m_list(&list),
+        m_start(slice.start) { };
+
+    /**
+     * Copy constructor
+     */
+    MutableListView(const MutableListView& other) = default;
+
+    /**
+     * Slice assignment: replace items of the slice by the items of another
+     * view, as assign does.
+     *
+     * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * list.slice(1, 3) = other.slice(0, 5); //list[1:3] = other[0:5]
+     * ~~~~~~~~~~~~~~~~~~~~~
+     *
+     * The view is not rebound to the other view.
+     *
+     * @param other view which items are assigned
+     * @throw ValueError if sizes mismatch on an extended slice
+     */
+    MutableListView& operator=(const MutableListView& other) throw(ValueError);
+
+    /**
+     * Replace items of the slice by the items of a container.
+     *
+     * If the step of the slice is 1, the container may have any size and the
+     * list grows or shrinks accordingly, shifting the following items only
+     * once. Otherwise, the container must have as many items as the slice.
+     * The container may be the list itself or a view of it: its items are
+     * then copied first, as Python does.
+     *
+     * The view then refers to the assigned items.
+     *
+     * @tparam Container container type
+     * @param items items to be assigned
+     * @throw ValueError if sizes mismatch on an extended slice
+     */
+    template <typename Container>
+    void assign(const Container& items) throw(ValueError);
+
+    /**
+     * Remove items of the slice from the list.
+     *
+     * Remaining items are compacted in a single pass. The view is then empty.
+     */
+    void erase();
+
+    private:
+
+    /**
+     * Attributes
+     */
+    ListType* m_list;
+    long m_start;
+};
+
+//==============================================================================
+// MUTABLELISTVIEW DEFINITION
+//==============================================================================
+
+template <typename ListType>
+MutableListView<ListType>&
+MutableListView<ListType>::operator=(const MutableListView& other)
+    throw(ValueError)
+{
+    assign(other);
+    return *this;
+}
+
+template <typename ListType>
+template <typename Container>
+void MutableListView<ListType>::assign(const Container& items) throw(ValueError)
+{
+    typedef typename ListType::size_type size_type;
+    auto& vect = m_list->m_vector;
+    if (detail::overlaps(items, vect.data(), vect.capacity(), 0))
+    {
+        //items would be overwritten or moved before being read
+        std::vector<value_type> copy(items.begin(), items.end());
+        assign(copy);
+        return;
+    }
+    size_type n = items.size();
+    auto src = items.begin();
+    if (this->m_step != 1)
+    {
+        if (n != this->m_size)
+            THROW(ValueError, "attempt to assign sequence of size " +
+                  std::to_string(n) + " to extended slice of size " +
+                  std::to_string(this->m_size));
+        for (size_type i = 0; i < n; ++i, ++src)
+            this->m_first[long(i) * this->m_step] = *src;
+        return;
+    }
+    //step 1: overwrite common part then grow or shrink in one shift
+    size_type start = size_type(m_start);
+    if (this->m_size == 0)
+        start = std::min(start, vect.size());
+    size_type common = std::min(n, this->m_size);
+    for (size_type i = 0; i < common; ++i, ++src)
+        vect[start + i] = *src;
+    if (n > common)
+        vect.insert(vect.begin() + start + common, src, items.end());
+    else if (this->m_size > common)
+        vect.erase(vect.begin() + start + common,
+                   vect.begin() + start + this->m_size);
+    this->m_first = vect.data() + start;
+    this->m_size = n;
+}
+
+template <typename ListType>
+void MutableListView<ListType>::erase()
+{
+    typedef typename ListType::size_type size_type;
+    auto& vect = m_list->m_vector;
+    if (this->m_size == 0)
+        return;
+    long step = this->m_step;
+    size_type first = size_type(m_start);
+    if (step < 0)
+    {
+        //same items as the positive slice walked backward
+        first = size_type(m_start + long(this->m_size - 1) * step);
+        step = -step;
+    }
+    if (step == 1)
+        vect.erase(vect.begin() + first, vect.begin() + first + this->m_size);
+    else
+    {
+        size_type last = first + (this->m_size - 1) * size_type(step);
+        size_type dest = first;
+        for (size_type src = first; src < vect.size(); ++src)
+        {
+            if (src <= last && (src - first) % size_type(step) == 0)
+                continue;
+            vect[dest++] = std::move(vect[src]);
+        }
+        vect.erase(vect.begin() + dest, vect.end());
+    }
+    this->m_first = vect.data() + first;
+    this->m_size = 0;
+}
+
+} //end of snowball namespace
+
+#endif
@@ -0,0 +1,896 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_PERSISTENT_LIST_HPP
+#define SNOWBALL_PERSISTENT_LIST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <iterator>
+#include <initializer_list>
+
+#include "snowball/exceptions/exceptions.h"
+#include "check_policy.hpp"
+#include "simd_search.h"
+#include "list.hpp"
+
+namespace snowball
+{
+
+//Forward declaration of PersistentList template
+template <typename T> class PersistentList;
+
+namespace detail
+{
+
+/**
+ * Node of the trie of a PersistentList.
+ *
+ * Internal nodes have up to 32 children, leaves up to 32 items. A node
+ * created by a transient list has the owner id of that transient, which may
+ * modify it in place; other nodes may be shared and are never modified.
+ */
+template <typename T>
+struct PersistentNode
+{
+    PersistentNode(std::uint64_t id): owner(id) { };
+
+    std::uint64_t owner;
+    std::vector< std::shared_ptr< PersistentNode<T> > > children;
+    std::vector<T> items;
+};
+
+/**
+ * Return a new owner id for a transient list, never 0.
+ */
+inline std::uint64_t persistentOwner()
+{
+    static std::atomic<std::uint64_t> counter(0);
+    return ++counter;
+}
+
+} //end of namespace detail
+
+//==============================================================================
+// PERSISTENTLISTITERATOR DECLARATION
+//==============================================================================
+
+/**
+ * @brief Random access iterator over a PersistentList.
+ *
+ * The iterator keeps the leaf of the last item accessed, so that iterating
+ * walks down the trie once per 32 items. Items are read-only.
+ *
+ * @tparam T type of items
+ */
+template <typename T>
+class PersistentListIterator
+{
+    public:
+
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+
+    /**
+     * Constructor
+     *
+     * Build a singular iterator.
+     */
+    PersistentListIterator(): m_list(0), m_pos(0), m_leaf(0), m_first(0) { };
+
+    /**
+     * Constructor
+     *
+     * @param list list to be iterated over
+     * @param pos index of item
+     */
+    PersistentListIterator(const PersistentList<T>* list, difference_type pos):
+        m_list(list), m_pos(pos), m_leaf(0), m_first(0) { };
+
+    reference operator*() const { return at(m_pos); };
+    pointer operator->() const { return &(operator*()); };
+    reference operator[](difference_type n) const { return at(m_pos + n); };
+
+    PersistentListIterator& operator++() { ++m_pos; return *this; };
+    PersistentListIterator operator++(int) { PersistentListIterator it(*this); ++m_pos; return it; };
+    PersistentListIterator& operator--() { --m_pos; return *this; };
+    PersistentListIterator operator--(int) { PersistentListIterator it(*this); --m_pos; return it; };
+    PersistentListIterator& operator+=(difference_type n) { m_pos += n; return *this; };
+    PersistentListIterator& operator-=(difference_type n) { m_pos -= n; return *this; };
+    PersistentListIterator operator+(difference_type n) const
+    {
+        return PersistentListIterator(m_list, m_pos + n);
+    };
+    PersistentListIterator operator-(difference_type n) const
+    {
+        return PersistentListIterator(m_list, m_pos - n);
+    };
+    difference_type operator-(const PersistentListIterator& other) const
+    {
+        return m_pos - other.m_pos;
+    };
+
+    bool operator==(const PersistentListIterator& o) const { return m_pos == o.m_pos; };
+    bool operator!=(const PersistentListIterator& o) const { return m_pos != o.m_pos; };
+    bool operator<(const PersistentListIterator& o) const { return m_pos < o.m_pos; };
+    bool operator<=(const PersistentListIterator& o) const { return m_pos <= o.m_pos; };
+    bool operator>(const PersistentListIterator& o) const { return m_pos > o.m_pos; };
+    bool operator>=(const PersistentListIterator& o) const { return m_pos >= o.m_pos; };
+
+    private:
+
+    reference at(difference_type pos) const
+    {
+        if (m_leaf == 0 || pos < m_first || pos >= m_first + 32)
+        {
+            m_leaf = m_list->leafFor(std::size_t(pos)).items.data();
+            m_first = pos & ~difference_type(31);
+        }
+        return m_leaf[pos - m_first];
+    };
+
+    const PersistentList<T>* m_list;
+    difference_type m_pos;
+    mutable const T* m_leaf;
+    mutable difference_type m_first;
+};
+
+//==============================================================================
+// PERSISTENTLIST DECLARATION
+//==============================================================================
+
+/**
+ * @brief Implements an immutable list which versions share their nodes.
+ *
+ * @tparam T type of items
+ *
+ * Items are stored in a trie of 32-way nodes, the last (up to) 32 items being
+ * kept apart in a tail leaf. Indexing walks down the trie in O(log32 n).
+ * append, set and pop return a new version of the list and leave the
+ * original untouched: only the nodes on the path to the modified item are
+ * copied, all others are shared between versions.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * PersistentList<int> v1 = {1, 2, 3};
+ * PersistentList<int> v2 = v1.append(4).set(0, 10);
+ * //v1 is still {1, 2, 3}, v2 is {10, 2, 3, 4}
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Copying a list is O(1), so a snapshot can be handed to readers while a
+ * writer builds newer versions: nodes are never modified once shared, and
+ * reading a version needs no lock. Only a variable holding the current
+ * version and shared by threads needs synchronization (a mutex held for the
+ * copy, or std::atomic_load and std::atomic_store).
+ *
+ * For batches of edits, a transient list modifies in place the nodes it has
+ * already copied, then hands back a persistent list:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * PersistentList<int>::Transient batch = v2.transient();
+ * for (int i = 0; i < 1000; ++i)
+ *     batch.append(i);
+ * PersistentList<int> v3 = batch.persistent();
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * A transient list is not thread-safe.
+ */
+template <typename T>
+class PersistentList
+{
+    public:
+
+    /**
+     * @typedef size_type
+     * size type for list
+     */
+    typedef std::size_t size_type;
+
+    /**
+     * @typedef value_type
+     * value type for list
+     */
+    typedef T value_type;
+
+    /**
+     * @typedef index_type
+     * the index type for list is size_type
+     */
+    typedef size_type index_type;
+
+    /**
+     * @typedef iterator
+     * a random access iterator to const items
+     */
+    typedef PersistentListIterator<T> iterator;
+
+    /**
+     * @typedef const_iterator
+     * a random access iterator to const items
+     */
+    typedef PersistentListIterator<T> const_iterator;
+
+    class Transient;
+
+    /**
+     * Constructor
+     *
+     * Creates an empty list.
+     */
+    PersistentList();
+
+    /**
+     * Constructor
+     *
+     * Creates a list from an initializer list.
+     *
+     * @param il initializer list
+     */
+    PersistentList(std::initializer_list<T> il);
+
+    /**
+     * Constructor
+     *
+     * Creates a list from the items of a List.
+     *
+     * @param list list to be copied
+     */
+    template <typename Alloc, typename CheckPolicy>
+    explicit PersistentList(const List<T, Alloc, CheckPolicy>& list);
+
+    /**
+     * Copy constructor
+     *
+     * Copies are O(1): nodes are shared. A list has no move constructor, so
+     * that a list moved from is still valid.
+     *
+     * @param other list to be copied
+     */
+    PersistentList(const PersistentList<T>& other) = default;
+
+    /**
+     * Copy assignment
+     *
+     * @param other list to be copied
+     */
+    PersistentList<T>& operator=(const PersistentList<T>& other) = default;
+
+    /**
+     * Return list size
+     *
+     * @return the number of items in the list
+     */
+    size_type size() const;
+
+    /**
+     * Return an item from the list at specified index.
+     *
+     * @param index index of item, negative indices are applied from the end
+     * @throw IndexError if index is out of range
+     */
+    const T& operator[](long index) const throw(IndexError);
+
+    /**
+     * Return a new version of the list with item appended.
+     *
+     * @param item item to be appended
+     */
+    PersistentList<T> append(const T& item) const;
+
+    /**
+     * Return a new version of the list with item at index replaced.
+     *
+     * @param index index of item, negative indices are applied from the end
+     * @param item new item
+     * @throw IndexError if index is out of range
+     */
+    PersistentList<T> set(long index, const T& item) const throw(IndexError);
+
+    /**
+     * Return a new version of the list without its last item.
+     *
+     * @throw IndexError if list is empty
+     */
+    PersistentList<T> pop() const throw(IndexError);
+
+    /**
+     * Return a transient list to edit a copy of this list in place.
+     */
+    Transient transient() const;
+
+    /**
+     * Return a copy of the list as a List.
+     */
+    List<T> toList() const;
+
+    /**
+     * Check wether a given item is in the list
+     *
+     * @param item item to be looked for
+     */
+    bool contains(const T& item) const;
+
+    /**
+     * Equality comparison with another list.
+     *
+     * @param other list to be compared to
+     */
+    bool operator==(const PersistentList<T>& other) const;
+
+    /**
+     * Inequality comparison with another list.
+     *
+     * @param other list to be compared to
+     */
+    bool operator!=(const PersistentList<T>& other) const;
+
+    /**
+     * Return an iterator to the beginning of the list.
+     */
+    const_iterator begin() const;
+
+    /**
+     * Return an iterator to the end of the list.
+     */
+    const_iterator end() const;
+
+    private:
+
+    friend class PersistentListIterator<T>;
+
+    typedef detail::PersistentNode<T> Node;
+    typedef std::shared_ptr<Node> NodePtr;
+
+    static const unsigned bits = 5;
+    static const size_type width = 32;
+    static const size_type mask = 31;
+
+    /**
+     * Index of the first item of the tail.
+     */
+    size_type tailOffset() const;
+
+    /**
+     * Return the leaf holding item at index.
+     */
+    const Node& leafFor(size_type index) const;
+
+    /**
+     * Return node, or a copy of node owned by owner if it is not already.
+     */
+    static NodePtr editable(const NodePtr& node, std::uint64_t owner);
+
+    /**
+     * Return a path of nodes from level down to leaf.
+     */
+    static NodePtr newPath(unsigned level, const NodePtr& leaf,
+                           std::uint64_t owner);
+
+    /**
+     * Return node with tail inserted as its last leaf.
+     */
+    NodePtr pushTail(unsigned level, const NodePtr& node, const NodePtr& tail,
+                     std::uint64_t owner) const;
+
+    /**
+     * Return node without its last leaf, or a null pointer if it is left
+     * empty.
+     */
+    NodePtr popTail(unsigned level, const NodePtr& node,
+                    std::uint64_t owner) const;
+
+    /**
+     * Return node with item at index replaced.
+     */
+    static NodePtr doSet(unsigned level, const NodePtr& node, size_type index,
+                         const T& item, std::uint64_t owner);
+
+    /**
+     * Edit methods, in place for nodes owned by owner.
+     */
+    void doAppend(const T& item, std::uint64_t owner);
+    void doSet(size_type index, const T& item, std::uint64_t owner);
+    void doPop(std::uint64_t owner);
+
+    /**
+     * Attributes
+     */
+    size_type m_size;
+    unsigned m_shift;
+    NodePtr m_root;
+    NodePtr m_tail;
+
+}; // end of PersistentList class
+
+//==============================================================================
+// TRANSIENT DECLARATION
+//==============================================================================
+
+/**
+ * @brief Mutable version of a PersistentList for batches of edits.
+ *
+ * A transient list copies the nodes it modifies once, then edits them in
+ * place. persistent() returns the edited list; nodes shared with it are not
+ * modified anymore by further edits of the transient list.
+ */
+template <typename T>
+class PersistentList<T>::Transient
+{
+    public:
+
+    /**
+     * Constructor
+     *
+     * @param list list to be edited
+     */
+    explicit Transient(const PersistentList<T>& list);
+
+    /**
+     * Move constructor
+     *
+     * The moved-from transient keeps a copy of the list, but can't edit its
+     * nodes anymore.
+     *
+     * @param other transient to be moved
+     */
+    Transient(Transient&& other);
+
+    /**
+     * Transients can't be copied: both would edit the same nodes.
+     */
+    Transient(const Transient& other) = delete;
+    Transient& operator=(const Transient& other) = delete;
+
+    /**
+     * Return list size
+     */
+    size_type size() const { return m_list.size(); };
+
+    /**
+     * Return an item from the list at specified index.
+     *
+     * @param index index of item, negative indices are applied from the end
+     * @throw IndexError if index is out of range
+     */
+    const T& operator[](long index) const throw(IndexError) { return m_list[index]; };
+
+    /**
+     * Append an item at the end of the list.
+     *
+     * @param item item to be appended
+     */
+    void append(const T& item);
+
+    /**
+     * Replace item at index.
+     *
+     * @param index index of item, negative indices are applied from the end
+     * @param item new item
+     * @throw IndexError if index is out of range
+     */
+    void set(long index, const T& item) throw(IndexError);
+
+    /**
+     * Remove last item of the list.
+     *
+     * @throw IndexError if list is empty
+     */
+    void pop() throw(IndexError);
+
+    /**
+     * Return the edited list as a persistent list.
+     */
+    PersistentList<T> persistent();
+
+    private:
+
+    PersistentList<T> m_list;
+    std::uint64_t m_owner;
+};
+
+//==============================================================================
+// PERSISTENTLIST DEFINITION
+//==============================================================================
+
+//Constructors
+
+template <typename T>
+PersistentList<T>::PersistentList():
+    m_size(0), m_shift(bits), m_root(std::make_shared<Node>(0)),
+    m_tail(std::make_shared<Node>(0))
+{ };
+
+template <typename T>
+PersistentList<T>::PersistentList(std::initializer_list<T> il):
+    PersistentList()
+{
+    Transient transient(*this);
+    for (const T& item: il)
+        transient.append(item);
+    *this = transient.persistent();
+}
+
+template <typename T>
+template <typename Alloc, typename CheckPolicy>
+PersistentList<T>::PersistentList(const List<T, Alloc, CheckPolicy>& list):
+    PersistentList()
+{
+    Transient transient(*this);
+    for (const T& item: list)
+        transient.append(item);
+    *this = transient.persistent();
+}
+
+//size method
+
+template <typename T>
+typename PersistentList<T>::size_type PersistentList<T>::size() const
+{
+    return m_size;
+}
+
+//item access
+
+template <typename T>
+typename PersistentList<T>::size_type PersistentList<T>::tailOffset() const
+{
+    return m_size < width ? 0 : ((m_size - 1) >> bits) << bits;
+}
+
+template <typename T>
+const typename PersistentList<T>::Node&
+PersistentList<T>::leafFor(size_type index) const
+{
+    if (index >= tailOffset())
+        return *m_tail;
+    const Node* node = m_root.get();
+    for (unsigned level = m_shift; level > 0; level -= bits)
+        node = node->children[(index >> level) & mask].get();
+    return *node;
+}
+
+template <typename T>
+const T& PersistentList<T>::operator[](long index) const throw(IndexError)
+{
+    size_type pos = PythonCheck::position(index, m_size);
+    return leafFor(pos).items[pos & mask];
+}
+
+//node edition
+
+template <typename T>
+typename PersistentList<T>::NodePtr
+PersistentList<T>::editable(const NodePtr& node, std::uint64_t owner)
+{
+    if (owner != 0 && node->owner == owner)
+        return node;
+    NodePtr copy = std::make_shared<Node>(*node);
+    copy->owner = owner;
+    return copy;
+}
+
+template <typename T>
+typename PersistentList<T>::NodePtr
+PersistentList<T>::newPath(unsigned level, const NodePtr& leaf,
+                           std::uint64_t owner)
+{
+    if (level == 0)
+        return leaf;
+    NodePtr node = std::make_shared<Node>(owner);
+    node->children.push_back(newPath(level - bits, leaf, owner));
+    return node;
+}
+
+template <typename T>
+typename PersistentList<T>::NodePtr
+PersistentList<T>::pushTail(unsigned level, const NodePtr& node,
+                            const NodePtr& tail, std::uint64_t owner) const
+{
+    NodePtr result = editable(node, owner);
+    size_type sub = ((m_size - 1) >> level) & mask;
+    NodePtr inserted;
+    if (level == bits)
+        inserted = tail;
+    else if (sub < node->children.size())
+        inserted = pushTail(level - bits, node->children[sub], tail, owner);
+    else
+        inserted = newPath(level - bits, tail, owner);
+    if (sub < result->children.size())
+        result->children[sub] = inserted;
+    else
+        result->children.push_back(inserted);
+    return result;
+}
+
+template <typename T>
+typename PersistentList<T>::NodePtr
+PersistentList<T>::popTail(unsigned level, const NodePtr& node,
+                           std::uint64_t owner) const
+{
+    size_type sub = ((m_size - 2) >> level) & mask;
+    if (level > bits)
+    {
+        NodePtr child = popTail(level - bits, node->children[sub], owner);
+        if (!child && sub == 0)
+            return NodePtr();
+        NodePtr result = editable(node, owner);
+        if (child)
+            result->children[sub] = child;
+        else
+            result->children.pop_back();
+        return result;
+    }
+    if (sub == 0)
+        return NodePtr();
+    NodePtr result = editable(node, owner);
+    result->children.pop_back();
+    return result;
+}
+
+template <typename T>
+typename PersistentList<T>::NodePtr
+PersistentList<T>::doSet(unsigned level, const NodePtr& node, size_type index,
+                         const T& item, std::uint64_t owner)
+{
+    NodePtr result = editable(node, owner);
+    if (level == 0)
+        result->items[index & mask] = item;
+    else
+    {
+        size_type sub = (index >> level) & mask;
+        result->children[sub] = doSet(level - bits, node->children[sub], index,
+                                      item, owner);
+    }
+    return result;
+}
+
+//edit methods
+
+template <typename T>
+void PersistentList<T>::doAppend(const T& item, std::uint64_t owner)
+{
+    if (m_size - tailOffset() < width)
+    {
+        m_tail = editable(m_tail, owner);
+        m_tail->items.push_back(item);
+        ++m_size;
+        return;
+    }
+    //tail is full: push it in the trie
+    if ((m_size >> bits) > (size_type(1) << m_shift))
+    {
+        NodePtr root = std::make_shared<Node>(owner);
+        root->children.push_back(m_root);
+        root->children.push_back(newPath(m_shift, m_tail, owner));
+        m_root = root;
+        m_shift += bits;
+    }
+    else
+        m_root = pushTail(m_shift, m_root, m_tail, owner);
+    m_tail = std::make_shared<Node>(owner);
+    m_tail->items.reserve(width);
+    m_tail->items.push_back(item);
+    ++m_size;
+}
+
+template <typename T>
+void PersistentList<T>::doSet(size_type index, const T& item,
+                              std::uint64_t owner)
+{
+    if (index >= tailOffset())
+    {
+        m_tail = editable(m_tail, owner);
+        m_tail->items[index & mask] = item;
+    }
+    else
+        m_root = doSet(m_shift, m_root, index, item, owner);
+}
+
+template <typename T>
+void PersistentList<T>::doPop(std::uint64_t owner)
+{
+    if (m_size == 0)
+        THROW(IndexError, "pop from an empty list");
+    if (m_size == 1)
+    {
+        *this = PersistentList<T>();
+        return;
+    }
+    if (m_size - tailOffset() > 1)
+    {
+        m_tail = editable(m_tail, owner);
+        m_tail->items.pop_back();
+        --m_size;
+        return;
+    }
+    //tail is emptied: last leaf of the trie becomes the tail
+    const NodePtr* leaf = &m_root;
+    for (unsigned level = m_shift; level > 0; level -= bits)
+        leaf = &(*leaf)->children[((m_size - 2) >> level) & mask];
+    NodePtr tail = *leaf;
+    NodePtr root = popTail(m_shift, m_root, owner);
+    if (!root)
+        root = std::make_shared<Node>(owner);
+    if (m_shift > bits && root->children.size() == 1)
+    {
+        root = root->children[0];
+        m_shift -= bits;
+    }
+    m_root = root;
+    m_tail = tail;
+    --m_size;
+}
+
+//persistent edit methods
+
+template <typename T>
+PersistentList<T> PersistentList<T>::append(const T& item) const
+{
+    PersistentList<T> result(*this);
+    result.doAppend(item, 0);
+    return result;
+}
+
+template <typename T>
+PersistentList<T> PersistentList<T>::set(long index, const T& item) const
+    throw(IndexError)
+{
+    size_type pos = PythonCheck::position(index, m_size);
+    PersistentList<T> result(*this);
+    result.doSet(pos, item, 0);
+    return result;
+}
+
+template <typename T>
+PersistentList<T> PersistentList<T>::pop() const throw(IndexError)
+{
+    PersistentList<T> result(*this);
+    result.doPop(0);
+    return result;
+}
+
+template <typename T>
+typename PersistentList<T>::Transient PersistentList<T>::transient() const
+{
+    return Transient(*this);
+}
+
+//toList method
+
+template <typename T>
+List<T> PersistentList<T>::toList() const
+{
+    List<T> output;
+    output.reserve(m_size);
+    for (size_type first = 0; first < m_size; first += width)
+    {
+        const std::vector<T>& items = leafFor(first).items;
+        for (const T& item: items)
+            output.append(item);
+    }
+    return output;
+}
+
+//contains method
+
+template <typename T>
+bool PersistentList<T>::contains(const T& item) const
+{
+    for (size_type first = 0; first < m_size; first += width)
+    {
+        const std::vector<T>& items = leafFor(first).items;
+        if (findItem(items.begin(), items.end(), item) != items.end())
+            return true;
+    }
+    return false;
+}
+
+//comparison operators
+
+template <typename T>
+bool PersistentList<T>::operator==(const PersistentList<T>& other) const
+{
+    if (m_size != other.m_size)
+        return false;
+    if (m_root == other.m_root && m_tail == other.m_tail)
+        return true;
+    for (size_type first = 0; first < m_size; first += width)
+    {
+        const Node& leaf = leafFor(first);
+        const Node& otherLeaf = other.leafFor(first);
+        if (&leaf != &otherLeaf && leaf.items != otherLeaf.items)
+            return false;
+    }
+    return true;
+}
+
+template <typename T>
+bool PersistentList<T>::operator!=(const PersistentList<T>& other) const
+{
+    return !(*this == other);
+}
+
+//iterators
+
+template <typename T>
+typename PersistentList<T>::const_iterator PersistentList<T>::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+template <typename T>
+typename PersistentList<T>::const_iterator PersistentList<T>::end() const
+{
+    return const_iterator(this, std::ptrdiff_t(m_size));
+}
+
+//==============================================================================
+// TRANSIENT DEFINITION
+//==============================================================================
+
+template <typename T>
+PersistentList<T>::Transient::Transient(const PersistentList<T>& list):
+    m_list(list), m_owner(detail::persistentOwner())
+{ };
+
+template <typename T>
+PersistentList<T>::Transient::Transient(Transient&& other):
+    m_list(other.m_list), m_owner(other.m_owner)
+{
+    other.m_owner = detail::persistentOwner();
+}
+
+template <typename T>
+void PersistentList<T>::Transient::append(const T& item)
+{
+    m_list.doAppend(item, m_owner);
+}
+
+template <typename T>
+void PersistentList<T>::Transient::set(long index, const T& item)
+    throw(IndexError)
+{
+    m_list.doSet(PythonCheck::position(index, m_list.size()), item, m_owner);
+}
+
+template <typename T>
+void PersistentList<T>::Transient::pop() throw(IndexError)
+{
+    m_list.doPop(m_owner);
+}
+
+template <typename T>
+PersistentList<T> PersistentList<T>::Transient::persistent()
+{
+    //nodes now shared with the returned list must not be edited anymore
+    m_owner = detail::persistentOwner();
+    return m_list;
+}
+
+} //end of namespace snowball
+
+#endif
@@ -0,0 +1,233 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_RADIX_SORT_H
+#define SNOWBALL_RADIX_SORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace snowball
+{
+
+/**
+ * @brief Radix sort of items of type T.
+ *
+ * The primary template is for types without radix sort: enabled is false and
+ * List::sort falls back to std::sort. Specializations set enabled to true and
+ * provide:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * template <typename RandomIt, typename Alloc>
+ * static void sort(RandomIt first, RandomIt last, const Alloc& alloc);
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * which sorts a contiguous range in ascending order, taking scratch memory
+ * from alloc (rebound as needed).
+ *
+ * Integral types (but bool) and float/double are sorted with a LSD radix
+ * sort; String provides its own specialization in string.h.
+ *
+ * @tparam T type of items
+ */
+template <typename T, typename Enable = void>
+struct RadixSorter
+{
+    static const bool enabled = false;
+};
+
+/**
+ * Ranges shorter than this are sorted with std::sort.
+ */
+const std::size_t radixSortThreshold = 1 << 10;
+
+namespace detail
+{
+
+/**
+ * @brief Map arithmetic values to unsigned keys of the same order.
+ *
+ * Signed integers get their sign bit flipped. For floating point values,
+ * negative values have all their bits flipped and positive values their sign
+ * bit only, which orders -inf < negative < -0.0 < 0.0 < positive < inf.
+ * Negative and positive NaNs go to both ends.
+ */
+template <typename T, typename Enable = void>
+struct RadixKey;
+
+template <typename T>
+struct RadixKey<T, typename std::enable_if<std::is_integral<T>::value &&
+                  !std::is_same<T, bool>::value>::type>
+{
+    typedef typename std::make_unsigned<T>::type type;
+
+    static type get(T value)
+    {
+        type key = type(value);
+        if (std::numeric_limits<T>::is_signed)
+            key ^= type(1) << (sizeof(type) * 8 - 1);
+        return key;
+    }
+};
+
+template <typename T, typename Key>
+struct FloatRadixKey
+{
+    typedef Key type;
+
+    static type get(T value)
+    {
+        type key;
+        std::memcpy(&key, &value, sizeof(key));
+        const type sign = type(1) << (sizeof(type) * 8 - 1);
+        return (key & sign) ? ~key : key ^ sign;
+    }
+};
+
+template <>
+struct RadixKey<float>: public FloatRadixKey<float, std::uint32_t> { };
+
+template <>
+struct RadixKey<double>: public FloatRadixKey<double, std::uint64_t> { };
+
+/**
+ * LSD radix sort on bytes of the key, least significant first.
+ *
+ * Histograms of all bytes are built in a single pass and bytes shared by
+ * all keys are skipped, so that small ranges of values need few passes.
+ */
+template <typename T, typename Alloc>
+void lsdRadixSort(T* first, T* last, const Alloc& alloc)
+{
+    typedef RadixKey<T> Traits;
+    typedef typename Traits::type Key;
+    const std::size_t bytes = sizeof(Key);
+    std::size_t n = last - first;
+    std::vector<std::size_t> counts(bytes * 256, 0);
+    for (T* it = first; it != last; ++it)
+    {
+        Key key = Traits::get(*it);
+        for (std::size_t b = 0; b < bytes; ++b)
+            ++counts[b * 256 + ((key >> (b * 8)) & 0xff)];
+    }
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<T>
+        Scratch;
+    std::vector<T, Scratch> scratch(n, T(), Scratch(alloc));
+    T* src = first;
+    T* dst = scratch.data();
+    Key firstKey = Traits::get(*first);
+    for (std::size_t b = 0; b < bytes; ++b)
+    {
+        std::size_t* count = &counts[b * 256];
+        std::size_t shift = b * 8;
+        if (count[(firstKey >> shift) & 0xff] == n)
+            continue;
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < 256; ++i)
+        {
+            std::size_t c = count[i];
+            count[i] = offset;
+            offset += c;
+        }
+        for (T* it = src; it != src + n; ++it)
+            dst[count[(Traits::get(*it) >> shift) & 0xff]++] = *it;
+        std::swap(src, dst);
+    }
+    if (src != first)
+        std::copy(src, src + n, first);
+}
+
+} //end of namespace detail
+
+/**
+ * @brief LSD radix sort of integral and floating point types.
+ */
+template <typename T>
+struct RadixSorter<T, typename std::enable_if<
+    (std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+    std::is_same<T, float>::value || std::is_same<T, double>::value>::type>
+{
+    static const bool enabled = true;
+
+    template <typename RandomIt, typename Alloc>
+    static void sort(RandomIt first, RandomIt last, const Alloc& alloc)
+    {
+        std::size_t n = last - first;
+        if (n < radixSortThreshold)
+        {
+            std::sort(first, last);
+            return;
+        }
+        detail::lsdRadixSort(&*first, &*first + n, alloc);
+    }
+};
+
+/**
+ * Sort contiguous range [first, last) in ascending order, using a radix sort
+ * when RadixSorter is enabled for its items and std::sort otherwise.
+ *
+ * @tparam RandomIt contiguous random access iterator
+ * @tparam Alloc allocator for scratch memory
+ * @param first beginning of range
+ * @param last end of range
+ * @param alloc allocator for scratch memory
+ */
+template <typename RandomIt, typename Alloc>
+void radixSort(RandomIt first, RandomIt last, const Alloc& alloc);
+
+namespace detail
+{
+
+template <typename RandomIt, typename Alloc>
+void radixSort(RandomIt first, RandomIt last, const Alloc& alloc,
+               std::true_type)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    RadixSorter<T>::sort(first, last, alloc);
+}
+
+template <typename RandomIt, typename Alloc>
+void radixSort(RandomIt first, RandomIt last, const Alloc&, std::false_type)
+{
+    std::sort(first, last);
+}
+
+} //end of namespace detail
+
+template <typename RandomIt, typename Alloc>
+void radixSort(RandomIt first, RandomIt last, const Alloc& alloc)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    detail::radixSort(first, last, alloc,
+                      std::integral_constant<bool, RadixSorter<T>::enabled>());
+}
+
+} //end of namespace snowball
+
+#endif
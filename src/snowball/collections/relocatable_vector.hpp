@@ -0,0 +1,668 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_RELOCATABLE_VECTOR_HPP
+#define SNOWBALL_RELOCATABLE_VECTOR_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <memory>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <initializer_list>
+
+#include "traits.hpp"
+
+namespace snowball
+{
+
+//==============================================================================
+// RELOCATABLEVECTOR DECLARATION
+//==============================================================================
+
+/**
+ * @brief Dynamic array of trivially relocatable items growing with realloc.
+ *
+ * @tparam T type of items, for which TriviallyRelocatable<T> holds
+ *
+ * This class provides the part of std::vector interface used by List, which
+ * uses it as storage when items are trivially relocatable and the allocator
+ * is the default one. Memory comes from malloc and growth calls realloc:
+ * small buffers are often extended in place and, with glibc, large buffers
+ * (allocated with mmap) are moved with mremap which remaps pages instead of
+ * copying them. Items are therefore never moved one by one on growth, and
+ * insertions or removals shift the following items with memmove.
+ *
+ * Iterators are plain pointers. Unlike std::vector, ranges given to insert
+ * must be read with forward iterators.
+ */
+template <typename T>
+class RelocatableVector
+{
+    static_assert(TriviallyRelocatable<T>::value,
+                  "RelocatableVector requires trivially relocatable items");
+
+    public:
+
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T value_type;
+    typedef std::allocator<T> allocator_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    /**
+     * Constructor
+     *
+     * Build an empty vector.
+     */
+    explicit RelocatableVector(const allocator_type& alloc = allocator_type());
+
+    /**
+     * Constructor
+     *
+     * @param il initializer list
+     * @param alloc ignored
+     */
+    RelocatableVector(std::initializer_list<T> il,
+                      const allocator_type& alloc = allocator_type());
+
+    /**
+     * Constructor
+     *
+     * @param n number of items
+     * @param value value of items
+     * @param alloc ignored
+     */
+    RelocatableVector(size_type n, const T& value,
+                      const allocator_type& alloc = allocator_type());
+
+    /**
+     * Constructor
+     *
+     * @param first beginning of range
+     * @param last end of range
+     * @param alloc ignored
+     */
+    template <typename ForwardIterator, typename = typename std::enable_if<
+        !std::is_integral<ForwardIterator>::value>::type>
+    RelocatableVector(ForwardIterator first, ForwardIterator last,
+                      const allocator_type& alloc = allocator_type());
+
+    /**
+     * Constructor
+     *
+     * @param vect vector which items are copied
+     * @param alloc ignored
+     */
+    RelocatableVector(const std::vector<T>& vect,
+                      const allocator_type& alloc = allocator_type());
+
+    /**
+     * Constructor
+     *
+     * Items are moved one by one: the buffer of vect cannot be taken over.
+     *
+     * @param vect vector which items are moved
+     */
+    RelocatableVector(std::vector<T>&& vect);
+
+    /**
+     * Constructor
+     *
+     * Take ownership of a buffer allocated with malloc, without moving items.
+     *
+     * @param data buffer, released with free by the vector
+     * @param size number of items constructed at the beginning of buffer
+     * @param capacity number of items buffer may hold
+     */
+    RelocatableVector(T* data, size_type size, size_type capacity);
+
+    /**
+     * Copy constructor
+     *
+     * @param other existing vector
+     */
+    RelocatableVector(const RelocatableVector<T>& other);
+
+    /**
+     * Copy constructor
+     *
+     * @param other existing vector
+     * @param alloc ignored
+     */
+    RelocatableVector(const RelocatableVector<T>& other,
+                      const allocator_type& alloc);
+
+    /**
+     * Move constructor
+     *
+     * @param other existing vector, left empty
+     */
+    RelocatableVector(RelocatableVector<T>&& other) noexcept;
+
+    /**
+     * Destructor
+     */
+    ~RelocatableVector();
+
+    RelocatableVector<T>& operator=(const RelocatableVector<T>& other);
+    RelocatableVector<T>& operator=(RelocatableVector<T>&& other) noexcept;
+    RelocatableVector<T>& operator=(const std::vector<T>& vect);
+    RelocatableVector<T>& operator=(std::initializer_list<T> il);
+
+    size_type size() const { return m_size; };
+    size_type capacity() const { return m_capacity; };
+    bool empty() const { return m_size == 0; };
+    allocator_type get_allocator() const { return allocator_type(); };
+
+    T* data() { return m_data; };
+    const T* data() const { return m_data; };
+    T& operator[](size_type pos) { return m_data[pos]; };
+    const T& operator[](size_type pos) const { return m_data[pos]; };
+    T& back() { return m_data[m_size - 1]; };
+    const T& back() const { return m_data[m_size - 1]; };
+
+    iterator begin() { return m_data; };
+    const_iterator begin() const { return m_data; };
+    iterator end() { return m_data + m_size; };
+    const_iterator end() const { return m_data + m_size; };
+    reverse_iterator rbegin() { return reverse_iterator(end()); };
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); };
+    reverse_iterator rend() { return reverse_iterator(begin()); };
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); };
+
+    /**
+     * Reallocate buffer so that it holds at least capacity items.
+     *
+     * @param capacity number of items
+     */
+    void reserve(size_type capacity);
+
+    void push_back(const T& value);
+    void push_back(T&& value);
+    template <typename... Args>
+    void emplace_back(Args&&... args);
+    void pop_back();
+
+    iterator insert(const_iterator pos, const T& value);
+    iterator insert(const_iterator pos, T&& value);
+    template <typename ForwardIterator, typename = typename std::enable_if<
+        !std::is_integral<ForwardIterator>::value>::type>
+    iterator insert(const_iterator pos, ForwardIterator first,
+                    ForwardIterator last);
+
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+
+    /**
+     * Destroy all items. Capacity is kept.
+     */
+    void clear();
+
+    /**
+     * Exchange content with another vector.
+     *
+     * @param other vector to be swapped with
+     */
+    void swap(RelocatableVector<T>& other) noexcept;
+
+    private:
+
+    /**
+     * Grow buffer so that it holds at least minimum items.
+     */
+    void grow(size_type minimum);
+
+    /**
+     * Move count items from position from to position to (memmove).
+     */
+    void relocate(size_type to, size_type from, size_type count);
+
+    /**
+     * Destroy items of [first, last).
+     */
+    static void destroy(T* first, T* last);
+
+    /**
+     * Whether range [first, last) lies in buffer. Iterators which are not
+     * pointers (move or reverse iterators...) are checked through the 
+     * address of the item they refer to.
+     */
+    template <typename Iterator>
+    bool overlaps(Iterator first, Iterator last) const;
+    bool overlaps(const T* first, const T* last) const;
+    bool overlaps(T* first, T* last) const;
+
+    /**
+     * Whether the item iterator refers to lies in buffer. Iterators yielding
+     * values which are not references to T never refer to the buffer.
+     */
+    template <typename Iterator>
+    bool holds(Iterator it, std::true_type) const;
+    template <typename Iterator>
+    bool holds(Iterator, std::false_type) const { return false; };
+
+    /**
+     * Attributes
+     */
+    T* m_data;
+    size_type m_size;
+    size_type m_capacity;
+};
+
+//==============================================================================
+// RELOCATABLEVECTOR DEFINITION
+//==============================================================================
+
+//constructors
+
+template <typename T>
+RelocatableVector<T>::RelocatableVector(const allocator_type&):
+    m_data(0), m_size(0), m_capacity(0) { };
+
+template <typename T>
+RelocatableVector<T>::RelocatableVector(std::initializer_list<T> il,
+                                        const allocator_type&):
+    m_data(0), m_size(0), m_capacity(0)
+{
+    try
+    {
+        insert(end(), il.begin(), il.end());
+    }
+    catch (...)
+    {
+        std::free(m_data);
+        throw;
+    }
+}
+
+template <typename T>
+RelocatableVector<T>::RelocatableVector(size_type n, const T& value,
+                                        const allocator_type&):
+    m_data(0), m_size(0), m_capacity(0)
+{
+    reserve(n);
+    try
+    {
+        std::uninitialized_fill_n(m_data, n, value);
+    }
+    catch (...)
+    {
+        std::free(m_data);
+        throw;
+    }
+    m_size = n;
+}
+
+template <typename T>
+template <typename ForwardIterator, typename>
+RelocatableVector<T>::RelocatableVector(ForwardIterator first,
+                                        ForwardIterator last,
+                                        const allocator_type&):
+    m_data(0), m_size(0), m_capacity(0)
+{
+    try
+    {
+        insert(end(), first, last);
+    }
+    catch (...)
+    {
+        std::free(m_data);
+        throw;
+    }
+}
+
+template <typename T>
+RelocatableVector<T>::RelocatableVector(const std::vector<T>& vect,
+                                        const allocator_type&):
+    RelocatableVector(vect.begin(), vect.end()) { };
+
+template <typename T>
+RelocatableVector<T>::RelocatableVector(std::vector<T>&& vect):
+    RelocatableVector(std::make_move_iterator(vect.begin()),
+                      std::make_move_iterator(vect.end()))
+{
+    vect.clear();
+}
+
+template <typename T>
+RelocatableVector<T>::RelocatableVector(T* data, size_type size,
+                                        size_type capacity):
+    m_data(data), m_size(size), m_capacity(capacity) { };
+
+template <typename T>
+RelocatableVector<T>::RelocatableVector(const RelocatableVector<T>& other):
+    RelocatableVector(other.begin(), other.end()) { };
+
+template <typename T>
+RelocatableVector<T>::RelocatableVector(const RelocatableVector<T>& other,
+                                        const allocator_type&):
+    RelocatableVector(other.begin(), other.end()) { };
+
+template <typename T>
+RelocatableVector<T>::RelocatableVector(RelocatableVector<T>&& other) noexcept:
+    m_data(other.m_data), m_size(other.m_size), m_capacity(other.m_capacity)
+{
+    other.m_data = 0;
+    other.m_size = 0;
+    other.m_capacity = 0;
+}
+
+//destructor
+
+template <typename T>
+RelocatableVector<T>::~RelocatableVector()
+{
+    destroy(m_data, m_data + m_size);
+    std::free(m_data);
+}
+
+//assignment operators
+
+template <typename T>
+RelocatableVector<T>& RelocatableVector<T>::operator=(
+    const RelocatableVector<T>& other)
+{
+    if (this != &other)
+    {
+        clear();
+        insert(end(), other.begin(), other.end());
+    }
+    return *this;
+}
+
+template <typename T>
+RelocatableVector<T>& RelocatableVector<T>::operator=(
+    RelocatableVector<T>&& other) noexcept
+{
+    RelocatableVector<T> tmp(std::move(other));
+    swap(tmp);
+    return *this;
+}
+
+template <typename T>
+RelocatableVector<T>& RelocatableVector<T>::operator=(
+    const std::vector<T>& vect)
+{
+    clear();
+    insert(end(), vect.begin(), vect.end());
+    return *this;
+}
+
+template <typename T>
+RelocatableVector<T>& RelocatableVector<T>::operator=(
+    std::initializer_list<T> il)
+{
+    clear();
+    insert(end(), il.begin(), il.end());
+    return *this;
+}
+
+//private helpers
+
+template <typename T>
+void RelocatableVector<T>::reserve(size_type capacity)
+{
+    if (capacity <= m_capacity)
+        return;
+    if (capacity > size_type(-1) / sizeof(T))
+        throw std::bad_alloc();
+    //items are relocated by realloc, without running any constructor
+    void* data = std::realloc(static_cast<void*>(m_data), capacity * sizeof(T));
+    if (!data)
+        throw std::bad_alloc();
+    m_data = static_cast<T*>(data);
+    m_capacity = capacity;
+}
+
+template <typename T>
+void RelocatableVector<T>::grow(size_type minimum)
+{
+    reserve(std::max(minimum, std::max<size_type>(2 * m_capacity, 4)));
+}
+
+template <typename T>
+void RelocatableVector<T>::relocate(size_type to, size_type from,
+                                    size_type count)
+{
+    if (count > 0)
+        std::memmove(static_cast<void*>(m_data + to),
+                     static_cast<const void*>(m_data + from),
+                     count * sizeof(T));
+}
+
+template <typename T>
+void RelocatableVector<T>::destroy(T* first, T* last)
+{
+    if (!std::is_trivially_destructible<T>::value)
+    {
+        for (; first != last; ++first)
+            first->~T();
+    }
+}
+
+template <typename T>
+template <typename Iterator>
+bool RelocatableVector<T>::overlaps(Iterator first, Iterator last) const
+{
+    typedef typename std::iterator_traits<Iterator>::reference reference;
+    typedef std::integral_constant<bool, std::is_reference<reference>::value &&
+        std::is_same<typename std::decay<reference>::type, T>::value> direct;
+    //a range of the buffer starts in the buffer
+    return first != last && holds(first, direct());
+}
+
+template <typename T>
+template <typename Iterator>
+bool RelocatableVector<T>::holds(Iterator it, std::true_type) const
+{
+    const T* item = std::addressof(static_cast<const T&>(*it));
+    std::less<const T*> less;
+    return !less(item, m_data) && less(item, m_data + m_size);
+}
+
+template <typename T>
+bool RelocatableVector<T>::overlaps(const T* first, const T* last) const
+{
+    std::less<const T*> less;
+    return first != last && less(first, m_data + m_size) && less(m_data, last);
+}
+
+template <typename T>
+bool RelocatableVector<T>::overlaps(T* first, T* last) const
+{
+    return overlaps(static_cast<const T*>(first), static_cast<const T*>(last));
+}
+
+//push/pop methods
+
+template <typename T>
+void RelocatableVector<T>::push_back(const T& value)
+{
+    if (m_size == m_capacity)
+    {
+        //value may be an item of this vector
+        T item(value);
+        grow(m_size + 1);
+        ::new (static_cast<void*>(m_data + m_size)) T(std::move(item));
+    }
+    else
+        ::new (static_cast<void*>(m_data + m_size)) T(value);
+    ++m_size;
+}
+
+template <typename T>
+void RelocatableVector<T>::push_back(T&& value)
+{
+    if (m_size == m_capacity)
+    {
+        T item(std::move(value));
+        grow(m_size + 1);
+        ::new (static_cast<void*>(m_data + m_size)) T(std::move(item));
+    }
+    else
+        ::new (static_cast<void*>(m_data + m_size)) T(std::move(value));
+    ++m_size;
+}
+
+template <typename T>
+template <typename... Args>
+void RelocatableVector<T>::emplace_back(Args&&... args)
+{
+    if (m_size == m_capacity)
+    {
+        T item(std::forward<Args>(args)...);
+        grow(m_size + 1);
+        ::new (static_cast<void*>(m_data + m_size)) T(std::move(item));
+    }
+    else
+        ::new (static_cast<void*>(m_data + m_size))
+            T(std::forward<Args>(args)...);
+    ++m_size;
+}
+
+template <typename T>
+void RelocatableVector<T>::pop_back()
+{
+    --m_size;
+    destroy(m_data + m_size, m_data + m_size + 1);
+}
+
+//insert methods
+
+template <typename T>
+typename RelocatableVector<T>::iterator
+RelocatableVector<T>::insert(const_iterator pos, const T& value)
+{
+    return insert(pos, T(value));
+}
+
+template <typename T>
+typename RelocatableVector<T>::iterator
+RelocatableVector<T>::insert(const_iterator pos, T&& value)
+{
+    size_type index = pos - m_data;
+    //value may be an item of this vector, moved by growth or shift
+    T item(std::move(value));
+    if (m_size == m_capacity)
+        grow(m_size + 1);
+    relocate(index + 1, index, m_size - index);
+    try
+    {
+        ::new (static_cast<void*>(m_data + index)) T(std::move(item));
+    }
+    catch (...)
+    {
+        relocate(index, index + 1, m_size - index);
+        throw;
+    }
+    ++m_size;
+    return m_data + index;
+}
+
+template <typename T>
+template <typename ForwardIterator, typename>
+typename RelocatableVector<T>::iterator
+RelocatableVector<T>::insert(const_iterator pos, ForwardIterator first,
+                             ForwardIterator last)
+{
+    size_type index = pos - m_data;
+    size_type n = std::distance(first, last);
+    if (n == 0)
+        return m_data + index;
+    if (overlaps(first, last))
+    {
+        //copy items first: growth or shift would move them
+        RelocatableVector<T> copy(first, last);
+        return insert(m_data + index, std::make_move_iterator(copy.begin()),
+                      std::make_move_iterator(copy.end()));
+    }
+    if (m_size + n > m_capacity)
+        grow(m_size + n);
+    relocate(index + n, index, m_size - index);
+    size_type i = 0;
+    try
+    {
+        for (; i < n; ++i, ++first)
+            ::new (static_cast<void*>(m_data + index + i)) T(*first);
+    }
+    catch (...)
+    {
+        destroy(m_data + index, m_data + index + i);
+        relocate(index, index + n, m_size - index);
+        throw;
+    }
+    m_size += n;
+    return m_data + index;
+}
+
+//erase methods
+
+template <typename T>
+typename RelocatableVector<T>::iterator
+RelocatableVector<T>::erase(const_iterator pos)
+{
+    return erase(pos, pos + 1);
+}
+
+template <typename T>
+typename RelocatableVector<T>::iterator
+RelocatableVector<T>::erase(const_iterator first, const_iterator last)
+{
+    size_type index = first - m_data;
+    size_type n = last - first;
+    if (n == 0)
+        return m_data + index;
+    destroy(m_data + index, m_data + index + n);
+    relocate(index, index + n, m_size - index - n);
+    m_size -= n;
+    return m_data + index;
+}
+
+//clear and swap methods
+
+template <typename T>
+void RelocatableVector<T>::clear()
+{
+    destroy(m_data, m_data + m_size);
+    m_size = 0;
+}
+
+template <typename T>
+void RelocatableVector<T>::swap(RelocatableVector<T>& other) noexcept
+{
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+    std::swap(m_capacity, other.m_capacity);
+}
+
+} //end of namespace snowball
+
+#endif
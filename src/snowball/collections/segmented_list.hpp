@@ -0,0 +1,966 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_SEGMENTED_LIST_HPP
+#define SNOWBALL_SEGMENTED_LIST_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <initializer_list>
+
+#include "snowball/exceptions/exceptions.h"
+#include "check_policy.hpp"
+#include "simd_search.h"
+
+namespace snowball
+{
+
+namespace detail
+{
+
+/**
+ * Return the base 2 logarithm of n rounded down (0 for n <= 1).
+ */
+constexpr std::size_t floorLog2(std::size_t n)
+{
+    return n <= 1 ? 0 : 1 + floorLog2(n / 2);
+}
+
+} //end of namespace detail
+
+//==============================================================================
+// SEGMENTEDLISTITERATOR DECLARATION
+//==============================================================================
+
+/**
+ * @brief Random access iterator over the segments of a SegmentedList.
+ *
+ * The iterator stores the index of the item and a pointer to the segment
+ * table of the list. It stays valid when items are appended, and is
+ * invalidated when the item it points to is removed.
+ *
+ * @tparam T type of items (possibly const)
+ * @tparam Shift base 2 logarithm of the number of items per segment
+ */
+template <typename T, std::size_t Shift>
+class SegmentedListIterator
+{
+    public:
+
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef typename std::remove_const<T>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* pointer;
+    typedef T& reference;
+
+    /**
+     * @typedef segments_type
+     * table of segments
+     */
+    typedef std::vector<value_type*> segments_type;
+
+    /**
+     * Constructor
+     *
+     * Build a singular iterator.
+     */
+    SegmentedListIterator(): m_segments(0), m_pos(0) { };
+
+    /**
+     * Constructor
+     *
+     * @param segments table of segments
+     * @param pos index of item
+     */
+    SegmentedListIterator(const segments_type* segments, difference_type pos):
+        m_segments(segments), m_pos(pos) { };
+
+    /**
+     * Conversion from non-const iterator to const iterator
+     *
+     * @param other iterator to be converted
+     */
+    template <typename U>
+    SegmentedListIterator(const SegmentedListIterator<U, Shift>& other):
+        m_segments(other.m_segments), m_pos(other.m_pos) { };
+
+    reference operator*() const { return at(m_pos); };
+    pointer operator->() const { return &(operator*()); };
+    reference operator[](difference_type n) const { return at(m_pos + n); };
+
+    SegmentedListIterator& operator++() { ++m_pos; return *this; };
+    SegmentedListIterator operator++(int) { SegmentedListIterator it(*this); ++m_pos; return it; };
+    SegmentedListIterator& operator--() { --m_pos; return *this; };
+    SegmentedListIterator operator--(int) { SegmentedListIterator it(*this); --m_pos; return it; };
+    SegmentedListIterator& operator+=(difference_type n) { m_pos += n; return *this; };
+    SegmentedListIterator& operator-=(difference_type n) { m_pos -= n; return *this; };
+    SegmentedListIterator operator+(difference_type n) const
+    {
+        return SegmentedListIterator(m_segments, m_pos + n);
+    };
+    SegmentedListIterator operator-(difference_type n) const
+    {
+        return SegmentedListIterator(m_segments, m_pos - n);
+    };
+    template <typename U>
+    difference_type operator-(const SegmentedListIterator<U, Shift>& other) const
+    {
+        return m_pos - other.m_pos;
+    };
+
+    template <typename U>
+    bool operator==(const SegmentedListIterator<U, Shift>& o) const { return m_pos == o.m_pos; };
+    template <typename U>
+    bool operator!=(const SegmentedListIterator<U, Shift>& o) const { return m_pos != o.m_pos; };
+    template <typename U>
+    bool operator<(const SegmentedListIterator<U, Shift>& o) const { return m_pos < o.m_pos; };
+    template <typename U>
+    bool operator<=(const SegmentedListIterator<U, Shift>& o) const { return m_pos <= o.m_pos; };
+    template <typename U>
+    bool operator>(const SegmentedListIterator<U, Shift>& o) const { return m_pos > o.m_pos; };
+    template <typename U>
+    bool operator>=(const SegmentedListIterator<U, Shift>& o) const { return m_pos >= o.m_pos; };
+
+    private:
+
+    template <typename U, std::size_t S> friend class SegmentedListIterator;
+
+    reference at(difference_type pos) const
+    {
+        std::size_t i = std::size_t(pos);
+        return (*m_segments)[i >> Shift][i & ((std::size_t(1) << Shift) - 1)];
+    };
+
+    const segments_type* m_segments;
+    difference_type m_pos;
+};
+
+template <typename T, std::size_t Shift>
+SegmentedListIterator<T, Shift> operator+(
+    typename SegmentedListIterator<T, Shift>::difference_type n,
+    const SegmentedListIterator<T, Shift>& it)
+{
+    return it + n;
+}
+
+//==============================================================================
+// SEGMENTEDLIST DECLARATION
+//==============================================================================
+
+/**
+ * @brief Implements a list which items are stored in fixed-size segments.
+ *
+ * @tparam T type of items in the list
+ * @tparam Alloc allocator to use for items
+ * @tparam CheckPolicy index checking policy (see List)
+ *
+ * Items are stored in segments of about 64 KiB (a power of two number of
+ * items) which addresses are kept in a table. Growing the list allocates a
+ * new segment and never moves existing items, so that:
+ *
+ * - append is constant time without the latency spike and the twice larger
+ *   memory peak of a std::vector reallocation
+ * - references and pointers to items stay valid until the item is removed
+ *   (only the segment table, one pointer per segment, is reallocated)
+ * - memory is released segment by segment by pop, remove and clear
+ *
+ * The price is on access: operator[] and iterators read the segment address
+ * in the table before reading the item, and split the index with a shift and
+ * a mask. This is one more dependent load than List::operator[] and prevents
+ * the compiler from vectorizing loops over the whole list. Searches
+ * (contains, index, count) run segment by segment on contiguous memory and
+ * are as fast as List ones.
+ *
+ * Insertion or removal elsewhere than at the end moves the following items
+ * by one slot, as with List.
+ *
+ * Fast methods of segmented list:
+ * - SegmentedList<T, Alloc>::append
+ * - SegmentedList<T, Alloc>::pop (with no index specified)
+ * - SegmentedList<T, Alloc>::operator[]
+ *
+ * Potentially slow methods because it requires to potentially navigate
+ * throug the whole list:
+ * - SegmentedList<T, Alloc>::contains
+ * - SegmentedList<T, Alloc>::index
+ * - SegmentedList<T, Alloc>::count
+ *
+ * Potentially slow methods because it causes an internal move of items:
+ * - SegmentedList<T, Alloc>::pop from anywhere in the list but last index
+ * - SegmentedList<T, Alloc>::insert
+ * - SegmentedList<T, Alloc>::remove
+ */
+template <typename T,
+          typename Alloc = std::allocator<T>,
+          typename CheckPolicy = PythonCheck>
+class SegmentedList
+{
+    private:
+
+    /**
+     * @typedef alloc_traits
+     * traits of the allocator
+     */
+    typedef std::allocator_traits<Alloc> alloc_traits;
+
+    public:
+
+    /**
+     * @typedef size_type
+     * size type for list
+     */
+    typedef std::size_t size_type;
+
+    /**
+     * @typedef value_type
+     * value type of list
+     */
+    typedef T value_type;
+
+    /**
+     * @typedef allocator_type
+     * allocator type of list
+     */
+    typedef Alloc allocator_type;
+
+    /**
+     * Base 2 logarithm of the number of items per segment.
+     */
+    static const size_type segmentShift =
+        detail::floorLog2((1 << 16) / sizeof(T));
+
+    /**
+     * Number of items per segment.
+     */
+    static const size_type segmentSize = size_type(1) << segmentShift;
+
+    /**
+     * @typedef iterator
+     * a random access iterator to SegmentedList<T, Alloc>::value_type
+     */
+    typedef SegmentedListIterator<T, segmentShift> iterator;
+
+    /**
+     * @typedef const_iterator
+     * a random access iterator to const SegmentedList<T, Alloc>::value_type
+     */
+    typedef SegmentedListIterator<const T, segmentShift> const_iterator;
+
+    /**
+     * @typedef reverse_iterator
+     * a random access reverse iterator to SegmentedList<T, Alloc>::value_type
+     */
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+
+    /**
+     * @typedef const_reverse_iterator
+     * a random access reverse iterator to const
+     * SegmentedList<T, Alloc>::value_type
+     */
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    /**
+     * @typedef index_type
+     * the index type for list is size_type
+     */
+    typedef size_type index_type;
+
+    public:
+
+    /**
+     * Constructor
+     *
+     * Creates an empty list.
+     *
+     * @param alloc allocator to use for items
+     */
+    SegmentedList(const allocator_type& alloc = allocator_type());
+
+    /**
+     * Constructor
+     *
+     * Creates a list from an initializer list.
+     *
+     * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * SegmentedList<int> list = {0, 1, 2, 3};
+     * ~~~~~~~~~~~~~~~~~~~~~
+     *
+     * @param il initializer list
+     * @param alloc allocator to use for items
+     */
+    SegmentedList(std::initializer_list<T> il,
+                  const allocator_type& alloc = allocator_type());
+
+    /**
+     * Copy constructor
+     *
+     * @param other existing list
+     */
+    SegmentedList(const SegmentedList<T, Alloc, CheckPolicy>& other);
+
+    /**
+     * Move constructor
+     *
+     * Segments are taken over: references to items remain valid.
+     *
+     * @param other existing list, left empty
+     */
+    SegmentedList(SegmentedList<T, Alloc, CheckPolicy>&& other) noexcept;
+
+    /**
+     * Destructor
+     */
+    virtual ~SegmentedList();
+
+    /**
+     * Assignment operator with another list
+     *
+     * @param other existing list
+     */
+    SegmentedList<T, Alloc, CheckPolicy>& operator=(
+        const SegmentedList<T, Alloc, CheckPolicy>& other);
+
+    /**
+     * Move assignment operator with another list
+     *
+     * @param other existing list
+     */
+    SegmentedList<T, Alloc, CheckPolicy>& operator=(
+        SegmentedList<T, Alloc, CheckPolicy>&& other) noexcept;
+
+    /**
+     * Return list size
+     *
+     * @return the number of items in the list
+     */
+    size_type size() const;
+
+    /**
+     * Return list capacity
+     *
+     * @return the number of items the allocated segments can hold
+     */
+    size_type capacity() const;
+
+    /**
+     * Return an item from the list at specified index.
+     *
+     * If specified index is negative, operator[] returns items from the end
+     * of the list.
+     *
+     * @param index index of item
+     * @throw IndexError if index is out of range (depends on CheckPolicy)
+     */
+    T& operator[](long index) throw(IndexError);
+
+    /**
+     * Return an item from the list at specified index.
+     *
+     * If specified index is negative, operator[] returns items from the end
+     * of the list.
+     *
+     * @param index index of item
+     * @throw IndexError if index is out of range (depends on CheckPolicy)
+     */
+    const T& operator[](long index) const throw(IndexError);
+
+    /**
+     * Item-wise equality comparison with another list.
+     *
+     * @param other list to be compared to
+     * @return true if both lists are equal
+     */
+    bool operator==(const SegmentedList<T, Alloc, CheckPolicy>& other) const;
+
+    /**
+     * Append an item at the end of the list.
+     *
+     * @param item item to be appended
+     */
+    void append(const T& item);
+
+    /**
+     * Append an item at the end of the list.
+     *
+     * @param item item to be appended
+     */
+    void append(T&& item);
+
+    /**
+     * Append all items of a container at the end of the list.
+     *
+     * The container may be the list itself: its items are then appended
+     * once.
+     *
+     * @tparam Container container type
+     * @param cont container which items are appended
+     */
+    template <typename Container>
+    void extend(const Container& cont);
+
+    /**
+     * Insert an item at given index.
+     *
+     * If index is negative, it is counted from the end of the list. Index is
+     * clamped to the list bounds like Python does.
+     *
+     * @param index index at which item is inserted
+     * @param item item to be inserted
+     */
+    void insert(long index, T item);
+
+    /**
+     * Remove and return item at given index (last one by default).
+     *
+     * Removing the last item of a segment releases the segment, but one
+     * spare segment is kept to avoid repeated allocations when appending and
+     * popping around a segment boundary.
+     *
+     * @param index index of item
+     * @throw IndexError if list is empty or index is out of range
+     */
+    T pop(long index = -1) throw(IndexError);
+
+    /**
+     * Check wether a given item is in the list
+     *
+     * @param item item to be looked for
+     */
+    bool contains(const T& item) const;
+
+    /**
+     * Return the index of item in the list.
+     *
+     * @param item to be looked for
+     * @throw ValueError if item is not in list
+     */
+    size_type index(const T& item) const throw(ValueError);
+
+    /**
+     * Count number of occurences of given item.
+     *
+     * @param item item to count
+     */
+    size_type count(const T& item) const;
+
+    /**
+     * Remove the first item in the list with specified value.
+     *
+     * @param item item to be removed from the list
+     * @throw ValueError if item is not in list
+     */
+    void remove(const T& item) throw(ValueError);
+
+    /**
+     * Reverse list in place.
+     */
+    void reverse();
+
+    /**
+     * Sort list with operator< of T.
+     */
+    void sort();
+
+    /**
+     * Sort list with a comparator.
+     *
+     * @tparam Compare comparator type
+     * @param comp comparator
+     */
+    template <typename Compare>
+    void sort(const Compare& comp);
+
+    /**
+     * Clear all items from the list.
+     *
+     * All segments are released.
+     */
+    void clear();
+
+    /**
+     * Iterator to the begin of the list.
+     */
+    iterator begin();
+
+    /**
+     * Const iterator to the begin of the list.
+     */
+    const_iterator begin() const;
+
+    /**
+     * Iterator to the end of the list.
+     */
+    iterator end();
+
+    /**
+     * Const iterator to the end of the list.
+     */
+    const_iterator end() const;
+
+    /**
+     * Reverse iterator to the reverse begining of the list.
+     */
+    reverse_iterator rbegin();
+
+    /**
+     * Const reverse iterator to the reverse begining of the list.
+     */
+    const_reverse_iterator rbegin() const;
+
+    /**
+     * Reverse iterator to the reverse end of the list.
+     */
+    reverse_iterator rend();
+
+    /**
+     * Const reverse iterator to the reverse end of the list.
+     */
+    const_reverse_iterator rend() const;
+
+    private:
+
+    /**
+     * Return item at given position (no check).
+     */
+    T& item(size_type pos) const;
+
+    /**
+     * Return the position of the first item equal to given one, or size.
+     */
+    size_type find(const T& item) const;
+
+    /**
+     * Make room for one more item at the end of the list.
+     */
+    void reserveOne();
+
+    /**
+     * Destroy last item and release spare segments.
+     */
+    void destroyLast();
+
+    /**
+     * Destroy all items and release all segments.
+     */
+    void release();
+
+    /**
+     * Attributes
+     */
+    Alloc m_alloc;
+    std::vector<T*> m_segments;
+    size_type m_size;
+
+}; // end of SegmentedList class
+
+//==============================================================================
+// SEGMENTEDLIST DEFINITION
+//==============================================================================
+
+template <typename T, typename Alloc, typename CheckPolicy>
+const typename SegmentedList<T, Alloc, CheckPolicy>::size_type
+SegmentedList<T, Alloc, CheckPolicy>::segmentShift;
+
+template <typename T, typename Alloc, typename CheckPolicy>
+const typename SegmentedList<T, Alloc, CheckPolicy>::size_type
+SegmentedList<T, Alloc, CheckPolicy>::segmentSize;
+
+//Constructor
+
+template <typename T, typename Alloc, typename CheckPolicy>
+SegmentedList<T, Alloc, CheckPolicy>::SegmentedList(
+    const allocator_type& alloc):
+    m_alloc(alloc), m_size(0) { };
+
+template <typename T, typename Alloc, typename CheckPolicy>
+SegmentedList<T, Alloc, CheckPolicy>::SegmentedList(
+    std::initializer_list<T> il, const allocator_type& alloc):
+    m_alloc(alloc), m_size(0)
+{
+    extend(il);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+SegmentedList<T, Alloc, CheckPolicy>::SegmentedList(
+    const SegmentedList<T, Alloc, CheckPolicy>& other):
+    m_alloc(alloc_traits::select_on_container_copy_construction(other.m_alloc)),
+    m_size(0)
+{
+    extend(other);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+SegmentedList<T, Alloc, CheckPolicy>::SegmentedList(
+    SegmentedList<T, Alloc, CheckPolicy>&& other) noexcept:
+    m_alloc(std::move(other.m_alloc)),
+    m_segments(std::move(other.m_segments)), m_size(other.m_size)
+{
+    other.m_segments.clear();
+    other.m_size = 0;
+}
+
+//Destructor
+
+template <typename T, typename Alloc, typename CheckPolicy>
+SegmentedList<T, Alloc, CheckPolicy>::~SegmentedList()
+{
+    release();
+}
+
+//Assignment operator
+
+template <typename T, typename Alloc, typename CheckPolicy>
+SegmentedList<T, Alloc, CheckPolicy>&
+SegmentedList<T, Alloc, CheckPolicy>::operator=(
+    const SegmentedList<T, Alloc, CheckPolicy>& other)
+{
+    if (this != &other)
+    {
+        clear();
+        extend(other);
+    }
+    return *this;
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+SegmentedList<T, Alloc, CheckPolicy>&
+SegmentedList<T, Alloc, CheckPolicy>::operator=(
+    SegmentedList<T, Alloc, CheckPolicy>&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        std::swap(m_segments, other.m_segments);
+        std::swap(m_size, other.m_size);
+    }
+    return *this;
+}
+
+//size and capacity methods
+
+template <typename T, typename Alloc, typename CheckPolicy>
+typename SegmentedList<T, Alloc, CheckPolicy>::size_type
+SegmentedList<T, Alloc, CheckPolicy>::size() const
+{
+    return m_size;
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+typename SegmentedList<T, Alloc, CheckPolicy>::size_type
+SegmentedList<T, Alloc, CheckPolicy>::capacity() const
+{
+    return m_segments.size() * segmentSize;
+}
+
+//private helpers
+
+template <typename T, typename Alloc, typename CheckPolicy>
+T& SegmentedList<T, Alloc, CheckPolicy>::item(size_type pos) const
+{
+    return m_segments[pos >> segmentShift][pos & (segmentSize - 1)];
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+typename SegmentedList<T, Alloc, CheckPolicy>::size_type
+SegmentedList<T, Alloc, CheckPolicy>::find(const T& value) const
+{
+    //each segment is contiguous: search it with findItem
+    for (size_type first = 0; first < m_size; first += segmentSize)
+    {
+        const T* segment = m_segments[first >> segmentShift];
+        size_type n = std::min(segmentSize, m_size - first);
+        size_type pos = findItem(segment, segment + n, value) - segment;
+        if (pos < n)
+            return first + pos;
+    }
+    return m_size;
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void SegmentedList<T, Alloc, CheckPolicy>::reserveOne()
+{
+    if (m_size == capacity())
+        m_segments.push_back(alloc_traits::allocate(m_alloc, segmentSize));
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void SegmentedList<T, Alloc, CheckPolicy>::destroyLast()
+{
+    --m_size;
+    alloc_traits::destroy(m_alloc, &item(m_size));
+    //keep the segment of the end of list and one spare segment
+    size_type used = (m_size + segmentSize - 1) >> segmentShift;
+    while (m_segments.size() > used + 1)
+    {
+        alloc_traits::deallocate(m_alloc, m_segments.back(), segmentSize);
+        m_segments.pop_back();
+    }
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void SegmentedList<T, Alloc, CheckPolicy>::release()
+{
+    for (size_type i = 0; i < m_size; ++i)
+        alloc_traits::destroy(m_alloc, &item(i));
+    m_size = 0;
+    for (size_type k = 0; k < m_segments.size(); ++k)
+        alloc_traits::deallocate(m_alloc, m_segments[k], segmentSize);
+    m_segments.clear();
+}
+
+//operator[]
+
+template <typename T, typename Alloc, typename CheckPolicy>
+T& SegmentedList<T, Alloc, CheckPolicy>::operator[](long index)
+    throw(IndexError)
+{
+    return item(CheckPolicy::position(index, m_size));
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+const T& SegmentedList<T, Alloc, CheckPolicy>::operator[](long index) const
+    throw(IndexError)
+{
+    return item(CheckPolicy::position(index, m_size));
+}
+
+//operator==
+
+template <typename T, typename Alloc, typename CheckPolicy>
+bool SegmentedList<T, Alloc, CheckPolicy>::operator==(
+    const SegmentedList<T, Alloc, CheckPolicy>& other) const
+{
+    if (m_size != other.m_size)
+        return false;
+    return std::equal(begin(), end(), other.begin());
+}
+
+//append methods
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void SegmentedList<T, Alloc, CheckPolicy>::append(const T& value)
+{
+    reserveOne();
+    alloc_traits::construct(m_alloc, &item(m_size), value);
+    ++m_size;
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void SegmentedList<T, Alloc, CheckPolicy>::append(T&& value)
+{
+    reserveOne();
+    alloc_traits::construct(m_alloc, &item(m_size), std::move(value));
+    ++m_size;
+}
+
+//extend method
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename Container>
+void SegmentedList<T, Alloc, CheckPolicy>::extend(const Container& cont)
+{
+    if (static_cast<const void*>(&cont) == static_cast<const void*>(this))
+    {
+        //end moves while appending: stop at the initial size. Items never
+        //move, so that appended references stay valid.
+        size_type n = m_size;
+        for (size_type i = 0; i < n; ++i)
+            append(item(i));
+        return;
+    }
+    for (auto it = cont.begin(); it != cont.end(); ++it)
+        append(*it);
+}
+
+//insert method
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void SegmentedList<T, Alloc, CheckPolicy>::insert(long index, T value)
+{
+    long size = long(m_size);
+    if (index < 0)
+        index = std::max(index + size, 0L);
+    if (index >= size)
+    {
+        append(std::move(value));
+        return;
+    }
+    append(std::move(item(m_size - 1)));
+    std::move_backward(begin() + index, end() - 2, end() - 1);
+    item(index) = std::move(value);
+}
+
+//pop method
+
+template <typename T, typename Alloc, typename CheckPolicy>
+T SegmentedList<T, Alloc, CheckPolicy>::pop(long index) throw(IndexError)
+{
+    if (m_size == 0)
+        THROW(IndexError, "pop from an empty list");
+    size_type pos = CheckPolicy::position(index, m_size);
+    T value(std::move(item(pos)));
+    std::move(begin() + pos + 1, end(), begin() + pos);
+    destroyLast();
+    return value;
+}
+
+//search methods
+
+template <typename T, typename Alloc, typename CheckPolicy>
+bool SegmentedList<T, Alloc, CheckPolicy>::contains(const T& value) const
+{
+    return find(value) != m_size;
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+typename SegmentedList<T, Alloc, CheckPolicy>::size_type
+SegmentedList<T, Alloc, CheckPolicy>::index(const T& value) const
+    throw(ValueError)
+{
+    size_type pos = find(value);
+    if (pos == m_size)
+        THROW(ValueError, "value not in list");
+    return pos;
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+typename SegmentedList<T, Alloc, CheckPolicy>::size_type
+SegmentedList<T, Alloc, CheckPolicy>::count(const T& value) const
+{
+    size_type total = 0;
+    for (size_type first = 0; first < m_size; first += segmentSize)
+    {
+        const T* segment = m_segments[first >> segmentShift];
+        size_type n = std::min(segmentSize, m_size - first);
+        total += countItem(segment, segment + n, value);
+    }
+    return total;
+}
+
+//remove method
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void SegmentedList<T, Alloc, CheckPolicy>::remove(const T& value)
+    throw(ValueError)
+{
+    size_type pos = index(value);
+    std::move(begin() + pos + 1, end(), begin() + pos);
+    destroyLast();
+}
+
+//reverse and sort methods
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void SegmentedList<T, Alloc, CheckPolicy>::reverse()
+{
+    std::reverse(begin(), end());
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void SegmentedList<T, Alloc, CheckPolicy>::sort()
+{
+    std::sort(begin(), end());
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+template <typename Compare>
+void SegmentedList<T, Alloc, CheckPolicy>::sort(const Compare& comp)
+{
+    std::sort(begin(), end(), comp);
+}
+
+//clear method
+
+template <typename T, typename Alloc, typename CheckPolicy>
+void SegmentedList<T, Alloc, CheckPolicy>::clear()
+{
+    release();
+}
+
+//forward iterators
+
+template <typename T, typename Alloc, typename CheckPolicy>
+typename SegmentedList<T, Alloc, CheckPolicy>::iterator
+SegmentedList<T, Alloc, CheckPolicy>::begin()
+{
+    return iterator(&m_segments, 0);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+typename SegmentedList<T, Alloc, CheckPolicy>::const_iterator
+SegmentedList<T, Alloc, CheckPolicy>::begin() const
+{
+    return const_iterator(&m_segments, 0);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+typename SegmentedList<T, Alloc, CheckPolicy>::iterator
+SegmentedList<T, Alloc, CheckPolicy>::end()
+{
+    return iterator(&m_segments, m_size);
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+typename SegmentedList<T, Alloc, CheckPolicy>::const_iterator
+SegmentedList<T, Alloc, CheckPolicy>::end() const
+{
+    return const_iterator(&m_segments, m_size);
+}
+
+//reverse iterators
+
+template <typename T, typename Alloc, typename CheckPolicy>
+typename SegmentedList<T, Alloc, CheckPolicy>::reverse_iterator
+SegmentedList<T, Alloc, CheckPolicy>::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+typename SegmentedList<T, Alloc, CheckPolicy>::const_reverse_iterator
+SegmentedList<T, Alloc, CheckPolicy>::rbegin() const
+{
+    return const_reverse_iterator(end());
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+typename SegmentedList<T, Alloc, CheckPolicy>::reverse_iterator
+SegmentedList<T, Alloc, CheckPolicy>::rend()
+{
+    return reverse_iterator(begin());
+}
+
+template <typename T, typename Alloc, typename CheckPolicy>
+typename SegmentedList<T, Alloc, CheckPolicy>::const_reverse_iterator
+SegmentedList<T, Alloc, CheckPolicy>::rend() const
+{
+    return const_reverse_iterator(begin());
+}
+
+} //end of snowball namespace
+
+#endif
@@ -0,0 +1,408 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "simd_search.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SNOWBALL_SIMD_X86
+#include <immintrin.h>
+#define SNOWBALL_TARGET_SSE2 __attribute__((target("sse2")))
+#define SNOWBALL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+using namespace snowball;
+
+namespace
+{
+
+//=============================================================================
+// Scalar kernels
+//=============================================================================
+
+template <typename T>
+std::size_t scalarFind(const T* data, std::size_t n, T value)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (data[i] == value)
+            return i;
+    }
+    return n;
+}
+
+template <typename T>
+std::size_t scalarCount(const T* data, std::size_t n, T value)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        count += data[i] == value;
+    return count;
+}
+
+#ifdef SNOWBALL_SIMD_X86
+
+//=============================================================================
+// Vector operations
+//
+// Each structure gives, for an instruction set and a type, the number of
+// items in a vector, a broadcast of value and the comparison of a vector
+// loaded from memory with it as a bit mask (bit i set if item i matches).
+//=============================================================================
+
+struct Sse2Int32
+{
+    typedef std::int32_t scalar;
+    typedef __m128i vector;
+    static const std::size_t width = 4;
+
+    SNOWBALL_TARGET_SSE2 static vector broadcast(scalar value)
+    {
+        return _mm_set1_epi32(value);
+    }
+
+    SNOWBALL_TARGET_SSE2 static unsigned match(const scalar* p, vector v)
+    {
+        __m128i items = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(items, v)));
+    }
+};
+
+struct Sse2Int64
+{
+    typedef std::int64_t scalar;
+    typedef __m128i vector;
+    static const std::size_t width = 2;
+
+    SNOWBALL_TARGET_SSE2 static vector broadcast(scalar value)
+    {
+        return _mm_set1_epi64x(value);
+    }
+
+    SNOWBALL_TARGET_SSE2 static unsigned match(const scalar* p, vector v)
+    {
+        //no 64-bit comparison in SSE2: both 32-bit halves must match
+        __m128i items = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i halves = _mm_cmpeq_epi32(items, v);
+        __m128i swapped = _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1));
+        return _mm_movemask_pd(_mm_castsi128_pd(_mm_and_si128(halves,
+                                                               swapped)));
+    }
+};
+
+struct Sse2Float
+{
+    typedef float scalar;
+    typedef __m128 vector;
+    static const std::size_t width = 4;
+
+    SNOWBALL_TARGET_SSE2 static vector broadcast(scalar value)
+    {
+        return _mm_set1_ps(value);
+    }
+
+    SNOWBALL_TARGET_SSE2 static unsigned match(const scalar* p, vector v)
+    {
+        return _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p), v));
+    }
+};
+
+struct Sse2Double
+{
+    typedef double scalar;
+    typedef __m128d vector;
+    static const std::size_t width = 2;
+
+    SNOWBALL_TARGET_SSE2 static vector broadcast(scalar value)
+    {
+        return _mm_set1_pd(value);
+    }
+
+    SNOWBALL_TARGET_SSE2 static unsigned match(const scalar* p, vector v)
+    {
+        return _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p), v));
+    }
+};
+
+struct Avx2Int32
+{
+    typedef std::int32_t scalar;
+    typedef __m256i vector;
+    static const std::size_t width = 8;
+
+    SNOWBALL_TARGET_AVX2 static vector broadcast(scalar value)
+    {
+        return _mm256_set1_epi32(value);
+    }
+
+    SNOWBALL_TARGET_AVX2 static unsigned match(const scalar* p, vector v)
+    {
+        __m256i items = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        return _mm256_movemask_ps(_mm256_castsi256_ps(
+            _mm256_cmpeq_epi32(items, v)));
+    }
+};
+
+struct Avx2Int64
+{
+    typedef std::int64_t scalar;
+    typedef __m256i vector;
+    static const std::size_t width = 4;
+
+    SNOWBALL_TARGET_AVX2 static vector broadcast(scalar value)
+    {
+        return _mm256_set1_epi64x(value);
+    }
+
+    SNOWBALL_TARGET_AVX2 static unsigned match(const scalar* p, vector v)
+    {
+        __m256i items = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        return _mm256_movemask_pd(_mm256_castsi256_pd(
+            _mm256_cmpeq_epi64(items, v)));
+    }
+};
+
+struct Avx2Float
+{
+    typedef float scalar;
+    typedef __m256 vector;
+    static const std::size_t width = 8;
+
+    SNOWBALL_TARGET_AVX2 static vector broadcast(scalar value)
+    {
+        return _mm256_set1_ps(value);
+    }
+
+    SNOWBALL_TARGET_AVX2 static unsigned match(const scalar* p, vector v)
+    {
+        return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p), v,
+                                                _CMP_EQ_OQ));
+    }
+};
+
+struct Avx2Double
+{
+    typedef double scalar;
+    typedef __m256d vector;
+    static const std::size_t width = 4;
+
+    SNOWBALL_TARGET_AVX2 static vector broadcast(scalar value)
+    {
+        return _mm256_set1_pd(value);
+    }
+
+    SNOWBALL_TARGET_AVX2 static unsigned match(const scalar* p, vector v)
+    {
+        return _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p), v,
+                                                _CMP_EQ_OQ));
+    }
+};
+
+//=============================================================================
+// Vector kernels
+//
+// Four vectors are compared per iteration to hide comparison latency. The
+// kernels are defined once per instruction set so that the operations above
+// are inlined with the right target.
+//=============================================================================
+
+#define SNOWBALL_SIMD_KERNELS(SUFFIX, TARGET)                                  \
+template <typename Ops>                                                        \
+TARGET std::size_t find##SUFFIX(const typename Ops::scalar* data,              \
+                                std::size_t n, typename Ops::scalar value)     \
+{                                                                              \
+    const std::size_t w = Ops::width;                                          \
+    typename Ops::vector v = Ops::broadcast(value);                            \
+    std::size_t i = 0;                                                         \
+    for (; i + 4 * w <= n; i += 4 * w)                                         \
+    {                                                                          \
+        unsigned m0 = Ops::match(data + i, v);                                 \
+        unsigned m1 = Ops::match(data + i + w, v);                             \
+        unsigned m2 = Ops::match(data + i + 2 * w, v);                         \
+        unsigned m3 = Ops::match(data + i + 3 * w, v);                         \
+        if ((m0 | m1 | m2 | m3) != 0)                                          \
+        {                                                                      \
+            unsigned mask = m0 | (m1 << w) | (m2 << 2 * w) | (m3 << 3 * w);    \
+            return i + __builtin_ctz(mask);                                    \
+        }                                                                      \
+    }                                                                          \
+    for (; i + w <= n; i += w)                                                 \
+    {                                                                          \
+        unsigned mask = Ops::match(data + i, v);                               \
+        if (mask != 0)                                                         \
+            return i + __builtin_ctz(mask);                                    \
+    }                                                                          \
+    return i + scalarFind(data + i, n - i, value);                             \
+}                                                                              \
+                                                                               \
+template <typename Ops>                                                        \
+TARGET std::size_t count##SUFFIX(const typename Ops::scalar* data,             \
+                                 std::size_t n, typename Ops::scalar value)    \
+{                                                                              \
+    const std::size_t w = Ops::width;                                          \
+    typename Ops::vector v = Ops::broadcast(value);                            \
+    std::size_t count = 0;                                                     \
+    std::size_t i = 0;                                                         \
+    for (; i + 4 * w <= n; i += 4 * w)                                         \
+    {                                                                          \
+        unsigned mask = Ops::match(data + i, v)                                \
+                      | (Ops::match(data + i + w, v) << w)                     \
+                      | (Ops::match(data + i + 2 * w, v) << 2 * w)             \
+                      | (Ops::match(data + i + 3 * w, v) << 3 * w);            \
+        count += __builtin_popcount(mask);                                     \
+    }                                                                          \
+    return count + scalarCount(data + i, n - i, value);                        \
+}
+
+SNOWBALL_SIMD_KERNELS(Sse2, SNOWBALL_TARGET_SSE2)
+SNOWBALL_SIMD_KERNELS(Avx2, SNOWBALL_TARGET_AVX2)
+
+#undef SNOWBALL_SIMD_KERNELS
+
+/*
+ * Whether AVX2 kernels may be used.
+ */
+bool hasAvx2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif
+
+//=============================================================================
+// Runtime dispatch
+//=============================================================================
+
+template <typename T>
+struct Kernels
+{
+    typedef std::size_t (*Function)(const T*, std::size_t, T);
+    Function find;
+    Function count;
+};
+
+#ifdef SNOWBALL_SIMD_X86
+
+template <typename Sse2, typename Avx2>
+Kernels<typename Sse2::scalar> selectKernels()
+{
+    typedef typename Sse2::scalar T;
+    if (hasAvx2())
+    {
+        Kernels<T> kernels = {&findAvx2<Avx2>, &countAvx2<Avx2>};
+        return kernels;
+    }
+    Kernels<T> kernels = {&findSse2<Sse2>, &countSse2<Sse2>};
+    return kernels;
+}
+
+const Kernels<std::int32_t>& kernels(std::int32_t)
+{
+    static const Kernels<std::int32_t> k = selectKernels<Sse2Int32, Avx2Int32>();
+    return k;
+}
+
+const Kernels<std::int64_t>& kernels(std::int64_t)
+{
+    static const Kernels<std::int64_t> k = selectKernels<Sse2Int64, Avx2Int64>();
+    return k;
+}
+
+const Kernels<float>& kernels(float)
+{
+    static const Kernels<float> k = selectKernels<Sse2Float, Avx2Float>();
+    return k;
+}
+
+const Kernels<double>& kernels(double)
+{
+    static const Kernels<double> k = selectKernels<Sse2Double, Avx2Double>();
+    return k;
+}
+
+#else
+
+template <typename T>
+const Kernels<T>& kernels(T)
+{
+    static const Kernels<T> k = {&scalarFind<T>, &scalarCount<T>};
+    return k;
+}
+
+#endif
+
+} //end of anonymous namespace
+
+//=============================================================================
+// Public kernels
+//=============================================================================
+
+std::size_t detail::simdFind(const std::int32_t* data, std::size_t n,
+                             std::int32_t value)
+{
+    return kernels(value).find(data, n, value);
+}
+
+std::size_t detail::simdFind(const std::int64_t* data, std::size_t n,
+                             std::int64_t value)
+{
+    return kernels(value).find(data, n, value);
+}
+
+std::size_t detail::simdFind(const float* data, std::size_t n, float value)
+{
+    return kernels(value).find(data, n, value);
+}
+
+std::size_t detail::simdFind(const double* data, std::size_t n, double value)
+{
+    return kernels(value).find(data, n, value);
+}
+
+std::size_t detail::simdCount(const std::int32_t* data, std::size_t n,
+                              std::int32_t value)
+{
+    return kernels(value).count(data, n, value);
+}
+
+std::size_t detail::simdCount(const std::int64_t* data, std::size_t n,
+                              std::int64_t value)
+{
+    return kernels(value).count(data, n, value);
+}
+
+std::size_t detail::simdCount(const float* data, std::size_t n, float value)
+{
+    return kernels(value).count(data, n, value);
+}
+
+std::size_t detail::simdCount(const double* data, std::size_t n,
+                              double value)
+{
+    return kernels(value).count(data, n, value);
+}
+
+const char* detail::simdInstructionSet()
+{
+#ifdef SNOWBALL_SIMD_X86
+    static const char* name = hasAvx2() ? "avx2" : "sse2";
+    return name;
+#else
+    return "scalar";
+#endif
+}
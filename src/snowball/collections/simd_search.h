@@ -0,0 +1,216 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_SIMD_SEARCH_H
+#define SNOWBALL_SIMD_SEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+namespace snowball
+{
+
+namespace detail
+{
+
+/**
+ * Vectorized linear search kernels.
+ *
+ * The instruction set is selected once at runtime: AVX2 if the CPU supports
+ * it, else SSE2 on x86-64 and a scalar loop on other targets. Floating point
+ * values are compared with operator== semantics (NaN never matches, -0.0
+ * matches 0.0).
+ *
+ * simdFind returns the position of the first item equal to value, or n if
+ * there is none. simdCount returns the number of items equal to value.
+ */
+std::size_t simdFind(const std::int32_t* data, std::size_t n,
+                     std::int32_t value);
+std::size_t simdFind(const std::int64_t* data, std::size_t n,
+                     std::int64_t value);
+std::size_t simdFind(const float* data, std::size_t n, float value);
+std::size_t simdFind(const double* data, std::size_t n, double value);
+
+std::size_t simdCount(const std::int32_t* data, std::size_t n,
+                      std::int32_t value);
+std::size_t simdCount(const std::int64_t* data, std::size_t n,
+                      std::int64_t value);
+std::size_t simdCount(const float* data, std::size_t n, float value);
+std::size_t simdCount(const double* data, std::size_t n, double value);
+
+/**
+ * Return the name of the instruction set used by kernels: "avx2", "sse2" or
+ * "scalar".
+ */
+const char* simdInstructionSet();
+
+} //end of namespace detail
+
+/**
+ * @brief Whether items of type T can be searched with SIMD kernels.
+ *
+ * Integral types of 4 or 8 bytes (compared bitwise) as well as float and
+ * double are. The scalar typedef is the type kernels work on.
+ *
+ * @tparam T type of items
+ */
+template <typename T, typename Enable = void>
+struct SimdSearch
+{
+    static const bool enabled = false;
+};
+
+template <typename T>
+struct SimdSearch<T, typename std::enable_if<std::is_integral<T>::value &&
+                     !std::is_same<T, bool>::value && sizeof(T) == 4>::type>
+{
+    static const bool enabled = true;
+    typedef std::int32_t scalar;
+};
+
+template <typename T>
+struct SimdSearch<T, typename std::enable_if<std::is_integral<T>::value &&
+                     sizeof(T) == 8>::type>
+{
+    static const bool enabled = true;
+    typedef std::int64_t scalar;
+};
+
+template <>
+struct SimdSearch<float>
+{
+    static const bool enabled = true;
+    typedef float scalar;
+};
+
+template <>
+struct SimdSearch<double>
+{
+    static const bool enabled = true;
+    typedef double scalar;
+};
+
+/**
+ * Return iterator to the first item of contiguous range [first, last) equal
+ * to value, or last.
+ *
+ * This is std::find, vectorized when SimdSearch is enabled for T and T is
+ * the type of items.
+ *
+ * @tparam Iterator contiguous iterator
+ * @tparam T type of items
+ * @param first beginning of range
+ * @param last end of range
+ * @param value value to be looked for
+ */
+template <typename Iterator, typename T>
+Iterator findItem(Iterator first, Iterator last, const T& value);
+
+/**
+ * Return the number of items of contiguous range [first, last) equal to
+ * value.
+ *
+ * This is std::count, vectorized when SimdSearch is enabled for T and T is
+ * the type of items.
+ *
+ * @tparam Iterator contiguous iterator
+ * @tparam T type of items
+ * @param first beginning of range
+ * @param last end of range
+ * @param value value to be counted
+ */
+template <typename Iterator, typename T>
+std::size_t countItem(Iterator first, Iterator last, const T& value);
+
+//=============================================================================
+// Implementation
+//=============================================================================
+
+namespace detail
+{
+
+template <typename Iterator, typename T>
+Iterator findItem(Iterator first, Iterator last, const T& value,
+                  std::true_type)
+{
+    typedef typename SimdSearch<T>::scalar Scalar;
+    std::size_t n = last - first;
+    if (n == 0)
+        return last;
+    const Scalar* data = reinterpret_cast<const Scalar*>(&*first);
+    return first + simdFind(data, n, Scalar(value));
+}
+
+template <typename Iterator, typename T>
+Iterator findItem(Iterator first, Iterator last, const T& value,
+                  std::false_type)
+{
+    return std::find(first, last, value);
+}
+
+template <typename Iterator, typename T>
+std::size_t countItem(Iterator first, Iterator last, const T& value,
+                      std::true_type)
+{
+    typedef typename SimdSearch<T>::scalar Scalar;
+    std::size_t n = last - first;
+    if (n == 0)
+        return 0;
+    const Scalar* data = reinterpret_cast<const Scalar*>(&*first);
+    return simdCount(data, n, Scalar(value));
+}
+
+template <typename Iterator, typename T>
+std::size_t countItem(Iterator first, Iterator last, const T& value,
+                      std::false_type)
+{
+    return std::count(first, last, value);
+}
+
+} //end of namespace detail
+
+template <typename Iterator, typename T>
+Iterator findItem(Iterator first, Iterator last, const T& value)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type Item;
+    //value of another type would have to be converted: leave it to std
+    return detail::findItem(first, last, value,
+        std::integral_constant<bool, SimdSearch<Item>::enabled &&
+                                     std::is_same<Item, T>::value>());
+}
+
+template <typename Iterator, typename T>
+std::size_t countItem(Iterator first, Iterator last, const T& value)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type Item;
+    //value of another type would have to be converted: leave it to std
+    return detail::countItem(first, last, value,
+        std::integral_constant<bool, SimdSearch<Item>::enabled &&
+                                     std::is_same<Item, T>::value>());
+}
+
+} //end of namespace snowball
+
+#endif
@@ -0,0 +1,997 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_SMALL_LIST_HPP
+#define SNOWBALL_SMALL_LIST_HPP
+
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <initializer_list>
+
+#include "snowball/exceptions/exceptions.h"
+#include "check_policy.hpp"
+
+namespace snowball
+{
+
+//==============================================================================
+// SMALLLIST DECLARATION
+//==============================================================================
+
+/**
+ * @brief Implements a list storing its first items inline.
+ *
+ * @tparam T type of items in the list
+ * @tparam N number of items stored inline
+ * @tparam Alloc allocator to use for items once list spills to the heap
+ * @tparam CheckPolicy index check policy of operator[]
+ *
+ * SmallList has the same interface than List. Up to N items are stored in
+ * the object itself: short lists never allocate. When the list grows beyond
+ * N items, items are moved to a buffer allocated on the heap which capacity
+ * is doubled when full, like std::vector.
+ *
+ * The downside is that moving a SmallList which items are stored inline
+ * moves every item, and that sizeof(SmallList) grows with N.
+ *
+ * Iterators are plain pointers. They are invalidated by any insertion or
+ * removal.
+ */
+template <typename T,
+          std::size_t N,
+          typename Alloc = std::allocator<T>,
+          typename CheckPolicy = PythonCheck>
+class SmallList
+{
+    static_assert(N > 0, "SmallList requires at least one inline item");
+
+    private:
+
+    /**
+     * @typedef alloc_traits
+     * traits of the allocator
+     */
+    typedef std::allocator_traits<Alloc> alloc_traits;
+
+    public:
+
+    /**
+     * @typedef size_type
+     * size type for list
+     */
+    typedef std::size_t size_type;
+
+    /**
+     * @typedef value_type
+     * value type of list
+     */
+    typedef T value_type;
+
+    /**
+     * @typedef allocator_type
+     * allocator type of list
+     */
+    typedef Alloc allocator_type;
+
+    /**
+     * @typedef iterator
+     * a random access iterator to SmallList::value_type
+     */
+    typedef T* iterator;
+
+    /**
+     * @typedef const_iterator
+     * a random access iterator to const SmallList::value_type
+     */
+    typedef const T* const_iterator;
+
+    /**
+     * @typedef reverse_iterator
+     * a random access reverse iterator to SmallList::value_type
+     */
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+
+    /**
+     * @typedef const_reverse_iterator
+     * a random access reverse iterator to const SmallList::value_type
+     */
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    /**
+     * @typedef index_type
+     * the index type for list is size_type
+     */
+    typedef size_type index_type;
+
+    public:
+
+    /**
+     * Constructor
+     *
+     * Creates an empty list.
+     *
+     * @param alloc allocator to use for items
+     */
+    SmallList(const allocator_type& alloc = allocator_type());
+
+    /**
+     * Constructor
+     *
+     * Creates a list from an initializer list
+     *
+     * @param il initializer list
+     * @param alloc allocator to use for items
+     */
+    SmallList(std::initializer_list<T> il,
+              const allocator_type& alloc = allocator_type());
+
+    /**
+     * Constructor
+     *
+     * Creates a list with duplicated constant value
+     *
+     * @param number number of copies
+     * @param value constant value
+     * @param alloc allocator to use for items
+     */
+    SmallList(size_type number, const T& value,
+              const allocator_type& alloc = allocator_type());
+
+    /**
+     * Copy constructor
+     *
+     * @param other existing list
+     */
+    SmallList(const SmallList& other);
+
+    /**
+     * Move constructor
+     *
+     * If other list spilled to the heap, its buffer is stolen. Otherwise its
+     * items are moved one by one. The other list is left empty.
+     *
+     * It does not throw unless moving an item throws, so that containers of
+     * small lists move them when they grow.
+     *
+     * @param other existing list
+     */
+    SmallList(SmallList&& other)
+        noexcept(std::is_nothrow_move_constructible<T>::value);
+
+    /**
+     * Destructor
+     */
+    virtual ~SmallList();
+
+    /**
+     * Assignment operator with another list
+     *
+     * @param other existing list
+     */
+    SmallList& operator=(const SmallList& other);
+
+    /**
+     * Move assignment operator with another list
+     *
+     * The heap buffer of other list is stolen when its allocator is
+     * propagated or compares equal to the one of current list. Otherwise
+     * items are moved one by one into a buffer of current allocator.
+     *
+     * @param other existing list, left empty
+     */
+    SmallList& operator=(SmallList&& other)
+        noexcept(std::is_nothrow_move_constructible<T>::value &&
+                 alloc_traits::propagate_on_container_move_assignment::value);
+
+    /**
+     * Assignment operator from an initializer list
+     *
+     * @param il initializer list
+     */
+    SmallList& operator=(std::initializer_list<T> il);
+
+    /**
+     * Return list size
+     *
+     * @return the number of items in the list
+     */
+    size_type size() const;
+
+    /**
+     * Return the number of items the list can hold without allocating.
+     */
+    size_type capacity() const;
+
+    /**
+     * Stat whether items are stored inline (no heap allocation).
+     */
+    bool isInline() const;
+
+    /**
+     * Make sure the list can hold given number of items without
+     * reallocating.
+     *
+     * @param capacity number of items
+     */
+    void reserve(size_type capacity);
+
+    /**
+     * Return an item from the list at specified index.
+     *
+     * If specified index is negative, operator[] returns items from the end
+     * of the list.
+     *
+     * @param index index of item
+     * @throw IndexError if index is out of range (PythonCheck policy only)
+     */
+    T& operator[](long index) throw(IndexError);
+
+    /**
+     * Return an item from the list at specified index.
+     *
+     * If specified index is negative, operator[] returns items from the end
+     * of the list.
+     *
+     * @param index index of item
+     * @throw IndexError if index is out of range (PythonCheck policy only)
+     */
+    const T& operator[](long index) const throw(IndexError);
+
+    /**
+     * Item-wise equality comparison with another list.
+     *
+     * @param other list to be compared to
+     * @return true if both lists are equal
+     */
+    bool operator==(const SmallList& other) const;
+
+    /**
+     * Append an item to the end of the list
+     *
+     * @param item item to be append
+     */
+    void append(const T& item);
+
+    /**
+     * Append an item to the end of the list
+     *
+     * @param item item to be append
+     */
+    void append(T&& item);
+
+    /**
+     * Construct an item in place at the end of the list
+     *
+     * @param args arguments of the constructor of T
+     */
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    /**
+     * Insert an item in the list before specified index
+     *
+     * Like List<T, Alloc>::insert, index is clamped to the list bounds.
+     *
+     * @param index index where item is going to be inserted
+     * @param item item to be inserted
+     */
+    void insert(long index, const T& item);
+
+    /**
+     * Insert an item in the list before specified index
+     *
+     * @param index index where item is going to be inserted
+     * @param item item to be inserted
+     */
+    void insert(long index, T&& item);
+
+    /**
+     * Insert another list before specified index.
+     *
+     * @param index index where items are going to be inserted
+     * @param other other list to be inserted into current one
+     */
+    void insert(long index, const SmallList& other);
+
+    /**
+     * Check wether a given item is in the list
+     *
+     * @param item item to be looked for
+     */
+    bool contains(const T& item) const;
+
+    /**
+     * Remove and return an item from the list at specified index
+     *
+     * @param index index at which item shall be removed and returned
+     * @throw IndexError if index is out of range
+     */
+    T pop(long index = -1) throw(IndexError);
+
+    /**
+     * Return the index of item in the list.
+     *
+     * @param item to be looked for
+     * @throw ValueError if item is not in list
+     */
+    size_type index(const T& item) const throw(ValueError);
+
+    /**
+     * Extend the content of current list by the one of provided list.
+     *
+     * @param other list used to extend current one
+     */
+    void extend(const SmallList& other);
+
+    /**
+     * Extend the content of current list by the one of provided list.
+     *
+     * Items of the other list are moved. The other list is left empty.
+     *
+     * @param other list used to extend current one
+     */
+    void extend(SmallList&& other);
+
+    /**
+     * Operator+=
+     *
+     * @param other list used to extend current one
+     */
+    void operator+=(const SmallList& other);
+
+    /**
+     * Operator+
+     *
+     * @param other list to be extended to the copy of current list
+     */
+    SmallList operator+(const SmallList& other) const;
+
+    /**
+     * Remove the first item in the list with specified value.
+     *
+     * @param item item to be removed from the list
+     * @throw ValueError if item is not in list
+     */
+    void remove(const T& item) throw(ValueError);
+
+    /**
+     * Count number of occurences of given item.
+     *
+     * @param item item to count
+     */
+    size_type count(const T& item) const;
+
+    /**
+     * Reverse list.
+     */
+    void reverse();
+
+    /**
+     * Sort list with operator< of T.
+     */
+    void sort();
+
+    /**
+     * Sort list with a function.
+     *
+     * @param funcptr sorting function
+     */
+    void sort(bool (*funcptr)(const T&, const T&));
+
+    /**
+     * Sort list with a functor object.
+     *
+     * @param functor sorting functor of type Compare
+     */
+    template <typename Compare>
+    void sort(const Compare& functor);
+
+    /**
+     * Iterator to the begin of the list.
+     */
+    iterator begin();
+
+    /**
+     * Const iterator to the begin of the list.
+     */
+    const_iterator begin() const;
+
+    /**
+     * Iterator to the end of the list.
+     */
+    iterator end();
+
+    /**
+     * Const iterator to the end of the list.
+     */
+    const_iterator end() const;
+
+    /**
+     * Reverse iterator to the reverse begining of the list.
+     */
+    reverse_iterator rbegin();
+
+    /**
+     * Const reverse iterator to the reverse begining of the list.
+     */
+    const_reverse_iterator rbegin() const;
+
+    /**
+     * Reverse iterator to the reverse end of the list.
+     */
+    reverse_iterator rend();
+
+    /**
+     * Const reverse iterator to the reverse end of the list.
+     */
+    const_reverse_iterator rend() const;
+
+    /**
+     * Clear all items from the list.
+     *
+     * Heap buffer, if any, is kept.
+     */
+    void clear();
+
+    private:
+
+    /**
+     * Return pointer to inline storage.
+     */
+    T* inlineData();
+
+    /**
+     * Return position of insertion for given index (clamped).
+     */
+    size_type insertPosition(long index) const;
+
+    /**
+     * Open a slot at given position, the slot is left unconstructed.
+     */
+    void openSlot(size_type pos);
+
+    /**
+     * Remove item at given position.
+     */
+    void erase(size_type pos);
+
+    /**
+     * Destroy all items and release heap buffer.
+     */
+    void release();
+
+    /**
+     * Move allocator of other list when the allocator propagates on move
+     * assignment, do nothing otherwise.
+     */
+    template <typename Allocator>
+    static void moveAllocator(Allocator& to, Allocator& from, std::true_type);
+    template <typename Allocator>
+    static void moveAllocator(Allocator& to, Allocator& from, std::false_type);
+
+    /**
+     * Attributes
+     */
+    Alloc m_alloc;
+    T* m_data;
+    size_type m_size;
+    size_type m_capacity;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type m_inline[N];
+
+}; // end of SmallList class
+
+//==============================================================================
+// SMALLLIST DEFINITION
+//==============================================================================
+
+//Constructor
+
+template <typename T, std::size_t N, typename A, typename C>
+SmallList<T, N, A, C>::SmallList(const allocator_type& alloc):
+    m_alloc(alloc), m_data(inlineData()), m_size(0), m_capacity(N) { };
+
+template <typename T, std::size_t N, typename A, typename C>
+SmallList<T, N, A, C>::SmallList(std::initializer_list<T> il,
+                                 const allocator_type& alloc):
+    m_alloc(alloc), m_data(inlineData()), m_size(0), m_capacity(N)
+{
+    reserve(il.size());
+    for (const T* it = il.begin(); it != il.end(); ++it)
+        alloc_traits::construct(m_alloc, m_data + m_size++, *it);
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+SmallList<T, N, A, C>::SmallList(size_type number, const T& value,
+                                 const allocator_type& alloc):
+    m_alloc(alloc), m_data(inlineData()), m_size(0), m_capacity(N)
+{
+    reserve(number);
+    while (m_size < number)
+        alloc_traits::construct(m_alloc, m_data + m_size++, value);
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+SmallList<T, N, A, C>::SmallList(const SmallList& other):
+    m_alloc(alloc_traits::select_on_container_copy_construction(other.m_alloc)),
+    m_data(inlineData()), m_size(0), m_capacity(N)
+{
+    extend(other);
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+SmallList<T, N, A, C>::SmallList(SmallList&& other)
+    noexcept(std::is_nothrow_move_constructible<T>::value):
+    m_alloc(std::move(other.m_alloc)), m_data(inlineData()), m_size(0),
+    m_capacity(N)
+{
+    *this = std::move(other);
+}
+
+//Destructor
+
+template <typename T, std::size_t N, typename A, typename C>
+SmallList<T, N, A, C>::~SmallList()
+{
+    release();
+}
+
+//Assignment operator
+
+template <typename T, std::size_t N, typename A, typename C>
+SmallList<T, N, A, C>& SmallList<T, N, A, C>::operator=(const SmallList& other)
+{
+    if (this != &other)
+    {
+        clear();
+        extend(other);
+    }
+    return *this;
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+SmallList<T, N, A, C>& SmallList<T, N, A, C>::operator=(SmallList&& other)
+    noexcept(std::is_nothrow_move_constructible<T>::value &&
+             alloc_traits::propagate_on_container_move_assignment::value)
+{
+    typedef typename alloc_traits::propagate_on_container_move_assignment propagate;
+    if (this == &other)
+        return *this;
+    release();
+    //heap buffer of other list can only be released by an equal allocator
+    bool steal = propagate::value || m_alloc == other.m_alloc;
+    moveAllocator(m_alloc, other.m_alloc, propagate());
+    if (!other.isInline() && steal)
+    {
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_capacity = other.m_capacity;
+        other.m_data = other.inlineData();
+        other.m_size = 0;
+        other.m_capacity = N;
+    }
+    else
+    {
+        reserve(other.m_size);
+        for (size_type i = 0; i < other.m_size; ++i)
+            alloc_traits::construct(m_alloc, m_data + i,
+                                    std::move(other.m_data[i]));
+        m_size = other.m_size;
+        other.clear();
+    }
+    return *this;
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+SmallList<T, N, A, C>&
+SmallList<T, N, A, C>::operator=(std::initializer_list<T> il)
+{
+    clear();
+    reserve(il.size());
+    for (const T* it = il.begin(); it != il.end(); ++it)
+        alloc_traits::construct(m_alloc, m_data + m_size++, *it);
+    return *this;
+}
+
+//size and capacity methods
+
+template <typename T, std::size_t N, typename A, typename C>
+typename SmallList<T, N, A, C>::size_type SmallList<T, N, A, C>::size() const
+{
+    return m_size;
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+typename SmallList<T, N, A, C>::size_type
+SmallList<T, N, A, C>::capacity() const
+{
+    return m_capacity;
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+bool SmallList<T, N, A, C>::isInline() const
+{
+    return m_data == reinterpret_cast<const T*>(m_inline);
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::reserve(size_type capacity)
+{
+    if (capacity <= m_capacity)
+        return;
+    capacity = std::max(capacity, 2 * m_capacity);
+    T* data = alloc_traits::allocate(m_alloc, capacity);
+    for (size_type i = 0; i < m_size; ++i)
+    {
+        alloc_traits::construct(m_alloc, data + i, std::move(m_data[i]));
+        alloc_traits::destroy(m_alloc, m_data + i);
+    }
+    if (!isInline())
+        alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+    m_data = data;
+    m_capacity = capacity;
+}
+
+//private helpers
+
+template <typename T, std::size_t N, typename A, typename C>
+T* SmallList<T, N, A, C>::inlineData()
+{
+    return reinterpret_cast<T*>(m_inline);
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+typename SmallList<T, N, A, C>::size_type
+SmallList<T, N, A, C>::insertPosition(long index) const
+{
+    long n = long(m_size);
+    if (index < 0)
+        index = std::max(long(0), index + n);
+    return size_type(std::min(index, n));
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::openSlot(size_type pos)
+{
+    reserve(m_size + 1);
+    if (pos < m_size)
+    {
+        alloc_traits::construct(m_alloc, m_data + m_size,
+                                std::move(m_data[m_size - 1]));
+        std::move_backward(m_data + pos, m_data + m_size - 1,
+                           m_data + m_size);
+        alloc_traits::destroy(m_alloc, m_data + pos);
+    }
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::erase(size_type pos)
+{
+    std::move(m_data + pos + 1, m_data + m_size, m_data + pos);
+    alloc_traits::destroy(m_alloc, m_data + m_size - 1);
+    --m_size;
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::release()
+{
+    clear();
+    if (!isInline())
+        alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+    m_data = inlineData();
+    m_capacity = N;
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+template <typename Allocator>
+void SmallList<T, N, A, C>::moveAllocator(Allocator& to, Allocator& from,
+                                          std::true_type)
+{
+    to = std::move(from);
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+template <typename Allocator>
+void SmallList<T, N, A, C>::moveAllocator(Allocator&, Allocator&,
+                                          std::false_type) { }
+
+//operator[]
+
+template <typename T, std::size_t N, typename A, typename C>
+T& SmallList<T, N, A, C>::operator[](long index) throw(IndexError)
+{
+    return m_data[C::position(index, m_size)];
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+const T& SmallList<T, N, A, C>::operator[](long index) const throw(IndexError)
+{
+    return m_data[C::position(index, m_size)];
+}
+
+//operator==
+
+template <typename T, std::size_t N, typename A, typename C>
+bool SmallList<T, N, A, C>::operator==(const SmallList& other) const
+{
+    if (m_size != other.m_size)
+        return false;
+    return std::equal(begin(), end(), other.begin());
+}
+
+//append and emplace methods
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::append(const T& item)
+{
+    emplace(item);
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::append(T&& item)
+{
+    emplace(std::move(item));
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+template <typename... Args>
+void SmallList<T, N, A, C>::emplace(Args&&... args)
+{
+    if (m_size == m_capacity)
+    {
+        //arguments may refer to an item of the list
+        T item(std::forward<Args>(args)...);
+        reserve(m_size + 1);
+        alloc_traits::construct(m_alloc, m_data + m_size, std::move(item));
+    }
+    else
+        alloc_traits::construct(m_alloc, m_data + m_size,
+                                std::forward<Args>(args)...);
+    ++m_size;
+}
+
+//insert methods
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::insert(long index, const T& item)
+{
+    insert(index, T(item));
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::insert(long index, T&& item)
+{
+    size_type pos = insertPosition(index);
+    openSlot(pos);
+    alloc_traits::construct(m_alloc, m_data + pos, std::move(item));
+    ++m_size;
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::insert(long index, const SmallList& other)
+{
+    SmallList items(other);
+    size_type pos = insertPosition(index);
+    reserve(m_size + items.m_size);
+    for (size_type i = 0; i < items.m_size; ++i)
+        emplace(std::move(items.m_data[i]));
+    std::rotate(m_data + pos, m_data + m_size - items.m_size, m_data + m_size);
+}
+
+//method contains
+
+template <typename T, std::size_t N, typename A, typename C>
+bool SmallList<T, N, A, C>::contains(const T& item) const
+{
+    return std::find(begin(), end(), item) != end();
+}
+
+//method pop
+
+template <typename T, std::size_t N, typename A, typename C>
+T SmallList<T, N, A, C>::pop(long index) throw(IndexError)
+{
+    if (m_size == 0)
+        THROW(IndexError, "pop from an empty list");
+    size_type pos = PythonCheck::position(index, m_size);
+    T item(std::move(m_data[pos]));
+    erase(pos);
+    return item;
+}
+
+//index method
+
+template <typename T, std::size_t N, typename A, typename C>
+typename SmallList<T, N, A, C>::size_type
+SmallList<T, N, A, C>::index(const T& item) const throw(ValueError)
+{
+    const_iterator it = std::find(begin(), end(), item);
+    if (it == end())
+        THROW(ValueError, "value not in list");
+    return it - begin();
+}
+
+//extend method
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::extend(const SmallList& other)
+{
+    size_type n = other.m_size;
+    reserve(m_size + n);
+    //index based loop: other may be current list
+    for (size_type i = 0; i < n; ++i)
+        alloc_traits::construct(m_alloc, m_data + m_size++, other.m_data[i]);
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::extend(SmallList&& other)
+{
+    if (m_size == 0)
+    {
+        *this = std::move(other);
+        return;
+    }
+    reserve(m_size + other.m_size);
+    for (size_type i = 0; i < other.m_size; ++i)
+        alloc_traits::construct(m_alloc, m_data + m_size++,
+                                std::move(other.m_data[i]));
+    other.clear();
+}
+
+//operator+= and operator+
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::operator+=(const SmallList& other)
+{
+    extend(other);
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+SmallList<T, N, A, C>
+SmallList<T, N, A, C>::operator+(const SmallList& other) const
+{
+    SmallList copy(m_alloc);
+    copy.reserve(m_size + other.m_size);
+    copy.extend(*this);
+    copy.extend(other);
+    return copy;
+}
+
+//remove method
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::remove(const T& item) throw(ValueError)
+{
+    erase(index(item));
+}
+
+//count method
+
+template <typename T, std::size_t N, typename A, typename C>
+typename SmallList<T, N, A, C>::size_type
+SmallList<T, N, A, C>::count(const T& item) const
+{
+    return std::count(begin(), end(), item);
+}
+
+//reverse method
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::reverse()
+{
+    std::reverse(begin(), end());
+}
+
+//sort method
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::sort()
+{
+    std::sort(begin(), end());
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::sort(bool (*funcptr)(const T&, const T&))
+{
+    std::sort(begin(), end(), funcptr);
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+template <typename Compare>
+void SmallList<T, N, A, C>::sort(const Compare& functor)
+{
+    std::sort(begin(), end(), functor);
+}
+
+//forward iterators
+
+template <typename T, std::size_t N, typename A, typename C>
+typename SmallList<T, N, A, C>::iterator SmallList<T, N, A, C>::begin()
+{
+    return m_data;
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+typename SmallList<T, N, A, C>::const_iterator
+SmallList<T, N, A, C>::begin() const
+{
+    return m_data;
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+typename SmallList<T, N, A, C>::iterator SmallList<T, N, A, C>::end()
+{
+    return m_data + m_size;
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+typename SmallList<T, N, A, C>::const_iterator
+SmallList<T, N, A, C>::end() const
+{
+    return m_data + m_size;
+}
+
+//reverse iterators
+
+template <typename T, std::size_t N, typename A, typename C>
+typename SmallList<T, N, A, C>::reverse_iterator
+SmallList<T, N, A, C>::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+typename SmallList<T, N, A, C>::const_reverse_iterator
+SmallList<T, N, A, C>::rbegin() const
+{
+    return const_reverse_iterator(end());
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+typename SmallList<T, N, A, C>::reverse_iterator
+SmallList<T, N, A, C>::rend()
+{
+    return reverse_iterator(begin());
+}
+
+template <typename T, std::size_t N, typename A, typename C>
+typename SmallList<T, N, A, C>::const_reverse_iterator
+SmallList<T, N, A, C>::rend() const
+{
+    return const_reverse_iterator(begin());
+}
+
+//clear method
+
+template <typename T, std::size_t N, typename A, typename C>
+void SmallList<T, N, A, C>::clear()
+{
+    for (size_type i = 0; i < m_size; ++i)
+        alloc_traits::destroy(m_alloc, m_data + i);
+    m_size = 0;
+}
+
+} //end of snowball namespace
+
+#endif
@@ -0,0 +1,880 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_SORTED_LIST_HPP
+#define SNOWBALL_SORTED_LIST_HPP
+
+#include <cstddef>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <initializer_list>
+
+#include "snowball/exceptions/exceptions.h"
+#include "check_policy.hpp"
+#include "list.hpp"
+
+namespace snowball
+{
+
+//==============================================================================
+// SORTEDLISTITERATOR DECLARATION
+//==============================================================================
+
+/**
+ * @brief Bidirectional iterator over the chunks of a SortedList.
+ *
+ * Items cannot be modified through the iterator as it would break the order
+ * of the list. The iterator is invalidated by any insertion or removal.
+ *
+ * @tparam T type of items
+ */
+template <typename T>
+class SortedListIterator
+{
+    public:
+
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+
+    /**
+     * Constructor
+     *
+     * Build a singular iterator.
+     */
+    SortedListIterator(): m_chunks(0), m_chunk(0), m_pos(0) { };
+
+    /**
+     * Constructor
+     *
+     * @param chunks chunks of the list
+     * @param chunk index of chunk
+     * @param pos position of item in chunk
+     */
+    SortedListIterator(const std::vector< std::vector<T> >* chunks,
+                       std::size_t chunk, std::size_t pos):
+        m_chunks(chunks), m_chunk(chunk), m_pos(pos) { };
+
+    reference operator*() const { return (*m_chunks)[m_chunk][m_pos]; };
+    pointer operator->() const { return &(operator*()); };
+
+    SortedListIterator& operator++()
+    {
+        if (++m_pos == (*m_chunks)[m_chunk].size())
+        {
+            ++m_chunk;
+            m_pos = 0;
+        }
+        return *this;
+    };
+    SortedListIterator operator++(int)
+    {
+        SortedListIterator it(*this);
+        ++(*this);
+        return it;
+    };
+    SortedListIterator& operator--()
+    {
+        if (m_pos == 0)
+            m_pos = (*m_chunks)[--m_chunk].size() - 1;
+        else
+            --m_pos;
+        return *this;
+    };
+    SortedListIterator operator--(int)
+    {
+        SortedListIterator it(*this);
+        --(*this);
+        return it;
+    };
+
+    bool operator==(const SortedListIterator& other) const
+    {
+        return m_chunk == other.m_chunk && m_pos == other.m_pos;
+    };
+    bool operator!=(const SortedListIterator& other) const
+    {
+        return !(*this == other);
+    };
+
+    private:
+
+    const std::vector< std::vector<T> >* m_chunks;
+    std::size_t m_chunk;
+    std::size_t m_pos;
+};
+
+//==============================================================================
+// SORTEDLIST DECLARATION
+//==============================================================================
+
+/**
+ * @brief Implements a list which items are kept sorted.
+ *
+ * @tparam T type of items in the list
+ * @tparam Compare comparator by which items are sorted
+ *
+ * Items are stored in a sequence of sorted chunks holding between load / 2
+ * and 2 * load items (except when the list is smaller), together with the
+ * greatest item of each chunk and a Fenwick tree of chunk sizes. Locating an
+ * item is a binary search among chunk maxima then within a chunk; converting
+ * between chunk positions and indices goes through the Fenwick tree. Adding
+ * or removing an item only moves items of one chunk:
+ *
+ * - SortedList<T, Compare>::add, SortedList<T, Compare>::remove and
+ *   SortedList<T, Compare>::pop take O(log n + load)
+ * - SortedList<T, Compare>::contains, SortedList<T, Compare>::index,
+ *   SortedList<T, Compare>::count, SortedList<T, Compare>::bisectLeft,
+ *   SortedList<T, Compare>::bisectRight and SortedList<T, Compare>::operator[]
+ *   take O(log n)
+ * - SortedList<T, Compare>::lowerBound and SortedList<T, Compare>::upperBound
+ *   give iterators to range queries in O(log n)
+ *
+ * Items are equal when neither compares less than the other. Among equal
+ * items, the last added comes last.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * SortedList<int> list = {5, 1, 3};
+ * list.add(2);                //list is {1, 2, 3, 5}
+ * list.index(3);              //2
+ * list.range(2, 5);           //List<int>({2, 3})
+ * ~~~~~~~~~~~~~~~~~~~~~
+ */
+template <typename T, typename Compare = std::less<T> >
+class SortedList
+{
+    public:
+
+    /**
+     * @typedef size_type
+     * size type of SortedList
+     */
+    typedef std::size_t size_type;
+
+    /**
+     * @typedef value_type
+     * type of items
+     */
+    typedef T value_type;
+
+    /**
+     * @typedef index_type
+     * index type of SortedList
+     */
+    typedef size_type index_type;
+
+    /**
+     * @typedef const_iterator
+     * bidirectional iterator for SortedList
+     */
+    typedef SortedListIterator<T> const_iterator;
+
+    /**
+     * @typedef iterator
+     * same as const_iterator: items cannot be modified in place
+     */
+    typedef const_iterator iterator;
+
+    /**
+     * Default number of items per chunk.
+     */
+    static const size_type defaultLoad = 1000;
+
+    /**
+     * Constructor
+     *
+     * Build an empty list.
+     *
+     * @param comp comparator
+     * @param load number of items per chunk (at least 4)
+     */
+    explicit SortedList(const Compare& comp = Compare(),
+                        size_type load = defaultLoad);
+
+    /**
+     * Constructor
+     *
+     * Build a list with given items.
+     *
+     * @param init items
+     * @param comp comparator
+     * @param load number of items per chunk (at least 4)
+     */
+    SortedList(std::initializer_list<T> init,
+               const Compare& comp = Compare(),
+               size_type load = defaultLoad);
+
+    /**
+     * Constructor
+     *
+     * Build a list with items from an iterator range.
+     *
+     * @param first beginning of range
+     * @param last end of range
+     * @param comp comparator
+     * @param load number of items per chunk (at least 4)
+     */
+    template <typename InputIterator>
+    SortedList(InputIterator first, InputIterator last,
+               const Compare& comp = Compare(),
+               size_type load = defaultLoad);
+
+    /**
+     * Return the size of the list.
+     */
+    size_type size() const;
+
+    /**
+     * Add item to the list.
+     *
+     * @param item item to be added
+     */
+    void add(T item);
+
+    /**
+     * Add items of a container to the list.
+     *
+     * Many items are sorted together with the list content and chunks are
+     * rebuilt, which is faster than adding them one by one.
+     *
+     * @param cont container of items
+     */
+    template <typename Container>
+    void update(const Container& cont);
+
+    /**
+     * Remove an item equal to the given one.
+     *
+     * @param item item to be removed
+     * @throw ValueError if item is not in list
+     */
+    void remove(const T& item) throw(ValueError);
+
+    /**
+     * Remove an item equal to the given one, if any.
+     *
+     * @param item item to be removed
+     * @return true if an item was removed
+     */
+    bool discard(const T& item);
+
+    /**
+     * Remove and return item at given index (last one by default).
+     *
+     * @param index index of item, negative values are counted from the end
+     * @throw IndexError if index is out of range
+     */
+    T pop(long index = -1) throw(IndexError);
+
+    /**
+     * Return item at given index.
+     *
+     * @param index index of item, negative values are counted from the end
+     * @throw IndexError if index is out of range
+     */
+    const T& operator[](long index) const throw(IndexError);
+
+    /**
+     * Check whether the list contains an item equal to the given one.
+     *
+     * @param item item to be looked for
+     */
+    bool contains(const T& item) const;
+
+    /**
+     * Return the index of the first item equal to the given one.
+     *
+     * @param item item to be looked for
+     * @throw ValueError if item is not in list
+     */
+    size_type index(const T& item) const throw(ValueError);
+
+    /**
+     * Count items equal to the given one.
+     *
+     * @param item item to be counted
+     */
+    size_type count(const T& item) const;
+
+    /**
+     * Return the index where item would be inserted before equal items.
+     *
+     * @param item item to be looked for
+     */
+    size_type bisectLeft(const T& item) const;
+
+    /**
+     * Return the index where item would be inserted after equal items.
+     *
+     * @param item item to be looked for
+     */
+    size_type bisectRight(const T& item) const;
+
+    /**
+     * Return an iterator to the first item not less than the given one.
+     *
+     * @param item item to be looked for
+     */
+    const_iterator lowerBound(const T& item) const;
+
+    /**
+     * Return an iterator to the first item greater than the given one.
+     *
+     * @param item item to be looked for
+     */
+    const_iterator upperBound(const T& item) const;
+
+    /**
+     * Return items in [minimum, maximum) as a List.
+     *
+     * @param minimum lower bound of items (included)
+     * @param maximum upper bound of items (excluded)
+     */
+    List<T> range(const T& minimum, const T& maximum) const;
+
+    /**
+     * Return all items as a List.
+     */
+    List<T> toList() const;
+
+    /**
+     * Clear all items from the list.
+     */
+    void clear();
+
+    /**
+     * Equality operator.
+     *
+     * @param other list to be compared to
+     */
+    bool operator==(const SortedList<T, Compare>& other) const;
+
+    /**
+     * Inequality operator.
+     *
+     * @param other list to be compared to
+     */
+    bool operator!=(const SortedList<T, Compare>& other) const;
+
+    /**
+     * Iterator to the begin of the list.
+     */
+    const_iterator begin() const;
+
+    /**
+     * Iterator to the end of the list.
+     */
+    const_iterator end() const;
+
+    private:
+
+    /**
+     * Rebuild chunks, maxima and tree from sorted items.
+     */
+    void rebuild(std::vector<T>& items);
+
+    /**
+     * Rebuild Fenwick tree after chunks were split, merged or removed.
+     */
+    void buildTree();
+
+    /**
+     * Add delta to the size of chunk k in Fenwick tree.
+     */
+    void updateTree(size_type k, long delta);
+
+    /**
+     * Return the number of items in chunks before chunk k.
+     */
+    size_type prefix(size_type k) const;
+
+    /**
+     * Return (chunk, position) of item at given index.
+     */
+    std::pair<size_type, size_type> locate(size_type index) const;
+
+    /**
+     * Split chunk k into two halves.
+     */
+    void split(size_type k);
+
+    /**
+     * Remove item at position pos of chunk k and rebalance chunks.
+     */
+    void erase(size_type k, size_type pos);
+
+    /**
+     * Attributes
+     */
+    std::vector< std::vector<T> > m_chunks;
+    std::vector<T> m_maxes;
+    std::vector<size_type> m_tree;
+    size_type m_size;
+    size_type m_load;
+    Compare m_comp;
+
+}; // end of SortedList class
+
+//==============================================================================
+// SORTEDLIST DEFINITIONS
+//==============================================================================
+
+template <typename T, typename Compare>
+const typename SortedList<T, Compare>::size_type
+SortedList<T, Compare>::defaultLoad;
+
+//constructors
+
+template <typename T, typename Compare>
+SortedList<T, Compare>::SortedList(const Compare& comp, size_type load):
+    m_size(0), m_load(std::max<size_type>(load, 4)), m_comp(comp)
+{
+
+}
+
+template <typename T, typename Compare>
+SortedList<T, Compare>::SortedList(std::initializer_list<T> init,
+                                   const Compare& comp, size_type load):
+    m_size(0), m_load(std::max<size_type>(load, 4)), m_comp(comp)
+{
+    std::vector<T> items(init);
+    std::stable_sort(items.begin(), items.end(), m_comp);
+    rebuild(items);
+}
+
+template <typename T, typename Compare>
+template <typename InputIterator>
+SortedList<T, Compare>::SortedList(InputIterator first, InputIterator last,
+                                   const Compare& comp, size_type load):
+    m_size(0), m_load(std::max<size_type>(load, 4)), m_comp(comp)
+{
+    std::vector<T> items(first, last);
+    std::stable_sort(items.begin(), items.end(), m_comp);
+    rebuild(items);
+}
+
+//size method
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::size_type SortedList<T, Compare>::size() const
+{
+    return m_size;
+}
+
+//add method
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::add(T item)
+{
+    if (m_chunks.empty())
+    {
+        m_maxes.push_back(item);
+        m_chunks.push_back(std::vector<T>(1, std::move(item)));
+        m_size = 1;
+        buildTree();
+        return;
+    }
+    size_type k = std::upper_bound(m_maxes.begin(), m_maxes.end(), item,
+                                   m_comp) - m_maxes.begin();
+    if (k == m_chunks.size())
+    {
+        --k;
+        m_chunks[k].push_back(std::move(item));
+        m_maxes[k] = m_chunks[k].back();
+    }
+    else
+    {
+        std::vector<T>& chunk = m_chunks[k];
+        chunk.insert(std::upper_bound(chunk.begin(), chunk.end(), item, m_comp),
+                     std::move(item));
+    }
+    ++m_size;
+    if (m_chunks[k].size() > 2 * m_load)
+        split(k);
+    else
+        updateTree(k, 1);
+}
+
+//update method
+
+template <typename T, typename Compare>
+template <typename Container>
+void SortedList<T, Compare>::update(const Container& cont)
+{
+    size_type n = std::distance(cont.begin(), cont.end());
+    if (n * 8 < m_size)
+    {
+        typename Container::const_iterator it;
+        for (it = cont.begin(); it != cont.end(); ++it)
+            add(*it);
+        return;
+    }
+    std::vector<T> items;
+    items.reserve(m_size + n);
+    for (size_type k = 0; k < m_chunks.size(); ++k)
+        std::move(m_chunks[k].begin(), m_chunks[k].end(),
+                  std::back_inserter(items));
+    size_type middle = items.size();
+    items.insert(items.end(), cont.begin(), cont.end());
+    std::stable_sort(items.begin() + middle, items.end(), m_comp);
+    std::inplace_merge(items.begin(), items.begin() + middle, items.end(),
+                       m_comp);
+    rebuild(items);
+}
+
+//remove/discard methods
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::remove(const T& item) throw(ValueError)
+{
+    if (!discard(item))
+        THROW(ValueError, "value not in list");
+}
+
+template <typename T, typename Compare>
+bool SortedList<T, Compare>::discard(const T& item)
+{
+    size_type k = std::lower_bound(m_maxes.begin(), m_maxes.end(), item,
+                                   m_comp) - m_maxes.begin();
+    if (k == m_chunks.size())
+        return false;
+    const std::vector<T>& chunk = m_chunks[k];
+    size_type pos = std::lower_bound(chunk.begin(), chunk.end(), item, m_comp)
+                    - chunk.begin();
+    if (m_comp(item, chunk[pos]))
+        return false;
+    erase(k, pos);
+    return true;
+}
+
+//pop method
+
+template <typename T, typename Compare>
+T SortedList<T, Compare>::pop(long index) throw(IndexError)
+{
+    if (m_size == 0)
+        THROW(IndexError, "pop from an empty list");
+    std::pair<size_type, size_type> loc;
+    loc = locate(PythonCheck::position(index, m_size));
+    T item(std::move(m_chunks[loc.first][loc.second]));
+    erase(loc.first, loc.second);
+    return item;
+}
+
+//operator[]
+
+template <typename T, typename Compare>
+const T& SortedList<T, Compare>::operator[](long index) const throw(IndexError)
+{
+    std::pair<size_type, size_type> loc;
+    loc = locate(PythonCheck::position(index, m_size));
+    return m_chunks[loc.first][loc.second];
+}
+
+//contains/index/count methods
+
+template <typename T, typename Compare>
+bool SortedList<T, Compare>::contains(const T& item) const
+{
+    size_type k = std::lower_bound(m_maxes.begin(), m_maxes.end(), item,
+                                   m_comp) - m_maxes.begin();
+    if (k == m_chunks.size())
+        return false;
+    const std::vector<T>& chunk = m_chunks[k];
+    return !m_comp(item, *std::lower_bound(chunk.begin(), chunk.end(), item,
+                                           m_comp));
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::size_type
+SortedList<T, Compare>::index(const T& item) const throw(ValueError)
+{
+    size_type i = bisectLeft(item);
+    if (i == m_size || m_comp(item, (*this)[long(i)]))
+        THROW(ValueError, "value not in list");
+    return i;
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::size_type
+SortedList<T, Compare>::count(const T& item) const
+{
+    return bisectRight(item) - bisectLeft(item);
+}
+
+//bisect methods
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::size_type
+SortedList<T, Compare>::bisectLeft(const T& item) const
+{
+    size_type k = std::lower_bound(m_maxes.begin(), m_maxes.end(), item,
+                                   m_comp) - m_maxes.begin();
+    if (k == m_chunks.size())
+        return m_size;
+    const std::vector<T>& chunk = m_chunks[k];
+    return prefix(k) + (std::lower_bound(chunk.begin(), chunk.end(), item,
+                                         m_comp) - chunk.begin());
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::size_type
+SortedList<T, Compare>::bisectRight(const T& item) const
+{
+    size_type k = std::upper_bound(m_maxes.begin(), m_maxes.end(), item,
+                                   m_comp) - m_maxes.begin();
+    if (k == m_chunks.size())
+        return m_size;
+    const std::vector<T>& chunk = m_chunks[k];
+    return prefix(k) + (std::upper_bound(chunk.begin(), chunk.end(), item,
+                                         m_comp) - chunk.begin());
+}
+
+//lowerBound/upperBound methods
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::const_iterator
+SortedList<T, Compare>::lowerBound(const T& item) const
+{
+    size_type k = std::lower_bound(m_maxes.begin(), m_maxes.end(), item,
+                                   m_comp) - m_maxes.begin();
+    if (k == m_chunks.size())
+        return end();
+    const std::vector<T>& chunk = m_chunks[k];
+    return const_iterator(&m_chunks, k,
+        std::lower_bound(chunk.begin(), chunk.end(), item, m_comp)
+        - chunk.begin());
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::const_iterator
+SortedList<T, Compare>::upperBound(const T& item) const
+{
+    size_type k = std::upper_bound(m_maxes.begin(), m_maxes.end(), item,
+                                   m_comp) - m_maxes.begin();
+    if (k == m_chunks.size())
+        return end();
+    const std::vector<T>& chunk = m_chunks[k];
+    return const_iterator(&m_chunks, k,
+        std::upper_bound(chunk.begin(), chunk.end(), item, m_comp)
+        - chunk.begin());
+}
+
+//range/toList methods
+
+template <typename T, typename Compare>
+List<T> SortedList<T, Compare>::range(const T& minimum,
+                                      const T& maximum) const
+{
+    List<T> items;
+    if (!m_comp(minimum, maximum))
+        return items;
+    const_iterator last = lowerBound(maximum);
+    for (const_iterator it = lowerBound(minimum); it != last; ++it)
+        items.append(*it);
+    return items;
+}
+
+template <typename T, typename Compare>
+List<T> SortedList<T, Compare>::toList() const
+{
+    List<T> items;
+    items.reserve(m_size);
+    for (size_type k = 0; k < m_chunks.size(); ++k)
+    {
+        for (size_type i = 0; i < m_chunks[k].size(); ++i)
+            items.append(m_chunks[k][i]);
+    }
+    return items;
+}
+
+//clear method
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::clear()
+{
+    m_chunks.clear();
+    m_maxes.clear();
+    m_tree.clear();
+    m_size = 0;
+}
+
+//comparison operators
+
+template <typename T, typename Compare>
+bool SortedList<T, Compare>::operator==(
+    const SortedList<T, Compare>& other) const
+{
+    return m_size == other.m_size &&
+           std::equal(begin(), end(), other.begin());
+}
+
+template <typename T, typename Compare>
+bool SortedList<T, Compare>::operator!=(
+    const SortedList<T, Compare>& other) const
+{
+    return !(*this == other);
+}
+
+//iterators
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::const_iterator
+SortedList<T, Compare>::begin() const
+{
+    return const_iterator(&m_chunks, 0, 0);
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::const_iterator
+SortedList<T, Compare>::end() const
+{
+    return const_iterator(&m_chunks, m_chunks.size(), 0);
+}
+
+//private methods
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::rebuild(std::vector<T>& items)
+{
+    m_chunks.clear();
+    m_maxes.clear();
+    m_size = items.size();
+    for (size_type first = 0; first < items.size(); first += m_load)
+    {
+        size_type last = std::min(first + m_load, items.size());
+        m_chunks.push_back(std::vector<T>(
+            std::make_move_iterator(items.begin() + first),
+            std::make_move_iterator(items.begin() + last)));
+        m_maxes.push_back(m_chunks.back().back());
+    }
+    buildTree();
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::buildTree()
+{
+    size_type n = m_chunks.size();
+    m_tree.assign(n, 0);
+    for (size_type i = 1; i <= n; ++i)
+    {
+        m_tree[i - 1] += m_chunks[i - 1].size();
+        size_type parent = i + (i & (~i + 1));
+        if (parent <= n)
+            m_tree[parent - 1] += m_tree[i - 1];
+    }
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::updateTree(size_type k, long delta)
+{
+    for (size_type i = k + 1; i <= m_tree.size(); i += i & (~i + 1))
+        m_tree[i - 1] += delta;
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::size_type
+SortedList<T, Compare>::prefix(size_type k) const
+{
+    size_type sum = 0;
+    for (size_type i = k; i > 0; i &= i - 1)
+        sum += m_tree[i - 1];
+    return sum;
+}
+
+template <typename T, typename Compare>
+std::pair<typename SortedList<T, Compare>::size_type,
+          typename SortedList<T, Compare>::size_type>
+SortedList<T, Compare>::locate(size_type index) const
+{
+    size_type n = m_tree.size();
+    size_type step = 1;
+    while (step * 2 <= n)
+        step *= 2;
+    size_type k = 0;
+    for (; step > 0; step /= 2)
+    {
+        if (k + step <= n && m_tree[k + step - 1] <= index)
+        {
+            k += step;
+            index -= m_tree[k - 1];
+        }
+    }
+    return std::make_pair(k, index);
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::split(size_type k)
+{
+    std::vector<T>& chunk = m_chunks[k];
+    size_type half = chunk.size() / 2;
+    std::vector<T> upper(std::make_move_iterator(chunk.begin() + half),
+                         std::make_move_iterator(chunk.end()));
+    chunk.erase(chunk.begin() + half, chunk.end());
+    m_maxes[k] = chunk.back();
+    m_maxes.insert(m_maxes.begin() + k + 1, upper.back());
+    m_chunks.insert(m_chunks.begin() + k + 1, std::move(upper));
+    buildTree();
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::erase(size_type k, size_type pos)
+{
+    std::vector<T>& chunk = m_chunks[k];
+    chunk.erase(chunk.begin() + pos);
+    --m_size;
+    if (chunk.empty())
+    {
+        m_chunks.erase(m_chunks.begin() + k);
+        m_maxes.erase(m_maxes.begin() + k);
+        buildTree();
+        return;
+    }
+    m_maxes[k] = chunk.back();
+    if (chunk.size() < m_load / 2 && m_chunks.size() > 1)
+    {
+        //merge with a neighbour, then split again if too large
+        size_type j = k > 0 ? k - 1 : k;
+        std::vector<T>& left = m_chunks[j];
+        std::vector<T>& right = m_chunks[j + 1];
+        left.insert(left.end(), std::make_move_iterator(right.begin()),
+                    std::make_move_iterator(right.end()));
+        m_maxes[j] = left.back();
+        m_chunks.erase(m_chunks.begin() + j + 1);
+        m_maxes.erase(m_maxes.begin() + j + 1);
+        if (m_chunks[j].size() > 2 * m_load)
+            split(j);
+        else
+            buildTree();
+        return;
+    }
+    updateTree(k, -1);
+}
+
+} //end of namespace snowball
+
+#endif
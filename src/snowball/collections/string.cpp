@@ -19,6 +19,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "string.h"
 
 #include <iostream>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
 
 
 using namespace std;
@@ -41,6 +44,8 @@ String::String(typename String::size_type n, char c): m_str(n, c) { }
 
 String::String(const String& other): m_str(other.m_str) { }
 
+String::String(String&& other) noexcept: m_str(std::move(other.m_str)) { }
+
 String::String(char c): String(1, c) { }
 
 /*
@@ -54,6 +59,16 @@ String& String::operator=(const String& other)
     return *this;
 }
 
+String& String::operator=(String&& other) noexcept
+{
+    if (this != &other)
+    {
+        m_str = std::move(other.m_str);
+        other.m_str.clear();
+    }
+    return *this;
+}
+
 String& String::operator=(const std::string& str)
 {
     m_str = str;
@@ -202,26 +217,7 @@ bool String::endsWith(const char c) const
 
 List<String> String::split(const std::string& sep) const
 {
-    List<String> fields;
-    size_t pos, current;
-    current = 0;
-    while (true)
-    {
-        pos = m_str.find_first_of(sep, current);
-        if (pos == string::npos)
-        {
-            fields.append(String(m_str.substr(current)));
-            break;
-        }
-        else if (pos == current)
-            current++;
-        else
-        {
-            fields.append(String(m_str.substr(current, pos - current)));
-            current = pos + 1;
-        }
-    }
-    return fields;
+    return split< List<String> >(sep);
 }
 
 List<String> String::split() const
@@ -772,4 +768,109 @@ bool String::operator>=(const String& other) const
     return m_str >= other.m_str;
 };
 
+/*
+ * Multikey quicksort of String keys
+ */
+
+namespace
+{
+
+/*
+ * Bytes of key considered at each step of the sort.
+ */
+const std::size_t chunkBytes = 7;
+
+/*
+ * Chunk of key at depth: the next 7 bytes packed big-endian in the high bits
+ * (zero padded) and the number of bytes left (up to 7) in the low byte, so
+ * that comparing chunks orders strings and equal chunks with less than 7
+ * bytes left stand for equal strings.
+ */
+inline std::uint64_t chunkAt(const detail::StringKey& key, std::size_t depth)
+{
+    std::size_t left = key.size > depth ? key.size - depth : 0;
+    if (left > chunkBytes)
+        left = chunkBytes;
+    const unsigned char* data = key.data + depth;
+    std::uint64_t chunk = 0;
+    for (std::size_t i = 0; i < left; ++i)
+        chunk |= std::uint64_t(data[i]) << (8 * (chunkBytes - i));
+    return chunk | left;
+}
+
+/*
+ * Compare keys sharing a common prefix of depth bytes.
+ */
+inline bool suffixLess(const detail::StringKey& a, const detail::StringKey& b,
+                       std::size_t depth)
+{
+    std::size_t sizeA = a.size - depth;
+    std::size_t sizeB = b.size - depth;
+    std::size_t common = std::min(sizeA, sizeB);
+    int result = common > 0 ? std::memcmp(a.data + depth, b.data + depth, 
+                                          common) : 0;
+    return result < 0 || (result == 0 && sizeA < sizeB);
+}
+
+/*
+ * Sort n keys that share a common prefix of depth bytes and which chunks at that
+ * depth are already computed.
+ */
+void sortChunks(detail::StringKey* keys, std::size_t n, std::size_t depth)
+{
+    while (n > 1)
+    {
+        if (n < 16)
+        {
+            for (std::size_t i = 1; i < n; ++i)
+            {
+                detail::StringKey key = keys[i];
+                std::size_t j = i;
+                for (; j > 0 && suffixLess(key, keys[j - 1], depth); --j)
+                    keys[j] = keys[j - 1];
+                keys[j] = key;
+            }
+            return;
+        }
+        //pivot is median of three chunks
+        std::uint64_t a = keys[0].chunk;
+        std::uint64_t b = keys[n / 2].chunk;
+        std::uint64_t c = keys[n - 1].chunk;
+        std::uint64_t pivot = std::max(std::min(a, b), 
+                                       std::min(std::max(a, b), c));
+        //three-way partition on current chunk
+        std::size_t lt = 0, i = 0, gt = n;
+        while (i < gt)
+        {
+            std::uint64_t chunk = keys[i].chunk;
+            if (chunk < pivot)
+                std::swap(keys[lt++], keys[i++]);
+            else if (chunk > pivot)
+                std::swap(keys[i], keys[--gt]);
+            else
+                ++i;
+        }
+        sortChunks(keys, lt, depth);
+        sortChunks(keys + gt, n - gt, depth);
+        //keys equal to pivot are sorted on next chunk unless they all ended
+        if ((pivot & 0xff) < chunkBytes)
+            return;
+        keys += lt;
+        n = gt - lt;
+        depth += chunkBytes;
+        for (std::size_t k = 0; k < n; ++k)
+            keys[k].chunk = chunkAt(keys[k], depth);
+    }
+}
+
+} //end of anonymous namespace
+
+void detail::multikeyQuicksort(detail::StringKey* keys, std::size_t n, 
+                               std::size_t depth)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        keys[i].chunk = chunkAt(keys[i], depth);
+    sortChunks(keys, n, depth);
+}
+
 } //end of namespace snowball
\ No newline at end of file
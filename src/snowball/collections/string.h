@@ -23,7 +23,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef SNOWBALL_STRING_H
 #define SNOWBALL_STRING_H
 
+#include <cstring>
 #include <string>
+#include <utility>
 #include <sstream>
 #include <locale>
 #include <algorithm>
@@ -32,11 +34,41 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <boost/locale.hpp>
 #endif
 
+#include "hash.hpp"
 #include "list.hpp"
+#include "small_list.hpp"
+#include "radix_sort.hpp"
 #include "snowball/exceptions/exceptions.h"
 
+/**
+ * @def SNOWBALL_STRING_RELOCATABLE
+ * 1 if std::string holds no pointer to itself: libc++ and the copy-on-write 
+ * string of libstdc++ old ABI. The short string buffer of libstdc++ C++11 
+ * ABI is pointed to by the string itself.
+ */
+#ifndef SNOWBALL_STRING_RELOCATABLE
+#if defined(_LIBCPP_VERSION) || \
+    (defined(_GLIBCXX_USE_CXX11_ABI) && !_GLIBCXX_USE_CXX11_ABI)
+#define SNOWBALL_STRING_RELOCATABLE 1
+#else
+#define SNOWBALL_STRING_RELOCATABLE 0
+#endif
+#endif
+
 namespace snowball
 {
+
+class String;
+
+/**
+ * String holds a single std::string and is trivially relocatable when it is.
+ * 
+ * Lists of String then grow with realloc.
+ */
+template <>
+struct TriviallyRelocatable<String>: public std::integral_constant<bool, 
+    SNOWBALL_STRING_RELOCATABLE> { };
+
 /**
  * @brief implements a String class on top of std::string
  */
@@ -130,6 +162,15 @@ class String
       */
      String(const String& other);
      
+     /**
+      * Move constructor.
+      * 
+      * Build a string by stealing content of an existing one, which is left
+      * empty.
+      * @param other existing string
+      */
+     String(String&& other) noexcept;
+     
      /**
       * Assignment operator.
       * 
@@ -138,6 +179,14 @@ class String
       */
      String& operator=(const String& other);
      
+     /**
+      * Move assignment operator.
+      * 
+      * Steal content of an existing string, which is left empty.
+      * @param other existing string
+      */
+     String& operator=(String&& other) noexcept;
+     
      /**
       * Assignment operator.
       * 
@@ -452,6 +501,50 @@ class String
      */
     List<String> split(const char c) const;
     
+    /**
+     * Split string into sub-string.
+     * 
+     * Same as String::split but substrings are appended to a container of 
+     * given type. The container must provide an append method. With a 
+     * SmallList, splitting short records does not allocate any list buffer:
+     * 
+     * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * String line("x;y;z");
+     * SmallList<String, 8> fields = line.split< SmallList<String, 8> >(";");
+     * ~~~~~~~~~~~~~~~~~~~~~
+     * 
+     * The string is split by space characters, end of line, line break or 
+     * tabulation.
+     * 
+     * @tparam Container type of returned container
+     */
+    template <typename Container>
+    Container split() const;
+    
+    /**
+     * Split string into sub-string.
+     * 
+     * The string is split by characters in given string. Substrings are 
+     * appended to a container of given type.
+     * 
+     * @tparam Container type of returned container
+     * @param sep separator characters
+     */
+    template <typename Container>
+    Container split(const std::string& sep) const;
+    
+    /**
+     * Split string into sub-string.
+     * 
+     * The string is split by given character. Substrings are appended to a 
+     * container of given type.
+     * 
+     * @tparam Container type of returned container
+     * @param c separator character
+     */
+    template <typename Container>
+    Container split(const char c) const;
+    
     /**
      * Strip the left of the string.
      * 
@@ -860,6 +953,135 @@ class String
     friend std::istream& getline(std::istream&, String&);
 };
 
+/**
+ * @brief Multikey radix sort of String.
+ * 
+ * Used by List<String>::sort(). Strings are sorted on their bytes with a 
+ * multikey quicksort (three-way radix quicksort) taking 7 bytes at a time, 
+ * which inspects common prefixes only once instead of once per comparison. 
+ * The sort works on an array of keys and moves each String only once.
+ */
+template <>
+struct RadixSorter<String>
+{
+    static const bool enabled = true;
+    
+    template <typename RandomIt, typename Alloc>
+    static void sort(RandomIt first, RandomIt last, const Alloc& alloc);
+};
+
+/**
+ * Specialization of Hash for String
+ * 
+ * Bytes of the string are hashed with hashBytes, so that Lists of String can
+ * be hashed by Hash< List<String> >.
+ */
+template <>
+struct Hash<String>
+{
+    /**
+     * Operator()
+     * 
+     * @param key value to be hashed
+     * @returns hash of string
+     */
+    size_t operator()(const String& key) const
+    {
+        if (key.size() == 0)
+            return hashBytes(0, 0);
+        return hashBytes(&*key.begin(), key.size());
+    };
+};
+
+namespace detail
+{
+
+/**
+ * Bytes of a string: pointer to first byte and size.
+ */
+inline std::pair<const char*, std::size_t> stringBytes(const std::string& str)
+{
+    return std::make_pair(str.data(), str.size());
+}
+
+inline std::pair<const char*, std::size_t> stringBytes(const String& str)
+{
+    return str.size() == 0 ? std::make_pair("", std::size_t(0))
+                           : std::make_pair(&*str.begin(), str.size());
+}
+
+inline std::pair<const char*, std::size_t> stringBytes(const char* str)
+{
+    return std::make_pair(str, std::strlen(str));
+}
+
+} //end of namespace detail
+
+/**
+ * @brief Transparent hash of strings.
+ *
+ * std::string, String and C strings with the same bytes have the same hash,
+ * so that a FlatDictionary using StringHash and StringEqual is looked up with
+ * any of them without building a key.
+ */
+struct StringHash
+{
+    typedef void is_transparent;
+
+    size_t operator()(const std::string& key) const { return hash(key); };
+    size_t operator()(const String& key) const { return hash(key); };
+    size_t operator()(const char* key) const { return hash(key); };
+
+private:
+
+    template <typename T>
+    static size_t hash(const T& key)
+    {
+        std::pair<const char*, std::size_t> bytes = detail::stringBytes(key);
+        return hashBytes(bytes.first, bytes.second);
+    };
+};
+
+/**
+ * @brief Transparent equality of strings.
+ *
+ * Compare bytes of std::string, String and C strings in any combination.
+ */
+struct StringEqual
+{
+    typedef void is_transparent;
+
+    template <typename T, typename U>
+    bool operator()(const T& a, const U& b) const
+    {
+        std::pair<const char*, std::size_t> x = detail::stringBytes(a);
+        std::pair<const char*, std::size_t> y = detail::stringBytes(b);
+        return x.second == y.second &&
+               std::memcmp(x.first, y.first, x.second) == 0;
+    };
+};
+
+namespace detail
+{
+
+/**
+ * @brief Sorting key of a String: its bytes and its position in range.
+ */
+struct StringKey
+{
+    const unsigned char* data;
+    std::size_t size;
+    std::size_t index;
+    std::uint64_t chunk;
+};
+
+/**
+ * Sort n keys sharing a common prefix of depth bytes.
+ */
+void multikeyQuicksort(StringKey* keys, std::size_t n, std::size_t depth);
+
+} //end of namespace detail
+
 /**
  * Operator<<
  * 
@@ -903,6 +1125,83 @@ std::istream& getline(std::istream& is, String& str);
  */
 std::istream& getline(std::istream& is, String& str, char delim);
 
+/*
+ * RadixSorter<String>
+ */
+
+template <typename RandomIt, typename Alloc>
+void RadixSorter<String>::sort(RandomIt first, RandomIt last, 
+                               const Alloc& alloc)
+{
+    typedef typename std::allocator_traits<Alloc>::template 
+        rebind_alloc<detail::StringKey> KeyAlloc;
+    typedef typename std::allocator_traits<Alloc>::template 
+        rebind_alloc<String> StringAlloc;
+    std::size_t n = last - first;
+    if (n < radixSortThreshold)
+    {
+        std::sort(first, last);
+        return;
+    }
+    std::vector<detail::StringKey, KeyAlloc> keys((KeyAlloc(alloc)));
+    keys.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const String& str = first[i];
+        detail::StringKey key = {0, str.size(), i, 0};
+        if (key.size > 0)
+            key.data = reinterpret_cast<const unsigned char*>(&*str.begin());
+        keys.push_back(key);
+    }
+    detail::multikeyQuicksort(keys.data(), n, 0);
+    std::vector<String, StringAlloc> sorted((StringAlloc(alloc)));
+    sorted.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        sorted.push_back(std::move(first[keys[i].index]));
+    std::move(sorted.begin(), sorted.end(), first);
+}
+
+/*
+ * Method split
+ */
+
+template <typename Container>
+Container String::split(const std::string& sep) const
+{
+    Container fields;
+    size_t pos, current;
+    current = 0;
+    while (true)
+    {
+        pos = m_str.find_first_of(sep, current);
+        if (pos == std::string::npos)
+        {
+            fields.append(String(m_str.substr(current)));
+            break;
+        }
+        else if (pos == current)
+            current++;
+        else
+        {
+            fields.append(String(m_str.substr(current, pos - current)));
+            current = pos + 1;
+        }
+    }
+    return fields;
+}
+
+template <typename Container>
+Container String::split() const
+{
+    return split<Container>(std::string(" \t\r\n"));
+}
+
+template <typename Container>
+Container String::split(const char c) const
+{
+    return split<Container>(std::string(1, c));
+}
+
 #ifdef SNOWBALL_WITH_BOOST_LOCALE
 /**
  * This enables to set once and for all locale settings for boost locale
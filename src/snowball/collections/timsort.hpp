@@ -0,0 +1,568 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_TIMSORT_H
+#define SNOWBALL_TIMSORT_H
+
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace snowball
+{
+
+/**
+ * Stable sort of range [first, last) with Timsort.
+ *
+ * This is the algorithm of Python list.sort: the range is cut into runs
+ * which are already sorted (descending runs are reversed), short runs are
+ * extended with a binary insertion sort, then runs are merged with galloping
+ * when one of them wins many times in a row. Sorted or reverse-sorted input
+ * is handled in linear time and a range made of a few sorted sequences is
+ * sorted in O(n log(runs)).
+ *
+ * Items of equivalent values keep their relative order. Merges use a buffer
+ * of at most half the range. If the comparator throws, the exception is
+ * propagated and the range holds all its items in an unspecified order.
+ *
+ * @tparam RandomIt random access iterator
+ * @tparam Compare comparator type
+ * @param first beginning of range
+ * @param last end of range
+ * @param comp comparator
+ */
+template <typename RandomIt, typename Compare>
+void stableSort(RandomIt first, RandomIt last, const Compare& comp);
+
+/**
+ * Stable sort of range [first, last) in ascending order with Timsort.
+ *
+ * @tparam RandomIt random access iterator
+ * @param first beginning of range
+ * @param last end of range
+ */
+template <typename RandomIt>
+void stableSort(RandomIt first, RandomIt last);
+
+namespace detail
+{
+
+/**
+ * @brief State of a Timsort: pending runs, merge buffer and gallop threshold.
+ *
+ * @tparam RandomIt random access iterator
+ * @tparam Compare comparator type
+ */
+template <typename RandomIt, typename Compare>
+class TimSort
+{
+public:
+
+    typedef typename std::iterator_traits<RandomIt>::value_type value_type;
+    typedef std::size_t size_type;
+
+    /**
+     * Constructor
+     *
+     * @param first beginning of range
+     * @param comp comparator
+     */
+    TimSort(RandomIt first, const Compare& comp);
+
+    /**
+     * Sort first n items.
+     */
+    void sort(size_type n);
+
+private:
+
+    /**
+     * Ranges shorter than this are sorted by binary insertion only.
+     */
+    static const size_type minMerge = 64;
+
+    /**
+     * Initial number of consecutive wins before galloping.
+     */
+    static const size_type minGallop = 7;
+
+    /**
+     * Return the minimum run length for a range of n items.
+     */
+    static size_type minRunLength(size_type n);
+
+    /**
+     * Return the length of the run starting at lo, reversing it if descending.
+     */
+    size_type countRun(size_type lo, size_type hi);
+
+    /**
+     * Sort [lo, hi) knowing that [lo, start) is already sorted.
+     */
+    void binaryInsertionSort(size_type lo, size_type hi, size_type start);
+
+    /**
+     * Merge pending runs until stack invariants are restored.
+     */
+    void mergeCollapse();
+
+    /**
+     * Merge all pending runs.
+     */
+    void mergeForceCollapse();
+
+    /**
+     * Merge pending runs i and i + 1.
+     */
+    void mergeAt(size_type i);
+
+    /**
+     * Merge adjacent runs, the first one being the shortest.
+     */
+    void mergeLo(size_type base1, size_type len1, size_type base2,
+                 size_type len2);
+
+    /**
+     * Merge adjacent runs, the second one being the shortest.
+     */
+    void mergeHi(size_type base1, size_type len1, size_type base2,
+                 size_type len2);
+
+    /**
+     * Return the number of items of sorted [base, base + len) before which
+     * key would be inserted, starting the search at hint.
+     *
+     * With Right false, key goes before equal items (number of items less
+     * than key); with Right true, key goes after them.
+     */
+    template <bool Right, typename Iterator>
+    size_type gallop(const value_type& key, Iterator base, size_type len,
+                     size_type hint) const;
+
+    /**
+     * Attributes
+     */
+    RandomIt m_first;
+    const Compare& m_comp;
+    size_type m_minGallop;
+    std::vector<value_type> m_buffer;
+    std::vector< std::pair<size_type, size_type> > m_runs;
+};
+
+} //end of namespace detail
+
+//=============================================================================
+// Implementation
+//=============================================================================
+
+template <typename RandomIt, typename Compare>
+void stableSort(RandomIt first, RandomIt last, const Compare& comp)
+{
+    detail::TimSort<RandomIt, Compare> timsort(first, comp);
+    timsort.sort(last - first);
+}
+
+template <typename RandomIt>
+void stableSort(RandomIt first, RandomIt last)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    stableSort(first, last, std::less<T>());
+}
+
+namespace detail
+{
+
+template <typename RandomIt, typename Compare>
+TimSort<RandomIt, Compare>::TimSort(RandomIt first, const Compare& comp)
+    : m_first(first), m_comp(comp), m_minGallop(minGallop)
+{
+
+}
+
+template <typename RandomIt, typename Compare>
+void TimSort<RandomIt, Compare>::sort(size_type n)
+{
+    if (n < 2)
+        return;
+    if (n < minMerge)
+    {
+        binaryInsertionSort(0, n, countRun(0, n));
+        return;
+    }
+    size_type minRun = minRunLength(n);
+    size_type lo = 0;
+    while (lo < n)
+    {
+        size_type length = countRun(lo, n);
+        if (length < minRun)
+        {
+            size_type forced = std::min(minRun, n - lo);
+            binaryInsertionSort(lo, lo + forced, lo + length);
+            length = forced;
+        }
+        m_runs.push_back(std::make_pair(lo, length));
+        mergeCollapse();
+        lo += length;
+    }
+    mergeForceCollapse();
+}
+
+template <typename RandomIt, typename Compare>
+typename TimSort<RandomIt, Compare>::size_type
+TimSort<RandomIt, Compare>::minRunLength(size_type n)
+{
+    size_type r = 0;
+    while (n >= minMerge)
+    {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+template <typename RandomIt, typename Compare>
+typename TimSort<RandomIt, Compare>::size_type
+TimSort<RandomIt, Compare>::countRun(size_type lo, size_type hi)
+{
+    size_type i = lo + 1;
+    if (i == hi)
+        return 1;
+    if (m_comp(m_first[i], m_first[lo]))
+    {
+        //strictly descending: reversing keeps stability
+        while (++i < hi && m_comp(m_first[i], m_first[i - 1]));
+        std::reverse(m_first + lo, m_first + i);
+    }
+    else
+    {
+        while (++i < hi && !m_comp(m_first[i], m_first[i - 1]));
+    }
+    return i - lo;
+}
+
+template <typename RandomIt, typename Compare>
+void TimSort<RandomIt, Compare>::binaryInsertionSort(size_type lo,
+                                                     size_type hi,
+                                                     size_type start)
+{
+    if (start == lo)
+        ++start;
+    for (; start < hi; ++start)
+    {
+        //search before moving anything so that a throwing comparator loses
+        //no item
+        RandomIt pos = std::upper_bound(m_first + lo, m_first + start,
+                                        m_first[start], m_comp);
+        RandomIt current = m_first + start;
+        if (pos == current)
+            continue;
+        value_type pivot = std::move(*current);
+        std::move_backward(pos, current, current + 1);
+        *pos = std::move(pivot);
+    }
+}
+
+template <typename RandomIt, typename Compare>
+void TimSort<RandomIt, Compare>::mergeCollapse()
+{
+    while (m_runs.size() > 1)
+    {
+        size_type n = m_runs.size() - 2;
+        if ((n > 0 && m_runs[n - 1].second <=
+                      m_runs[n].second + m_runs[n + 1].second) ||
+            (n > 1 && m_runs[n - 2].second <=
+                      m_runs[n - 1].second + m_runs[n].second))
+        {
+            if (m_runs[n - 1].second < m_runs[n + 1].second)
+                --n;
+            mergeAt(n);
+        }
+        else if (m_runs[n].second <= m_runs[n + 1].second)
+        {
+            mergeAt(n);
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+template <typename RandomIt, typename Compare>
+void TimSort<RandomIt, Compare>::mergeForceCollapse()
+{
+    while (m_runs.size() > 1)
+    {
+        size_type n = m_runs.size() - 2;
+        if (n > 0 && m_runs[n - 1].second < m_runs[n + 1].second)
+            --n;
+        mergeAt(n);
+    }
+}
+
+template <typename RandomIt, typename Compare>
+void TimSort<RandomIt, Compare>::mergeAt(size_type i)
+{
+    size_type base1 = m_runs[i].first;
+    size_type len1 = m_runs[i].second;
+    size_type base2 = m_runs[i + 1].first;
+    size_type len2 = m_runs[i + 1].second;
+    m_runs[i].second = len1 + len2;
+    m_runs.erase(m_runs.begin() + i + 1);
+    //items of run 1 not greater than the first of run 2 are in place
+    size_type k = gallop<true>(m_first[base2], m_first + base1, len1, 0);
+    base1 += k;
+    len1 -= k;
+    if (len1 == 0)
+        return;
+    //items of run 2 not less than the last of run 1 are in place
+    len2 = gallop<false>(m_first[base1 + len1 - 1], m_first + base2, len2,
+                         len2 - 1);
+    if (len2 == 0)
+        return;
+    if (len1 <= len2)
+        mergeLo(base1, len1, base2, len2);
+    else
+        mergeHi(base1, len1, base2, len2);
+}
+
+template <typename RandomIt, typename Compare>
+void TimSort<RandomIt, Compare>::mergeLo(size_type base1, size_type len1,
+                                         size_type base2, size_type len2)
+{
+    m_buffer.assign(std::make_move_iterator(m_first + base1),
+                    std::make_move_iterator(m_first + base1 + len1));
+    typename std::vector<value_type>::iterator tmp = m_buffer.begin();
+    size_type i1 = 0;
+    size_type i2 = base2;
+    size_type dest = base1;
+    size_type end2 = base2 + len2;
+    size_type threshold = m_minGallop;
+    try
+    {
+        while (i1 < len1 && i2 < end2)
+        {
+            //one item at a time until a run wins threshold times in a row
+            size_type count1 = 0;
+            size_type count2 = 0;
+            while (i1 < len1 && i2 < end2)
+            {
+                if (m_comp(m_first[i2], tmp[i1]))
+                {
+                    m_first[dest++] = std::move(m_first[i2++]);
+                    count1 = 0;
+                    if (++count2 >= threshold)
+                        break;
+                }
+                else
+                {
+                    m_first[dest++] = std::move(tmp[i1++]);
+                    count2 = 0;
+                    if (++count1 >= threshold)
+                        break;
+                }
+            }
+            if (i1 == len1 || i2 == end2)
+                break;
+            //galloping as long as it pays
+            ++threshold;
+            do
+            {
+                if (threshold > 1)
+                    --threshold;
+                count1 = gallop<true>(m_first[i2], tmp + i1, len1 - i1, 0);
+                std::move(tmp + i1, tmp + i1 + count1, m_first + dest);
+                dest += count1;
+                i1 += count1;
+                if (i1 == len1)
+                    break;
+                m_first[dest++] = std::move(m_first[i2++]);
+                if (i2 == end2)
+                    break;
+                count2 = gallop<false>(tmp[i1], m_first + i2, end2 - i2, 0);
+                std::move(m_first + i2, m_first + i2 + count2,
+                          m_first + dest);
+                dest += count2;
+                i2 += count2;
+                if (i2 == end2)
+                    break;
+                m_first[dest++] = std::move(tmp[i1++]);
+                if (i1 == len1)
+                    break;
+            } while (count1 >= minGallop || count2 >= minGallop);
+            if (i1 == len1 || i2 == end2)
+                break;
+            ++threshold;
+        }
+    }
+    catch (...)
+    {
+        //the hole left in range is exactly the size of the buffer left
+        std::move(tmp + i1, tmp + len1, m_first + dest);
+        throw;
+    }
+    std::move(tmp + i1, tmp + len1, m_first + dest);
+    m_minGallop = std::max<size_type>(1, threshold);
+}
+
+template <typename RandomIt, typename Compare>
+void TimSort<RandomIt, Compare>::mergeHi(size_type base1, size_type len1,
+                                         size_type base2, size_type len2)
+{
+    m_buffer.assign(std::make_move_iterator(m_first + base2),
+                    std::make_move_iterator(m_first + base2 + len2));
+    typename std::vector<value_type>::iterator tmp = m_buffer.begin();
+    //cursors are one past the next item to be moved
+    size_type i1 = base1 + len1;
+    size_type i2 = len2;
+    size_type dest = base2 + len2;
+    size_type threshold = m_minGallop;
+    try
+    {
+        while (i1 > base1 && i2 > 0)
+        {
+            size_type count1 = 0;
+            size_type count2 = 0;
+            while (i1 > base1 && i2 > 0)
+            {
+                if (m_comp(tmp[i2 - 1], m_first[i1 - 1]))
+                {
+                    m_first[--dest] = std::move(m_first[--i1]);
+                    count2 = 0;
+                    if (++count1 >= threshold)
+                        break;
+                }
+                else
+                {
+                    m_first[--dest] = std::move(tmp[--i2]);
+                    count1 = 0;
+                    if (++count2 >= threshold)
+                        break;
+                }
+            }
+            if (i1 == base1 || i2 == 0)
+                break;
+            ++threshold;
+            do
+            {
+                if (threshold > 1)
+                    --threshold;
+                size_type remaining = i1 - base1;
+                count1 = remaining - gallop<true>(tmp[i2 - 1], m_first + base1,
+                                                  remaining, remaining - 1);
+                std::move_backward(m_first + i1 - count1, m_first + i1,
+                                   m_first + dest);
+                dest -= count1;
+                i1 -= count1;
+                if (i1 == base1)
+                    break;
+                m_first[--dest] = std::move(tmp[--i2]);
+                if (i2 == 0)
+                    break;
+                count2 = i2 - gallop<false>(m_first[i1 - 1], tmp, i2, i2 - 1);
+                std::move_backward(tmp + i2 - count2, tmp + i2, m_first + dest);
+                dest -= count2;
+                i2 -= count2;
+                if (i2 == 0)
+                    break;
+                m_first[--dest] = std::move(m_first[--i1]);
+                if (i1 == base1)
+                    break;
+            } while (count1 >= minGallop || count2 >= minGallop);
+            if (i1 == base1 || i2 == 0)
+                break;
+            ++threshold;
+        }
+    }
+    catch (...)
+    {
+        std::move(tmp, tmp + i2, m_first + i1);
+        throw;
+    }
+    std::move(tmp, tmp + i2, m_first + i1);
+    m_minGallop = std::max<size_type>(1, threshold);
+}
+
+template <typename RandomIt, typename Compare>
+template <bool Right, typename Iterator>
+typename TimSort<RandomIt, Compare>::size_type
+TimSort<RandomIt, Compare>::gallop(const value_type& key, Iterator base,
+                                   size_type len, size_type hint) const
+{
+    //pred is true for items going before key: true then false along base
+    const Compare& comp = m_comp;
+    auto before = [&](const value_type& item) {
+        return Right ? !comp(key, item) : comp(item, key);
+    };
+    size_type lo;
+    size_type hi;
+    size_type lastOffset = 0;
+    size_type offset = 1;
+    if (before(base[hint]))
+    {
+        //gallop to the right of hint
+        size_type maxOffset = len - hint;
+        while (offset < maxOffset &&
+               before(base[hint + offset]))
+        {
+            lastOffset = offset;
+            offset = (offset << 1) + 1;
+        }
+        if (offset > maxOffset)
+            offset = maxOffset;
+        lo = hint + lastOffset + 1;
+        hi = hint + offset;
+    }
+    else
+    {
+        //gallop to the left of hint
+        size_type maxOffset = hint + 1;
+        while (offset < maxOffset &&
+               !before(base[hint - offset]))
+        {
+            lastOffset = offset;
+            offset = (offset << 1) + 1;
+        }
+        if (offset > maxOffset)
+            offset = maxOffset;
+        lo = hint + 1 - offset;
+        hi = hint - lastOffset;
+    }
+    while (lo < hi)
+    {
+        size_type middle = lo + (hi - lo) / 2;
+        if (before(base[middle]))
+            lo = middle + 1;
+        else
+            hi = middle;
+    }
+    return lo;
+}
+
+} //end of namespace detail
+
+} //end of namespace snowball
+
+#endif
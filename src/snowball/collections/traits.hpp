@@ -0,0 +1,82 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ *
+ * Type traits with which containers select fast paths.
+ */
+
+#ifndef SNOWBALL_TRAITS_HPP
+#define SNOWBALL_TRAITS_HPP
+
+#include <type_traits>
+
+namespace snowball
+{
+
+/**
+ * @brief Whether two objects of type T are equal if and only if their
+ * object representations (bytes) are equal.
+ *
+ * Containers of such types compare and hash their storage as a whole with
+ * memcmp and byte hashing. This holds for integral types, enumerations and
+ * pointers. It does not for floating point types (0.0 == -0.0, NaN != NaN)
+ * nor for types with padding bytes.
+ *
+ * A trivially copyable type without padding which operator== compares all
+ * members bitwise may opt in:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * struct Point { int x; int y; };
+ *
+ * namespace snowball
+ * {
+ * template <>
+ * struct TriviallyComparable<Point>: public std::true_type { };
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @tparam T type of objects
+ */
+template <typename T>
+struct TriviallyComparable: public std::integral_constant<bool,
+    std::is_integral<T>::value || std::is_enum<T>::value ||
+    std::is_pointer<T>::value> { };
+
+/**
+ * @brief Whether an object of type T may be moved to another address by
+ * copying its bytes, the source being then forgotten without running its
+ * destructor.
+ *
+ * Containers of such types grow with realloc instead of allocating a new
+ * buffer, moving items one by one and freeing the old buffer. This holds for
+ * trivially copyable types. Types which hold pointers to heap memory but no
+ * pointer to themselves (nor are pointed to by other objects) may opt in by
+ * specializing this trait. Types holding a pointer into their own storage,
+ * like libstdc++ std::string with its short string buffer, must not.
+ *
+ * @tparam T type of objects
+ */
+template <typename T>
+struct TriviallyRelocatable: public std::integral_constant<bool,
+    std::is_trivially_copyable<T>::value> { };
+
+} //end of namespace snowball
+
+#endif
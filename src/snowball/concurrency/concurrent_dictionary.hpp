@@ -0,0 +1,493 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_CONCURRENT_DICTIONARY_HPP
+#define SNOWBALL_CONCURRENT_DICTIONARY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "snowball/collections/flat_dictionary.hpp"
+#include "snowball/collections/list.hpp"
+#include "snowball/concurrency/read_write_lock.h"
+
+#ifdef SNOWBALL_WITH_BOOST_HASH
+#include <boost/functional/hash.hpp>
+#endif
+
+namespace snowball
+{
+
+//==============================================================================
+// CONCURRENTDICTIONARY DECLARATION
+//==============================================================================
+
+/**
+ * @brief Dictionary shared by several threads, split into locked shards.
+ *
+ * Keys are spread over a power of two number of shards by the upper bits of
+ * their hash. Each shard is a FlatDictionary with its own ReadWriteLock, so
+ * that threads working on different shards never wait for each other, and
+ * readers of the same shard do not wait for each other either:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * ConcurrentDictionary<std::string, long> hits;
+ * ThreadPool::instance().parallelFor(n, [&](std::size_t i) {
+ *     hits.update(requests[i].path, [](long& count) { ++count; });
+ * });
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Each method hashes the key once: the hash selects the shard, then probes
+ * the shard under its lock. Shards are padded so that their locks do not
+ * share a cache line.
+ *
+ * Values are returned by copy as another thread may erase them as soon as
+ * the lock is released. Each method is atomic: getOrInsert and update look
+ * up and modify the value under the same exclusive lock. getOrInsert first
+ * tries a shared lock so that hits do not serialize readers.
+ *
+ * size, keys, values and forEach visit shards one after another: they see
+ * each shard at a different time and are not a snapshot of the whole
+ * dictionary.
+ *
+ * As in FlatDictionary, lookup methods take keys of any type, which are not
+ * converted into Key when Hash and Pred are transparent.
+ *
+ * @tparam Key type of keys
+ * @tparam Value type of values
+ * @tparam Hash hash function of keys
+ * @tparam Pred equality of keys
+ */
+template <typename Key,
+          typename Value,
+#ifdef SNOWBALL_WITH_BOOST_HASH
+          typename Hash=boost::hash<Key>,
+#else
+          typename Hash=std::hash<Key>,
+#endif
+          typename Pred=std::equal_to<Key> >
+class ConcurrentDictionary
+{
+public:
+
+    /**
+     * @typedef size_type
+     * Type of dictionary size
+     */
+    typedef std::size_t size_type;
+
+    /**
+     * @typedef shard_type
+     * Type of dictionary of each shard
+     */
+    typedef FlatDictionary<Key, Value, Hash, Pred> shard_type;
+
+    /**
+     * Constructor
+     *
+     * Build an empty dictionary. Shards allocate no memory before their
+     * first insertion.
+     *
+     * @param shards number of shards, rounded up to a power of two. 0 stands
+     * for 4 times the number of hardware threads.
+     */
+    explicit ConcurrentDictionary(size_type shards = 0);
+
+    /**
+     * Return the number of shards.
+     */
+    size_type shards() const;
+
+    /**
+     * Return the number of pairs, summed over shards.
+     */
+    size_type size() const;
+
+    /**
+     * Return true if the dictionary has no pair.
+     */
+    bool empty() const;
+
+    /**
+     * Make room for n pairs spread evenly over shards, so that no shard
+     * grows while they are inserted.
+     *
+     * @param n number of pairs
+     */
+    void reserve(size_type n);
+
+    /**
+     * Erase all pairs. Shards keep their capacity.
+     */
+    void clear();
+
+    /**
+     * Return true if dictionary contains key.
+     *
+     * @param key key to look for
+     */
+    template <typename K = Key>
+    bool contains(const K& key) const;
+
+    /**
+     * Return a copy of value of key, or default value if key does not exist.
+     *
+     * @param key key to look for
+     * @param defaultValue value returned if key does not exist
+     */
+    template <typename K = Key>
+    Value get(const K& key, const Value& defaultValue) const;
+
+    /**
+     * Return a copy of value of key, inserting given value first if key
+     * does not exist.
+     *
+     * @param key key to look for
+     * @param value value inserted if key does not exist
+     */
+    template <typename K = Key>
+    Value getOrInsert(const K& key, const Value& value);
+
+    /**
+     * Set value of key, inserting key if it does not exist.
+     *
+     * @param key key to set
+     * @param value new value of key
+     */
+    template <typename K = Key>
+    void set(const K& key, const Value& value);
+
+    /**
+     * Call function with a reference to value of key, and return a copy of
+     * value afterwards. If key does not exist, it is inserted with a default
+     * constructed value before function is called.
+     *
+     * Shard is locked while function runs: it must be short and must not
+     * use the dictionary.
+     *
+     * @param key key to update
+     * @param function function called with Value&
+     */
+    template <typename Function, typename K = Key>
+    Value update(const K& key, Function function);
+
+    /**
+     * Erase key and return true if it existed.
+     *
+     * @param key key to erase
+     */
+    template <typename K = Key>
+    bool erase(const K& key);
+
+    /**
+     * Call function with key and value of each pair.
+     *
+     * Each shard is locked for reading while it is visited: function must
+     * not use the dictionary. Even reads may deadlock, as the lock is not 
+     * recursive and lets a waiting writer go first.
+     *
+     * @param function function called with (const Key&, const Value&)
+     */
+    template <typename Function>
+    void forEach(Function function) const;
+
+    /**
+     * Return a list of all dictionary keys.
+     */
+    List<Key> keys() const;
+
+    /**
+     * Return a list of all dictionary values.
+     */
+    List<Value> values() const;
+
+private:
+
+    //Non copyable
+    ConcurrentDictionary(const ConcurrentDictionary&);
+    ConcurrentDictionary& operator=(const ConcurrentDictionary&);
+
+    /**
+     * @brief Dictionary and lock of one shard.
+     *
+     * Padding keeps locks of consecutive shards in distinct cache lines.
+     */
+    struct Shard
+    {
+        mutable ReadWriteLock lock;
+        shard_type dictionary;
+        char padding[64];
+    };
+
+    /**
+     * Return mixed hash of key, as computed by shards.
+     */
+    template <typename K>
+    std::uint64_t hashOf(const K& key) const;
+
+    /**
+     * Return shard of a mixed hash.
+     */
+    Shard& shardOf(std::uint64_t hash) const;
+
+    /**
+     * Attributes
+     */
+    std::unique_ptr<Shard[]> m_shards;
+    size_type m_count;
+    unsigned m_bits;
+    Hash m_hash;
+};
+
+//==============================================================================
+// CONCURRENTDICTIONARY DEFINITION
+//==============================================================================
+
+/*
+ * Constructor
+ */
+
+template <typename K, typename V, typename H, typename P>
+ConcurrentDictionary<K, V, H, P>::ConcurrentDictionary(size_type shards):
+    m_count(1), m_bits(0)
+{
+    if (shards == 0)
+        shards = 4 * std::max(1u, std::thread::hardware_concurrency());
+    while (m_count < shards)
+    {
+        m_count *= 2;
+        ++m_bits;
+    }
+    m_shards.reset(new Shard[m_count]);
+}
+
+/*
+ * Size and capacity
+ */
+
+template <typename K, typename V, typename H, typename P>
+typename ConcurrentDictionary<K, V, H, P>::size_type
+ConcurrentDictionary<K, V, H, P>::shards() const
+{
+    return m_count;
+}
+
+template <typename K, typename V, typename H, typename P>
+typename ConcurrentDictionary<K, V, H, P>::size_type
+ConcurrentDictionary<K, V, H, P>::size() const
+{
+    size_type n = 0;
+    for (size_type i = 0; i < m_count; ++i)
+    {
+        ReadGuard guard(m_shards[i].lock);
+        n += m_shards[i].dictionary.size();
+    }
+    return n;
+}
+
+template <typename K, typename V, typename H, typename P>
+bool ConcurrentDictionary<K, V, H, P>::empty() const
+{
+    return size() == 0;
+}
+
+template <typename K, typename V, typename H, typename P>
+void ConcurrentDictionary<K, V, H, P>::reserve(size_type n)
+{
+    //hashes are not spread exactly evenly: leave some slack
+    size_type perShard = (n + m_count - 1) / m_count;
+    perShard += perShard / 8;
+    for (size_type i = 0; i < m_count; ++i)
+    {
+        std::lock_guard<ReadWriteLock> guard(m_shards[i].lock);
+        m_shards[i].dictionary.reserve(perShard);
+    }
+}
+
+template <typename K, typename V, typename H, typename P>
+void ConcurrentDictionary<K, V, H, P>::clear()
+{
+    for (size_type i = 0; i < m_count; ++i)
+    {
+        std::lock_guard<ReadWriteLock> guard(m_shards[i].lock);
+        m_shards[i].dictionary.clear();
+    }
+}
+
+/*
+ * Lookup and mutation
+ */
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+bool ConcurrentDictionary<K, V, H, P>::contains(const K2& key) const
+{
+    typename detail::FlatProbe<K, K2, H, P>::type probe = key;
+    std::uint64_t hash = hashOf(probe);
+    Shard& shard = shardOf(hash);
+    ReadGuard guard(shard.lock);
+    return shard.dictionary.find(probe, hash) != shard_type::npos;
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+V ConcurrentDictionary<K, V, H, P>::get(const K2& key,
+                                        const V& defaultValue) const
+{
+    typename detail::FlatProbe<K, K2, H, P>::type probe = key;
+    std::uint64_t hash = hashOf(probe);
+    Shard& shard = shardOf(hash);
+    ReadGuard guard(shard.lock);
+    size_type slot = shard.dictionary.find(probe, hash);
+    if (slot == shard_type::npos)
+        return defaultValue;
+    return shard.dictionary.m_slots[slot].second;
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+V ConcurrentDictionary<K, V, H, P>::getOrInsert(const K2& key,
+                                                const V& value)
+{
+    typename detail::FlatProbe<K, K2, H, P>::type probe = key;
+    std::uint64_t hash = hashOf(probe);
+    Shard& shard = shardOf(hash);
+    {
+        ReadGuard guard(shard.lock);
+        size_type slot = shard.dictionary.find(probe, hash);
+        if (slot != shard_type::npos)
+            return shard.dictionary.m_slots[slot].second;
+    }
+    //another thread may insert key in between: insert checks again
+    std::lock_guard<ReadWriteLock> guard(shard.lock);
+    bool inserted;
+    size_type slot = shard.dictionary.insert(probe, hash, inserted, value);
+    return shard.dictionary.m_slots[slot].second;
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+void ConcurrentDictionary<K, V, H, P>::set(const K2& key, const V& value)
+{
+    typename detail::FlatProbe<K, K2, H, P>::type probe = key;
+    std::uint64_t hash = hashOf(probe);
+    Shard& shard = shardOf(hash);
+    std::lock_guard<ReadWriteLock> guard(shard.lock);
+    bool inserted;
+    size_type slot = shard.dictionary.insert(probe, hash, inserted, value);
+    if (!inserted)
+        shard.dictionary.m_slots[slot].second = value;
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename Function, typename K2>
+V ConcurrentDictionary<K, V, H, P>::update(const K2& key, Function function)
+{
+    typename detail::FlatProbe<K, K2, H, P>::type probe = key;
+    std::uint64_t hash = hashOf(probe);
+    Shard& shard = shardOf(hash);
+    std::lock_guard<ReadWriteLock> guard(shard.lock);
+    bool inserted;
+    size_type slot = shard.dictionary.insert(probe, hash, inserted);
+    V& value = shard.dictionary.m_slots[slot].second;
+    function(value);
+    return value;
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+bool ConcurrentDictionary<K, V, H, P>::erase(const K2& key)
+{
+    typename detail::FlatProbe<K, K2, H, P>::type probe = key;
+    std::uint64_t hash = hashOf(probe);
+    Shard& shard = shardOf(hash);
+    std::lock_guard<ReadWriteLock> guard(shard.lock);
+    size_type slot = shard.dictionary.find(probe, hash);
+    if (slot == shard_type::npos)
+        return false;
+    shard.dictionary.eraseSlot(slot);
+    return true;
+}
+
+/*
+ * Traversal
+ */
+
+template <typename K, typename V, typename H, typename P>
+template <typename Function>
+void ConcurrentDictionary<K, V, H, P>::forEach(Function function) const
+{
+    for (size_type i = 0; i < m_count; ++i)
+    {
+        const Shard& shard = m_shards[i];
+        ReadGuard guard(shard.lock);
+        const shard_type& dictionary = shard.dictionary;
+        for (size_type slot = 0; slot < dictionary.m_capacity; ++slot)
+            if (dictionary.m_control[slot] >= 0)
+                function(dictionary.m_slots[slot].first,
+                         dictionary.m_slots[slot].second);
+    }
+}
+
+template <typename K, typename V, typename H, typename P>
+List<K> ConcurrentDictionary<K, V, H, P>::keys() const
+{
+    List<K> result;
+    forEach([&result](const K& key, const V&) { result.append(key); });
+    return result;
+}
+
+template <typename K, typename V, typename H, typename P>
+List<V> ConcurrentDictionary<K, V, H, P>::values() const
+{
+    List<V> result;
+    forEach([&result](const K&, const V& value) { result.append(value); });
+    return result;
+}
+
+/*
+ * private helpers
+ */
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+std::uint64_t ConcurrentDictionary<K, V, H, P>::hashOf(const K2& key) const
+{
+    return detail::flatMix(m_hash(key));
+}
+
+template <typename K, typename V, typename H, typename P>
+typename ConcurrentDictionary<K, V, H, P>::Shard&
+ConcurrentDictionary<K, V, H, P>::shardOf(std::uint64_t hash) const
+{
+    //upper bits: shards use lower bits to place keys in their slots
+    return m_shards[m_bits == 0 ? 0 : hash >> (64 - m_bits)];
+}
+
+} //end of namespace snowball
+
+#endif
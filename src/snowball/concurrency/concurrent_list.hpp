@@ -0,0 +1,537 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_CONCURRENT_LIST_HPP
+#define SNOWBALL_CONCURRENT_LIST_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <utility>
+#include <vector>
+#include <type_traits>
+
+#include "snowball/exceptions/exceptions.h"
+#include "snowball/collections/check_policy.hpp"
+#include "snowball/collections/list.hpp"
+
+namespace snowball
+{
+
+//==============================================================================
+// CONCURRENTLIST DECLARATION
+//==============================================================================
+
+/**
+ * @brief Append-only list filled by several threads without lock.
+ *
+ * @tparam T type of items, which move constructor must not throw
+ *
+ * Producer threads share the list and call append, which never blocks:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * ConcurrentList<Result> results;
+ * ThreadPool::instance().parallelFor(n, [&](std::size_t i) {
+ *     results.append(compute(i));
+ * });
+ * List<Result> list = results.freeze();
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Items are stored in segments which never move: segment 0 holds the
+ * capacity given to the constructor (rounded up to a power of two) and each
+ * following segment doubles the total capacity. A segment is allocated by the
+ * first thread which needs it; concurrent threads race with compare and swap
+ * and the losers release their buffer.
+ *
+ * append makes sure the segment of the next slot is allocated, reserves the
+ * slot with a compare and swap and moves the item into it. If all slots before are published, the size is pushed over the
+ * slot at once; else the slot is flagged as ready and the thread which fills
+ * the last missing slot before it pushes the size over all ready slots, so
+ * that no thread waits for a slower one.
+ * size is therefore a snapshot which only grows, and items below it may be
+ * read by operator[] concurrently with appends, in constant time and without
+ * retry.
+ *
+ * freeze ends the concurrent phase and hands storage over to a List. With
+ * trivially relocatable items, segment 0 becomes the buffer of the list: no
+ * item is moved if the list fits in the initial capacity, else the buffer is
+ * extended with realloc and the other segments are appended with memcpy.
+ * Other items are moved into the list one by one.
+ *
+ * Items are never removed: there is no pop, insert or remove. If memory runs
+ * out when a segment is allocated, std::bad_alloc is thrown before any slot
+ * is reserved: the list is left unchanged and remains usable.
+ */
+template <typename T>
+class ConcurrentList
+{
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+                  "ConcurrentList requires nothrow move constructible items");
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "ConcurrentList does not support over-aligned items");
+
+public:
+
+    /**
+     * @typedef size_type
+     * size type of list
+     */
+    typedef std::size_t size_type;
+
+    /**
+     * @typedef value_type
+     * value type of list
+     */
+    typedef T value_type;
+
+    /**
+     * Base 2 logarithm of the smallest capacity of segment 0.
+     */
+    static const size_type minimumShift = 10;
+
+    /**
+     * Constructor
+     *
+     * Build an empty list. No memory is allocated before the first append.
+     *
+     * @param capacity number of items stored in segment 0
+     */
+    explicit ConcurrentList(size_type capacity = 0);
+
+    /**
+     * Destructor
+     *
+     * No thread may append concurrently.
+     */
+    ~ConcurrentList();
+
+    ConcurrentList(const ConcurrentList<T>& other) = delete;
+    ConcurrentList<T>& operator=(const ConcurrentList<T>& other) = delete;
+
+    /**
+     * Append an item to the list. Thread-safe and lock-free.
+     *
+     * @param value item to be copied
+     * @return index of item, which may be read once size is above it
+     */
+    size_type append(const T& value);
+
+    /**
+     * Append an item to the list. Thread-safe and lock-free.
+     *
+     * @param value item to be moved
+     * @return index of item, which may be read once size is above it
+     */
+    size_type append(T&& value);
+
+    /**
+     * Append an item built from arguments. Thread-safe and lock-free.
+     *
+     * The item is built before a slot is reserved: if its constructor throws,
+     * the list is unchanged.
+     *
+     * @param args arguments given to the constructor of item
+     * @return index of item, which may be read once size is above it
+     */
+    template <typename... Args>
+    size_type emplace(Args&&... args);
+
+    /**
+     * Get item at given index. Thread-safe and wait-free.
+     *
+     * @param index index of item, negative values count from size
+     * @throw IndexError index is not below size
+     */
+    T& operator[](long index) throw(IndexError);
+
+    /**
+     * Get item at given index. Thread-safe and wait-free.
+     *
+     * @param index index of item, negative values count from size
+     * @throw IndexError index is not below size
+     */
+    const T& operator[](long index) const throw(IndexError);
+
+    /**
+     * Return the number of items which may be read. Thread-safe.
+     *
+     * Items appended concurrently may not be counted yet.
+     */
+    size_type size() const;
+
+    /**
+     * Return true if no item may be read. Thread-safe.
+     */
+    bool empty() const;
+
+    /**
+     * Move items into a List and leave this list empty.
+     *
+     * No thread may append concurrently: all appends must have returned.
+     */
+    List<T> freeze();
+
+private:
+
+    /**
+     * Return segment which stores item at given index and set offset of
+     * item in this segment.
+     */
+    size_type locate(size_type index, size_type& offset) const;
+
+    /**
+     * Return number of items of given segment.
+     */
+    size_type segmentSize(size_type segment) const;
+
+    /**
+     * Return ready flags of given segment, which follow items in buffer.
+     */
+    std::atomic<unsigned char>* flags(T* items, size_type segment) const;
+
+    /**
+     * Return buffer of given segment, allocating it if needed.
+     */
+    T* acquire(size_type segment);
+
+    /**
+     * Move item into a new slot and publish it.
+     */
+    size_type publish(T&& item);
+
+    /**
+     * Whether slot at given index is filled.
+     */
+    bool ready(size_type index) const;
+
+    /**
+     * Return item at given index, which must be below size.
+     */
+    T& at(size_type index) const;
+
+    /**
+     * Destroy items, release segments and reset counters.
+     */
+    void release(bool destroyItems);
+
+    /**
+     * Hand segments over to storage of a list (trivially relocatable items).
+     * Member templates: only the selected version is instantiated.
+     */
+    template <typename Storage>
+    void freeze(Storage& storage, std::true_type);
+
+    /**
+     * Move items one by one into storage of a list.
+     */
+    template <typename Storage>
+    void freeze(Storage& storage, std::false_type);
+
+    /**
+     * Maximum number of segments.
+     */
+    static const size_type maximumSegments = 64;
+
+    /**
+     * Attributes
+     *
+     * Reservation and publication counters are kept on separate cache lines
+     * as all producers update both.
+     */
+    size_type m_shift;
+    std::atomic<T*> m_segments[maximumSegments];
+    std::atomic<size_type> m_reserved;
+    char m_padding[64];
+    std::atomic<size_type> m_size;
+};
+
+//==============================================================================
+// CONCURRENTLIST DEFINITION
+//==============================================================================
+
+//constructor and destructor
+
+template <typename T>
+ConcurrentList<T>::ConcurrentList(size_type capacity):
+    m_shift(minimumShift), m_reserved(0), m_size(0)
+{
+    while ((size_type(1) << m_shift) < capacity)
+        ++m_shift;
+    for (size_type i = 0; i < maximumSegments; ++i)
+        m_segments[i].store(0, std::memory_order_relaxed);
+}
+
+template <typename T>
+ConcurrentList<T>::~ConcurrentList()
+{
+    release(true);
+}
+
+//append methods
+
+template <typename T>
+typename ConcurrentList<T>::size_type ConcurrentList<T>::append(const T& value)
+{
+    T item(value);
+    return publish(std::move(item));
+}
+
+template <typename T>
+typename ConcurrentList<T>::size_type ConcurrentList<T>::append(T&& value)
+{
+    return publish(std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+typename ConcurrentList<T>::size_type ConcurrentList<T>::emplace(
+    Args&&... args)
+{
+    T item(std::forward<Args>(args)...);
+    return publish(std::move(item));
+}
+
+//access methods
+
+template <typename T>
+T& ConcurrentList<T>::operator[](long index) throw(IndexError)
+{
+    return at(PythonCheck::position(index, size()));
+}
+
+template <typename T>
+const T& ConcurrentList<T>::operator[](long index) const throw(IndexError)
+{
+    return at(PythonCheck::position(index, size()));
+}
+
+template <typename T>
+typename ConcurrentList<T>::size_type ConcurrentList<T>::size() const
+{
+    return m_size.load(std::memory_order_acquire);
+}
+
+template <typename T>
+bool ConcurrentList<T>::empty() const
+{
+    return size() == 0;
+}
+
+//freeze method
+
+template <typename T>
+List<T> ConcurrentList<T>::freeze()
+{
+    List<T> list;
+    freeze(list.m_vector, std::integral_constant<bool, std::is_same<
+        typename List<T>::storage_type, RelocatableVector<T> >::value>());
+    return list;
+}
+
+//private helpers
+
+template <typename T>
+typename ConcurrentList<T>::size_type ConcurrentList<T>::locate(
+    size_type index, size_type& offset) const
+{
+    size_type first = size_type(1) << m_shift;
+    if (index < first)
+    {
+        offset = index;
+        return 0;
+    }
+    //segment k > 0 starts at first << (k - 1)
+#if defined(__GNUC__)
+    size_type segment = 64 - __builtin_clzll(index >> m_shift);
+#else
+    size_type segment = 0;
+    for (size_type rest = index >> m_shift; rest != 0; rest >>= 1)
+        ++segment;
+#endif
+    offset = index - (first << (segment - 1));
+    return segment;
+}
+
+template <typename T>
+typename ConcurrentList<T>::size_type ConcurrentList<T>::segmentSize(
+    size_type segment) const
+{
+    return segment == 0 ? size_type(1) << m_shift
+                        : size_type(1) << (m_shift + segment - 1);
+}
+
+template <typename T>
+std::atomic<unsigned char>* ConcurrentList<T>::flags(T* items,
+                                                     size_type segment) const
+{
+    return reinterpret_cast<std::atomic<unsigned char>*>(
+        items + segmentSize(segment));
+}
+
+template <typename T>
+T* ConcurrentList<T>::acquire(size_type segment)
+{
+    T* items = m_segments[segment].load(std::memory_order_acquire);
+    if (items)
+        return items;
+    size_type n = segmentSize(segment);
+    if (n > size_type(-1) / (sizeof(T) + 1))
+        throw std::bad_alloc();
+    //items then one ready flag per item, from calloc so that flags start
+    //cleared (large buffers come zeroed from mmap) and from malloc family so
+    //that freeze may hand segment 0 over to RelocatableVector
+    T* buffer = static_cast<T*>(std::calloc(n, sizeof(T) + 1));
+    if (!buffer)
+        throw std::bad_alloc();
+    if (m_segments[segment].compare_exchange_strong(
+        items, buffer, std::memory_order_acq_rel, std::memory_order_acquire))
+        return buffer;
+    //another thread installed the segment first
+    std::free(buffer);
+    return items;
+}
+
+template <typename T>
+typename ConcurrentList<T>::size_type ConcurrentList<T>::publish(T&& item)
+{
+    //allocate the segment of the slot before reserving it: if allocation
+    //throws, no slot is left unfilled below the size
+    size_type index = m_reserved.load(std::memory_order_relaxed);
+    size_type offset;
+    size_type segment;
+    T* items;
+    do
+    {
+        segment = locate(index, offset);
+        items = acquire(segment);
+    }
+    while (!m_reserved.compare_exchange_weak(index, index + 1,
+                                             std::memory_order_relaxed));
+    new (items + offset) T(std::move(item));
+    //slot follows the published ones: publish it directly, else flag it for
+    //the thread which fills the slots before
+    size_type current = index;
+    if (m_size.compare_exchange_strong(current, index + 1))
+        current = index + 1;
+    else
+        flags(items, segment)[offset].store(1);
+    //push size over ready slots: either this thread sees the slots flagged
+    //after its own, or their owners see the new size (sequential consistency)
+    current = m_size.load();
+    while (ready(current))
+        if (m_size.compare_exchange_weak(current, current + 1))
+            ++current;
+    return index;
+}
+
+template <typename T>
+bool ConcurrentList<T>::ready(size_type index) const
+{
+    size_type offset;
+    size_type segment = locate(index, offset);
+    T* items = m_segments[segment].load(std::memory_order_acquire);
+    return items && flags(items, segment)[offset].load() != 0;
+}
+
+template <typename T>
+T& ConcurrentList<T>::at(size_type index) const
+{
+    size_type offset;
+    size_type segment = locate(index, offset);
+    return m_segments[segment].load(std::memory_order_acquire)[offset];
+}
+
+template <typename T>
+void ConcurrentList<T>::release(bool destroyItems)
+{
+    size_type n = m_size.load();
+    for (size_type segment = 0; segment < maximumSegments; ++segment)
+    {
+        T* items = m_segments[segment].load();
+        if (!items)
+            continue;
+        if (destroyItems && !std::is_trivially_destructible<T>::value)
+        {
+            size_type first = segment == 0 ? 0 : segmentSize(segment);
+            for (size_type i = first; i < n && i < first + segmentSize(segment);
+                 ++i)
+                items[i - first].~T();
+        }
+        std::free(items);
+        m_segments[segment].store(0);
+    }
+    m_reserved.store(0);
+    m_size.store(0);
+}
+
+template <typename T>
+template <typename Storage>
+void ConcurrentList<T>::freeze(Storage& storage, std::true_type)
+{
+    size_type n = m_size.load();
+    if (n == 0)
+    {
+        release(false);
+        return;
+    }
+    T* data = m_segments[0].load();
+    size_type capacity = segmentSize(0);
+    if (n > capacity)
+    {
+        //ready flags at the end of segment 0 are overwritten
+        data = static_cast<T*>(std::realloc(static_cast<void*>(data),
+                                            n * sizeof(T)));
+        if (!data)
+            throw std::bad_alloc();
+        m_segments[0].store(data);
+        for (size_type segment = 1; capacity < n; ++segment)
+        {
+            size_type count = std::min(segmentSize(segment), n - capacity);
+            std::memcpy(static_cast<void*>(data + capacity),
+                        static_cast<const void*>(m_segments[segment].load()),
+                        count * sizeof(T));
+            capacity += count;
+        }
+    }
+    storage = Storage(data, n, capacity);
+    //segment 0 now belongs to list
+    m_segments[0].store(0);
+    release(false);
+}
+
+template <typename T>
+template <typename Storage>
+void ConcurrentList<T>::freeze(Storage& storage, std::false_type)
+{
+    size_type n = m_size.load();
+    storage.reserve(n);
+    for (size_type i = 0; i < n; ++i)
+        storage.push_back(std::move(at(i)));
+    release(true);
+}
+
+} //end of namespace snowball
+
+#endif
@@ -0,0 +1,327 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_PARALLEL_SORT_H
+#define SNOWBALL_PARALLEL_SORT_H
+
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "thread_pool.h"
+
+namespace snowball
+{
+
+/**
+ * @brief Request for a parallel algorithm.
+ *
+ * Passed to algorithms which have a parallel version, such as List::sort:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * list.sort(Parallel());       //all hardware threads
+ * list.sort(Parallel(4));      //at most 4 threads
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Below threshold items, the algorithm runs sequentially as starting threads
+ * would cost more than it saves. Work is split into as many tasks as threads
+ * and run by ThreadPool::instance: asking for more threads than hardware
+ * threads gives more tasks but no more concurrency.
+ */
+struct Parallel
+{
+    /**
+     * Default threshold below which algorithms run sequentially.
+     */
+    static const std::size_t defaultThreshold = 1 << 16;
+
+    /**
+     * Constructor
+     *
+     * @param threads maximum number of threads, 0 stands for all threads of
+     * the pool
+     * @param threshold number of items below which algorithm is sequential
+     */
+    explicit Parallel(unsigned threads = 0,
+                      std::size_t threshold = defaultThreshold)
+        : threads(threads), threshold(threshold) { }
+
+    /**
+     * Return the number of threads to be used for n items.
+     */
+    unsigned concurrency(std::size_t n) const
+    {
+        if (n < threshold || n < 2)
+            return 1;
+        unsigned pool = ThreadPool::instance().size();
+        unsigned count = threads == 0 ? pool : threads;
+        return std::size_t(count) > n / 2 ? unsigned(n / 2) : count;
+    }
+
+    unsigned threads;
+    std::size_t threshold;
+};
+
+/**
+ * Sort range [first, last) using several threads.
+ *
+ * The range is split into one chunk per thread, chunks are sorted with
+ * std::sort in parallel, then sorted runs are merged pairwise. Each merge is
+ * itself split between threads so that all of them keep busy until the last
+ * merge. The merges go through a buffer of the size of the range. As
+ * std::sort, this is not a stable sort.
+ *
+ * If an exception is thrown by the comparator, it is rethrown in the calling
+ * thread and the range is left in an unspecified order.
+ *
+ * @tparam RandomIt random access iterator
+ * @tparam Compare comparator type
+ * @param first beginning of range
+ * @param last end of range
+ * @param comp comparator
+ * @param policy thread count and threshold
+ */
+template <typename RandomIt, typename Compare>
+void parallelSort(RandomIt first, RandomIt last, const Compare& comp,
+                  const Parallel& policy = Parallel());
+
+/**
+ * Sort range [first, last) in ascending order using several threads.
+ *
+ * @tparam RandomIt random access iterator
+ * @param first beginning of range
+ * @param last end of range
+ * @param policy thread count and threshold
+ */
+template <typename RandomIt>
+void parallelSort(RandomIt first, RandomIt last,
+                  const Parallel& policy = Parallel());
+
+namespace detail
+{
+
+/**
+ * Part of a merge step: merge [a, aEnd) and [b, bEnd) into out.
+ *
+ * When b == bEnd, the part is only moved to out.
+ */
+struct MergePart
+{
+    std::size_t a;
+    std::size_t aEnd;
+    std::size_t b;
+    std::size_t bEnd;
+    std::size_t out;
+};
+
+/**
+ * @brief Uninitialized storage for the merge steps of parallelSort.
+ *
+ * Chunks of the storage are constructed and destroyed by the threads of the
+ * sort, so that the buffer costs no serial pass over the range. Chunks still
+ * built are destroyed by the destructor when the sort throws.
+ */
+template <typename T>
+class SortBuffer
+{
+public:
+
+    /**
+     * Constructor
+     *
+     * @param bounds bounds of chunks
+     */
+    explicit SortBuffer(const std::vector<std::size_t>& bounds):
+        m_bounds(bounds), m_built(bounds.size() - 1, 0),
+        m_data(m_alloc.allocate(bounds.back()))
+    {
+    };
+
+    /**
+     * Destructor
+     */
+    ~SortBuffer()
+    {
+        for (std::size_t i = 0; i < m_built.size(); ++i)
+            destroy(i);
+        m_alloc.deallocate(m_data, m_bounds.back());
+    };
+
+    /**
+     * Move-construct chunk i of the buffer from items starting at first.
+     */
+    template <typename RandomIt>
+    void build(std::size_t i, RandomIt first)
+    {
+        std::uninitialized_copy(
+            std::make_move_iterator(first + m_bounds[i]),
+            std::make_move_iterator(first + m_bounds[i + 1]),
+            m_data + m_bounds[i]);
+        m_built[i] = 1;
+    };
+
+    /**
+     * Destroy chunk i of the buffer if built.
+     */
+    void destroy(std::size_t i)
+    {
+        if (!m_built[i])
+            return;
+        for (T* p = m_data + m_bounds[i]; p != m_data + m_bounds[i + 1]; ++p)
+            p->~T();
+        m_built[i] = 0;
+    };
+
+    /**
+     * Return beginning of the buffer.
+     */
+    T* data() { return m_data; };
+
+private:
+
+    //Non copyable
+    SortBuffer(const SortBuffer&);
+    SortBuffer& operator=(const SortBuffer&);
+
+    std::allocator<T> m_alloc;
+    std::vector<std::size_t> m_bounds;
+    std::vector<char> m_built;
+    T* m_data;
+};
+
+} //end of namespace detail
+
+//=============================================================================
+// Implementation
+//=============================================================================
+
+template <typename RandomIt, typename Compare>
+void parallelSort(RandomIt first, RandomIt last, const Compare& comp,
+                  const Parallel& policy)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    std::size_t n = last - first;
+    unsigned threads = policy.concurrency(n);
+    if (threads <= 1)
+    {
+        std::sort(first, last, comp);
+        return;
+    }
+    ThreadPool& pool = ThreadPool::instance();
+    //sort one chunk per thread
+    std::vector<std::size_t> bounds;
+    for (unsigned i = 0; i <= threads; ++i)
+        bounds.push_back(n * i / threads);
+    //each thread moves its sorted chunk to the buffer
+    detail::SortBuffer<T> buffer(bounds);
+    pool.parallelFor(threads, [&](std::size_t i) {
+        std::sort(first + bounds[i], first + bounds[i + 1], comp);
+        buffer.build(i, first);
+    });
+    //merge runs pairwise, back and forth between range and buffer
+    T* scratch = buffer.data();
+    bool inBuffer = true;
+    std::vector<detail::MergePart> parts;
+    while (bounds.size() > 2)
+    {
+        std::size_t runs = bounds.size() - 1;
+        std::size_t pairs = runs / 2;
+        std::size_t split = std::max<std::size_t>(1, threads / pairs);
+        std::vector<std::size_t> merged;
+        parts.clear();
+        for (std::size_t r = 0; r + 1 < runs; r += 2)
+        {
+            std::size_t a = bounds[r], mid = bounds[r + 1], b = bounds[r + 2];
+            merged.push_back(a);
+            //split the first run evenly and find matching splits in the
+            //second one
+            std::size_t prevA = a, prevB = mid;
+            for (std::size_t j = 1; j <= split; ++j)
+            {
+                std::size_t nextA = a + (mid - a) * j / split;
+                std::size_t nextB = b;
+                if (j < split)
+                {
+                    if (inBuffer)
+                        nextB = std::lower_bound(scratch + mid, scratch + b,
+                                                 scratch[nextA], comp)
+                                - scratch;
+                    else
+                        nextB = std::lower_bound(first + mid, first + b,
+                                                 first[nextA], comp)
+                                - first;
+                }
+                detail::MergePart part = {prevA, nextA, prevB, nextB,
+                                          prevA + prevB - mid};
+                parts.push_back(part);
+                prevA = nextA;
+                prevB = nextB;
+            }
+        }
+        if (runs % 2 == 1)
+        {
+            //odd run left: only moved
+            detail::MergePart part = {bounds[runs - 1], bounds[runs], 0, 0,
+                                      bounds[runs - 1]};
+            parts.push_back(part);
+            merged.push_back(bounds[runs - 1]);
+        }
+        merged.push_back(n);
+        pool.parallelFor(parts.size(), [&](std::size_t i) {
+            const detail::MergePart& p = parts[i];
+            if (inBuffer)
+                std::merge(std::make_move_iterator(scratch + p.a),
+                           std::make_move_iterator(scratch + p.aEnd),
+                           std::make_move_iterator(scratch + p.b),
+                           std::make_move_iterator(scratch + p.bEnd),
+                           first + p.out, comp);
+            else
+                std::merge(std::make_move_iterator(first + p.a),
+                           std::make_move_iterator(first + p.aEnd),
+                           std::make_move_iterator(first + p.b),
+                           std::make_move_iterator(first + p.bEnd),
+                           scratch + p.out, comp);
+        });
+        bounds.swap(merged);
+        inBuffer = !inBuffer;
+    }
+    pool.parallelFor(threads, [&](std::size_t i) {
+        if (inBuffer)
+            std::move(scratch + n * i / threads, scratch + n * (i + 1) / threads,
+                      first + n * i / threads);
+        buffer.destroy(i);
+    });
+}
+
+template <typename RandomIt>
+void parallelSort(RandomIt first, RandomIt last, const Parallel& policy)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    parallelSort(first, last, std::less<T>(), policy);
+}
+
+} //end of namespace snowball
+
+#endif
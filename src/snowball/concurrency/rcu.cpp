@@ -0,0 +1,148 @@
+#include <thread>
+
+#include "rcu.h"
+
+#ifdef __linux__
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace snowball;
+
+//=============================================================================
+// Records of reader threads
+//=============================================================================
+
+namespace
+{
+
+/**
+ * Give record of a thread back when the thread ends.
+ */
+struct RecordReleaser
+{
+    ~RecordReleaser()
+    {
+        if (record)
+        {
+            record->epoch.store(0, std::memory_order_relaxed);
+            record->depth = 0;
+            record->used.store(false, std::memory_order_release);
+        }
+    }
+
+    RcuDomain::Record* record;
+};
+
+}
+
+//=============================================================================
+// RcuDomain class
+//=============================================================================
+
+/*
+ * Constructor
+ */
+
+RcuDomain::RcuDomain(): m_epoch(1), m_records(0), m_asymmetric(false)
+{
+#ifdef MEMBARRIER_CMD_PRIVATE_EXPEDITED
+    long commands = syscall(__NR_membarrier, MEMBARRIER_CMD_QUERY, 0);
+    if (commands > 0 && (commands & MEMBARRIER_CMD_PRIVATE_EXPEDITED))
+        m_asymmetric = syscall(__NR_membarrier,
+            MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0) == 0;
+#endif
+}
+
+/*
+ * Method instance
+ */
+
+RcuDomain& RcuDomain::instance()
+{
+    static RcuDomain domain;
+    return domain;
+}
+
+/*
+ * Method retire
+ */
+
+std::uint64_t RcuDomain::retire()
+{
+    return m_epoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+}
+
+/*
+ * Method minimumEpoch
+ */
+
+std::uint64_t RcuDomain::minimumEpoch() const
+{
+    //readers which store is not seen by the scan below load new versions
+    writerBarrier();
+    std::uint64_t minimum = m_epoch.load(std::memory_order_acquire);
+    for (Record* r = m_records.load(std::memory_order_acquire); r; r = r->next)
+    {
+        std::uint64_t epoch = r->epoch.load(std::memory_order_acquire);
+        if (epoch != 0 && epoch < minimum)
+            minimum = epoch;
+    }
+    return minimum;
+}
+
+/*
+ * Method waitFor
+ */
+
+void RcuDomain::waitFor(std::uint64_t epoch) const
+{
+    while (minimumEpoch() < epoch)
+        std::this_thread::yield();
+}
+
+/*
+ * Method acquireRecord
+ */
+
+RcuDomain::Record* RcuDomain::acquireRecord()
+{
+    Record* record = m_records.load(std::memory_order_acquire);
+    for (; record; record = record->next)
+    {
+        bool used = false;
+        if (!record->used.load(std::memory_order_relaxed) &&
+            record->used.compare_exchange_strong(used, true,
+                                                 std::memory_order_acquire))
+            break;
+    }
+    if (!record)
+    {
+        record = new Record();
+        record->used.store(true, std::memory_order_relaxed);
+        Record* head = m_records.load(std::memory_order_relaxed);
+        do
+            record->next = head;
+        while (!m_records.compare_exchange_weak(head, record,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed));
+    }
+    static thread_local RecordReleaser releaser;
+    releaser.record = record;
+    detail::RcuThread<Record>::record = record;
+    return record;
+}
+
+/*
+ * Method writerBarrier
+ */
+
+void RcuDomain::writerBarrier() const
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+#ifdef MEMBARRIER_CMD_PRIVATE_EXPEDITED
+    if (m_asymmetric)
+        syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0);
+#endif
+}
@@ -0,0 +1,231 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_RCU_H
+#define SNOWBALL_RCU_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace snowball
+{
+
+/**
+ * @brief Epochs of readers of read-copy-update structures.
+ *
+ * Readers of shared data enclose their accesses between enter and exit.
+ * Writers never modify data seen by readers: they publish a new version
+ * with an atomic store, then retire the old version, which may only be
+ * released once no reader may still use it.
+ *
+ * The domain keeps a global epoch, incremented by retire, and one record per
+ * reader thread holding the epoch seen when its reader entered (0 when out).
+ * A version retired at epoch e is released once every reader in is at epoch
+ * e or later: those readers entered after the new version was published.
+ *
+ * enter and exit only write to the record of the calling thread, with no
+ * atomic read-modify-write. On Linux, writers force a memory barrier on all
+ * running threads with the membarrier system call, so that readers need no
+ * barrier either. Elsewhere, enter issues a full memory fence.
+ *
+ * Reader sections may be nested. A single process-wide domain is returned
+ * by RcuDomain::instance.
+ */
+class RcuDomain
+{
+public:
+
+    /**
+     * Enter reader section of calling thread.
+     */
+    void enter();
+
+    /**
+     * Exit reader section of calling thread.
+     */
+    void exit();
+
+    /**
+     * Start a new epoch and return it. Versions unpublished before the call
+     * may be released once minimumEpoch returns this epoch or later.
+     */
+    std::uint64_t retire();
+
+    /**
+     * Return the smallest epoch of readers in, or the current epoch if no
+     * reader is in.
+     */
+    std::uint64_t minimumEpoch() const;
+
+    /**
+     * Wait until minimumEpoch returns given epoch or later.
+     *
+     * Must not be called from a reader section of the same domain.
+     */
+    void waitFor(std::uint64_t epoch) const;
+
+    /**
+     * Return the process-wide domain.
+     */
+    static RcuDomain& instance();
+
+    struct Record;
+
+private:
+
+    /**
+     * Constructor
+     */
+    RcuDomain();
+
+    //Non copyable
+    RcuDomain(const RcuDomain&);
+    RcuDomain& operator=(const RcuDomain&);
+
+    /**
+     * Return record of calling thread, taking a free one or allocating a new
+     * one on first call.
+     */
+    Record* record();
+
+    /**
+     * Take a record for calling thread.
+     */
+    Record* acquireRecord();
+
+    /**
+     * Order stores of readers before loads of the calling writer.
+     */
+    void writerBarrier() const;
+
+    /**
+     * Attributes
+     */
+    std::atomic<std::uint64_t> m_epoch;
+    std::atomic<Record*> m_records;
+    bool m_asymmetric;
+};
+
+/**
+ * @brief Hold a reader section of a RcuDomain during its lifetime.
+ */
+class RcuReadSection
+{
+public:
+
+    /**
+     * Constructor
+     *
+     * Enter reader section.
+     */
+    explicit RcuReadSection(RcuDomain& domain): m_domain(domain)
+    {
+        m_domain.enter();
+    };
+
+    /**
+     * Destructor
+     *
+     * Exit reader section.
+     */
+    ~RcuReadSection() { m_domain.exit(); };
+
+private:
+
+    //Non copyable
+    RcuReadSection(const RcuReadSection&);
+    RcuReadSection& operator=(const RcuReadSection&);
+
+    RcuDomain& m_domain;
+};
+
+/**
+ * @brief Record of a reader thread.
+ *
+ * Records are never released: a record left by a thread which ended is
+ * taken by the next new thread.
+ */
+struct RcuDomain::Record
+{
+    std::atomic<std::uint64_t> epoch;
+    unsigned depth;
+    std::atomic<bool> used;
+    Record* next;
+    char padding[64];
+};
+
+namespace detail
+{
+
+/**
+ * @brief Record of calling thread.
+ *
+ * A static member of a class template is defined in this header, so that
+ * the compiler sees it needs no dynamic initialization and reads it
+ * directly. A thread_local defined in rcu.cpp would be read through a call
+ * to its initialization wrapper.
+ */
+template <typename Record>
+struct RcuThread
+{
+    static thread_local Record* record;
+};
+
+template <typename Record>
+thread_local Record* RcuThread<Record>::record = 0;
+
+} //end of namespace detail
+
+//=============================================================================
+// RcuDomain inline methods
+//=============================================================================
+
+inline RcuDomain::Record* RcuDomain::record()
+{
+    Record* r = detail::RcuThread<Record>::record;
+    return r ? r : acquireRecord();
+}
+
+inline void RcuDomain::enter()
+{
+    Record* r = record();
+    if (r->depth++ == 0)
+    {
+        r->epoch.store(m_epoch.load(std::memory_order_acquire),
+                       std::memory_order_relaxed);
+        if (m_asymmetric)
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        else
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+inline void RcuDomain::exit()
+{
+    Record* r = detail::RcuThread<Record>::record;
+    if (--r->depth == 0)
+        r->epoch.store(0, std::memory_order_release);
+}
+
+} //end of namespace snowball
+
+#endif
@@ -0,0 +1,498 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_RCU_DICTIONARY_HPP
+#define SNOWBALL_RCU_DICTIONARY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "snowball/collections/flat_dictionary.hpp"
+#include "snowball/concurrency/rcu.h"
+
+#ifdef SNOWBALL_WITH_BOOST_HASH
+#include <boost/functional/hash.hpp>
+#endif
+
+namespace snowball
+{
+
+//==============================================================================
+// RCUDICTIONARY DECLARATION
+//==============================================================================
+
+/**
+ * @brief Read-mostly dictionary which readers never lock (read-copy-update).
+ *
+ * The dictionary is an immutable FlatDictionary, the current version.
+ * Readers load it with a single atomic load and look keys up as in any
+ * FlatDictionary: they never wait for writers nor for each other, and write
+ * nothing but the epoch of their own thread (see RcuDomain).
+ *
+ * Writers build a new version and publish it atomically, either as a whole
+ * or by applying a batch of edits to a copy of the current version:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * RcuDictionary<std::string, Route> routes;
+ * routes.update([&](RcuDictionary<std::string, Route>::version_type& v) {
+ *     for (const Change& change: changes)
+ *         v[change.prefix] = change.route;
+ * });
+ * Route route = routes.get(prefix, defaultRoute);
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Readers which already loaded the previous version keep using it: it is
+ * retired and released once they all left, which publish checks each time
+ * and synchronize waits for. Writers are serialized by a mutex and each
+ * edit copies the whole table: the dictionary suits tables which are read
+ * much more often than they are modified.
+ *
+ * get, contains and size each load the current version once. A Snapshot
+ * keeps a version for several lookups, which then all see the same
+ * version.
+ *
+ * @tparam Key type of keys
+ * @tparam Value type of values
+ * @tparam Hash hash function of keys
+ * @tparam Pred equality of keys
+ */
+template <typename Key,
+          typename Value,
+#ifdef SNOWBALL_WITH_BOOST_HASH
+          typename Hash=boost::hash<Key>,
+#else
+          typename Hash=std::hash<Key>,
+#endif
+          typename Pred=std::equal_to<Key> >
+class RcuDictionary
+{
+public:
+
+    /**
+     * @typedef size_type
+     * Type of dictionary size
+     */
+    typedef std::size_t size_type;
+
+    /**
+     * @typedef version_type
+     * Type of versions of the dictionary
+     */
+    typedef FlatDictionary<Key, Value, Hash, Pred> version_type;
+
+    /**
+     * @brief Version of a RcuDictionary kept alive for reading.
+     *
+     * The version is not released while the snapshot exists. A snapshot
+     * belongs to the thread which took it and should be short-lived, as it
+     * holds back the release of all retired versions.
+     */
+    class Snapshot
+    {
+    public:
+
+        /**
+         * Move constructor
+         */
+        Snapshot(Snapshot&& other) noexcept;
+
+        /**
+         * Destructor
+         *
+         * Exit reader section.
+         */
+        ~Snapshot();
+
+        /**
+         * Return version.
+         */
+        const version_type& operator*() const;
+
+        /**
+         * Return pointer to version.
+         */
+        const version_type* operator->() const;
+
+    private:
+
+        friend class RcuDictionary;
+
+        /**
+         * Constructor
+         *
+         * Enter reader section and load current version.
+         */
+        Snapshot(RcuDomain& domain,
+                 const std::atomic<const version_type*>& current);
+
+        //Non copyable
+        Snapshot(const Snapshot&);
+        Snapshot& operator=(const Snapshot&);
+
+        RcuDomain* m_domain;
+        const version_type* m_version;
+    };
+
+    /**
+     * Constructor
+     *
+     * Build an empty dictionary.
+     */
+    RcuDictionary();
+
+    /**
+     * Constructor
+     *
+     * Build a dictionary which first version is given.
+     *
+     * @param version first version
+     */
+    explicit RcuDictionary(version_type version);
+
+    /**
+     * Destructor
+     *
+     * Release all versions: no reader may be left.
+     */
+    virtual ~RcuDictionary();
+
+    /**
+     * Return a snapshot of the current version.
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * Return number of pairs of the current version.
+     */
+    size_type size() const;
+
+    /**
+     * Return true if current version contains key.
+     *
+     * @param key key to look for
+     */
+    template <typename K = Key>
+    bool contains(const K& key) const;
+
+    /**
+     * Return a copy of value of key in current version, or default value if
+     * key does not exist.
+     *
+     * @param key key to look for
+     * @param defaultValue value returned if key does not exist
+     */
+    template <typename K = Key>
+    Value get(const K& key, const Value& defaultValue) const;
+
+    /**
+     * Replace current version.
+     *
+     * @param version new version
+     */
+    void publish(version_type version);
+
+    /**
+     * Call function with a copy of current version and publish it. If
+     * function throws, nothing is published.
+     *
+     * @param function function called with version_type&
+     */
+    template <typename Function>
+    void update(Function function);
+
+    /**
+     * Publish a version where key has given value.
+     *
+     * @param key key to set
+     * @param value new value of key
+     */
+    template <typename K = Key>
+    void set(const K& key, const Value& value);
+
+    /**
+     * Publish a version without key and return true if key existed.
+     *
+     * @param key key to erase
+     */
+    template <typename K = Key>
+    bool erase(const K& key);
+
+    /**
+     * Wait for readers of previous versions to leave and release them.
+     *
+     * Must not be called while the calling thread holds a snapshot.
+     */
+    void synchronize();
+
+private:
+
+    //Non copyable
+    RcuDictionary(const RcuDictionary&);
+    RcuDictionary& operator=(const RcuDictionary&);
+
+    /**
+     * @brief Previous version waiting for its readers to leave.
+     */
+    struct Retired
+    {
+        const version_type* version;
+        std::uint64_t epoch;
+    };
+
+    /**
+     * Publish version and retire current one, taking ownership of version.
+     * Writer mutex must be held.
+     */
+    void replace(const version_type* version);
+
+    /**
+     * Release retired versions older than given epoch. Writer mutex must be
+     * held.
+     */
+    void reclaim(std::uint64_t epoch);
+
+    /**
+     * Attributes
+     */
+    RcuDomain& m_domain;
+    std::atomic<const version_type*> m_current;
+    std::mutex m_writer;
+    std::vector<Retired> m_retired;
+};
+
+//==============================================================================
+// SNAPSHOT DEFINITION
+//==============================================================================
+
+template <typename K, typename V, typename H, typename P>
+RcuDictionary<K, V, H, P>::Snapshot::Snapshot(RcuDomain& domain,
+    const std::atomic<const version_type*>& current): m_domain(&domain)
+{
+    m_domain->enter();
+    m_version = current.load(std::memory_order_acquire);
+}
+
+template <typename K, typename V, typename H, typename P>
+RcuDictionary<K, V, H, P>::Snapshot::Snapshot(Snapshot&& other) noexcept:
+    m_domain(other.m_domain), m_version(other.m_version)
+{
+    other.m_version = 0;
+}
+
+template <typename K, typename V, typename H, typename P>
+RcuDictionary<K, V, H, P>::Snapshot::~Snapshot()
+{
+    if (m_version)
+        m_domain->exit();
+}
+
+template <typename K, typename V, typename H, typename P>
+const typename RcuDictionary<K, V, H, P>::version_type&
+RcuDictionary<K, V, H, P>::Snapshot::operator*() const
+{
+    return *m_version;
+}
+
+template <typename K, typename V, typename H, typename P>
+const typename RcuDictionary<K, V, H, P>::version_type*
+RcuDictionary<K, V, H, P>::Snapshot::operator->() const
+{
+    return m_version;
+}
+
+//==============================================================================
+// RCUDICTIONARY DEFINITION
+//==============================================================================
+
+/*
+ * Constructors and destructor
+ */
+
+template <typename K, typename V, typename H, typename P>
+RcuDictionary<K, V, H, P>::RcuDictionary():
+    m_domain(RcuDomain::instance()), m_current(new version_type()) { };
+
+template <typename K, typename V, typename H, typename P>
+RcuDictionary<K, V, H, P>::RcuDictionary(version_type version):
+    m_domain(RcuDomain::instance()),
+    m_current(new version_type(std::move(version))) { };
+
+template <typename K, typename V, typename H, typename P>
+RcuDictionary<K, V, H, P>::~RcuDictionary()
+{
+    for (std::size_t i = 0; i < m_retired.size(); ++i)
+        delete m_retired[i].version;
+    delete m_current.load(std::memory_order_relaxed);
+}
+
+/*
+ * Readers
+ */
+
+template <typename K, typename V, typename H, typename P>
+typename RcuDictionary<K, V, H, P>::Snapshot
+RcuDictionary<K, V, H, P>::snapshot() const
+{
+    return Snapshot(m_domain, m_current);
+}
+
+template <typename K, typename V, typename H, typename P>
+typename RcuDictionary<K, V, H, P>::size_type
+RcuDictionary<K, V, H, P>::size() const
+{
+    RcuReadSection section(m_domain);
+    return m_current.load(std::memory_order_acquire)->size();
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+bool RcuDictionary<K, V, H, P>::contains(const K2& key) const
+{
+    RcuReadSection section(m_domain);
+    const version_type* version = m_current.load(std::memory_order_acquire);
+    return version->lookup(key) != version_type::npos;
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+V RcuDictionary<K, V, H, P>::get(const K2& key, const V& defaultValue) const
+{
+    RcuReadSection section(m_domain);
+    const version_type* version = m_current.load(std::memory_order_acquire);
+    typename version_type::size_type slot = version->lookup(key);
+    if (slot == version_type::npos)
+        return defaultValue;
+    return version->m_slots[slot].second;
+}
+
+/*
+ * Writers
+ */
+
+template <typename K, typename V, typename H, typename P>
+void RcuDictionary<K, V, H, P>::publish(version_type version)
+{
+    const version_type* next = new version_type(std::move(version));
+    std::lock_guard<std::mutex> lock(m_writer);
+    replace(next);
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename Function>
+void RcuDictionary<K, V, H, P>::update(Function function)
+{
+    std::lock_guard<std::mutex> lock(m_writer);
+    //only writers replace the current version: no reader section needed
+    version_type* next = new version_type(
+        *m_current.load(std::memory_order_relaxed));
+    try
+    {
+        function(*next);
+    }
+    catch (...)
+    {
+        delete next;
+        throw;
+    }
+    replace(next);
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+void RcuDictionary<K, V, H, P>::set(const K2& key, const V& value)
+{
+    update([&key, &value](version_type& version) { version[key] = value; });
+}
+
+template <typename K, typename V, typename H, typename P>
+template <typename K2>
+bool RcuDictionary<K, V, H, P>::erase(const K2& key)
+{
+    {
+        RcuReadSection section(m_domain);
+        if (m_current.load(std::memory_order_acquire)->lookup(key) ==
+            version_type::npos)
+            return false;
+    }
+    bool erased = false;
+    update([&key, &erased](version_type& version) {
+        erased = version.erase(key);
+    });
+    return erased;
+}
+
+template <typename K, typename V, typename H, typename P>
+void RcuDictionary<K, V, H, P>::synchronize()
+{
+    std::lock_guard<std::mutex> lock(m_writer);
+    if (m_retired.empty())
+        return;
+    m_domain.waitFor(m_retired.back().epoch);
+    reclaim(m_retired.back().epoch);
+}
+
+/*
+ * private helpers
+ */
+
+template <typename K, typename V, typename H, typename P>
+void RcuDictionary<K, V, H, P>::replace(const version_type* version)
+{
+    //reserve first so that push_back cannot throw once published
+    try
+    {
+        m_retired.reserve(m_retired.size() + 1);
+    }
+    catch (...)
+    {
+        delete version;
+        throw;
+    }
+    const version_type* previous = m_current.exchange(version,
+        std::memory_order_acq_rel);
+    Retired retired = {previous, m_domain.retire()};
+    m_retired.push_back(retired);
+    reclaim(m_domain.minimumEpoch());
+}
+
+template <typename K, typename V, typename H, typename P>
+void RcuDictionary<K, V, H, P>::reclaim(std::uint64_t epoch)
+{
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < m_retired.size(); ++i)
+    {
+        if (m_retired[i].epoch <= epoch)
+            delete m_retired[i].version;
+        else
+            m_retired[kept++] = m_retired[i];
+    }
+    m_retired.resize(kept);
+}
+
+} //end of namespace snowball
+
+#endif
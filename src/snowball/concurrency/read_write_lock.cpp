@@ -0,0 +1,80 @@
+#include <thread>
+
+#include "read_write_lock.h"
+
+using namespace snowball;
+
+//=============================================================================
+// Waiting
+//=============================================================================
+
+namespace
+{
+
+/**
+ * Wait a little before testing the lock again: spin first, then give the
+ * processor away so that the owner may run if it was preempted.
+ */
+void relax(unsigned& spins)
+{
+    if (++spins < 64)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+    else
+        std::this_thread::yield();
+}
+
+}
+
+//=============================================================================
+// ReadWriteLock class
+//=============================================================================
+
+/*
+ * Method lock
+ */
+
+void ReadWriteLock::lock()
+{
+    unsigned spins = 0;
+    std::uint32_t state = m_state.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        if ((state & ~pending) == 0)
+        {
+            //taking the lock clears pending: other waiting writers set it
+            //again on their next attempt
+            if (m_state.compare_exchange_weak(state, writer,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed))
+                return;
+            continue;
+        }
+        if (!(state & pending))
+            m_state.fetch_or(pending, std::memory_order_relaxed);
+        relax(spins);
+        state = m_state.load(std::memory_order_relaxed);
+    }
+}
+
+/*
+ * Method waitShared
+ */
+
+void ReadWriteLock::waitShared()
+{
+    unsigned spins = 0;
+    for (;;)
+    {
+        //give back the increment of lockShared, which a writer waits for
+        m_state.fetch_sub(1, std::memory_order_relaxed);
+        while (m_state.load(std::memory_order_relaxed) & (writer | pending))
+            relax(spins);
+        std::uint32_t state = m_state.fetch_add(1, std::memory_order_acquire);
+        if (!(state & (writer | pending)))
+            return;
+    }
+}
@@ -0,0 +1,176 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_READ_WRITE_LOCK_H
+#define SNOWBALL_READ_WRITE_LOCK_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace snowball
+{
+
+/**
+ * @brief Lock shared by readers or owned by a single writer.
+ *
+ * The lock is a single 32 bits word: a shared lock or unlock is one atomic
+ * increment or decrement when no writer is around, against a kernel call
+ * for contended std::mutex. Waiting threads spin a little then yield, so
+ * that critical sections are expected to be short.
+ *
+ * A waiting writer stops new readers from entering, so that writers are not
+ * starved by a steady flow of readers.
+ *
+ * lock and unlock meet the requirements of std::lock_guard; ReadGuard is the
+ * matching guard of shared locks:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * {
+ *     ReadGuard guard(lock);
+ *     read(table);
+ * }
+ * {
+ *     std::lock_guard<ReadWriteLock> guard(lock);
+ *     write(table);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The lock is not recursive.
+ */
+class ReadWriteLock
+{
+public:
+
+    /**
+     * Constructor
+     */
+    ReadWriteLock();
+
+    /**
+     * Take lock for writing.
+     */
+    void lock();
+
+    /**
+     * Release lock taken for writing.
+     */
+    void unlock();
+
+    /**
+     * Take lock for reading.
+     */
+    void lockShared();
+
+    /**
+     * Release lock taken for reading.
+     */
+    void unlockShared();
+
+private:
+
+    //Non copyable
+    ReadWriteLock(const ReadWriteLock&);
+    ReadWriteLock& operator=(const ReadWriteLock&);
+
+    /**
+     * Wait for lockShared when a writer is around.
+     */
+    void waitShared();
+
+    /**
+     * Bit set while a writer owns the lock.
+     */
+    static const std::uint32_t writer = 1u << 31;
+
+    /**
+     * Bit set while a writer waits for the lock.
+     */
+    static const std::uint32_t pending = 1u << 30;
+
+    /**
+     * Attributes
+     *
+     * m_state holds writer bits and the number of readers in lower bits.
+     */
+    std::atomic<std::uint32_t> m_state;
+};
+
+/**
+ * @brief Hold a ReadWriteLock for reading during its lifetime.
+ */
+class ReadGuard
+{
+public:
+
+    /**
+     * Constructor
+     *
+     * Take lock for reading.
+     */
+    explicit ReadGuard(ReadWriteLock& lock): m_lock(lock)
+    {
+        m_lock.lockShared();
+    };
+
+    /**
+     * Destructor
+     *
+     * Release lock.
+     */
+    ~ReadGuard() { m_lock.unlockShared(); };
+
+private:
+
+    //Non copyable
+    ReadGuard(const ReadGuard&);
+    ReadGuard& operator=(const ReadGuard&);
+
+    ReadWriteLock& m_lock;
+};
+
+//=============================================================================
+// ReadWriteLock inline methods
+//=============================================================================
+
+inline ReadWriteLock::ReadWriteLock(): m_state(0) { }
+
+inline void ReadWriteLock::unlock()
+{
+    //readers backing off and other writers may have touched lower bits
+    m_state.fetch_sub(writer, std::memory_order_release);
+}
+
+inline void ReadWriteLock::lockShared()
+{
+    std::uint32_t state = m_state.fetch_add(1, std::memory_order_acquire);
+    if (state & (writer | pending))
+        waitShared();
+}
+
+inline void ReadWriteLock::unlockShared()
+{
+    m_state.fetch_sub(1, std::memory_order_release);
+}
+
+} //end of namespace snowball
+
+#endif
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+#include "thread_pool.h"
+
+using namespace snowball;
+
+//=============================================================================
+// Loop shared between calling thread and workers
+//=============================================================================
+
+struct ThreadPool::Loop
+{
+    Loop(std::size_t n, const std::function<void(std::size_t)>& func)
+        : func(func), n(n), next(0), done(0) { }
+
+    const std::function<void(std::size_t)>& func;
+    std::size_t n;
+    std::atomic<std::size_t> next;
+    std::atomic<std::size_t> done;
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+};
+
+//=============================================================================
+// ThreadPool class
+//=============================================================================
+
+/*
+ * Constructor
+ */
+
+ThreadPool::ThreadPool(unsigned threads): m_stop(false)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 1; i < threads; ++i)
+        m_workers.push_back(std::thread(&ThreadPool::workerMain, this));
+}
+
+/*
+ * Destructor
+ */
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_all();
+    for (std::size_t i = 0; i < m_workers.size(); ++i)
+        m_workers[i].join();
+}
+
+/*
+ * Method size
+ */
+
+unsigned ThreadPool::size() const
+{
+    return unsigned(m_workers.size()) + 1;
+}
+
+/*
+ * Method instance
+ */
+
+ThreadPool& ThreadPool::instance()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+/*
+ * Method work
+ */
+
+void ThreadPool::work(Loop& loop)
+{
+    std::size_t i;
+    while ((i = loop.next.fetch_add(1)) < loop.n)
+    {
+        try
+        {
+            loop.func(i);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(loop.mutex);
+            if (!loop.error)
+                loop.error = std::current_exception();
+        }
+        if (loop.done.fetch_add(1) + 1 == loop.n)
+        {
+            std::lock_guard<std::mutex> lock(loop.mutex);
+            loop.finished.notify_all();
+        }
+    }
+}
+
+/*
+ * Method parallelFor
+ */
+
+void ThreadPool::parallelFor(std::size_t n,
+                             const std::function<void(std::size_t)>& func)
+{
+    if (n == 0)
+        return;
+    std::shared_ptr<Loop> loop = std::make_shared<Loop>(n, func);
+    if (n > 1 && !m_workers.empty())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_loops.push_back(loop);
+        }
+        m_wakeup.notify_all();
+    }
+    work(*loop);
+    {
+        std::unique_lock<std::mutex> lock(loop->mutex);
+        while (loop->done.load() < n)
+            loop->finished.wait(lock);
+    }
+    if (loop->error)
+        std::rethrow_exception(loop->error);
+}
+
+/*
+ * Method workerMain
+ */
+
+void ThreadPool::workerMain()
+{
+    while (true)
+    {
+        std::shared_ptr<Loop> loop;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_stop && m_loops.empty())
+                m_wakeup.wait(lock);
+            if (m_loops.empty())
+                return;
+            loop = m_loops.front();
+            //every iteration is taken: no need to keep the loop around
+            if (loop->next.load() >= loop->n)
+            {
+                m_loops.pop_front();
+                continue;
+            }
+        }
+        work(*loop);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_loops.empty() && m_loops.front() == loop)
+                m_loops.pop_front();
+        }
+    }
+}
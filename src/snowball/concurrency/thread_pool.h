@@ -0,0 +1,130 @@
+/*
+Snowball library
+Copyright (C) 2016 Cédric Campguilhem
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file
+ */
+
+#ifndef SNOWBALL_THREAD_POOL_H
+#define SNOWBALL_THREAD_POOL_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+
+namespace snowball
+{
+
+/**
+ * @brief Pool of worker threads running data-parallel loops.
+ *
+ * The pool runs loops which iterations are independent tasks:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * ThreadPool::instance().parallelFor(chunks, [&](std::size_t i) {
+ *     process(chunk[i]);
+ * });
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The calling thread takes part in the loop and parallelFor returns once all
+ * iterations are done. A loop may therefore be run from within another loop
+ * without deadlock. If an iteration throws, the first exception is rethrown
+ * by parallelFor in the calling thread.
+ *
+ * Worker threads are created once by the constructor and wait for loops to
+ * run. A process-wide pool is returned by ThreadPool::instance.
+ */
+class ThreadPool
+{
+public:
+
+    /**
+     * Constructor
+     *
+     * Start worker threads. As the calling thread of parallelFor also runs
+     * iterations, a pool of n threads starts n - 1 workers.
+     *
+     * @param threads number of threads, 0 stands for the number of hardware
+     * threads
+     */
+    explicit ThreadPool(unsigned threads = 0);
+
+    /**
+     * Destructor
+     *
+     * Wait for pending loops and join worker threads.
+     */
+    virtual ~ThreadPool();
+
+    /**
+     * Return the number of threads of the pool (including calling thread).
+     */
+    unsigned size() const;
+
+    /**
+     * Run func(0), func(1)... func(n - 1) in parallel and wait for all of
+     * them.
+     *
+     * @param n number of iterations
+     * @param func function called with iteration index
+     */
+    void parallelFor(std::size_t n, const std::function<void(std::size_t)>& func);
+
+    /**
+     * Return the process-wide pool.
+     *
+     * It has as many threads as hardware threads.
+     */
+    static ThreadPool& instance();
+
+private:
+
+    //Non copyable
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+    struct Loop;
+
+    /**
+     * Run iterations of given loop until none is left.
+     */
+    static void work(Loop& loop);
+
+    /**
+     * Body of worker threads.
+     */
+    void workerMain();
+
+    /**
+     * Attributes
+     */
+    std::vector<std::thread> m_workers;
+    std::deque< std::shared_ptr<Loop> > m_loops;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    bool m_stop;
+};
+
+} //end of namespace snowball
+
+#endif
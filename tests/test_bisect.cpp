@@ -0,0 +1,74 @@
+#include "catch.hpp"
+
+#include <functional>
+
+#include "snowball/collections/bisect.hpp"
+#include "snowball/collections/list.hpp"
+#include "snowball/exceptions/exceptions.h"
+
+using namespace snowball;
+
+TEST_CASE("bisect", "[collections]")
+{
+    List<int> list = {1, 3, 3, 3, 7, 9};
+
+    SECTION("bisect left")
+    {
+        REQUIRE(bisectLeft(list, 0) == 0);
+        REQUIRE(bisectLeft(list, 3) == 1);
+        REQUIRE(bisectLeft(list, 4) == 4);
+        REQUIRE(bisectLeft(list, 10) == 6);
+    }
+    SECTION("bisect right")
+    {
+        REQUIRE(bisectRight(list, 0) == 0);
+        REQUIRE(bisectRight(list, 3) == 4);
+        REQUIRE(bisectRight(list, 9) == 6);
+    }
+    SECTION("bisect with bounds")
+    {
+        REQUIRE(bisectLeft(list, 3, 2) == 2);
+        REQUIRE(bisectRight(list, 3, 0, 3) == 3);
+        REQUIRE(bisectRight(list, 9, 0, 100) == 6);
+        REQUIRE(bisectLeft(list, 9, 5, 2) == 5);
+        REQUIRE(bisectLeft(list, 9, 0, -1) == 0);
+        REQUIRE(bisectRight(list, 0, 3, -5) == 3);
+        REQUIRE(bisectLeft(list, 0, 100) == 6);
+        REQUIRE_THROWS_AS(bisectLeft(list, 3, -1), ValueError);
+    }
+    SECTION("bisect with comparator")
+    {
+        List<int> reversed = {9, 7, 3, 3, 1};
+        REQUIRE(bisectLeft(reversed, 3, std::greater<int>()) == 2);
+        REQUIRE(bisectRight(reversed, 3, std::greater<int>()) == 4);
+        REQUIRE(bisectRight(reversed, 3, std::greater<int>(), 0, 3) == 3);
+    }
+    SECTION("insort")
+    {
+        insort(list, 5);
+        insort(list, 0);
+        insort(list, 10);
+        REQUIRE(list == List<int>({0, 1, 3, 3, 3, 5, 7, 9, 10}));
+        insortLeft(list, 4);
+        REQUIRE(list == List<int>({0, 1, 3, 3, 3, 4, 5, 7, 9, 10}));
+        List<int> empty;
+        insort(empty, 1);
+        REQUIRE(empty == List<int>({1}));
+    }
+    SECTION("insort is stable")
+    {
+        typedef std::pair<int, int> Pair;
+        List<Pair> pairs;
+        auto byFirst = [](const Pair& a, const Pair& b)
+        {
+            return a.first < b.first;
+        };
+        insort(pairs, Pair(1, 0), byFirst);
+        insort(pairs, Pair(0, 1), byFirst);
+        insort(pairs, Pair(1, 2), byFirst);
+        insort(pairs, Pair(1, 3), byFirst);
+        REQUIRE(pairs[1].second == 0);
+        REQUIRE(pairs[2].second == 2);
+        REQUIRE(pairs[3].second == 3);
+    }
+}
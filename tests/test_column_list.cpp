@@ -0,0 +1,129 @@
+#include "catch.hpp"
+
+#include <string>
+#include <tuple>
+
+#include "snowball/collections/column_list.hpp"
+#include "snowball/collections/algorithms.hpp"
+#include "snowball/collections/list.hpp"
+#include "snowball/exceptions/exceptions.h"
+
+using namespace snowball;
+
+typedef ColumnList<int, double, std::string> Table;
+typedef std::tuple<int, double, std::string> Record;
+
+template <typename T>
+const T& asConst(const T& object)
+{
+    return object;
+}
+
+TEST_CASE("column list", "[collections]")
+{
+    SECTION("constructors")
+    {
+        Table table1;
+        REQUIRE (table1.size() == 0);
+        Table table2 = {Record(1, 0.5, "a"), Record(2, 1.5, "b")};
+        REQUIRE (table2.size() == 2);
+        REQUIRE (asConst(table2).column<0>() == List<int>({1, 2}));
+        REQUIRE (asConst(table2).column<1>() == List<double>({0.5, 1.5}));
+        REQUIRE (asConst(table2).column<2>() == List<std::string>({"a", "b"}));
+    }
+
+    SECTION("append and row access")
+    {
+        Table table;
+        table.reserve(4);
+        table.append(3, 0.25, "c");
+        table.append(Record(1, 0.75, "a"));
+        REQUIRE (table.size() == 2);
+        REQUIRE (table[0].get<0>() == 3);
+        REQUIRE (table[-1].get<2>() == "a");
+        Record record = table[1];
+        REQUIRE (record == Record(1, 0.75, "a"));
+        table[0].get<1>() = 2.5;
+        REQUIRE (asConst(table).column<1>() == List<double>({2.5, 0.75}));
+        table[1] = Record(7, 7.5, "g");
+        REQUIRE (table[1].get<0>() == 7);
+        REQUIRE (table[1].get<2>() == "g");
+        const Table& ref = table;
+        REQUIRE (ref[0].get<2>() == "c");
+        REQUIRE_THROWS_AS (table[2], IndexError);
+        REQUIRE_THROWS_AS (ref[-3], IndexError);
+    }
+
+    SECTION("pop")
+    {
+        Table table = {Record(1, 0.5, "a"), Record(2, 1.5, "b"),
+                       Record(3, 2.5, "c")};
+        REQUIRE (table.pop() == Record(3, 2.5, "c"));
+        REQUIRE (table.pop(0) == Record(1, 0.5, "a"));
+        REQUIRE (table.size() == 1);
+        REQUIRE_THROWS_AS (table.pop(5), IndexError);
+        REQUIRE (table.size() == 1);
+        REQUIRE (asConst(table).column<2>() == List<std::string>({"b"}));
+        table.pop();
+        REQUIRE_THROWS_AS (table.pop(), IndexError);
+    }
+
+    SECTION("sort")
+    {
+        Table table = {Record(2, 0.5, "b"), Record(1, 1.5, "z"),
+                       Record(2, 0.5, "a"), Record(1, 0.5, "y")};
+        Table expected = {Record(1, 0.5, "y"), Record(1, 1.5, "z"),
+                          Record(2, 0.5, "a"), Record(2, 0.5, "b")};
+        table.sort();
+        REQUIRE (table == expected);
+    }
+
+    SECTION("sortBy")
+    {
+        Table table = {Record(2, 0.5, "b"), Record(1, 1.5, "z"),
+                       Record(2, 0.5, "a"), Record(1, 0.5, "y")};
+        table.sortBy<0>();
+        REQUIRE (asConst(table).column<2>() == List<std::string>({"z", "y", "b", "a"}));
+        table.sortBy<1>(true);
+        REQUIRE (asConst(table).column<2>() == List<std::string>({"z", "y", "b", "a"}));
+        table.sortBy<2>(true);
+        REQUIRE (asConst(table).column<0>() == List<int>({1, 1, 2, 2}));
+        REQUIRE (asConst(table).column<2>() == List<std::string>({"z", "y", "b", "a"}));
+        table.sortBy<2>();
+        REQUIRE (asConst(table).column<2>() == List<std::string>({"a", "b", "y", "z"}));
+    }
+
+    SECTION("algorithms on columns")
+    {
+        Table table = {Record(4, 0.5, "d"), Record(9, -1.5, "i"),
+                       Record(1, 2.5, "a"), Record(6, 0.0, "f")};
+        const Table& ref = table;
+        REQUIRE (max(ref.column<0>()) == 9);
+        REQUIRE (argmin(ref.column<1>()) == 1);
+        REQUIRE (argmax(table.column<1>()) == 2);
+        List<int> even;
+        filter([](const int& item) { return item % 2 == 0; },
+               ref.column<0>(), even);
+        REQUIRE (even == List<int>({4, 6}));
+        List<double> twice;
+        map([](const double& item) { return 2. * item; },
+            table.column<1>(), twice);
+        REQUIRE (twice == List<double>({1.0, -3.0, 5.0, 0.0}));
+        ListView<double> prices = table.column<1>();
+        prices[-1] = 3.5;
+        max(prices) = 10.;
+        REQUIRE (ref.column<1>() == List<double>({0.5, -1.5, 2.5, 10.}));
+    }
+
+    SECTION("repeated field types")
+    {
+        ColumnList<double, double> points;
+        points.append(1., 2.);
+        points.append(0., 3.);
+        points.sort();
+        REQUIRE (points[0].get<1>() == 3.);
+        points.clear();
+        REQUIRE (points.size() == 0);
+        REQUIRE (asConst(points).column<1>().size() == 0);
+    }
+}
@@ -0,0 +1,204 @@
+#include "catch.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <string>
+
+#include "snowball/collections/compressed_list.hpp"
+#include "snowball/collections/bit_packing.h"
+#include "snowball/collections/list.hpp"
+#include "snowball/exceptions/exceptions.h"
+
+using namespace snowball;
+
+/*
+ * Pack 128 random offsets of given bits from base, then check both block and
+ * single item unpacking.
+ */
+bool roundTrip(unsigned bits, std::uint64_t base)
+{
+    const std::size_t n = detail::packedBlockSize;
+    std::uint64_t values[n];
+    std::uint64_t mask = bits == 64 ? ~std::uint64_t(0)
+                                    : (std::uint64_t(1) << bits) - 1;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        std::uint64_t random = (std::uint64_t(rand()) << 42) ^
+                               (std::uint64_t(rand()) << 21) ^ rand();
+        values[i] = base + (random & mask);
+    }
+    //largest offset on exactly bits
+    if (bits != 0)
+        values[n / 2] = base + mask;
+    if (detail::packedBits(values[n / 2] - base) != bits)
+        return false;
+    std::vector<std::uint64_t> words(detail::packedWords(bits) + 1, 0xdead);
+    detail::packBlock(values, base, bits, words.data());
+    if (words.back() != 0xdead)
+        return false;
+    std::uint64_t output[n];
+    detail::unpackBlock(words.data(), bits, base, output);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (output[i] != values[i])
+            return false;
+        if (detail::unpackItem(words.data(), bits, base, i) != values[i])
+            return false;
+    }
+    return true;
+}
+
+TEST_CASE("compressed list", "[collections]")
+{
+    SECTION("bit packing")
+    {
+        std::string isa = detail::bitPackingInstructionSet();
+        REQUIRE ((isa == "avx2" || isa == "scalar"));
+        srand(0);
+        for (unsigned bits = 0; bits <= 64; ++bits)
+        {
+            INFO("bits: " << bits);
+            REQUIRE (roundTrip(bits, 0));
+            REQUIRE (roundTrip(bits, 123456789));
+        }
+    }
+
+    SECTION("append and index")
+    {
+        CompressedList<long> list;
+        REQUIRE (list.size() == 0);
+        REQUIRE_THROWS_AS (list[0], IndexError);
+        for (long i = 0; i < 1000; ++i)
+            list.append(1000000 + 7 * i);
+        REQUIRE (list.size() == 1000);
+        REQUIRE (list[0] == 1000000);
+        REQUIRE (list[127] == 1000000 + 7 * 127);
+        REQUIRE (list[128] == 1000000 + 7 * 128);
+        REQUIRE (list[999] == 1000000 + 7 * 999);
+        REQUIRE (list[-1] == 1000000 + 7 * 999);
+        REQUIRE (list[-1000] == 1000000);
+        REQUIRE_THROWS_AS (list[1000], IndexError);
+        REQUIRE_THROWS_AS (list[-1001], IndexError);
+        REQUIRE (list.sorted());
+        CompressedList<int> small = {3, -2, 1};
+        REQUIRE (small.size() == 3);
+        REQUIRE (small[1] == -2);
+        REQUIRE_FALSE (small.sorted());
+    }
+
+    SECTION("extreme values")
+    {
+        List<long> items;
+        for (long i = 0; i < 300; ++i)
+            items.append(i % 2 ? std::numeric_limits<long>::max() - i
+                               : std::numeric_limits<long>::min() + i);
+        CompressedList<long> list;
+        list.extend(items);
+        REQUIRE (list.toList() == items);
+        REQUIRE (list[130] == std::numeric_limits<long>::min() + 130);
+        REQUIRE (list[131] == std::numeric_limits<long>::max() - 131);
+        List<unsigned int> unsignedItems;
+        for (unsigned int i = 0; i < 300; ++i)
+            unsignedItems.append(i % 3 ? 4000000000u + i : i);
+        CompressedList<unsigned int> unsignedList;
+        unsignedList.extend(unsignedItems);
+        REQUIRE (unsignedList.toList() == unsignedItems);
+        REQUIRE (unsignedList.contains(4000000001u));
+        REQUIRE_FALSE (unsignedList.contains(4000000000u));
+        List<short> shortItems;
+        for (short i = -200; i < 200; ++i)
+            shortItems.append(i);
+        CompressedList<short> shortList;
+        shortList.extend(shortItems);
+        REQUIRE (shortList.toList() == shortItems);
+    }
+
+    SECTION("iteration")
+    {
+        CompressedList<long> list;
+        List<long> items;
+        for (long i = 0; i < 1000; ++i)
+        {
+            long item = (i * 7919) % 1013 - 500;
+            list.append(item);
+            items.append(item);
+        }
+        REQUIRE (list.toList() == items);
+        long sum = 0;
+        for (long item: list)
+            sum += item;
+        REQUIRE (sum == std::accumulate(items.begin(), items.end(), 0L));
+        CompressedList<long>::const_iterator it = list.begin();
+        std::advance(it, 200);
+        REQUIRE (*it == items[200]);
+        REQUIRE (*it++ == items[200]);
+        REQUIRE (*it == items[201]);
+        REQUIRE (std::distance(list.begin(), list.end()) == 1000);
+        CompressedList<long> empty;
+        REQUIRE (empty.begin() == empty.end());
+    }
+
+    SECTION("contains")
+    {
+        CompressedList<long> sorted;
+        CompressedList<long> unsorted;
+        for (long i = 0; i < 1000; ++i)
+        {
+            sorted.append(3 * i);
+            unsorted.append(3 * ((i * 7919) % 1000));
+        }
+        REQUIRE (sorted.sorted());
+        REQUIRE_FALSE (unsorted.sorted());
+        for (long item = -3; item < 3003; ++item)
+        {
+            bool expected = item >= 0 && item < 3000 && item % 3 == 0;
+            if (sorted.contains(item) != expected ||
+                unsorted.contains(item) != expected)
+                FAIL("wrong contains for " << item);
+        }
+    }
+
+    SECTION("bisect")
+    {
+        CompressedList<int> list;
+        List<int> items;
+        for (int i = 0; i < 1000; ++i)
+        {
+            list.append(i / 3 - 100);
+            items.append(i / 3 - 100);
+        }
+        for (int item = -102; item < 240; ++item)
+        {
+            std::size_t left = std::lower_bound(items.begin(), items.end(),
+                                                item) - items.begin();
+            std::size_t right = std::upper_bound(items.begin(), items.end(),
+                                                 item) - items.begin();
+            if (list.bisectLeft(item) != left ||
+                list.bisectRight(item) != right)
+                FAIL("wrong bisection for " << item);
+        }
+        list.append(0);
+        REQUIRE_THROWS_AS (list.bisectLeft(0), ValueError);
+        REQUIRE (list.contains(-100));
+    }
+
+    SECTION("memory and clear")
+    {
+        CompressedList<long> list;
+        for (long i = 0; i < 100000; ++i)
+            list.append(1500000000000L + 10 * i);
+        list.shrinkToFit();
+        //offsets of 128 consecutive items fit on 11 bits
+        REQUIRE (list.memoryUsage() < 100000 * 2);
+        list.clear();
+        REQUIRE (list.size() == 0);
+        REQUIRE (list.sorted());
+        list.append(5);
+        REQUIRE (list[0] == 5);
+    }
+}
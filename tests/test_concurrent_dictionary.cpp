@@ -0,0 +1,219 @@
+#include "catch.hpp"
+
+#include <string>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "snowball/concurrency/concurrent_dictionary.hpp"
+#include "snowball/concurrency/read_write_lock.h"
+#include "snowball/concurrency/thread_pool.h"
+#include "snowball/collections/string.h"
+
+using namespace snowball;
+
+/**
+ * Hash of long counting its calls.
+ */
+struct CountingHash
+{
+    std::size_t operator()(long key) const
+    {
+        ++calls;
+        return std::hash<long>()(key);
+    };
+
+    static long calls;
+};
+
+long CountingHash::calls = 0;
+
+
+TEST_CASE("read write lock", "[concurrency]")
+{
+    SECTION("readers and writers")
+    {
+        ReadWriteLock lock;
+        long a = 0;
+        long b = 0;
+        std::vector<char> consistent(4, 1);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+            threads.push_back(std::thread([&, t]() {
+                for (int i = 0; i < 20000; ++i)
+                {
+                    if (i % 4 == 0)
+                    {
+                        std::lock_guard<ReadWriteLock> guard(lock);
+                        ++a;
+                        ++b;
+                    }
+                    else
+                    {
+                        ReadGuard guard(lock);
+                        if (a != b)
+                            consistent[t] = 0;
+                    }
+                }
+            }));
+        for (std::thread& thread: threads)
+            thread.join();
+        REQUIRE (std::count(consistent.begin(), consistent.end(), 0) == 0);
+        REQUIRE (a == 20000);
+        REQUIRE (b == 20000);
+    }
+}
+
+TEST_CASE("concurrent dictionary", "[concurrency]")
+{
+    SECTION("constructor")
+    {
+        ConcurrentDictionary<std::string, int> dict1;
+        REQUIRE (dict1.shards() >= 4);
+        REQUIRE (dict1.empty());
+        ConcurrentDictionary<std::string, int> dict2(5);
+        REQUIRE (dict2.shards() == 8);
+        ConcurrentDictionary<std::string, int> dict3(1);
+        REQUIRE (dict3.shards() == 1);
+        dict3.set("one", 1);
+        REQUIRE (dict3.get("one", 0) == 1);
+    }
+
+    SECTION("single thread")
+    {
+        ConcurrentDictionary<std::string, int> dict(4);
+        REQUIRE (dict.get("one", -1) == -1);
+        REQUIRE (dict.getOrInsert("one", 1) == 1);
+        REQUIRE (dict.getOrInsert("one", 2) == 1);
+        dict.set("two", 2);
+        dict.set("two", 22);
+        REQUIRE (dict.get("two", -1) == 22);
+        REQUIRE (dict.update("three", [](int& v) { v += 3; }) == 3);
+        REQUIRE (dict.update("three", [](int& v) { v *= 2; }) == 6);
+        REQUIRE (dict.size() == 3);
+        REQUIRE (dict.contains("one"));
+        REQUIRE (dict.erase("one"));
+        REQUIRE_FALSE (dict.erase("one"));
+        REQUIRE_FALSE (dict.contains("one"));
+        List<std::string> keys = dict.keys();
+        keys.sort();
+        REQUIRE (keys == List<std::string>({"three", "two"}));
+        List<int> values = dict.values();
+        values.sort();
+        REQUIRE (values == List<int>({6, 22}));
+        dict.clear();
+        REQUIRE (dict.empty());
+        REQUIRE (dict.get("two", -1) == -1);
+    }
+
+    SECTION("reserve")
+    {
+        ConcurrentDictionary<long, long> dict(8);
+        dict.reserve(10000);
+        for (long i = 0; i < 10000; ++i)
+            dict.set(i, -i);
+        REQUIRE (dict.size() == 10000);
+        bool found = true;
+        for (long i = 0; i < 10000; ++i)
+            found = found && dict.get(i, 1) == -i;
+        REQUIRE (found);
+        long sum = 0;
+        dict.forEach([&sum](long key, long value) { sum += key + value; });
+        REQUIRE (sum == 0);
+    }
+
+    SECTION("heterogeneous lookup")
+    {
+        ConcurrentDictionary<std::string, int, StringHash, StringEqual> dict;
+        dict.set("one", 1);
+        dict.set(String("two"), 2);
+        REQUIRE (dict.contains(std::string("one")));
+        REQUIRE (dict.get(String("one"), 0) == 1);
+        REQUIRE (dict.get("two", 0) == 2);
+        REQUIRE (dict.erase(String("two")));
+        REQUIRE (dict.size() == 1);
+    }
+
+    SECTION("one hash per call")
+    {
+        ConcurrentDictionary<long, long, CountingHash> dict(1);
+        dict.reserve(100);
+        CountingHash::calls = 0;
+        dict.set(1, 1);
+        dict.set(1, 2);
+        dict.update(2, [](long& v) { ++v; });
+        dict.getOrInsert(3, 3);
+        dict.getOrInsert(3, 4);
+        REQUIRE (CountingHash::calls == 5);
+        REQUIRE (dict.get(1, 0) == 2);
+        REQUIRE (dict.get(3, 0) == 3);
+    }
+
+    SECTION("concurrent updates")
+    {
+        ConcurrentDictionary<long, long> dict(4);
+        const long threads = 4;
+        const long keys = 100;
+        std::vector<std::thread> workers;
+        for (long t = 0; t < threads; ++t)
+            workers.push_back(std::thread([&dict]() {
+                for (long i = 0; i < 20000; ++i)
+                    dict.update(i % keys, [](long& count) { ++count; });
+            }));
+        for (std::thread& worker: workers)
+            worker.join();
+        REQUIRE (dict.size() == std::size_t(keys));
+        bool counted = true;
+        for (long i = 0; i < keys; ++i)
+            counted = counted && dict.get(i, 0) == threads * 20000 / keys;
+        REQUIRE (counted);
+    }
+
+    SECTION("concurrent get or insert")
+    {
+        //all threads agree on the value of each key, whoever inserted it
+        ConcurrentDictionary<long, long> dict;
+        const long threads = 4;
+        std::vector< std::vector<long> > seen(threads);
+        std::vector<std::thread> workers;
+        for (long t = 0; t < threads; ++t)
+            workers.push_back(std::thread([&dict, &seen, t]() {
+                for (long i = 0; i < 5000; ++i)
+                    seen[t].push_back(dict.getOrInsert(i, t));
+            }));
+        for (std::thread& worker: workers)
+            worker.join();
+        REQUIRE (dict.size() == 5000);
+        bool agree = true;
+        for (long t = 1; t < threads; ++t)
+            agree = agree && seen[t] == seen[0];
+        REQUIRE (agree);
+    }
+
+    SECTION("concurrent readers and writers")
+    {
+        ConcurrentDictionary<long, std::string> dict(2);
+        for (long i = 0; i < 1000; ++i)
+            dict.set(i, std::to_string(i));
+        ThreadPool pool(4);
+        std::vector<char> consistent(8000, 1);
+        pool.parallelFor(8000, [&](std::size_t i) {
+            long key = long(i % 2000);
+            if (i % 10 == 0)
+            {
+                //writers insert new keys and erase them again
+                dict.set(key + 1000, std::to_string(key + 1000));
+                dict.erase(key + 1000);
+            }
+            else
+            {
+                std::string value = dict.get(key, "");
+                if (!value.empty() && value != std::to_string(key))
+                    consistent[i] = 0;
+            }
+        });
+        REQUIRE (std::count(consistent.begin(), consistent.end(), 0) == 0);
+        REQUIRE (dict.get(999, "") == "999");
+    }
+}
@@ -0,0 +1,154 @@
+#include "catch.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "snowball/concurrency/concurrent_list.hpp"
+#include "snowball/concurrency/thread_pool.h"
+
+using namespace snowball;
+
+//all members must compile, whether items are trivially relocatable or not
+template class snowball::ConcurrentList<long>;
+template class snowball::ConcurrentList<std::string>;
+
+TEST_CASE("concurrent list", "[concurrency]")
+{
+    SECTION("append and access")
+    {
+        ConcurrentList<long> list;
+        REQUIRE (list.empty());
+        REQUIRE_THROWS_AS (list[0], IndexError);
+        for (long i = 0; i < 5000; ++i)
+            REQUIRE (list.append(i * 3) == std::size_t(i));
+        REQUIRE (list.size() == 5000);
+        REQUIRE (list[0] == 0);
+        REQUIRE (list[1023] == 3069);
+        REQUIRE (list[1024] == 3072);
+        REQUIRE (list[4999] == 14997);
+        REQUIRE (list[-1] == 14997);
+        REQUIRE_THROWS_AS (list[5000], IndexError);
+        list[2] = -1;
+        const ConcurrentList<long>& clist = list;
+        REQUIRE (clist[2] == -1);
+    }
+
+    SECTION("emplace")
+    {
+        ConcurrentList<std::string> list;
+        list.emplace(3, 'a');
+        list.append(std::string("bc"));
+        std::string d("d");
+        list.append(d);
+        REQUIRE (list.size() == 3);
+        REQUIRE (list[0] == "aaa");
+        REQUIRE (list[1] == "bc");
+        REQUIRE (list[2] == "d");
+    }
+
+    SECTION("freeze within capacity")
+    {
+        ConcurrentList<long> list(100);
+        for (long i = 0; i < 100; ++i)
+            list.append(i);
+        const long* data = &list[0];
+        List<long> frozen = list.freeze();
+        REQUIRE (list.size() == 0);
+        REQUIRE (frozen.size() == 100);
+        REQUIRE (&frozen[0] == data);
+        for (long i = 0; i < 100; ++i)
+            REQUIRE (frozen[i] == i);
+        list.append(7);
+        REQUIRE (list[0] == 7);
+        REQUIRE (ConcurrentList<long>().freeze().size() == 0);
+    }
+
+    SECTION("freeze over several segments")
+    {
+        ConcurrentList<long> list;
+        for (long i = 0; i < 10000; ++i)
+            list.append(i);
+        List<long> frozen = list.freeze();
+        REQUIRE (frozen.size() == 10000);
+        for (long i = 0; i < 10000; ++i)
+            REQUIRE (frozen[i] == i);
+        frozen.append(10000);
+        REQUIRE (frozen[-1] == 10000);
+    }
+
+    SECTION("freeze non trivially relocatable items")
+    {
+        ConcurrentList<std::string> list;
+        for (int i = 0; i < 3000; ++i)
+            list.append(std::to_string(i));
+        List<std::string> frozen = list.freeze();
+        REQUIRE (frozen.size() == 3000);
+        REQUIRE (frozen[0] == "0");
+        REQUIRE (frozen[2999] == "2999");
+        REQUIRE (list.empty());
+    }
+
+    SECTION("concurrent appends")
+    {
+        ConcurrentList<long> list;
+        const long threads = 4;
+        const long items = 20000;
+        std::vector<std::thread> producers;
+        std::vector<char> consistent(threads, 1);
+        for (long t = 0; t < threads; ++t)
+            producers.push_back(std::thread([&list, &consistent, t, items]() {
+                for (long i = 0; i < items; ++i)
+                {
+                    std::size_t index = list.append(t * items + i);
+                    //size may lag behind but never passes reserved slots
+                    if (list.size() > index && list[index] != t * items + i)
+                        consistent[t] = 0;
+                }
+            }));
+        for (std::thread& producer: producers)
+            producer.join();
+        REQUIRE (std::count(consistent.begin(), consistent.end(), 0) == 0);
+        REQUIRE (list.size() == std::size_t(threads * items));
+        List<long> frozen = list.freeze();
+        std::sort(frozen.begin(), frozen.end());
+        bool complete = true;
+        for (long i = 0; i < threads * items; ++i)
+            complete = complete && frozen[i] == i;
+        REQUIRE (complete);
+    }
+
+    SECTION("concurrent reads")
+    {
+        ConcurrentList<long> list;
+        std::thread producer([&list]() {
+            for (long i = 0; i < 50000; ++i)
+                list.append(i);
+        });
+        bool consistent = true;
+        std::size_t seen = 0;
+        while (seen < 50000)
+        {
+            std::size_t size = list.size();
+            for (std::size_t i = seen; i < size; ++i)
+                consistent = consistent && list[i] == long(i);
+            seen = size;
+        }
+        producer.join();
+        REQUIRE (consistent);
+    }
+
+    SECTION("thread pool")
+    {
+        ConcurrentList<std::string> list(16);
+        ThreadPool pool(4);
+        pool.parallelFor(1000, [&](std::size_t i) {
+            list.emplace(std::to_string(i));
+        });
+        REQUIRE (list.size() == 1000);
+        List<std::string> frozen = list.freeze();
+        REQUIRE (frozen.count("999") == 1);
+        REQUIRE (frozen.count("0") == 1);
+    }
+}
@@ -0,0 +1,226 @@
+#include "catch.hpp"
+
+#include <string>
+
+#include "snowball/collections/deque.hpp"
+#include "snowball/collections/list.hpp"
+#include "snowball/exceptions/exceptions.h"
+
+using namespace snowball;
+
+
+template <typename T>
+List<T> toList(const Deque<T>& deque)
+{
+    List<T> output;
+    typename Deque<T>::const_iterator it;
+    for (it = deque.begin(); it != deque.end(); ++it)
+        output.append(*it);
+    return output;
+}
+
+/**
+ * Stateful allocator which instances only release their own buffers.
+ */
+template <typename T>
+struct ArenaAllocator
+{
+    typedef T value_type;
+    typedef std::false_type propagate_on_container_move_assignment;
+    ArenaAllocator(int id): id(id) { };
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other): id(other.id) { };
+    T* allocate(std::size_t n)
+    {
+        ++live[id];
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n)
+    {
+        --live[id];
+        std::allocator<T>().deallocate(p, n);
+    }
+    bool operator==(const ArenaAllocator& other) const { return id == other.id; };
+    bool operator!=(const ArenaAllocator& other) const { return id != other.id; };
+    int id;
+    static int live[2];
+};
+
+template <typename T>
+int ArenaAllocator<T>::live[2] = {0, 0};
+
+TEST_CASE("deque", "[collections]")
+{
+    SECTION("constructors")
+    {
+        Deque<int> deque1;
+        REQUIRE (deque1.size() == 0);
+        REQUIRE (deque1.maxlen() == Deque<int>::unbounded);
+        Deque<int> deque2 = {0, 1, 2, 3};
+        REQUIRE (deque2.size() == 4);
+        Deque<int> deque3({0, 1, 2, 3, 4}, 3);
+        REQUIRE (toList(deque3) == List<int>({2, 3, 4}));
+        Deque<int> deque4(deque2);
+        REQUIRE (deque4 == deque2);
+        Deque<int> deque5(std::move(deque4));
+        REQUIRE (deque5 == deque2);
+        REQUIRE (deque4.size() == 0);
+        deque4 = deque5;
+        REQUIRE (deque4 == deque2);
+    }
+
+    SECTION("move assignment with unequal allocators")
+    {
+        typedef Deque<std::string, ArenaAllocator<std::string> > ArenaDeque;
+        {
+            ArenaDeque deque1(ArenaAllocator<std::string>(0));
+            ArenaDeque deque2(ArenaAllocator<std::string>(1));
+            deque1.append("snow");
+            deque2.append("ball");
+            deque2.appendleft("snow");
+            deque1 = std::move(deque2);
+            REQUIRE (deque1.size() == 2);
+            REQUIRE (deque1[0] == "snow");
+            REQUIRE (deque1[1] == "ball");
+            REQUIRE (deque2.size() == 0);
+        }
+        REQUIRE (ArenaAllocator<std::string>::live[0] == 0);
+        REQUIRE (ArenaAllocator<std::string>::live[1] == 0);
+    }
+
+    SECTION("append and appendleft")
+    {
+        Deque<int> deque;
+        for (int i = 0; i < 100; ++i)
+        {
+            deque.append(i);
+            deque.appendleft(-i);
+        }
+        REQUIRE (deque.size() == 200);
+        REQUIRE (deque[0] == -99);
+        REQUIRE (deque[-1] == 99);
+        REQUIRE (deque[99] == 0);
+        REQUIRE (deque[100] == 0);
+    }
+
+    SECTION("pop and popleft")
+    {
+        Deque<std::string> deque = {"a", "b", "c"};
+        REQUIRE (deque.pop() == "c");
+        REQUIRE (deque.popleft() == "a");
+        REQUIRE (deque.popleft() == "b");
+        REQUIRE_THROWS_AS (deque.pop(), IndexError);
+        REQUIRE_THROWS_AS (deque.popleft(), IndexError);
+    }
+
+    SECTION("work queue wrapping around the buffer")
+    {
+        Deque<int> deque;
+        int expected = 0;
+        for (int i = 0; i < 1000; ++i)
+        {
+            deque.append(i);
+            if (i % 3 == 0)
+                REQUIRE (deque.popleft() == expected++);
+        }
+        while (deque.size() > 0)
+            REQUIRE (deque.popleft() == expected++);
+        REQUIRE (expected == 1000);
+    }
+
+    SECTION("operator[]")
+    {
+        Deque<int> deque = {0, 1, 2, 3};
+        deque.appendleft(-1);
+        REQUIRE (deque[0] == -1);
+        REQUIRE (deque[-1] == 3);
+        REQUIRE (deque[-5] == -1);
+        deque[-2] = 20;
+        REQUIRE (deque[3] == 20);
+        REQUIRE_THROWS_AS (deque[5], IndexError);
+        REQUIRE_THROWS_AS (deque[-6], IndexError);
+    }
+
+    SECTION("maxlen")
+    {
+        Deque<int> deque(3);
+        REQUIRE (deque.maxlen() == 3);
+        for (int i = 0; i < 5; ++i)
+            deque.append(i);
+        REQUIRE (toList(deque) == List<int>({2, 3, 4}));
+        deque.appendleft(10);
+        REQUIRE (toList(deque) == List<int>({10, 2, 3}));
+        Deque<int> empty(0);
+        empty.append(1);
+        REQUIRE (empty.size() == 0);
+    }
+
+    SECTION("rotate")
+    {
+        Deque<int> deque = {0, 1, 2, 3, 4};
+        deque.rotate(1);
+        REQUIRE (toList(deque) == List<int>({4, 0, 1, 2, 3}));
+        deque.rotate(-2);
+        REQUIRE (toList(deque) == List<int>({1, 2, 3, 4, 0}));
+        deque.rotate(4);
+        REQUIRE (toList(deque) == List<int>({2, 3, 4, 0, 1}));
+        deque.rotate(10);
+        REQUIRE (toList(deque) == List<int>({2, 3, 4, 0, 1}));
+        Deque<int> full = {0, 1, 2, 3, 4, 5, 6, 7};
+        full.rotate(3);
+        REQUIRE (toList(full) == List<int>({5, 6, 7, 0, 1, 2, 3, 4}));
+    }
+
+    SECTION("extend and extendleft")
+    {
+        Deque<int> deque = {0};
+        deque.extend(List<int>({1, 2}));
+        deque.extendleft(List<int>({-1, -2}));
+        REQUIRE (toList(deque) == List<int>({-2, -1, 0, 1, 2}));
+    }
+
+    SECTION("extend with itself")
+    {
+        Deque<int> deque = {0, 1, 2, 3, 4, 5, 6};
+        deque.extend(deque);
+        REQUIRE (toList(deque) == List<int>({0, 1, 2, 3, 4, 5, 6,
+                                             0, 1, 2, 3, 4, 5, 6}));
+        Deque<int> left = {1, 2, 3};
+        left.extendleft(left);
+        REQUIRE (toList(left) == List<int>({3, 2, 1, 1, 2, 3}));
+        Deque<int> bounded({1, 2, 3}, 4);
+        bounded.extend(bounded);
+        REQUIRE (toList(bounded) == List<int>({3, 1, 2, 3}));
+    }
+
+    SECTION("contains, index, count and remove")
+    {
+        Deque<int> deque = {3, 1, 2, 1, 4};
+        deque.appendleft(1);
+        REQUIRE (deque.contains(4));
+        REQUIRE (!deque.contains(5));
+        REQUIRE (deque.index(2) == 3);
+        REQUIRE (deque.count(1) == 3);
+        REQUIRE_THROWS_AS (deque.index(5), ValueError);
+        deque.remove(1);
+        REQUIRE (toList(deque) == List<int>({3, 1, 2, 1, 4}));
+        deque.remove(4);
+        REQUIRE (toList(deque) == List<int>({3, 1, 2, 1}));
+        REQUIRE_THROWS_AS (deque.remove(5), ValueError);
+    }
+
+    SECTION("reverse and iterators")
+    {
+        Deque<int> deque = {1, 2, 3};
+        deque.appendleft(0);
+        deque.reverse();
+        REQUIRE (toList(deque) == List<int>({3, 2, 1, 0}));
+        List<int> output;
+        Deque<int>::reverse_iterator it;
+        for (it = deque.rbegin(); it != deque.rend(); ++it)
+            output.append(*it);
+        REQUIRE (output == List<int>({0, 1, 2, 3}));
+        deque.clear();
+        REQUIRE (deque.size() == 0);
+    }
+}
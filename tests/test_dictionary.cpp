@@ -164,5 +164,117 @@ TEST_CASE("dictionary", "[collections]")
         REQUIRE (dict2.size() == 2);
     }
     
+    SECTION("keys, values and items views")
+    {
+        Dictionary<int, string> dict;
+        dict[1] = "one";
+        dict[2] = "two";
+        Dictionary<int, string>::keys_view keys = dict.keysView();
+        Dictionary<int, string>::values_view values = dict.valuesView();
+        Dictionary<int, string>::items_view items = dict.items();
+        dict[3] = "three";
+        REQUIRE (keys.size() == 3);
+        REQUIRE (values.size() == 3);
+        REQUIRE (items.size() == 3);
+        REQUIRE (keys.contains(3));
+        REQUIRE_FALSE (keys.contains(4));
+        REQUIRE (values.contains("two"));
+        REQUIRE_FALSE (values.contains("four"));
+        REQUIRE (items.contains(2, "two"));
+        REQUIRE_FALSE (items.contains(2, "three"));
+        REQUIRE_FALSE (items.contains(4, "four"));
+        List<int> keyList(vector<int>(keys.begin(), keys.end()));
+        List<string> valueList(vector<string>(values.begin(), values.end()));
+        keyList.sort();
+        valueList.sort();
+        REQUIRE (keyList == List<int>({1, 2, 3}));
+        REQUIRE (valueList == List<string>({"one", "three", "two"}));
+        int sum = 0;
+        for (const pair<const int, string>& item: items)
+            sum += item.first * int(item.second.size());
+        REQUIRE (sum == 1 * 3 + 2 * 3 + 3 * 5);
+    }
+    
+    SECTION("set operations on keys views")
+    {
+        Dictionary<int, string> dict1;
+        Dictionary<int, double> dict2;
+        for (int i = 0; i < 6; ++i)
+            dict1[i] = "";
+        for (int i = 4; i < 9; ++i)
+            dict2[i] = 0.;
+        List<int> intersection = dict1.keysView() & dict2.keysView();
+        List<int> both = dict1.keysView() | dict2.keysView();
+        List<int> difference = dict1.keysView() - dict2.keysView();
+        List<int> symmetric = dict1.keysView() ^ dict2.keysView();
+        intersection.sort();
+        both.sort();
+        difference.sort();
+        symmetric.sort();
+        REQUIRE (intersection == List<int>({4, 5}));
+        REQUIRE (both == List<int>({0, 1, 2, 3, 4, 5, 6, 7, 8}));
+        REQUIRE (difference == List<int>({0, 1, 2, 3}));
+        REQUIRE (symmetric == List<int>({0, 1, 2, 3, 6, 7, 8}));
+        REQUIRE_FALSE (dict1.keysView().isDisjoint(dict2.keysView()));
+        Dictionary<int, string> dict3;
+        dict3[10] = "ten";
+        REQUIRE (dict1.keysView().isDisjoint(dict3.keysView()));
+        REQUIRE (dict3.keysView() != dict1.keysView());
+        Dictionary<int, string> dict4(dict1);
+        REQUIRE (dict4.keysView() == dict1.keysView());
+    }
+    
+    SECTION("operator[] with const dictionary")
+    {
+        Dictionary<string, int> dict;
+        dict["one"] = 1;
+        const Dictionary<string, int>& cdict = dict;
+        REQUIRE (cdict["one"] == 1);
+        REQUIRE_THROWS_AS (cdict["two"], KeyError);
+        REQUIRE (cdict.size() == 1);
+    }
+    
+    SECTION("mutation")
+    {
+        Dictionary<string, int> dict;
+        dict.update({{"one", 1}, {"two", 2}});
+        REQUIRE (dict.contains("one"));
+        REQUIRE_FALSE (dict.contains("three"));
+        REQUIRE (dict.pop("one") == 1);
+        REQUIRE_FALSE (dict.contains("one"));
+        REQUIRE_THROWS_AS (dict.pop("one"), KeyError);
+        REQUIRE (dict.pop("one", -1) == -1);
+        REQUIRE (dict.setDefault("three", 3) == 3);
+        REQUIRE (dict.setDefault("three", 4) == 3);
+        dict.setDefault("four")++;
+        REQUIRE (dict["four"] == 1);
+        REQUIRE (dict.erase("four"));
+        REQUIRE_FALSE (dict.erase("four"));
+        REQUIRE (dict.emplace("five", 5));
+        REQUIRE_FALSE (dict.emplace("five", 6));
+        REQUIRE (dict["five"] == 5);
+        Dictionary<string, int> other;
+        other["five"] = 55;
+        other["six"] = 6;
+        dict.update(other);
+        dict.update(dict);
+        REQUIRE (dict.size() == 4);
+        REQUIRE (dict["five"] == 55);
+        REQUIRE (dict["six"] == 6);
+    }
+    
+    SECTION("try emplace")
+    {
+        Dictionary<int, string> dict;
+        string value("one");
+        REQUIRE (dict.tryEmplace(1, std::move(value)));
+        REQUIRE (value.empty());
+        string other("uno");
+        REQUIRE_FALSE (dict.tryEmplace(1, std::move(other)));
+        REQUIRE (other == "uno");
+        REQUIRE (dict.tryEmplace(2, 3, 'x'));
+        REQUIRE (dict[2] == "xxx");
+    }
+    
 }
 
@@ -0,0 +1,273 @@
+#include "catch.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <random>
+
+#include "snowball/collections/flat_dictionary.hpp"
+#include "snowball/collections/string.h"
+
+using namespace snowball;
+using namespace std;
+
+/**
+ * Hash sending all keys into a few groups.
+ */
+struct PoorHash
+{
+    size_t operator()(long key) const { return key % 3; };
+};
+
+
+TEST_CASE("flat dictionary", "[collections]")
+{
+    SECTION("constructor")
+    {
+        FlatDictionary<string, int> dct1;
+        REQUIRE (dct1.size() == 0);
+        REQUIRE (dct1.capacity() == 0);
+        REQUIRE (dct1.get("one", 1) == 1);
+        REQUIRE (dct1.keys().size() == 0);
+    }
+
+    SECTION("operator[] with non-const dictionary")
+    {
+        FlatDictionary<string, int> dct1;
+        dct1[string("Hello World !")] = 1;
+        dct1[string("Undefined")];
+        REQUIRE (dct1.size() == 2);
+        REQUIRE (dct1["Hello World !"] == 1);
+        REQUIRE (dct1["Undefined"] == 0);
+        REQUIRE (dct1.size() == 2);
+    }
+
+    SECTION("operator[] with const dictionary")
+    {
+        FlatDictionary<string, int> dct1;
+        dct1["one"] = 1;
+        const FlatDictionary<string, int>& cdct1 = dct1;
+        REQUIRE (cdct1["one"] == 1);
+        REQUIRE_THROWS_AS (cdct1["two"], KeyError);
+        REQUIRE (cdct1.size() == 1);
+    }
+
+    SECTION("growth")
+    {
+        FlatDictionary<long, long> dct1;
+        for (long i = 0; i < 100000; ++i)
+            dct1[i * 7] = i;
+        REQUIRE (dct1.size() == 100000);
+        REQUIRE (dct1.capacity() >= dct1.size() + dct1.size() / 7);
+        bool found = true;
+        for (long i = 0; i < 100000; ++i)
+            found = found && dct1.get(i * 7, -1) == i;
+        REQUIRE (found);
+        REQUIRE (dct1.get(1, -1) == -1);
+        REQUIRE (dct1.get(-7, -1) == -1);
+    }
+
+    SECTION("collisions")
+    {
+        FlatDictionary<long, long, PoorHash> dct1;
+        for (long i = 0; i < 300; ++i)
+            dct1[i] = -i;
+        REQUIRE (dct1.size() == 300);
+        for (long i = 0; i < 300; ++i)
+            REQUIRE (dct1[i] == -i);
+        REQUIRE (dct1.get(300, 1) == 1);
+        REQUIRE (dct1.size() == 300);
+    }
+
+    SECTION("against unordered_map")
+    {
+        FlatDictionary<long, long> dct1;
+        unordered_map<long, long> reference;
+        mt19937_64 random(42);
+        for (int i = 0; i < 20000; ++i)
+        {
+            long key = long(random() % 5000);
+            dct1[key] += i;
+            reference[key] += i;
+        }
+        REQUIRE (dct1.size() == reference.size());
+        bool same = true;
+        for (const pair<const long, long>& item: reference)
+            same = same && dct1.get(item.first, -1) == item.second;
+        REQUIRE (same);
+    }
+
+    SECTION("copy and move")
+    {
+        FlatDictionary<string, string> dct1;
+        dct1["one"] = "un";
+        dct1["two"] = "deux";
+        FlatDictionary<string, string> dct2(dct1);
+        dct2["three"] = "trois";
+        REQUIRE (dct1.size() == 2);
+        REQUIRE (dct2.size() == 3);
+        REQUIRE (dct2["one"] == "un");
+        FlatDictionary<string, string> dct3;
+        dct3 = dct2;
+        REQUIRE (dct3.size() == 3);
+        REQUIRE (dct3["three"] == "trois");
+        FlatDictionary<string, string> dct4(std::move(dct3));
+        REQUIRE (dct3.size() == 0);
+        REQUIRE (dct4.size() == 3);
+        dct3 = std::move(dct4);
+        REQUIRE (dct3["two"] == "deux");
+        dct3 = dct3;
+        REQUIRE (dct3.size() == 3);
+    }
+
+    SECTION("reserve and clear")
+    {
+        FlatDictionary<int, int> dct1;
+        dct1.reserve(1000);
+        size_t capacity = dct1.capacity();
+        REQUIRE (capacity >= 1000);
+        for (int i = 0; i < 1000; ++i)
+            dct1[i] = i;
+        REQUIRE (dct1.capacity() == capacity);
+        dct1.clear();
+        REQUIRE (dct1.size() == 0);
+        REQUIRE (dct1.capacity() == capacity);
+        REQUIRE (dct1.get(5, -1) == -1);
+        dct1[5] = 6;
+        REQUIRE (dct1[5] == 6);
+    }
+
+    SECTION("keys and values")
+    {
+        FlatDictionary<int, string> dict;
+        dict[1] = "one";
+        dict[2] = "two";
+        dict[3] = "three";
+        List<string> values = dict.values();
+        List<int> keys = dict.keys();
+        values.sort();
+        keys.sort();
+        REQUIRE (keys == List<int>({1, 2, 3}));
+        REQUIRE (values == List<string>({"one", "three", "two"}));
+    }
+
+    SECTION("get with default value")
+    {
+        FlatDictionary<string, int> dict;
+        dict["one"] = 1;
+        dict["two"] = 2;
+        const FlatDictionary<string, int> cdict(dict);
+        REQUIRE (dict.get("one", 0) == 1);
+        REQUIRE (dict.get("three", 3) == 3);
+        REQUIRE (dict.size() == 2);
+        REQUIRE (cdict.get("two", 0) == 2);
+        REQUIRE (cdict.get("three", 3) == 3);
+        FlatDictionary<string, string> dict2;
+        dict2["two"] = "deux";
+        dict2.get("two", "n/a") = "dos";
+        REQUIRE (dict2.get("two", "n/a") == "dos");
+    }
+
+    SECTION("mutation")
+    {
+        FlatDictionary<string, int> dict;
+        dict.update({{"one", 1}, {"two", 2}});
+        REQUIRE (dict.contains("one"));
+        REQUIRE_FALSE (dict.contains("three"));
+        REQUIRE (dict.pop("one") == 1);
+        REQUIRE_FALSE (dict.contains("one"));
+        REQUIRE_THROWS_AS (dict.pop("one"), KeyError);
+        REQUIRE (dict.pop("one", -1) == -1);
+        REQUIRE (dict.setDefault("three", 3) == 3);
+        REQUIRE (dict.setDefault("three", 4) == 3);
+        dict.setDefault("four")++;
+        REQUIRE (dict["four"] == 1);
+        REQUIRE (dict.erase("four"));
+        REQUIRE_FALSE (dict.erase("four"));
+        REQUIRE (dict.emplace("five", 5));
+        REQUIRE_FALSE (dict.emplace("five", 6));
+        REQUIRE (dict["five"] == 5);
+        FlatDictionary<string, int> other;
+        other["five"] = 55;
+        other["six"] = 6;
+        dict.update(other);
+        dict.update(dict);
+        REQUIRE (dict.size() == 4);
+        REQUIRE (dict["five"] == 55);
+        REQUIRE (dict["six"] == 6);
+    }
+
+    SECTION("try emplace")
+    {
+        FlatDictionary<int, string> dict;
+        string value("one");
+        REQUIRE (dict.tryEmplace(1, std::move(value)));
+        REQUIRE (value.empty());
+        string other("uno");
+        REQUIRE_FALSE (dict.tryEmplace(1, std::move(other)));
+        REQUIRE (other == "uno");
+        REQUIRE (dict.tryEmplace(2, 3, 'x'));
+        REQUIRE (dict[2] == "xxx");
+    }
+
+    SECTION("erase and reinsert")
+    {
+        FlatDictionary<long, long> dict;
+        //churn over a constant number of keys: tombstones are purged
+        //instead of growing the table
+        for (long i = 0; i < 1000; ++i)
+            dict[i] = i;
+        size_t capacity = dict.capacity();
+        for (long i = 1000; i < 100000; ++i)
+        {
+            REQUIRE (dict.erase(i - 1000));
+            dict[i] = i;
+        }
+        REQUIRE (dict.size() == 1000);
+        REQUIRE (dict.capacity() == capacity);
+        bool found = true;
+        for (long i = 99000; i < 100000; ++i)
+            found = found && dict.get(i, -1) == i;
+        REQUIRE (found);
+        REQUIRE_FALSE (dict.contains(98999));
+        REQUIRE (dict.keys().size() == 1000);
+        FlatDictionary<long, long> copy(dict);
+        REQUIRE (copy.size() == 1000);
+        REQUIRE (copy.get(99999, -1) == 99999);
+    }
+
+    SECTION("heterogeneous lookup")
+    {
+        static_assert(std::is_same<detail::FlatProbe<string, const char*,
+            StringHash, StringEqual>::type, const char* const&>::value,
+            "C strings probe transparent dictionaries as is");
+        static_assert(std::is_same<detail::FlatProbe<string, const char*,
+            std::hash<string>, std::equal_to<string> >::type, string>::value,
+            "C strings are converted for other dictionaries");
+        static_assert(std::is_same<detail::FlatProbe<string, string,
+            std::hash<string>, std::equal_to<string> >::type,
+            const string&>::value, "keys are not copied");
+        FlatDictionary<string, int, StringHash, StringEqual> dict;
+        dict["one"] = 1;
+        dict[string("two")] = 2;
+        dict[String("three")] = 3;
+        const char* four = "four";
+        dict[four] = 4;
+        REQUIRE (dict.size() == 4);
+        REQUIRE (dict.contains("one"));
+        REQUIRE (dict.contains(String("two")));
+        REQUIRE (dict.contains(string("three")));
+        REQUIRE (dict.get(four, 0) == 4);
+        REQUIRE (dict.get(String("one"), 0) == 1);
+        REQUIRE_FALSE (dict.contains(String("five")));
+        const FlatDictionary<string, int, StringHash, StringEqual>& cdict = dict;
+        REQUIRE (cdict["three"] == 3);
+        REQUIRE_THROWS_AS (cdict[String("")], KeyError);
+        REQUIRE (dict.pop(String("two")) == 2);
+        REQUIRE (dict.erase("three"));
+        REQUIRE (dict.size() == 2);
+        REQUIRE (StringHash()("abc") == StringHash()(String("abc")));
+        REQUIRE (StringHash()("abc") == StringHash()(string("abc")));
+        REQUIRE (StringEqual()(String("abc"), "abc"));
+        REQUIRE_FALSE (StringEqual()(string("abc"), "abcd"));
+    }
+}
@@ -1,21 +1,95 @@
 #include "catch.hpp"
 
 #include <limits>
+#include <cmath>
+#include <cstdlib>
 #include <cstddef>
 #include <iostream>
 #include <functional>
 
 #include "snowball/collections/list.hpp"
+#include "snowball/collections/string.h"
+#include "snowball/collections/dictionary.hpp"
 #include "snowball/exceptions/exceptions.h"
 
 using namespace snowball;
 
+/*
+ * Item without padding that opts in to memcmp comparison.
+ */
+struct Pixel
+{
+    int x;
+    int y;
+    bool operator!=(const Pixel& other) const 
+    { 
+        return x != other.x || y != other.y; 
+    };
+};
+
+namespace snowball
+{
+template <>
+struct TriviallyComparable<Pixel>: public std::true_type { };
+}
+
 
 const int valueAt(const List<int>& list, int index)
 {
     return list[index];
 }
 
+/*
+ * Item counting copies to check that move semantics are used.
+ */
+struct CopyCounter
+{
+    static int copies;
+    int value;
+    CopyCounter(int v = 0): value(v) { };
+    CopyCounter(const CopyCounter& other): value(other.value) { ++copies; };
+    CopyCounter(CopyCounter&& other) noexcept: value(other.value) { };
+    CopyCounter& operator=(const CopyCounter& other) 
+    { 
+        value = other.value; 
+        ++copies; 
+        return *this; 
+    };
+    CopyCounter& operator=(CopyCounter&& other) noexcept
+    { 
+        value = other.value; 
+        return *this; 
+    };
+    bool operator!=(const CopyCounter& other) const 
+    { 
+        return value != other.value; 
+    };
+};
+
+int CopyCounter::copies = 0;
+
+/*
+ * Allocator counting allocations of all its instances.
+ */
+template <typename T>
+struct CountingAllocator: public std::allocator<T>
+{
+    static int allocations;
+    template <typename U>
+    struct rebind { typedef CountingAllocator<U> other; };
+    CountingAllocator() { };
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) { };
+    T* allocate(std::size_t n)
+    {
+        ++allocations;
+        return std::allocator<T>::allocate(n);
+    };
+};
+
+template <typename T>
+int CountingAllocator<T>::allocations = 0;
+
 bool sortInt(const int& i, const int& j)
 {
     if ((3 - i) * (3 - i) == (3 - j) * (3 - j))
@@ -121,6 +195,25 @@ TEST_CASE("list", "[collections]")
         REQUIRE_THROWS_AS (list[-8], IndexError);
     }
     
+    SECTION("operator[] with check policies")
+    {
+        UncheckedList<int> list1 = {0, 1, 2, 3};
+        REQUIRE (list1[0] == 0);
+        REQUIRE (list1[-1] == 3);
+        list1[-2] = 5;
+        REQUIRE (list1 == UncheckedList<int>({0, 1, 5, 3}));
+        DebugList<int> list2 = {0, 1, 2, 3};
+        REQUIRE (list2[3] == 3);
+        REQUIRE (list2[-4] == 0);
+        list2.append(4);
+        list2.sort();
+        REQUIRE (list2[-1] == 4);
+        List<int, std::allocator<int>, PythonCheck> list3 = {0, 1};
+        REQUIRE_THROWS_AS (list3[2], IndexError);
+        REQUIRE_THROWS_AS (list3[-3], IndexError);
+        REQUIRE_THROWS_AS (list3[std::numeric_limits<long>::min()], IndexError);
+    }
+    
     SECTION("operator==")
     {
         List<int> list1 = {1, 2, 3, 4};
@@ -132,6 +225,58 @@ TEST_CASE("list", "[collections]")
         REQUIRE (list2 == list3);
         REQUIRE (list4 == list5);
     }
+    
+    SECTION("operator== with trivially comparable items")
+    {
+        List<long> list1;
+        for (long i = 0; i < 1000; ++i)
+            list1.append(i * i);
+        List<long> list2 = list1;
+        REQUIRE (list1 == list2);
+        list2[999] = 0;
+        REQUIRE (!(list1 == list2));
+        List<Pixel> pixels1 = {{1, 2}, {3, 4}};
+        List<Pixel> pixels2 = {{1, 2}, {3, 4}};
+        REQUIRE (pixels1 == pixels2);
+        pixels2[0].y = 0;
+        REQUIRE (!(pixels1 == pixels2));
+        //floating point items are compared by value, not by bytes
+        List<double> zeros1 = {0.0, 1.0};
+        List<double> zeros2 = {-0.0, 1.0};
+        REQUIRE (zeros1 == zeros2);
+    }
+    
+    SECTION("hash")
+    {
+        Hash< List<int> > hasher;
+        List<int> list1 = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+        List<int> list2 = list1;
+        REQUIRE (hasher(list1) == hasher(list2));
+        list2[10] = 12;
+        REQUIRE (hasher(list1) != hasher(list2));
+        REQUIRE (hasher(List<int>()) != hasher(List<int>({0})));
+        Hash< List<String> > stringHasher;
+        List<String> strings1 = {"hello", "world"};
+        List<String> strings2 = {String("hello"), String("world")};
+        REQUIRE (stringHasher(strings1) == stringHasher(strings2));
+        REQUIRE (stringHasher(strings1) != 
+                 stringHasher(List<String>({"world", "hello"})));
+        //equal lists hash the same when bytes of items differ
+        Hash< List<double> > doubleHasher;
+        REQUIRE (doubleHasher(List<double>({0.0, 1.0})) == 
+                 doubleHasher(List<double>({-0.0, 1.0})));
+        Hash< List<std::wstring> > wideHasher;
+        List<std::wstring> wide1 = {L"a wide string stored on the heap", L"b"};
+        List<std::wstring> wide2 = {L"a wide string stored on the heap", L"b"};
+        REQUIRE (wide1 == wide2);
+        REQUIRE (wideHasher(wide1) == wideHasher(wide2));
+        Dictionary<List<int>, int, Hash< List<int> > > dct;
+        dct[list1] = 1;
+        dct[List<int>({1, 2})] = 2;
+        REQUIRE (dct.size() == 2);
+        REQUIRE (dct[List<int>({1, 2})] == 2);
+        REQUIRE (dct[list1] == 1);
+    }
         
     SECTION("append")
     {
@@ -247,6 +392,57 @@ TEST_CASE("list", "[collections]")
         REQUIRE_THROWS_AS (list.remove(3), ValueError);
     }
     
+    SECTION("bulk remove")
+    {
+        List<int> list = {6, 4, 4, 0, 5, 1, 2, 7, 3, 4};
+        REQUIRE (list.removeIf([](int x) { return x % 2 == 1; }) == 4);
+        REQUIRE (list == List<int>({6, 4, 4, 0, 2, 4}));
+        REQUIRE (list.removeAll(4) == 3);
+        REQUIRE (list == List<int>({6, 0, 2}));
+        REQUIRE (list.removeAll(4) == 0);
+        List<int> other = {6, 4, 4, 0, 5, 1, 2, 7, 3, 4};
+        REQUIRE (other.removeMany(List<int>({4, 7, 9})) == 4);
+        REQUIRE (other == List<int>({6, 0, 5, 1, 2, 3}));
+        REQUIRE (other.removeMany(List<int>()) == 0);
+        //large removal sets go through a hash set
+        List<int> large;
+        List<int> odds;
+        for (int i = 0; i < 1000; ++i)
+        {
+            large.append(i % 100);
+            if (i % 2 == 1)
+                odds.append(i);
+        }
+        REQUIRE (large.removeMany(odds) == 500);
+        //String is hashed by the library's own Hash
+        List<String> words;
+        List<String> removed;
+        for (int i = 0; i < 100; ++i)
+        {
+            words.append(String(std::to_string(i % 50)));
+            if (i % 2 == 0)
+                removed.append(String(std::to_string(i)));
+        }
+        REQUIRE (words.removeMany(removed) == 50);
+        REQUIRE (words.size() == 50);
+        REQUIRE (words[0] == String("1"));
+        REQUIRE (large.size() == 500);
+        REQUIRE (large[0] == 0);
+        REQUIRE (large[1] == 2);
+        REQUIRE (large[-1] == 98);
+        //hashed and scanned removal agree with operator==
+        List<double> zeros = {-0.0, 1.0, 2.0};
+        REQUIRE (zeros.removeMany(List<double>({0.0})) == 1);
+        REQUIRE (zeros.size() == 2);
+        List<double> values;
+        for (int i = 0; i < 20; ++i)
+            values.append(i + 10.0);
+        values.append(0.0);
+        zeros = {-0.0, 1.0, 2.0};
+        REQUIRE (zeros.removeMany(values) == 1);
+        REQUIRE (zeros == List<double>({1.0, 2.0}));
+    }
+    
     SECTION("sort")
     {
         List<int> list = {6, 4, 0, 5, 1, 2, 7, 3};
@@ -315,6 +511,202 @@ TEST_CASE("list", "[collections]")
         REQUIRE (list == List<int>({0, 1, 2, 3, 4, 5, 6, 7}));
     }
     
+    SECTION("parallel sort")
+    {
+        //threshold lowered so that small lists go through the parallel path
+        List<int> list;
+        for (int i = 0; i < 1000; ++i)
+            list.append((i * 7919) % 1009);
+        List<int> expected = list;
+        expected.sort();
+        for (unsigned threads = 1; threads <= 5; ++threads)
+        {
+            List<int> copy = list;
+            copy.sort(Parallel(threads, 2));
+            REQUIRE (copy == expected);
+        }
+        List<int> small = {6, 4, 0, 5, 1, 2, 7, 3};
+        small.sort(Parallel(3, 2));
+        REQUIRE (small == List<int>({0, 1, 2, 3, 4, 5, 6, 7}));
+        List<int> tiny = {1};
+        tiny.sort(Parallel(4, 0));
+        REQUIRE (tiny == List<int>({1}));
+    }
+    
+    SECTION("parallel sort with comparator")
+    {
+        List<int> list = {6, 4, 0, 5, 1, 2, 7, 3};
+        list.sort(sortInt, Parallel(3, 2));
+        REQUIRE (list == List<int>({3, 2, 4, 1, 5, 0, 6, 7}));
+        Comp cmp;
+        list.sort(cmp, Parallel(4, 2));
+        REQUIRE (list == List<int>({0, 1, 2, 3, 4, 5, 6, 7}));
+        List<std::string> words = {"pear", "apple", "fig", "kiwi", "banana"};
+        words.sort(std::greater<std::string>(), Parallel(2, 2));
+        REQUIRE (words == List<std::string>({"pear", "kiwi", "fig", "banana", 
+                                             "apple"}));
+    }
+    
+    SECTION("radix sort")
+    {
+        List<int> ints;
+        List<long> longs;
+        List<unsigned short> shorts;
+        List<double> doubles;
+        for (long i = 0; i < 5000; ++i)
+        {
+            long value = (i * 7919) % 10007 - 5000;
+            ints.append(int(value));
+            longs.append(value * 1000000007L);
+            shorts.append((unsigned short)(value * 13));
+            doubles.append(value / 7.);
+        }
+        doubles.append(-0.);
+        doubles.append(std::numeric_limits<double>::infinity());
+        doubles.append(-std::numeric_limits<double>::infinity());
+        doubles.append(std::numeric_limits<double>::denorm_min());
+        std::vector<int> expectedInts(ints.begin(), ints.end());
+        std::vector<long> expectedLongs(longs.begin(), longs.end());
+        std::vector<unsigned short> expectedShorts(shorts.begin(), 
+                                                   shorts.end());
+        std::vector<double> expectedDoubles(doubles.begin(), doubles.end());
+        std::sort(expectedInts.begin(), expectedInts.end());
+        std::sort(expectedLongs.begin(), expectedLongs.end());
+        std::sort(expectedShorts.begin(), expectedShorts.end());
+        std::sort(expectedDoubles.begin(), expectedDoubles.end());
+        ints.sort();
+        longs.sort();
+        shorts.sort();
+        doubles.sort();
+        REQUIRE (ints == List<int>(expectedInts));
+        REQUIRE (longs == List<long>(expectedLongs));
+        REQUIRE (shorts == List<unsigned short>(expectedShorts));
+        REQUIRE (doubles == List<double>(expectedDoubles));
+        //-0.0 goes before 0.0
+        REQUIRE (std::signbit(doubles[doubles.index(0.)]));
+        REQUIRE (!std::signbit(doubles[doubles.index(0.) + 1]));
+    }
+    
+    SECTION("sort with key")
+    {
+        List<int> list = {6, -4, 0, 5, -1, 2, -7, 3};
+        int calls = 0;
+        auto absolute = [&calls](const int& i) { ++calls; return std::abs(i); };
+        list.sort(absolute, false);
+        REQUIRE (calls == 8);
+        REQUIRE (list == List<int>({0, -1, 2, 3, -4, 5, 6, -7}));
+        list.sort(absolute, true);
+        REQUIRE (list == List<int>({-7, 6, 5, -4, 3, 2, -1, 0}));
+        List<std::string> words = {"pear", "Fig", "apple", "kiwi", "Banana"};
+        words.sort([](const std::string& w) { return w.size(); }, false);
+        REQUIRE (words == List<std::string>({"Fig", "pear", "kiwi", "apple", 
+                                             "Banana"}));
+        //equal keys keep their order when reversed
+        words.sort([](const std::string& w) { return w.size(); }, true);
+        REQUIRE (words == List<std::string>({"Banana", "apple", "pear", 
+                                             "kiwi", "Fig"}));
+    }
+    
+    SECTION("sort with key computed in parallel")
+    {
+        List<int> list;
+        for (int i = 0; i < 2000; ++i)
+            list.append((i * 7919) % 2003 - 1000);
+        List<int> expected = list;
+        expected.sort([](const int& i) { return i * i; }, true);
+        list.sort([](const int& i) { return i * i; }, true, Parallel(4, 2));
+        REQUIRE (list == expected);
+        int largest = list[0] * list[0];
+        REQUIRE (largest == 1002 * 1002);
+    }
+    
+    SECTION("sort with throwing key")
+    {
+        List<int> list = {6, 4, 0, 5, 1, 2, 7, 3};
+        auto failing = [](const int& i) { 
+            if (i == 2) 
+                throw ValueError("no key");
+            return i;
+        };
+        REQUIRE_THROWS_AS (list.sort(failing, false), ValueError);
+        REQUIRE (list == List<int>({6, 4, 0, 5, 1, 2, 7, 3}));
+    }
+    
+    SECTION("stable sort")
+    {
+        List<int> list = {6, 4, 0, 5, 1, 2, 7, 3};
+        list.stableSort();
+        REQUIRE (list == List<int>({0, 1, 2, 3, 4, 5, 6, 7}));
+        list.stableSort(sortInt);
+        REQUIRE (list == List<int>({3, 2, 4, 1, 5, 0, 6, 7}));
+        Comp cmp;
+        list.stableSort(cmp);
+        REQUIRE (list == List<int>({0, 1, 2, 3, 4, 5, 6, 7}));
+        List<int> empty;
+        empty.stableSort();
+        REQUIRE (empty.size() == 0);
+    }
+    
+    SECTION("stable sort keeps order of equal items")
+    {
+        //items are value * 1000 + position: sort on value only
+        std::function<bool(const int&, const int&)> byValue = 
+            [](const int& a, const int& b) { return a / 1000 < b / 1000; };
+        List<int> patterns[4];
+        for (int i = 0; i < 5000; ++i)
+        {
+            patterns[0].append(((i * 7919) % 37) * 1000 + i % 1000);
+            patterns[1].append((i / 100) * 1000 + i % 1000);
+            patterns[2].append((50 - i / 100) * 1000 + i % 1000);
+            patterns[3].append(((i % 700 == 0) ? 3 : i / 500) * 1000 + 
+                               i % 1000);
+        }
+        for (int p = 0; p < 4; ++p)
+        {
+            std::vector<int> expected(patterns[p].begin(), patterns[p].end());
+            std::stable_sort(expected.begin(), expected.end(), byValue);
+            patterns[p].stableSort(byValue);
+            REQUIRE (patterns[p] == List<int>(expected));
+        }
+    }
+    
+    SECTION("stable sort of presorted runs")
+    {
+        List<int> list;
+        for (int i = 0; i < 3000; ++i)
+            list.append(i);
+        for (int i = 3000; i > 0; --i)
+            list.append(i);
+        for (int i = 0; i < 3000; ++i)
+            list.append(i % 2 == 0 ? i : 3000 - i);
+        std::vector<int> expected(list.begin(), list.end());
+        std::sort(expected.begin(), expected.end());
+        list.stableSort();
+        REQUIRE (list == List<int>(expected));
+    }
+    
+    SECTION("stable sort with throwing comparator")
+    {
+        List<int> list;
+        for (int i = 0; i < 1000; ++i)
+            list.append((i * 7919) % 1009);
+        int calls = 0;
+        auto failing = [&calls](const int& a, const int& b) {
+            if (++calls == 5000)
+                throw ValueError("comparison failed");
+            return a < b;
+        };
+        REQUIRE_THROWS_AS (list.stableSort(failing), ValueError);
+        //no item was lost
+        std::vector<int> items(list.begin(), list.end());
+        std::sort(items.begin(), items.end());
+        std::vector<int> expected;
+        for (int i = 0; i < 1000; ++i)
+            expected.push_back((i * 7919) % 1009);
+        std::sort(expected.begin(), expected.end());
+        REQUIRE (items == expected);
+    }
+    
     SECTION("reverse")
     {
         List<int> list = {6, 4, 0, 5, 1, 2, 7, 3};
@@ -368,6 +760,295 @@ TEST_CASE("list", "[collections]")
         REQUIRE (list1.size() == 0);
     }
     
+    SECTION("move construction and assignment")
+    {
+        List<CopyCounter> list1;
+        for (int i = 0; i < 10; ++i)
+            list1.emplace(i);
+        CopyCounter::copies = 0;
+        List<CopyCounter> list2(std::move(list1));
+        REQUIRE (list2.size() == 10);
+        REQUIRE (list1.size() == 0);
+        List<CopyCounter> list3;
+        list3 = std::move(list2);
+        REQUIRE (list3.size() == 10);
+        REQUIRE (list3[9].value == 9);
+        REQUIRE (CopyCounter::copies == 0);
+        std::vector<int> vect = {0, 1, 2};
+        List<int> list4(std::move(vect));
+        REQUIRE (list4 == List<int>({0, 1, 2}));
+    }
+    
+    SECTION("append, insert and emplace with move")
+    {
+        List<CopyCounter> list;
+        CopyCounter::copies = 0;
+        list.append(CopyCounter(1));
+        list.emplace(2);
+        list.insert(0, CopyCounter(0));
+        CopyCounter item(3);
+        list.append(std::move(item));
+        REQUIRE (list.size() == 4);
+        REQUIRE (list[0].value == 0);
+        REQUIRE (list[-1].value == 3);
+        REQUIRE (CopyCounter::copies == 0);
+        List<std::string> strings;
+        strings.emplace(3, 'a');
+        REQUIRE (strings[0] == "aaa");
+    }
+    
+    SECTION("lazy concatenation")
+    {
+        typedef List<int, CountingAllocator<int> > CountedList;
+        CountedList a = {0, 1};
+        CountedList b = {2, 3, 4};
+        CountedList c = {5};
+        CountingAllocator<int>::allocations = 0;
+        CountedList abc = a + b + c + a;
+        REQUIRE (CountingAllocator<int>::allocations == 1);
+        REQUIRE (abc == CountedList({0, 1, 2, 3, 4, 5, 0, 1}));
+        //iteration does not build the concatenation
+        CountingAllocator<int>::allocations = 0;
+        int sum = 0;
+        for (int item: a + (b + c))
+            sum += item;
+        REQUIRE (sum == 15);
+        REQUIRE (CountingAllocator<int>::allocations == 0);
+        std::size_t size = ((a + b) + (c + a)).size();
+        REQUIRE (size == 8);
+        REQUIRE ((a + b) == CountedList({0, 1, 2, 3, 4}));
+        REQUIRE ((a + b) != CountedList({0, 1, 2, 3}));
+        //a concatenation may be kept while its lists are alive
+        auto abca = a + b + c + a;
+        REQUIRE (std::distance(abca.begin(), abca.end()) == 8);
+        //assignment, extend and insert copy items once
+        CountingAllocator<int>::allocations = 0;
+        abc = b + c;
+        REQUIRE (CountingAllocator<int>::allocations == 0);
+        REQUIRE (abc == CountedList({2, 3, 4, 5}));
+        abc.extend(a + c);
+        REQUIRE (abc == CountedList({2, 3, 4, 5, 0, 1, 5}));
+        abc += c + c;
+        REQUIRE (abc == CountedList({2, 3, 4, 5, 0, 1, 5, 5, 5}));
+        abc.insert(1, a + a);
+        REQUIRE (abc == CountedList({2, 0, 1, 0, 1, 3, 4, 5, 0, 1, 5, 5, 5}));
+        abc.insert(-100, b + c);
+        REQUIRE (abc[0] == 2);
+        REQUIRE (abc[3] == 5);
+        //operands may be the target
+        CountedList list = {1, 2};
+        list = c + list + list;
+        REQUIRE (list == CountedList({5, 1, 2, 1, 2}));
+        list.extend(list + c);
+        REQUIRE (list == CountedList({5, 1, 2, 1, 2, 5, 1, 2, 1, 2, 5}));
+        list = {1, 2};
+        list.insert(1, list + list);
+        REQUIRE (list == CountedList({1, 1, 2, 1, 2, 2}));
+        //items of other types are copied once
+        List<CopyCounter> counters1;
+        List<CopyCounter> counters2;
+        for (int i = 0; i < 5; ++i)
+        {
+            counters1.emplace(i);
+            counters2.emplace(i + 5);
+        }
+        CopyCounter::copies = 0;
+        List<CopyCounter> counters3 = counters1 + counters2 + counters1;
+        REQUIRE (counters3.size() == 15);
+        REQUIRE (CopyCounter::copies == 15);
+    }
+    
+    SECTION("concatenation with temporaries")
+    {
+        List<std::string> a = {"a", "b"};
+        List<std::string> b = {"c"};
+        auto make = []() { return List<std::string>({"x", "y", "z"}); };
+        std::string joined;
+        for (const std::string& item: a + make())
+            joined += item;
+        REQUIRE (joined == "abxyz");
+        joined.clear();
+        for (const std::string& item: a + b + make())
+            joined += item;
+        REQUIRE (joined == "abcxyz");
+        joined.clear();
+        for (const std::string& item: make() + (a + b))
+            joined += item;
+        REQUIRE (joined == "xyzabc");
+        REQUIRE ((make() + make()) == List<std::string>({"x", "y", "z", 
+                                                         "x", "y", "z"}));
+        //items of the temporary are moved
+        List<CopyCounter> counters1;
+        List<CopyCounter> counters2;
+        for (int i = 0; i < 5; ++i)
+        {
+            counters1.emplace(i);
+            counters2.emplace(i + 5);
+        }
+        CopyCounter::copies = 0;
+        List<CopyCounter> counters3 = counters1 + std::move(counters2);
+        REQUIRE (counters3.size() == 10);
+        REQUIRE (CopyCounter::copies == 5);
+    }
+    
+    SECTION("extend and operator+ with move")
+    {
+        List<CopyCounter> list1;
+        List<CopyCounter> list2;
+        for (int i = 0; i < 5; ++i)
+        {
+            list1.emplace(i);
+            list2.emplace(i + 5);
+        }
+        CopyCounter::copies = 0;
+        List<CopyCounter> list3;
+        list3.extend(std::move(list1));
+        list3 += std::move(list2);
+        REQUIRE (list3.size() == 10);
+        REQUIRE (list1.size() == 0);
+        REQUIRE (list2.size() == 0);
+        REQUIRE (CopyCounter::copies == 0);
+        List<CopyCounter> list4 = std::move(list3) + List<CopyCounter>();
+        REQUIRE (list4.size() == 10);
+        REQUIRE (CopyCounter::copies == 0);
+        List<int> a = {0, 1};
+        List<int> b = {2, 3};
+        List<int> c = {4};
+        List<int> abc = a + b + c;
+        REQUIRE (abc == List<int>({0, 1, 2, 3, 4}));
+        REQUIRE (a == List<int>({0, 1}));
+    }
+    
+    SECTION("extend with itself moved")
+    {
+        List<std::string> list = {"snow", "ball"};
+        list.extend(std::move(list));
+        REQUIRE (list == List<std::string>({"snow", "ball", "snow", "ball"}));
+        list = {"x"};
+        list += std::move(list);
+        REQUIRE (list == List<std::string>({"x", "x"}));
+        List<std::string> empty;
+        empty.extend(std::move(empty));
+        REQUIRE (empty.size() == 0);
+    }
+    
+    SECTION("pop moves items out")
+    {
+        List<CopyCounter> list;
+        for (int i = 0; i < 5; ++i)
+            list.emplace(i);
+        CopyCounter::copies = 0;
+        REQUIRE (list.pop().value == 4);
+        REQUIRE (list.pop(0).value == 0);
+        REQUIRE (list.pop(-2).value == 2);
+        REQUIRE (CopyCounter::copies == 0);
+        REQUIRE_THROWS_AS (list.pop(2), IndexError);
+        REQUIRE_THROWS_AS (list.pop(-3), IndexError);
+    }
+    
+    SECTION("slice with Python semantics")
+    {
+        List<int> list = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        REQUIRE (list.slice(2, 5).toList() == List<int>({2, 3, 4}));
+        REQUIRE (list.slice(-3).toList() == List<int>({7, 8, 9}));
+        REQUIRE (list.slice(Slice::none, 2).toList() == List<int>({0, 1}));
+        REQUIRE (list.slice(1, -1, 3).toList() == List<int>({1, 4, 7}));
+        REQUIRE (list.slice(Slice::none, Slice::none, -3).toList() == 
+                 List<int>({9, 6, 3, 0}));
+        REQUIRE (list.slice(7, 2, -2).toList() == List<int>({7, 5, 3}));
+        REQUIRE (list.slice(-100, 100).size() == 10);
+        REQUIRE (list.slice(5, 2).size() == 0);
+        REQUIRE (list.slice(100, Slice::none, -1).size() == 10);
+        REQUIRE_THROWS_AS (list.slice(0, 5, 0), ValueError);
+        List<int> empty;
+        REQUIRE (empty.slice(Slice::none, Slice::none, -1).size() == 0);
+    }
+    
+    SECTION("read-only list view")
+    {
+        const List<int> list = {5, 1, 5, 2, 5, 3};
+        ListView<const int> view = list.slice(1, Slice::none, 2);
+        REQUIRE (view.size() == 3);
+        REQUIRE (view[0] == 1);
+        REQUIRE (view[-1] == 3);
+        REQUIRE_THROWS_AS (view[3], IndexError);
+        REQUIRE (view.contains(2));
+        REQUIRE (!view.contains(5));
+        REQUIRE (view.count(5) == 0);
+        REQUIRE (list.slice(0).count(5) == 3);
+        REQUIRE (view.index(3) == 2);
+        REQUIRE_THROWS_AS (view.index(5), ValueError);
+        List<int> output;
+        ListView<const int>::iterator it;
+        for (it = view.begin(); it != view.end(); ++it)
+            output.append(*it);
+        REQUIRE (output == List<int>({1, 2, 3}));
+        REQUIRE (&view[0] == &list[1]);
+    }
+    
+    SECTION("mutable list view")
+    {
+        List<int> list = {0, 1, 2, 3, 4, 5};
+        list.slice(Slice::none, Slice::none, -2)[0] = 50;
+        REQUIRE (list[5] == 50);
+        list.slice(1, 3).assign(List<int>({7, 8, 9}));
+        REQUIRE (list == List<int>({0, 7, 8, 9, 3, 4, 50}));
+        list.slice(1, 5).assign(List<int>({1}));
+        REQUIRE (list == List<int>({0, 1, 4, 50}));
+        list.slice(2, 2).assign(List<int>({2, 3}));
+        REQUIRE (list == List<int>({0, 1, 2, 3, 4, 50}));
+        list.slice(Slice::none, Slice::none, 2).assign(List<int>({10, 12, 14}));
+        REQUIRE (list == List<int>({10, 1, 12, 3, 14, 50}));
+        REQUIRE_THROWS_AS (list.slice(0, Slice::none, 2).assign(List<int>({1})), 
+                           ValueError);
+        list.slice(0, Slice::none, 2).erase();
+        REQUIRE (list == List<int>({1, 3, 50}));
+        list.slice(-2).erase();
+        REQUIRE (list == List<int>({1}));
+        List<int> list2 = {0, 1, 2, 3, 4, 5, 6};
+        list2.slice(5, 0, -2).erase();
+        REQUIRE (list2 == List<int>({0, 2, 4, 6}));
+    }
+
+    SECTION("slice assignment from the same list")
+    {
+        //l[5:10] = l[0:20]
+        List<int> list;
+        list.reserve(200);
+        for (int i = 0; i < 20; ++i)
+            list.append(i);
+        const List<int>& clist = list;
+        list.slice(5, 10).assign(clist.slice(0, 20));
+        List<int> expected;
+        for (int i = 0; i < 5; ++i)
+            expected.append(i);
+        for (int i = 0; i < 20; ++i)
+            expected.append(i);
+        for (int i = 10; i < 20; ++i)
+            expected.append(i);
+        REQUIRE (list == expected);
+        //l[::-1] = l
+        List<int> list2 = {0, 1, 2, 3, 4};
+        list2.slice(Slice::none, Slice::none, -1).assign(list2);
+        REQUIRE (list2 == List<int>({4, 3, 2, 1, 0}));
+        //l[1:2] = l[:] from a non-const view
+        List<int> list3 = {0, 1, 2};
+        list3.slice(1, 2).assign(list3.slice(0));
+        REQUIRE (list3 == List<int>({0, 0, 1, 2, 2}));
+    }
+
+    SECTION("slice assignment operator")
+    {
+        List<int> list = {0, 1, 2, 3, 4, 5};
+        List<int> other = {7, 8, 9};
+        list.slice(1, 3) = other.slice(0);
+        REQUIRE (list == List<int>({0, 7, 8, 9, 3, 4, 5}));
+        list.slice(0, 2) = list.slice(4);
+        REQUIRE (list == List<int>({3, 4, 5, 8, 9, 3, 4, 5}));
+        REQUIRE_THROWS_AS (list.slice(0, Slice::none, 2) = other.slice(0, 1),
+                           ValueError);
+    }
+    
     SECTION("list of pointers")
     {
         List<int*> list;
@@ -0,0 +1,165 @@
+#include "catch.hpp"
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "snowball/collections/persistent_list.hpp"
+#include "snowball/collections/list.hpp"
+#include "snowball/exceptions/exceptions.h"
+
+using namespace snowball;
+
+/*
+ * Whether list holds the same items as vect, by index and by iterator.
+ */
+template <typename T>
+bool sameItems(const PersistentList<T>& list, const std::vector<T>& vect)
+{
+    if (list.size() != vect.size())
+        return false;
+    for (std::size_t i = 0; i < vect.size(); ++i)
+    {
+        if (list[long(i)] != vect[i])
+            return false;
+    }
+    return std::equal(vect.begin(), vect.end(), list.begin());
+}
+
+TEST_CASE("persistent list", "[collections]")
+{
+    SECTION("constructors")
+    {
+        PersistentList<int> list1;
+        REQUIRE (list1.size() == 0);
+        REQUIRE (list1.begin() == list1.end());
+        PersistentList<int> list2 = {1, 2, 3};
+        REQUIRE (list2.size() == 3);
+        REQUIRE (list2[-1] == 3);
+        List<std::string> strings = {"a", "b", "c"};
+        PersistentList<std::string> list3(strings);
+        REQUIRE (list3.toList() == strings);
+        REQUIRE_THROWS_AS (list3[3], IndexError);
+        REQUIRE_THROWS_AS (list3[-4], IndexError);
+    }
+
+    SECTION("append keeps versions")
+    {
+        //crosses the tail, one and two levels of the trie
+        const int n = 32 * 32 * 32 + 100;
+        std::vector<PersistentList<int> > versions(1);
+        std::vector<int> items;
+        for (int i = 0; i < n; ++i)
+        {
+            versions.push_back(versions.back().append(i));
+            items.push_back(i);
+        }
+        REQUIRE (sameItems(versions.back(), items));
+        for (int size: {0, 1, 31, 32, 33, 1055, 1056, 1057, 32800, 32801})
+        {
+            std::vector<int> prefix(items.begin(), items.begin() + size);
+            if (!sameItems(versions[size], prefix))
+                FAIL("version " << size << " was modified");
+        }
+    }
+
+    SECTION("set")
+    {
+        List<int> items;
+        for (int i = 0; i < 2000; ++i)
+            items.append(i);
+        PersistentList<int> list1(items);
+        PersistentList<int> list2 = list1.set(0, -1).set(1500, -2).set(-1, -3);
+        REQUIRE (list1.toList() == items);
+        REQUIRE (list2[0] == -1);
+        REQUIRE (list2[1500] == -2);
+        REQUIRE (list2[1999] == -3);
+        REQUIRE (list2[1] == 1);
+        REQUIRE (list1 != list2);
+        REQUIRE (list1 == PersistentList<int>(items));
+        REQUIRE_THROWS_AS (list1.set(2000, 0), IndexError);
+    }
+
+    SECTION("pop")
+    {
+        const int n = 32 * 32 * 32 + 100;
+        PersistentList<int>::Transient transient = PersistentList<int>().transient();
+        std::vector<int> items;
+        for (int i = 0; i < n; ++i)
+        {
+            transient.append(i);
+            items.push_back(i);
+        }
+        PersistentList<int> full = transient.persistent();
+        PersistentList<int> list = full;
+        while (list.size() != 0)
+        {
+            list = list.pop();
+            items.pop_back();
+            std::size_t size = items.size();
+            if (size % 997 == 0 || size < 40 || (size > 1020 && size < 1090) ||
+                (size > 32760 && size < 32840))
+            {
+                if (!sameItems(list, items))
+                    FAIL("wrong items after pop to size " << size);
+            }
+        }
+        REQUIRE_THROWS_AS (list.pop(), IndexError);
+        REQUIRE (full.size() == std::size_t(n));
+        REQUIRE (full[n - 1] == n - 1);
+        //a popped list grows again
+        PersistentList<int> regrown = full.pop().pop().append(7);
+        REQUIRE (regrown.size() == std::size_t(n - 1));
+        REQUIRE (regrown[-1] == 7);
+        REQUIRE (regrown[-2] == n - 3);
+    }
+
+    SECTION("transient")
+    {
+        PersistentList<int> base = {0, 1, 2};
+        PersistentList<int>::Transient transient = base.transient();
+        for (int i = 3; i < 100; ++i)
+            transient.append(i);
+        transient.set(0, 42);
+        transient.pop();
+        REQUIRE (transient.size() == 99);
+        REQUIRE (transient[0] == 42);
+        PersistentList<int> first = transient.persistent();
+        //edits after persistent() must not change first
+        transient.set(50, -1);
+        transient.append(1000);
+        PersistentList<int> second = transient.persistent();
+        REQUIRE (base == PersistentList<int>({0, 1, 2}));
+        REQUIRE (first.size() == 99);
+        REQUIRE (first[50] == 50);
+        REQUIRE (first[0] == 42);
+        REQUIRE (second.size() == 100);
+        REQUIRE (second[50] == -1);
+        REQUIRE (second[-1] == 1000);
+        PersistentList<int>::Transient moved(std::move(transient));
+        moved.set(0, 7);
+        REQUIRE (transient[0] == 42);
+        REQUIRE (moved[0] == 7);
+        REQUIRE (second[0] == 42);
+    }
+
+    SECTION("contains and iterators")
+    {
+        List<std::string> strings;
+        for (int i = 0; i < 100; ++i)
+            strings.append(std::to_string(i));
+        PersistentList<std::string> list(strings);
+        REQUIRE (list.contains("99"));
+        REQUIRE (list.contains("0"));
+        REQUIRE_FALSE (list.contains("100"));
+        PersistentList<std::string>::const_iterator it = list.end();
+        --it;
+        REQUIRE (*it == "99");
+        REQUIRE (it->size() == 2);
+        REQUIRE (it[-60] == "39");
+        std::ptrdiff_t size = list.end() - list.begin();
+        REQUIRE (size == 100);
+        std::ptrdiff_t pos = std::find(list.begin(), list.end(), "64") - list.begin();
+        REQUIRE (pos == 64);
+    }
+}
@@ -0,0 +1,181 @@
+#include "catch.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "snowball/concurrency/rcu_dictionary.hpp"
+#include "snowball/collections/string.h"
+
+using namespace snowball;
+
+/**
+ * Value counting its live instances.
+ */
+struct Counted
+{
+    Counted(): value(0) { ++live; };
+    Counted(long value): value(value) { ++live; };
+    Counted(const Counted& other): value(other.value) { ++live; };
+    ~Counted() { --live; };
+    Counted& operator=(const Counted& other)
+    {
+        value = other.value;
+        return *this;
+    };
+
+    long value;
+    static std::atomic<long> live;
+};
+
+std::atomic<long> Counted::live(0);
+
+
+TEST_CASE("rcu dictionary", "[concurrency]")
+{
+    SECTION("single thread")
+    {
+        RcuDictionary<std::string, int> dict;
+        REQUIRE (dict.size() == 0);
+        REQUIRE (dict.get("one", -1) == -1);
+        dict.set("one", 1);
+        dict.set("two", 2);
+        REQUIRE (dict.size() == 2);
+        REQUIRE (dict.get("one", -1) == 1);
+        REQUIRE (dict.contains("two"));
+        REQUIRE (dict.erase("two"));
+        REQUIRE_FALSE (dict.erase("two"));
+        REQUIRE_FALSE (dict.contains("two"));
+        dict.update([](RcuDictionary<std::string, int>::version_type& v) {
+            v["three"] = 3;
+            v["four"] = 4;
+        });
+        REQUIRE (dict.size() == 3);
+        FlatDictionary<std::string, int> version;
+        version["five"] = 5;
+        dict.publish(version);
+        REQUIRE (dict.size() == 1);
+        REQUIRE (dict.get("five", 0) == 5);
+        dict.synchronize();
+    }
+
+    SECTION("first version")
+    {
+        FlatDictionary<long, long> version;
+        for (long i = 0; i < 100; ++i)
+            version[i] = i * i;
+        RcuDictionary<long, long> dict(std::move(version));
+        REQUIRE (dict.size() == 100);
+        REQUIRE (dict.get(9, 0) == 81);
+    }
+
+    SECTION("snapshot")
+    {
+        RcuDictionary<std::string, int> dict;
+        dict.set("one", 1);
+        {
+            RcuDictionary<std::string, int>::Snapshot snapshot = dict.snapshot();
+            dict.set("one", 11);
+            dict.set("two", 2);
+            //snapshot keeps its version
+            REQUIRE ((*snapshot)["one"] == 1);
+            REQUIRE (snapshot->size() == 1);
+            REQUIRE_FALSE (snapshot->contains("two"));
+            RcuDictionary<std::string, int>::Snapshot nested = dict.snapshot();
+            REQUIRE ((*nested)["one"] == 11);
+            RcuDictionary<std::string, int>::Snapshot moved(std::move(nested));
+            REQUIRE (moved->size() == 2);
+        }
+        REQUIRE (dict.get("one", 0) == 11);
+    }
+
+    SECTION("failed update")
+    {
+        RcuDictionary<std::string, int> dict;
+        dict.set("one", 1);
+        REQUIRE_THROWS_AS (dict.update(
+            [](RcuDictionary<std::string, int>::version_type& v) {
+                v["two"] = 2;
+                throw ValueError("abort");
+            }), ValueError);
+        REQUIRE (dict.size() == 1);
+    }
+
+    SECTION("reclamation")
+    {
+        long before = Counted::live;
+        {
+            RcuDictionary<int, Counted> dict;
+            dict.set(1, Counted(1));
+            {
+                RcuDictionary<int, Counted>::Snapshot snapshot = dict.snapshot();
+                for (int i = 2; i < 10; ++i)
+                    dict.set(i, Counted(i));
+                //versions published while the snapshot is held are kept
+                long kept = Counted::live - before;
+                REQUIRE (kept > 9);
+                REQUIRE ((*snapshot)[1].value == 1);
+            }
+            dict.set(10, Counted(10));
+            //the next publish releases all but the current version
+            long current = Counted::live - before;
+            REQUIRE (current == 10);
+            dict.synchronize();
+            current = Counted::live - before;
+            REQUIRE (current == 10);
+        }
+        long after = Counted::live;
+        REQUIRE (after == before);
+    }
+
+    SECTION("heterogeneous lookup")
+    {
+        RcuDictionary<std::string, int, StringHash, StringEqual> dict;
+        dict.set("one", 1);
+        REQUIRE (dict.get(String("one"), 0) == 1);
+        REQUIRE (dict.contains(std::string("one")));
+        REQUIRE (dict.erase(String("one")));
+    }
+
+    SECTION("concurrent readers and writer")
+    {
+        //each version maps every key to the same value: a reader seeing two
+        //values in a snapshot saw a torn version
+        RcuDictionary<long, std::string> dict;
+        dict.update([](RcuDictionary<long, std::string>::version_type& v) {
+            for (long i = 0; i < 100; ++i)
+                v[i] = "0";
+        });
+        std::atomic<bool> stop(false);
+        std::vector<char> consistent(3, 1);
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 3; ++t)
+            readers.push_back(std::thread([&, t]() {
+                while (!stop)
+                {
+                    RcuDictionary<long, std::string>::Snapshot snapshot =
+                        dict.snapshot();
+                    const std::string& first = (*snapshot)[0];
+                    for (long i = 1; i < 100; ++i)
+                        if ((*snapshot)[i] != first)
+                            consistent[t] = 0;
+                    if (dict.get(t, "").empty())
+                        consistent[t] = 0;
+                }
+            }));
+        for (long round = 1; round <= 500; ++round)
+            dict.update([round](RcuDictionary<long, std::string>::version_type& v) {
+                for (long i = 0; i < 100; ++i)
+                    v[i] = std::to_string(round);
+            });
+        stop = true;
+        for (std::thread& reader: readers)
+            reader.join();
+        REQUIRE (std::count(consistent.begin(), consistent.end(), 0) == 0);
+        REQUIRE (dict.get(50, "") == "500");
+        dict.synchronize();
+    }
+}
@@ -0,0 +1,197 @@
+#include "catch.hpp"
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+
+#include "snowball/collections/relocatable_vector.hpp"
+#include "snowball/collections/list.hpp"
+
+using namespace snowball;
+
+/*
+ * Item owning heap memory, which opts in to relocation. Copies throw when
+ * the counter of allowed copies is exhausted.
+ */
+struct Owner
+{
+    static int alive;
+    static int copiesLeft;
+    int* value;
+    Owner(int v = 0): value(new int(v)) { ++alive; };
+    Owner(const Owner& other): value(0)
+    {
+        if (copiesLeft-- == 0)
+            throw std::runtime_error("copy");
+        value = new int(*other.value);
+        ++alive;
+    };
+    Owner(Owner&& other) noexcept: value(other.value)
+    {
+        other.value = 0;
+        ++alive;
+    };
+    Owner& operator=(Owner&& other) noexcept
+    {
+        std::swap(value, other.value);
+        return *this;
+    };
+    Owner& operator=(const Owner& other)
+    {
+        *value = *other.value;
+        return *this;
+    };
+    ~Owner() { delete value; --alive; };
+};
+
+int Owner::alive = 0;
+int Owner::copiesLeft = -1;
+
+namespace snowball
+{
+template <>
+struct TriviallyRelocatable<Owner>: public std::true_type { };
+}
+
+/*
+ * Allocator distinct from std::allocator: List falls back to std::vector.
+ */
+template <typename T>
+struct OtherAllocator: public std::allocator<T>
+{
+    template <typename U>
+    struct rebind { typedef OtherAllocator<U> other; };
+    OtherAllocator() { };
+    template <typename U>
+    OtherAllocator(const OtherAllocator<U>&) { };
+};
+
+TEST_CASE("relocatable vector", "[collections]")
+{
+    SECTION("storage of List")
+    {
+        typedef List<int>::storage_type IntStorage;
+        typedef List<double>::storage_type DoubleStorage;
+        typedef List<std::string>::storage_type StringStorage;
+        typedef List<int, OtherAllocator<int> >::storage_type OtherStorage;
+        bool intRelocatable = std::is_same<IntStorage, 
+                                           RelocatableVector<int> >::value;
+        bool doubleRelocatable = std::is_same<DoubleStorage, 
+                                 RelocatableVector<double> >::value;
+        bool stringVector = std::is_same<StringStorage, 
+                            std::vector<std::string> >::value;
+        bool otherVector = std::is_same<OtherStorage, 
+                           std::vector<int, OtherAllocator<int> > >::value;
+        REQUIRE (intRelocatable);
+        REQUIRE (doubleRelocatable);
+        REQUIRE (stringVector);
+        REQUIRE (otherVector);
+        List<int, OtherAllocator<int> > list = {1, 2};
+        list.append(3);
+        REQUIRE (list[-1] == 3);
+    }
+
+    SECTION("growth")
+    {
+        RelocatableVector<long> vect;
+        for (long i = 0; i < 100000; ++i)
+            vect.push_back(i);
+        REQUIRE (vect.size() == 100000);
+        REQUIRE (vect.capacity() >= 100000);
+        REQUIRE (vect[99999] == 99999);
+        RelocatableVector<long> copy(vect);
+        REQUIRE (copy.size() == 100000);
+        REQUIRE (copy[12345] == 12345);
+        vect.clear();
+        REQUIRE (vect.size() == 0);
+        REQUIRE (vect.capacity() >= 100000);
+    }
+
+    SECTION("insert and erase")
+    {
+        RelocatableVector<int> vect = {0, 1, 2, 3, 4};
+        vect.insert(vect.begin(), -1);
+        vect.insert(vect.begin() + 3, 10);
+        vect.insert(vect.end(), 5);
+        REQUIRE (std::vector<int>(vect.begin(), vect.end()) == 
+                 std::vector<int>({-1, 0, 1, 10, 2, 3, 4, 5}));
+        vect.erase(vect.begin() + 3);
+        vect.erase(vect.begin(), vect.begin() + 2);
+        REQUIRE (std::vector<int>(vect.begin(), vect.end()) == 
+                 std::vector<int>({1, 2, 3, 4, 5}));
+        std::vector<int> other = {7, 8};
+        vect.insert(vect.begin() + 1, other.begin(), other.end());
+        REQUIRE (std::vector<int>(vect.begin(), vect.end()) == 
+                 std::vector<int>({1, 7, 8, 2, 3, 4, 5}));
+    }
+
+    SECTION("items of the vector itself")
+    {
+        List<int> list = {1, 2, 3};
+        for (int i = 0; i < 10; ++i)
+            list.append(list[0]);
+        REQUIRE (list.size() == 13);
+        REQUIRE (list[-1] == 1);
+        list.extend(list);
+        REQUIRE (list.size() == 26);
+        REQUIRE (list[14] == 2);
+        RelocatableVector<int> vect = {0, 1, 2, 3};
+        vect.reserve(100);
+        vect.insert(vect.begin() + 1, vect.begin() + 2, vect.end());
+        REQUIRE (std::vector<int>(vect.begin(), vect.end()) == 
+                 std::vector<int>({0, 2, 3, 1, 2, 3}));
+        vect.insert(vect.begin(), vect[5]);
+        REQUIRE (vect[0] == 3);        //iterators which are not pointers into a full buffer
+        RelocatableVector<int> full = {0, 1, 2, 3};
+        full.insert(full.begin() + 1, std::make_move_iterator(full.begin()),
+                    std::make_move_iterator(full.end()));
+        REQUIRE (std::vector<int>(full.begin(), full.end()) == 
+                 std::vector<int>({0, 0, 1, 2, 3, 1, 2, 3}));
+        full.insert(full.end(), full.rbegin(), full.rbegin() + full.size());
+        REQUIRE (full.size() == 16);
+        REQUIRE (full[8] == 3);
+        REQUIRE (full[15] == 0);
+    }
+
+    SECTION("items owning memory")
+    {
+        Owner::alive = 0;
+        {
+            List<Owner> list;
+            for (int i = 0; i < 1000; ++i)
+                list.append(Owner(i));
+            REQUIRE (Owner::alive == 1000);
+            list.insert(0, Owner(-1));
+            REQUIRE (*list[0].value == -1);
+            REQUIRE (*list[1000].value == 999);
+            list.pop(0);
+            list.pop();
+            REQUIRE (Owner::alive == 999);
+            REQUIRE (*list[500].value == 500);
+            List<Owner> copy = list;
+            REQUIRE (Owner::alive == 1998);
+        }
+        REQUIRE (Owner::alive == 0);
+    }
+
+    SECTION("exception while inserting")
+    {
+        Owner::alive = 0;
+        {
+            RelocatableVector<Owner> vect;
+            for (int i = 0; i < 4; ++i)
+                vect.emplace_back(i);
+            std::vector<Owner> items(3);
+            Owner::copiesLeft = 2;
+            REQUIRE_THROWS_AS (vect.insert(vect.begin() + 1, items.begin(), 
+                                           items.end()), std::runtime_error);
+            Owner::copiesLeft = -1;
+            REQUIRE (vect.size() == 4);
+            REQUIRE (*vect[1].value == 1);
+            REQUIRE (*vect[3].value == 3);
+            REQUIRE (Owner::alive == 7);
+        }
+        REQUIRE (Owner::alive == 0);
+    }
+}
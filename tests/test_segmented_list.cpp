@@ -0,0 +1,181 @@
+#include "catch.hpp"
+
+#include <string>
+#include <functional>
+
+#include "snowball/collections/segmented_list.hpp"
+#include "snowball/collections/list.hpp"
+#include "snowball/exceptions/exceptions.h"
+
+using namespace snowball;
+
+/*
+ * Item large enough to have 16 items per segment.
+ */
+struct Block
+{
+    Block(int v = 0): value(v) { };
+    bool operator==(const Block& other) const { return value == other.value; };
+    int value;
+    char payload[4092];
+};
+
+template <typename T>
+List<T> toList(const SegmentedList<T>& list)
+{
+    List<T> output;
+    typename SegmentedList<T>::const_iterator it;
+    for (it = list.begin(); it != list.end(); ++it)
+        output.append(*it);
+    return output;
+}
+
+TEST_CASE("segmented list", "[collections]")
+{
+    SECTION("constructors")
+    {
+        SegmentedList<int> list1;
+        REQUIRE (list1.size() == 0);
+        REQUIRE (list1.capacity() == 0);
+        SegmentedList<int> list2 = {0, 1, 2, 3};
+        REQUIRE (toList(list2) == List<int>({0, 1, 2, 3}));
+        SegmentedList<int> list3(list2);
+        REQUIRE (list3 == list2);
+        SegmentedList<int> list4(std::move(list3));
+        REQUIRE (list4 == list2);
+        REQUIRE (list3.size() == 0);
+        list3 = list4;
+        REQUIRE (list3 == list2);
+        list1 = std::move(list3);
+        REQUIRE (list1 == list2);
+    }
+
+    SECTION("segment size")
+    {
+        REQUIRE (SegmentedList<int>::segmentSize == 16384);
+        REQUIRE (SegmentedList<Block>::segmentSize == 16);
+        REQUIRE (SegmentedList<char>::segmentSize == 65536);
+    }
+
+    SECTION("append keeps references valid")
+    {
+        SegmentedList<int> list;
+        list.append(-1);
+        const int* first = &list[0];
+        for (int i = 0; i < 100000; ++i)
+            list.append(i);
+        REQUIRE (list.size() == 100001);
+        REQUIRE (first == &list[0]);
+        REQUIRE (*first == -1);
+        REQUIRE (list[-1] == 99999);
+        REQUIRE (list[50001] == 50000);
+        REQUIRE_THROWS_AS (list[100001], IndexError);
+        REQUIRE_THROWS_AS (list[-100002], IndexError);
+    }
+
+    SECTION("pop releases segments")
+    {
+        SegmentedList<Block> list;
+        for (int i = 0; i < 100; ++i)
+            list.append(Block(i));
+        REQUIRE (list.capacity() == 112);
+        for (int i = 99; i >= 20; --i)
+            REQUIRE (list.pop().value == i);
+        //segment of last item and one spare segment are kept
+        REQUIRE (list.capacity() == 48);
+        REQUIRE (list.pop(0).value == 0);
+        REQUIRE (list[0].value == 1);
+        REQUIRE (list.size() == 19);
+        list.clear();
+        REQUIRE (list.size() == 0);
+        REQUIRE (list.capacity() == 0);
+        REQUIRE_THROWS_AS (list.pop(), IndexError);
+        list.append(Block(3));
+        REQUIRE (list[0].value == 3);
+    }
+
+    SECTION("insert")
+    {
+        SegmentedList<Block> list;
+        for (int i = 0; i < 40; ++i)
+            list.append(Block(i));
+        list.insert(0, Block(-1));
+        list.insert(17, Block(100));
+        list.insert(-1, Block(200));
+        list.insert(1000, Block(300));
+        REQUIRE (list.size() == 44);
+        REQUIRE (list[0].value == -1);
+        REQUIRE (list[1].value == 0);
+        REQUIRE (list[17].value == 100);
+        REQUIRE (list[18].value == 16);
+        REQUIRE (list[-3].value == 200);
+        REQUIRE (list[-2].value == 39);
+        REQUIRE (list[-1].value == 300);
+    }
+
+    SECTION("search")
+    {
+        SegmentedList<int> list;
+        for (int i = 0; i < 50000; ++i)
+            list.append(i % 20000);
+        REQUIRE (list.contains(19999));
+        REQUIRE (!list.contains(20000));
+        REQUIRE (list.index(17000) == 17000);
+        REQUIRE (list.count(7000) == 3);
+        REQUIRE (list.count(17000) == 2);
+        REQUIRE_THROWS_AS (list.index(-1), ValueError);
+        list.remove(17000);
+        REQUIRE (list.size() == 49999);
+        REQUIRE (list.index(17000) == 36999);
+        REQUIRE (list[17000] == 17001);
+        REQUIRE_THROWS_AS (list.remove(-1), ValueError);
+    }
+
+    SECTION("extend with itself")
+    {
+        SegmentedList<long> list;
+        for (long i = 0; i < 20000; ++i)
+            list.append(i);
+        list.extend(list);
+        REQUIRE (list.size() == 40000);
+        bool same = true;
+        for (long i = 0; i < 20000; ++i)
+            same = same && list[i] == i && list[i + 20000] == i;
+        REQUIRE (same);
+        SegmentedList<std::string> strings = {"a", "b"};
+        strings.extend(strings);
+        REQUIRE (toList(strings) == List<std::string>({"a", "b", "a", "b"}));
+    }
+
+    SECTION("strings")
+    {
+        SegmentedList<std::string> list = {"b", "c", "a"};
+        list.sort();
+        REQUIRE (toList(list) == List<std::string>({"a", "b", "c"}));
+        list.sort(std::greater<std::string>());
+        REQUIRE (toList(list) == List<std::string>({"c", "b", "a"}));
+        list.reverse();
+        REQUIRE (list.pop(1) == "b");
+        REQUIRE (toList(list) == List<std::string>({"a", "c"}));
+    }
+
+    SECTION("iterators")
+    {
+        SegmentedList<int> list;
+        for (int i = 0; i < 40000; ++i)
+            list.append(40000 - i);
+        list.sort();
+        REQUIRE (list[0] == 1);
+        REQUIRE (list[-1] == 40000);
+        SegmentedList<int>::iterator it = list.begin() + 20000;
+        REQUIRE (*it == 20001);
+        long distance = it - list.begin();
+        REQUIRE (distance == 20000);
+        SegmentedList<int>::const_reverse_iterator rit = list.rbegin();
+        REQUIRE (*rit == 40000);
+        long sum = 0;
+        for (int value: list)
+            sum += value;
+        REQUIRE (sum == 800020000L);
+    }
+}
@@ -0,0 +1,91 @@
+#include "catch.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <string>
+
+#include "snowball/collections/simd_search.h"
+#include "snowball/collections/list.hpp"
+
+using namespace snowball;
+
+/*
+ * Check findItem and countItem against std::find and std::count for all 
+ * sizes up to 80 and a match at every position.
+ */
+template <typename T>
+bool matchesStd(T filler, T target)
+{
+    for (std::size_t n = 0; n < 80; ++n)
+    {
+        std::vector<T> data(n, filler);
+        for (std::size_t pos = 0; pos <= n; ++pos)
+        {
+            if (pos < n)
+                data[pos] = target;
+            if (findItem(data.begin(), data.end(), target) != 
+                std::find(data.begin(), data.end(), target))
+                return false;
+            if (countItem(data.begin(), data.end(), target) != 
+                std::size_t(std::count(data.begin(), data.end(), target)))
+                return false;
+            if (findItem(data.begin(), data.end(), filler) != 
+                std::find(data.begin(), data.end(), filler))
+                return false;
+        }
+    }
+    return true;
+}
+
+
+TEST_CASE("simd search", "[collections]")
+{
+    SECTION("instruction set")
+    {
+        std::string isa = detail::simdInstructionSet();
+        REQUIRE ((isa == "avx2" || isa == "sse2" || isa == "scalar"));
+    }
+    
+    SECTION("integral types")
+    {
+        REQUIRE (matchesStd<int>(3, -7));
+        REQUIRE (matchesStd<unsigned int>(3, 4000000000u));
+        REQUIRE (matchesStd<long>(1L << 40, (1L << 40) + 1));
+        REQUIRE (matchesStd<long long>(-1, 1LL << 33));
+        //only the upper half differs
+        REQUIRE (matchesStd<std::int64_t>(5, 5 + (std::int64_t(1) << 32)));
+    }
+    
+    SECTION("floating point types")
+    {
+        REQUIRE (matchesStd<float>(1.5f, -2.25f));
+        REQUIRE (matchesStd<double>(1.5, 1.5 + 1e-12));
+        std::vector<double> data(37, 1.);
+        data[20] = -0.;
+        data[30] = std::numeric_limits<double>::quiet_NaN();
+        long zero = findItem(data.begin(), data.end(), 0.) - data.begin();
+        REQUIRE (zero == 20);
+        double nan = std::numeric_limits<double>::quiet_NaN();
+        REQUIRE (findItem(data.begin(), data.end(), nan) == data.end());
+        REQUIRE (countItem(data.begin(), data.end(), nan) == 0);
+    }
+    
+    SECTION("list methods")
+    {
+        List<long> list;
+        for (long i = 0; i < 100; ++i)
+            list.append(i % 10);
+        REQUIRE (list.contains(9));
+        REQUIRE (!list.contains(10));
+        REQUIRE (list.index(7) == 7);
+        REQUIRE (list.count(3) == 10);
+        list.remove(0);
+        REQUIRE (list.size() == 99);
+        REQUIRE (list.index(0) == 9);
+        REQUIRE_THROWS_AS (list.remove(10), ValueError);
+        List<float> floats = {0.5f, 1.5f, 2.5f};
+        REQUIRE (floats.index(2.5f) == 2);
+    }
+}
@@ -0,0 +1,214 @@
+#include "catch.hpp"
+
+#include <string>
+#include <vector>
+
+#include "snowball/collections/small_list.hpp"
+#include "snowball/exceptions/exceptions.h"
+
+using namespace snowball;
+
+typedef SmallList<int, 4> IntList;
+typedef SmallList<int, 8> IntList8;
+typedef SmallList<std::string, 2> StringList2;
+typedef SmallList<std::string, 3> StringList3;
+
+
+/**
+ * Stateful allocator which instances only release their own buffers.
+ */
+template <typename T>
+struct ArenaAllocator
+{
+    typedef T value_type;
+    typedef std::false_type propagate_on_container_move_assignment;
+    ArenaAllocator(int id): id(id) { };
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other): id(other.id) { };
+    T* allocate(std::size_t n)
+    {
+        ++live[id];
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n)
+    {
+        --live[id];
+        std::allocator<T>().deallocate(p, n);
+    }
+    bool operator==(const ArenaAllocator& other) const { return id == other.id; };
+    bool operator!=(const ArenaAllocator& other) const { return id != other.id; };
+    int id;
+    static int live[2];
+};
+
+template <typename T>
+int ArenaAllocator<T>::live[2] = {0, 0};
+
+bool greaterInt(const int& i, const int& j)
+{
+    return i > j;
+}
+
+TEST_CASE("small list", "[collections]")
+{
+    SECTION("constructors")
+    {
+        IntList list1;
+        REQUIRE (list1.size() == 0);
+        REQUIRE (list1.capacity() == 4);
+        REQUIRE (list1.isInline());
+        IntList list2 = {0, 1, 2};
+        REQUIRE (list2.size() == 3);
+        REQUIRE (list2.isInline());
+        IntList list3(6, 1);
+        REQUIRE (list3.size() == 6);
+        REQUIRE (!list3.isInline());
+        IntList list4(list3);
+        REQUIRE (list4 == list3);
+        list4 = list2;
+        REQUIRE (list4 == list2);
+        list4 = {5, 6};
+        REQUIRE (list4 == IntList({5, 6}));
+    }
+
+    SECTION("move inline and spilled lists")
+    {
+        StringList2 list1 = {"a", "b"};
+        StringList2 list2(std::move(list1));
+        REQUIRE (list2 == StringList2({"a", "b"}));
+        REQUIRE (list1.size() == 0);
+        list2.append("c");
+        REQUIRE (!list2.isInline());
+        const std::string* data = &list2[0];
+        StringList2 list3;
+        list3 = std::move(list2);
+        REQUIRE (&list3[0] == data);
+        REQUIRE (list2.isInline());
+        REQUIRE (list2.size() == 0);
+    }
+
+    SECTION("move assignment with unequal allocators")
+    {
+        typedef SmallList<std::string, 2, ArenaAllocator<std::string> > ArenaList;
+        {
+            ArenaList list1(ArenaAllocator<std::string>(0));
+            ArenaList list2(ArenaAllocator<std::string>(1));
+            list1.append("a");
+            for (int i = 0; i < 5; ++i)
+                list2.append(std::to_string(i));
+            REQUIRE (!list2.isInline());
+            list1 = std::move(list2);
+            REQUIRE (list1.size() == 5);
+            REQUIRE (list1[4] == "4");
+            REQUIRE (list2.size() == 0);
+        }
+        REQUIRE (ArenaAllocator<std::string>::live[0] == 0);
+        REQUIRE (ArenaAllocator<std::string>::live[1] == 0);
+    }
+
+    SECTION("containers move small lists")
+    {
+        static_assert(std::is_nothrow_move_constructible<StringList2>::value,
+                      "move constructor is noexcept");
+        static_assert(std::is_nothrow_move_assignable<StringList2>::value,
+                      "move assignment is noexcept");
+        //growth of the vector moves spilled lists: their buffers are kept
+        std::vector<StringList2> lists(1);
+        lists[0] = {"a", "b", "c"};
+        const std::string* data = &lists[0][0];
+        lists.resize(lists.capacity() + 1);
+        REQUIRE (&lists[0][0] == data);
+    }
+
+    SECTION("append spills to the heap")
+    {
+        StringList3 list;
+        for (int i = 0; i < 3; ++i)
+            list.append(std::string(1, char('a' + i)));
+        REQUIRE (list.isInline());
+        list.emplace(2, 'd');
+        REQUIRE (!list.isInline());
+        REQUIRE (list.size() == 4);
+        REQUIRE (list[0] == "a");
+        REQUIRE (list[-1] == "dd");
+        list.append(list[0]);
+        REQUIRE (list[-1] == "a");
+    }
+
+    SECTION("operator[]")
+    {
+        IntList8 list = {0, 1, 2, 3};
+        REQUIRE (list[0] == 0);
+        REQUIRE (list[-1] == 3);
+        list[-4] = 10;
+        REQUIRE (list[0] == 10);
+        REQUIRE_THROWS_AS (list[4], IndexError);
+        REQUIRE_THROWS_AS (list[-5], IndexError);
+    }
+
+    SECTION("insert")
+    {
+        IntList list = {0, 1, 2};
+        list.insert(10, 3);
+        REQUIRE (list == IntList({0, 1, 2, 3}));
+        list.insert(-10, 4);
+        REQUIRE (list == IntList({4, 0, 1, 2, 3}));
+        list.insert(2, 5);
+        REQUIRE (list == IntList({4, 0, 5, 1, 2, 3}));
+        list.insert(-1, 7);
+        REQUIRE (list == IntList({4, 0, 5, 1, 2, 7, 3}));
+        IntList other = {0, 1, 2};
+        other.insert(1, IntList({3, 4, 5}));
+        REQUIRE (other == IntList({0, 3, 4, 5, 1, 2}));
+    }
+
+    SECTION("pop, index, count and remove")
+    {
+        IntList list = {6, 4, 0, 5, 1, 4};
+        REQUIRE (list.pop() == 4);
+        REQUIRE (list.pop(0) == 6);
+        REQUIRE (list.pop(-2) == 5);
+        REQUIRE (list == IntList({4, 0, 1}));
+        REQUIRE (list.index(1) == 2);
+        REQUIRE_THROWS_AS (list.index(7), ValueError);
+        REQUIRE (list.contains(0));
+        REQUIRE (list.count(4) == 1);
+        list.remove(4);
+        REQUIRE (list == IntList({0, 1}));
+        REQUIRE_THROWS_AS (list.remove(4), ValueError);
+        list.clear();
+        REQUIRE_THROWS_AS (list.pop(), IndexError);
+    }
+
+    SECTION("extend and operator+")
+    {
+        IntList list1 = {0, 1};
+        IntList list2 = {2, 3, 4};
+        IntList list3 = list1 + list2;
+        REQUIRE (list3 == IntList({0, 1, 2, 3, 4}));
+        list1 += list2;
+        REQUIRE (list1 == list3);
+        list1.extend(list1);
+        REQUIRE (list1.size() == 10);
+        list2.extend(std::move(list3));
+        REQUIRE (list2.size() == 8);
+        REQUIRE (list3.size() == 0);
+    }
+
+    SECTION("sort, reverse and iterators")
+    {
+        IntList list = {6, 4, 0, 5, 1, 2, 7, 3};
+        list.sort();
+        REQUIRE (list == IntList({0, 1, 2, 3, 4, 5, 6, 7}));
+        list.sort(greaterInt);
+        REQUIRE (list == IntList({7, 6, 5, 4, 3, 2, 1, 0}));
+        list.reverse();
+        int expected = 0;
+        IntList::const_iterator it;
+        for (it = list.begin(); it != list.end(); ++it)
+            REQUIRE (*it == expected++);
+        IntList::reverse_iterator rit;
+        for (rit = list.rbegin(); rit != list.rend(); ++rit)
+            REQUIRE (*rit == --expected);
+    }
+}
@@ -0,0 +1,192 @@
+#include "catch.hpp"
+
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "snowball/collections/sorted_list.hpp"
+#include "snowball/exceptions/exceptions.h"
+
+using namespace snowball;
+
+/*
+ * Apply random additions and removals to a SortedList with small chunks and
+ * to a sorted std::vector, and check they agree.
+ */
+bool matchesVector(std::size_t n, std::size_t load)
+{
+    SortedList<int> list(std::less<int>(), load);
+    std::vector<int> ref;
+    std::srand(42);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        int value = std::rand() % 500;
+        if (std::rand() % 3 == 0 && !ref.empty())
+        {
+            std::size_t pos = std::rand() % ref.size();
+            if (list.pop(long(pos)) != ref[pos])
+                return false;
+            ref.erase(ref.begin() + pos);
+        }
+        else if (std::rand() % 3 == 0)
+        {
+            bool found = std::binary_search(ref.begin(), ref.end(), value);
+            if (list.discard(value) != found)
+                return false;
+            if (found)
+                ref.erase(std::lower_bound(ref.begin(), ref.end(), value));
+        }
+        else
+        {
+            list.add(value);
+            ref.insert(std::upper_bound(ref.begin(), ref.end(), value), value);
+        }
+        if (list.size() != ref.size())
+            return false;
+        if (i % 97 != 0)
+            continue;
+        if (!std::equal(ref.begin(), ref.end(), list.begin()))
+            return false;
+        for (std::size_t j = 0; j < ref.size(); ++j)
+        {
+            if (list[long(j)] != ref[j])
+                return false;
+        }
+        for (int v = -1; v < 501; v += 7)
+        {
+            std::size_t left = std::lower_bound(ref.begin(), ref.end(), v)
+                               - ref.begin();
+            std::size_t right = std::upper_bound(ref.begin(), ref.end(), v)
+                                - ref.begin();
+            if (list.bisectLeft(v) != left || list.bisectRight(v) != right)
+                return false;
+            if (list.count(v) != right - left)
+                return false;
+            if (list.contains(v) != (right > left))
+                return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("SortedList", "[collections]")
+{
+    SortedList<int> list = {5, 1, 3, 3, 9};
+
+    SECTION("constructors")
+    {
+        REQUIRE(list.size() == 5);
+        REQUIRE(list.toList() == List<int>({1, 3, 3, 5, 9}));
+        std::vector<int> items = {4, 2, 8};
+        SortedList<int> other(items.begin(), items.end());
+        REQUIRE(other.toList() == List<int>({2, 4, 8}));
+        SortedList<int> small({6, 2, 7, 1, 5, 3, 4}, std::less<int>(), 4);
+        small.add(0);
+        REQUIRE(small.toList() == List<int>({0, 1, 2, 3, 4, 5, 6, 7}));
+        std::vector<int> many;
+        for (int i = 99; i >= 0; --i)
+            many.push_back(i);
+        SortedList<int> chunked(many.begin(), many.end(), std::less<int>(), 4);
+        REQUIRE(chunked.size() == 100);
+        REQUIRE(chunked[50] == 50);
+        REQUIRE(chunked.pop(10) == 10);
+        REQUIRE(chunked.bisectLeft(11) == 10);
+        SortedList<int> empty;
+        REQUIRE(empty.size() == 0);
+        REQUIRE(empty.begin() == empty.end());
+        REQUIRE(!empty.contains(1));
+        REQUIRE(empty.bisectLeft(1) == 0);
+    }
+    SECTION("add")
+    {
+        list.add(4);
+        list.add(0);
+        list.add(10);
+        REQUIRE(list.toList() == List<int>({0, 1, 3, 3, 4, 5, 9, 10}));
+    }
+    SECTION("update")
+    {
+        list.update(List<int>({7, 2, 2}));
+        REQUIRE(list.toList() == List<int>({1, 2, 2, 3, 3, 5, 7, 9}));
+    }
+    SECTION("remove")
+    {
+        list.remove(3);
+        REQUIRE(list.toList() == List<int>({1, 3, 5, 9}));
+        REQUIRE_THROWS_AS(list.remove(4), ValueError);
+        REQUIRE(!list.discard(4));
+        REQUIRE(list.discard(9));
+        REQUIRE(list.toList() == List<int>({1, 3, 5}));
+    }
+    SECTION("pop")
+    {
+        REQUIRE(list.pop() == 9);
+        REQUIRE(list.pop(0) == 1);
+        REQUIRE(list.pop(-2) == 3);
+        REQUIRE(list.toList() == List<int>({3, 5}));
+        REQUIRE_THROWS_AS(list.pop(2), IndexError);
+        SortedList<int> empty;
+        REQUIRE_THROWS_AS(empty.pop(), IndexError);
+    }
+    SECTION("indexing")
+    {
+        REQUIRE(list[0] == 1);
+        REQUIRE(list[4] == 9);
+        REQUIRE(list[-1] == 9);
+        REQUIRE_THROWS_AS(list[5], IndexError);
+    }
+    SECTION("search")
+    {
+        REQUIRE(list.contains(3));
+        REQUIRE(!list.contains(4));
+        REQUIRE(list.index(3) == 1);
+        REQUIRE(list.index(9) == 4);
+        REQUIRE_THROWS_AS(list.index(4), ValueError);
+        REQUIRE_THROWS_AS(list.index(10), ValueError);
+        REQUIRE(list.count(3) == 2);
+        REQUIRE(list.count(4) == 0);
+        REQUIRE(list.bisectLeft(3) == 1);
+        REQUIRE(list.bisectRight(3) == 3);
+    }
+    SECTION("range queries")
+    {
+        REQUIRE(*list.lowerBound(3) == 3);
+        REQUIRE(*list.upperBound(3) == 5);
+        REQUIRE(list.upperBound(9) == list.end());
+        REQUIRE(list.range(2, 9) == List<int>({3, 3, 5}));
+        REQUIRE(list.range(0, 100) == List<int>({1, 3, 3, 5, 9}));
+        REQUIRE(list.range(9, 2) == List<int>());
+    }
+    SECTION("comparator")
+    {
+        SortedList<int, std::greater<int> > reversed = {5, 1, 3};
+        REQUIRE(reversed.toList() == List<int>({5, 3, 1}));
+        REQUIRE(reversed.index(1) == 2);
+    }
+    SECTION("iterators")
+    {
+        SortedList<int>::const_iterator it = list.end();
+        --it;
+        REQUIRE(*it == 9);
+        int sum = 0;
+        for (int value: list)
+            sum += value;
+        REQUIRE(sum == 21);
+    }
+    SECTION("comparison and clear")
+    {
+        SortedList<int> other = {9, 5, 3, 3, 1};
+        REQUIRE(list == other);
+        other.clear();
+        REQUIRE(other.size() == 0);
+        REQUIRE(list != other);
+        other.add(2);
+        REQUIRE(other.toList() == List<int>({2}));
+    }
+    SECTION("many items in small chunks")
+    {
+        REQUIRE(matchesVector(5000, 4));
+        REQUIRE(matchesVector(5000, 16));
+    }
+}
@@ -3,6 +3,8 @@
 #include <iostream>
 #include <sstream>
 #include <cmath>
+#include <vector>
+#include <algorithm>
 
 #include "snowball/collections/string.h"
 #include "snowball/version.h"
@@ -165,6 +167,56 @@ TEST_CASE("string", "[collections]")
         REQUIRE (fields == expected);
     }
     
+    SECTION("split into a SmallList")
+    {
+        typedef SmallList<String, 8> Fields;
+        typedef SmallList<String, 2> ShortFields;
+        String test("x;y;z");
+        Fields fields = test.split<Fields>(";");
+        REQUIRE (fields.isInline());
+        REQUIRE (fields == Fields({"x", "y", "z"}));
+        fields = test.split<Fields>(';');
+        REQUIRE (fields.size() == 3);
+        fields = String("a b\tc").split<Fields>();
+        REQUIRE (fields == Fields({"a", "b", "c"}));
+        ShortFields spilled = test.split<ShortFields>(";");
+        REQUIRE (!spilled.isInline());
+        REQUIRE (spilled[-1] == "z");
+    }
+    
+    SECTION("move")
+    {
+        String source("It's raining cats and dogs today !");
+        String moved(std::move(source));
+        REQUIRE (moved == "It's raining cats and dogs today !");
+        REQUIRE (source.size() == 0);
+        source = std::move(moved);
+        REQUIRE (source == "It's raining cats and dogs today !");
+        REQUIRE (moved.size() == 0);
+    }
+    
+    SECTION("sort list of strings")
+    {
+        List<String> list;
+        const char* prefixes[] = {"", "a", "ab", "abc", "snowball/", "\xc3\xa9"};
+        for (int i = 0; i < 3000; ++i)
+        {
+            std::stringstream ss;
+            ss << prefixes[i % 6] << (i * 7919) % 1009;
+            if (i % 11 == 0)
+                ss.str("");
+            list.append(String(ss.str()));
+        }
+        List<String> small = {"pear", "apple", "", "fig", "apple pie"};
+        std::vector<String> expected(list.begin(), list.end());
+        std::sort(expected.begin(), expected.end());
+        list.sort();
+        small.sort();
+        REQUIRE (list == List<String>(expected));
+        REQUIRE (small == List<String>({"", "apple", "apple pie", "fig", 
+                                        "pear"}));
+    }
+    
     SECTION("operator!=")
     {
         String test1("Hello World!");
@@ -0,0 +1,55 @@
+#include "catch.hpp"
+
+#include <atomic>
+#include <vector>
+#include <stdexcept>
+
+#include "snowball/concurrency/thread_pool.h"
+
+using namespace snowball;
+
+
+TEST_CASE("thread pool", "[concurrency]")
+{
+    SECTION("size")
+    {
+        ThreadPool pool(3);
+        REQUIRE (pool.size() == 3);
+        REQUIRE (ThreadPool::instance().size() >= 1);
+    }
+    
+    SECTION("parallel for")
+    {
+        ThreadPool pool(4);
+        std::vector<int> values(1000, 0);
+        pool.parallelFor(values.size(), [&](std::size_t i) {
+            values[i] = int(i) * 2;
+        });
+        for (std::size_t i = 0; i < values.size(); ++i)
+            REQUIRE (values[i] == int(i) * 2);
+        pool.parallelFor(0, [&](std::size_t i) { values[i] = -1; });
+        REQUIRE (values[0] == 0);
+    }
+    
+    SECTION("nested parallel for")
+    {
+        ThreadPool pool(2);
+        std::atomic<int> count(0);
+        pool.parallelFor(8, [&](std::size_t) {
+            pool.parallelFor(8, [&](std::size_t) { ++count; });
+        });
+        REQUIRE (count.load() == 64);
+    }
+    
+    SECTION("exception")
+    {
+        ThreadPool pool(3);
+        std::atomic<int> count(0);
+        REQUIRE_THROWS_AS (pool.parallelFor(16, [&](std::size_t i) {
+            ++count;
+            if (i == 5)
+                throw std::runtime_error("failure");
+        }), std::runtime_error);
+        REQUIRE (count.load() == 16);
+    }
+}